@@ -148,6 +148,11 @@ bool Master::init() {
 				return false;
 			}
 		}
+
+		if ( queue.pipeline.enable ) {
+			SEISCOMP_INFO("  + pipelined processing, backlog %d", queue.pipeline.backlog);
+			q->setPipelined(true, queue.pipeline.backlog);
+		}
 	}
 
 	if ( _server->numberOfQueues() == 0 ) {
@@ -44,6 +44,7 @@ class DebugDelay : public Messaging::Broker::MessageProcessor {
 	public:
 		DebugDelay() {
 			setMode(Messages);
+			setBlocking(true);
 		}
 
 
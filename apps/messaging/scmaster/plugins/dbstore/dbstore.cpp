@@ -273,6 +273,7 @@ class DBStore : public Messaging::Broker::MessageProcessor {
 	public:
 		DBStore() {
 			setMode(Messages | Connections);
+			setBlocking(true);
 		}
 
 		bool init(const Config::Config &cfg, const string &configPrefix) override {
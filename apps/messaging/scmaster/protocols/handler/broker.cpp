@@ -238,6 +238,23 @@ BrokerHandler::~BrokerHandler() {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BrokerHandler::start() {
 	_bytesSent = 0;
+	_inUpdate = true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void BrokerHandler::finish() {
+	_inUpdate = false;
+
+	if ( _ackPending ) {
+		_ackPending = false;
+		if ( _session->request().state != HttpRequest::FINISHED ) {
+			sendAck();
+		}
+	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -482,6 +499,24 @@ void BrokerHandler::disconnected(const Broker::Client *disconnectedClient,
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BrokerHandler::ack() {
+	// While received frames are handled the acknowledgement is deferred
+	// to the end of the update cycle. A client sending a batch of messages
+	// which spans several acknowledgement windows receives only one
+	// cumulative acknowledgement.
+	if ( _inUpdate ) {
+		_ackPending = true;
+		return;
+	}
+
+	sendAck();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void BrokerHandler::sendAck() {
 	Broker::Message msg;
 	msg.encodingWebSocket = new Buffer;
 
@@ -512,14 +547,17 @@ void BrokerHandler::dispose() {
 size_t BrokerHandler::sendMessage(Broker::Message *msg) {
 	if ( !msg->encodingWebSocket ) {
 		// Create new buffer. Other session will reuse it and send
-		// it without further encoding
+		// it without further encoding. The protocol header and the frame
+		// header go into the buffer header and the payload is moved into
+		// the buffer data. Both are sent with a single scatter-gather
+		// write and the payload is never copied.
 		msg->encodingWebSocket = new Buffer;
 
 		// The default frame type is binary
 		Websocket::Frame::Type frameType = Websocket::Frame::BinaryFrame;
 
 		if ( msg->type != Broker::Message::Type::Status ) {
-			osstream os(msg->encodingWebSocket->data);
+			osstream os(msg->encodingWebSocket->header);
 			bool identity = true;
 			os << SCMP_PROTO_REPLY_SEND "\n"
 			   << SCMP_PROTO_REPLY_SEND_HEADER_SENDER ":" << msg->sender << "\n"
@@ -545,21 +583,25 @@ size_t BrokerHandler::sendMessage(Broker::Message *msg) {
 						frameType = Websocket::Frame::TextFrame;
 				}
 			}
-			os << "\n"
-			   << msg->payload;
+			os << "\n";
 		}
 		else {
 			frameType = Websocket::Frame::TextFrame;
-			osstream os(msg->encodingWebSocket->data);
+			osstream os(msg->encodingWebSocket->header);
 			os << SCMP_PROTO_REPLY_STATE "\n"
 			   << SCMP_PROTO_REPLY_STATE_HEADER_DESTINATION ":" << msg->target << "\n"
 			   << SCMP_PROTO_REPLY_STATE_HEADER_CLIENT ":" << msg->sender << "\n"
 			   << SCMP_PROTO_REPLY_STATE_HEADER_CONTENT_LENGTH ":" << msg->payload.size() << "\n";
-			os << "\n"
-			   << msg->payload;
+			os << "\n";
 		}
 
-		Websocket::Frame::finalizeBuffer(msg->encodingWebSocket.get(), frameType);
+		if ( msg->blockingPending )
+			// Blocking processors still read the payload, copy it
+			msg->encodingWebSocket->data = msg->payload;
+		else
+			// Move the payload into the frame, it is cleared below anyway
+			msg->encodingWebSocket->data.swap(msg->payload);
+		Websocket::Frame::finalizeSplitBuffer(msg->encodingWebSocket.get(), frameType);
 	}
 
 	_session->send(msg->encodingWebSocket.get());
@@ -574,9 +616,13 @@ size_t BrokerHandler::sendMessage(Broker::Message *msg) {
 	*/
 
 	// Clear payload and object as it is not required anymore. We do not
-	// transcode and do not support multiple protocols.
-	msg->payload = std::string();
-	msg->object = nullptr;
+	// transcode and do not support multiple protocols. If blocking processors
+	// still access the message then the queue releases both once they are
+	// finished.
+	if ( !msg->blockingPending ) {
+		msg->payload = std::string();
+		msg->object = nullptr;
+	}
 
 	/*
 	SEISCOMP_DEBUG("- message from %s/%s to %s",
@@ -46,6 +46,7 @@ class BrokerHandler : public WebsocketHandler, Broker::Client {
 
 	public:
 		void start() override;
+		void finish() override;
 		void handleFrame(Seiscomp::Wired::Websocket::Frame &frame) override;
 		void buffersFlushed() override;
 		void close() override;
@@ -76,6 +77,7 @@ class BrokerHandler : public WebsocketHandler, Broker::Client {
 		void commandSTATE(char *frame, size_t len, bool service);
 
 		size_t sendMessage(Broker::Message *msg);
+		void sendAck();
 
 		void replyWithError(const char *msg, size_t len);
 		void replyWithError(const std::string &msg);
@@ -84,6 +86,8 @@ class BrokerHandler : public WebsocketHandler, Broker::Client {
 		OPT(Broker::SequenceNumber) _continueWithSeqNo;
 		int                         _bytesSent{0};
 		int                         _messageBacklog{0};
+		bool                        _inUpdate{false};
+		bool                        _ackPending{false};
 		std::string                 _requestQueue;
 };
 
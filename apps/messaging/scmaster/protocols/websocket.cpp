@@ -70,6 +70,10 @@ void WebsocketSession::update() {
 	}
 
 	HttpSession::update();
+
+	if ( _handler ) {
+		_handler->finish();
+	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -53,6 +53,10 @@ class WebsocketHandler : public Seiscomp::Core::BaseObject {
 		//! gives connection control to the underlying session.
 		virtual void start() = 0;
 
+		//! Called at the end of an update cycle after all received frames
+		//! have been handled.
+		virtual void finish() {}
+
 		//! Main function to handle a websocket frame.
 		virtual void handleFrame(Seiscomp::Wired::Websocket::Frame &frame) = 0;
 
@@ -150,6 +150,7 @@ Message::Message()
 : type(Type::Unspecified)
 , selfDiscard(true)
 , processed(false)
+, blockingPending(false)
 , sequenceNumber(INVALID_SEQUENCE_NUMBER)
 , _internalGroupPtr(NULL)
 {}
@@ -145,6 +145,10 @@ class SC_BROKER_API Message : public Seiscomp::Core::BaseObject {
 		Type                          type; //!< The message type
 		bool                          selfDiscard; //!< Whether self discard should be checked or not
 		bool                          processed;
+		/** Whether blocking processors of a pipelined queue still read
+		    payload and object. Only modified by the dispatcher thread once
+		    the message has been handed over. */
+		bool                          blockingPending;
 		/** The assigned sequence number */
 		SequenceNumber                sequenceNumber;
 
@@ -114,6 +114,15 @@ class SC_BROKER_API MessageProcessor : public Processor {
 		 */
 		bool isConnectionProcessingEnabled() const { return _mode & Connections; }
 
+		/**
+		 * @brief Returns whether message processing blocks on I/O, e.g.
+		 *        database writes. If the queue runs in pipelined mode then
+		 *        blocking processors are executed in a separate stage which
+		 *        does not delay the distribution of messages to clients.
+		 * @return Flag
+		 */
+		bool isBlocking() const { return _blocking; }
+
 
 	// ----------------------------------------------------------------------
 	//  Protected methods
@@ -121,12 +130,21 @@ class SC_BROKER_API MessageProcessor : public Processor {
 	protected:
 		void setMode(int mode);
 
+		/**
+		 * @brief Declares the processor as blocking. Blocking processors
+		 *        must not modify the message passed to process and must only
+		 *        read its meta data and decoded object.
+		 * @param enable Flag
+		 */
+		void setBlocking(bool enable);
+
 
 	// ----------------------------------------------------------------------
 	//  Private members
 	// ----------------------------------------------------------------------
 	private:
-		int _mode;
+		int  _mode;
+		bool _blocking;
 };
 
 
@@ -34,6 +34,7 @@
 #include <seiscomp/logging/log.h>
 #include <seiscomp/core/version.h>
 #include <seiscomp/core/strings.h>
+#include <seiscomp/datamodel/publicobject.h>
 #include <seiscomp/messaging/status.h>
 #include <seiscomp/system/hostinfo.h>
 #include <seiscomp/utils/base64.h>
@@ -73,6 +74,9 @@ Queue::Queue(const std::string &name, uint64_t maxPayloadSize)
 , _processedMessageDispatcher(nullptr)
 , _sequenceNumber(0)
 , _messageProcessor(nullptr)
+, _blockingProcessor(nullptr)
+, _pipelined(false)
+, _pipelineBacklog(1000)
 , _allocatedClientHeap(0)
 , _sohInterval(12)
 , _inactivityLimit(36)
@@ -164,6 +168,16 @@ void Queue::setMessageDispatcher(MessageDispatcher *dispatcher) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Queue::setPipelined(bool enable, int backlog) {
+	_pipelined = enable;
+	_pipelineBacklog = backlog > 0 ? backlog : 1;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Queue::Result Queue::push(Client *sender, Message *msg, int packetSize) {
 	flushProcessedMessages();
@@ -584,6 +598,23 @@ void Queue::flushProcessedMessages() {
 	ProcessingTask result;
 
 	try {
+		if ( _blockingProcessor ) {
+			// Release the references held by the blocking stage. This must
+			// happen in this thread as reference counting is not atomic.
+			while ( _blockingResults.pop(result) ) {
+				Message *msg = result.second;
+				msg->blockingPending = false;
+				// The object is only required by processors. The payload
+				// is released if the message has already been encoded
+				// for sending, otherwise the client does it once it has
+				// been sent.
+				msg->object = nullptr;
+				if ( msg->encodingWebSocket )
+					msg->payload = string();
+				msg->decrementReferenceCount();
+			}
+		}
+
 		while ( _results.pop(result) ) {
 			Clients::iterator cit = _clients.find(result.second->sender);
 			if ( cit == _clients.end() )
@@ -631,12 +662,36 @@ void Queue::processingLoop() {
 
 	SEISCOMP_DEBUG("[queue] worker is running");
 
+	if ( _blockingProcessor ) {
+		// Messages are decoded in this thread and forwarded to the blocking
+		// stage. Decoded objects must not be registered globally, the same
+		// way as dbstore does it for the serial processing.
+		DataModel::PublicObject::SetRegistrationEnabled(false);
+	}
+
 	try {
 
 	while ( true ) {
 		task = _tasks.pop();
 		process(task);
-		taskReady(task);
+
+		if ( _blockingProcessor && (task.second->type == Message::Type::Regular) ) {
+			// Keep the message alive for the blocking stage. The reference
+			// is acquired before the message is handed over to the
+			// dispatcher thread and released again by the dispatcher thread
+			// in flushProcessedMessages. Until then clients must not
+			// release payload and object.
+			task.second->incrementReferenceCount();
+			task.second->blockingPending = true;
+			taskReady(task);
+			if ( !_blockingTasks.push(task) ) {
+				// Queue closed, the reference is released in shutdown()
+				dropBlockingTask(task);
+				break;
+			}
+		}
+		else
+			taskReady(task);
 	}
 
 	}
@@ -649,9 +704,67 @@ void Queue::processingLoop() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Queue::blockingProcessingLoop() {
+	ProcessingTask task;
+
+	SEISCOMP_DEBUG("[queue] blocking worker is running");
+
+	try {
+
+	while ( true ) {
+		// Messages are popped in the order they have been processed by the
+		// first stage which preserves the order of e.g. database writes.
+		task = _blockingTasks.pop();
+
+		for ( auto &proc : _messageProcessors ) {
+			if ( proc->isBlocking() )
+				proc->process(task.second);
+		}
+
+		if ( !_blockingResults.push(task) ) {
+			// Queue closed, the reference is released in shutdown()
+			dropBlockingTask(task);
+			break;
+		}
+
+		_processedMessageDispatcher->messageAvailable(this);
+	}
+
+	}
+	catch ( std::exception & ) {
+		// Queue closed
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Queue::dropBlockingTask(const ProcessingTask &task) {
+	// The message might still be referenced by the results queue and
+	// must not be released before shutdown() has cleared it.
+	lock_guard<mutex> lock(_droppedBlockingTasksMutex);
+	_droppedBlockingTasks.push_back(task.second);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Queue::process(ProcessingTask &task) {
+	if ( _blockingProcessor && (task.second->type == Message::Type::Regular) ) {
+		// Decode the message in this stage already. Once the message has
+		// been handed over to the dispatcher it must not be modified
+		// anymore by the blocking stage.
+		task.second->decode();
+	}
+
 	for ( auto &proc : _messageProcessors ) {
+		if ( _blockingProcessor && proc->isBlocking() )
+			continue;
 		if ( task.second->type == Message::Type::Regular )
 			proc->process(task.second);
 		task.second->processed = true;
@@ -688,6 +801,32 @@ void Queue::activate() {
 		return;
 	}
 
+	if ( _pipelined ) {
+		bool hasBlockingProcessors = false;
+		for ( auto &proc : _messageProcessors ) {
+			if ( proc->isBlocking() ) {
+				hasBlockingProcessors = true;
+				break;
+			}
+		}
+
+		if ( !_processedMessageDispatcher ) {
+			SEISCOMP_WARNING("[queue] %s: pipelined processing requires a "
+			                 "message dispatcher, falling back to serial "
+			                 "processing", _name.c_str());
+		}
+		else if ( hasBlockingProcessors ) {
+			_blockingTasks.resize(_pipelineBacklog);
+			_blockingResults.resize(_pipelineBacklog);
+
+			// Start the blocking stage before the first stage to be able to
+			// accept tasks right from the beginning
+			_blockingProcessor = new thread(bind(&Queue::blockingProcessingLoop, this));
+			SEISCOMP_DEBUG("[queue] %s: pipelined processing with backlog %d",
+			               _name.c_str(), _pipelineBacklog);
+		}
+	}
+
 	// Start the processing thread
 	_messageProcessor = new thread(bind(&Queue::processingLoop, this));
 }
@@ -703,6 +842,8 @@ void Queue::shutdown() {
 	// Close the queues and let the thread terminate
 	_tasks.close();
 	_results.close();
+	_blockingTasks.close();
+	_blockingResults.close();
 
 	if ( _messageProcessor ) {
 		_messageProcessor->join();
@@ -710,6 +851,12 @@ void Queue::shutdown() {
 		_messageProcessor = nullptr;
 	}
 
+	if ( _blockingProcessor ) {
+		_blockingProcessor->join();
+		delete _blockingProcessor;
+		_blockingProcessor = nullptr;
+	}
+
 	// Disconnect all clients
 	{
 		Clients::iterator it;
@@ -734,14 +881,42 @@ void Queue::shutdown() {
 	}
 	_tasks.close();
 
-	// Clear pending results
+	// Clear pending results. Messages might still be referenced by the
+	// blocking stage and are deleted when their last reference is released.
 	_results.reopen();
 	while ( _results.canPop() ) {
 		ProcessingTask result = _results.pop();
-		delete result.second;
+		MessagePtr guard(result.second);
 	}
 	_results.close();
 
+	// Release messages of the blocking stage
+	size_t droppedBlockingTasks = 0;
+	_blockingTasks.reopen();
+	while ( _blockingTasks.canPop() ) {
+		ProcessingTask task = _blockingTasks.pop();
+		task.second->decrementReferenceCount();
+		++droppedBlockingTasks;
+	}
+	_blockingTasks.close();
+
+	if ( droppedBlockingTasks ) {
+		SEISCOMP_WARNING("[queue] Dropped %d messages not yet processed by "
+		                 "blocking processors", int(droppedBlockingTasks));
+	}
+
+	_blockingResults.reopen();
+	while ( _blockingResults.canPop() ) {
+		ProcessingTask result = _blockingResults.pop();
+		result.second->decrementReferenceCount();
+	}
+	_blockingResults.close();
+
+	// Release messages the blocking stage could not hand over anymore
+	for ( auto msg : _droppedBlockingTasks )
+		msg->decrementReferenceCount();
+	_droppedBlockingTasks.clear();
+
 	// Clear message ring
 	_messages.clear();
 
@@ -820,7 +995,7 @@ void Queue::timeout() {
 			   << Status::Tag(Status::CPUUsage).toString() << "=" << fixed << setprecision(3) << usedCPU << "&"
 			   << Status::Tag(Status::ClientMemoryUsage).toString() << "=" << HostInfo.getCurrentMemoryUsage() << "&"
 			   << Status::Tag(Status::ObjectCount).toString() << "=" << Core::BaseObject::ObjectCount() << "&"
-			   << Status::Tag(Status::MessageQueueSize).toString() << "=" << _tasks.size() << "&"
+			   << Status::Tag(Status::MessageQueueSize).toString() << "=" << (_tasks.size() + _blockingTasks.size()) << "&"
 			   << Status::Tag(Status::Uptime).toString() << "=" << Core::toString(floor(double(now - _created)*100 + 0.5)*0.01);
 
 			for ( auto &&item : _processors )
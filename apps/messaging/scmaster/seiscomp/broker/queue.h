@@ -37,6 +37,7 @@
 #include <seiscomp/broker/utils/utils.h>
 #include <seiscomp/broker/utils/circular.h>
 
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -171,6 +172,32 @@ class SC_BROKER_API Queue {
 		 */
 		void setMessageDispatcher(MessageDispatcher *dispatcher);
 
+		/**
+		 * @brief Enables or disables the pipelined processing mode.
+		 *
+		 * In pipelined mode message processing is split into two stages.
+		 * The first stage decodes a message, runs all non-blocking
+		 * processors and hands the message over to the dispatcher to be
+		 * published. The second stage runs in a separate thread and
+		 * executes all blocking processors, e.g. dbstore, in the order the
+		 * messages have been received. Publishing a message does therefore
+		 * not wait for e.g. a database write to be finished anymore.
+		 *
+		 * Pipelined mode requires a message dispatcher and must be
+		 * configured before the queue is activated.
+		 *
+		 * @param enable Whether to enable pipelined processing.
+		 * @param backlog The maximum number of messages pending in the
+		 *                blocking stage. If the backlog is full then the
+		 *                first stage waits for the blocking stage.
+		 */
+		void setPipelined(bool enable, int backlog = 1000);
+
+		/**
+		 * @return Whether pipelined processing is enabled or not.
+		 */
+		bool isPipelined() const;
+
 		/**
 		 * @brief Subscribe a client to a particular group
 		 * @param client The client
@@ -344,6 +371,20 @@ class SC_BROKER_API Queue {
 		 */
 		void processingLoop();
 
+		/**
+		 * @brief The processing loop of blocking processors running in a
+		 *        different thread if pipelined mode is active.
+		 */
+		void blockingProcessingLoop();
+
+		/**
+		 * @brief Keeps a message referenced by the blocking stage which
+		 *        could not be forwarded anymore because the queue has
+		 *        been closed. Its reference is released in shutdown().
+		 * @param task The task holding the message
+		 */
+		void dropBlockingTask(const ProcessingTask &task);
+
 		/**
 		 * @brief Processes a message e.g. via plugins.
 		 * @param task The task to be processed
@@ -384,8 +425,15 @@ class SC_BROKER_API Queue {
 		MessageRing          _messages;
 		Clients              _clients;
 		std::thread         *_messageProcessor;
+		std::thread         *_blockingProcessor;
 		TaskQueue            _tasks;
 		TaskQueue            _results;
+		TaskQueue            _blockingTasks;
+		TaskQueue            _blockingResults;
+		std::mutex           _droppedBlockingTasksMutex;
+		std::vector<Message*> _droppedBlockingTasks;
+		bool                 _pipelined;
+		int                  _pipelineBacklog;
 		Core::Time           _created;
 		OPT(Core::Time)      _lastSOHTimestamp;
 		int                  _allocatedClientHeap;
@@ -406,6 +454,11 @@ inline const std::string &Queue::name() const {
 }
 
 
+inline bool Queue::isPipelined() const {
+	return _pipelined;
+}
+
+
 inline uint64_t Queue::maxPayloadSize() const {
 	return _maxPayloadSize;
 }
@@ -59,6 +59,15 @@ struct Settings : Seiscomp::System::Application::AbstractSettings {
 			}
 		} dbstore;
 
+		struct Pipeline {
+			bool enable{false};
+			int  backlog{1000};
+
+			void accept(Seiscomp::System::Application::SettingsLinker &linker) {
+				linker & cfg(enable, "enable") & cfg(backlog, "backlog");
+			}
+		} pipeline;
+
 		void accept(Seiscomp::System::Application::SettingsLinker &linker) {
 			linker
 			& key(name)
@@ -67,7 +76,8 @@ struct Settings : Seiscomp::System::Application::AbstractSettings {
 			& cfg(plugins, "plugins")
 			& cfg(maxPayloadSize, "maxPayloadSize")
 			& cfg(messageProcessors, "processors.messages")
-			& cfg(dbstore, "processors.messages.dbstore");
+			& cfg(dbstore, "processors.messages.dbstore")
+			& cfg(pipeline, "processors.pipeline");
 		}
 	};
 
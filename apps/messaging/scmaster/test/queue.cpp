@@ -0,0 +1,247 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/core/datamessage.h>
+#include <seiscomp/core/strings.h>
+#include <seiscomp/broker/queue.h>
+#include <seiscomp/broker/client.h>
+#include <seiscomp/broker/message.h>
+#include <seiscomp/broker/messagedispatcher.h>
+#include <seiscomp/broker/messageprocessor.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Messaging::Broker;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+/**
+ * Releases payload and object after sending in the same way as the
+ * websocket broker handler does.
+ */
+class TestClient : public Client {
+	public:
+		Wired::Socket::IPAddress IPAddress() const override {
+			return Wired::Socket::IPAddress();
+		}
+
+		size_t publish(Client *, Message *msg) override {
+			if ( !msg->encodingWebSocket ) {
+				msg->encodingWebSocket = new Wired::Buffer;
+				if ( msg->blockingPending )
+					msg->encodingWebSocket->data = msg->payload;
+				else
+					msg->encodingWebSocket->data.swap(msg->payload);
+			}
+
+			if ( !msg->blockingPending ) {
+				msg->payload = string();
+				msg->object = nullptr;
+			}
+
+			++published;
+			return msg->encodingWebSocket->data.size();
+		}
+
+		void enter(const Group *, const Client *, Message *) override {}
+		void leave(const Group *, const Client *, Message *) override {}
+		void disconnected(const Client *, Message *) override {}
+		void ack() override {}
+		void dispose() override {}
+
+	public:
+		size_t published{0};
+};
+
+
+class TestDispatcher : public MessageDispatcher {
+	public:
+		void sendMessage(Client *, Message *) override {}
+
+		void messageAvailable(Queue *) override {
+			lock_guard<mutex> l(_mutex);
+			_available = true;
+			_cv.notify_one();
+		}
+
+		void flush(Queue *queue) {
+			{
+				unique_lock<mutex> l(_mutex);
+				_cv.wait_for(l, chrono::milliseconds(10), [this] { return _available; });
+				_available = false;
+			}
+
+			flushMessages(queue);
+		}
+
+	private:
+		mutex              _mutex;
+		condition_variable _cv;
+		bool               _available{false};
+};
+
+
+/**
+ * A blocking processor which takes some time for each message and records
+ * what it has seen of the message while the dispatcher publishes it.
+ */
+class BlockingProcessor : public MessageProcessor {
+	public:
+		BlockingProcessor() {
+			setMode(Messages);
+			setBlocking(true);
+		}
+
+		bool init(const Config::Config &, const string &) override { return true; }
+		bool close() override { return true; }
+		void getInfo(const Core::Time &, ostream &) override {}
+
+		bool acceptConnection(Client *, const KeyCStrValues, int,
+		                      KeyValues &) override {
+			return true;
+		}
+
+		void dropConnection(Client *) override {}
+
+		bool process(Message *msg) override {
+			this_thread::sleep_for(chrono::microseconds(200));
+			lock_guard<mutex> l(access);
+			payloads.push_back(msg->payload);
+			objects.push_back(msg->object.get() != nullptr);
+			return true;
+		}
+
+	public:
+		std::mutex     access;
+		vector<string> payloads;
+		vector<bool>   objects;
+};
+
+
+size_t processed(BlockingProcessor *proc) {
+	lock_guard<mutex> l(proc->access);
+	return proc->payloads.size();
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_broker_queue)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(PipelinedDispatch) {
+	const size_t count = 200;
+
+	TestClient client;
+	TestDispatcher dispatcher;
+	MessageProcessorPtr proc = new BlockingProcessor;
+	auto blockingProc = static_cast<BlockingProcessor*>(proc.get());
+
+	Queue queue("test", 1024*1024);
+	BOOST_REQUIRE(queue.add(proc.get()));
+	queue.setMessageDispatcher(&dispatcher);
+	queue.setPipelined(true, 8);
+	BOOST_REQUIRE_EQUAL(queue.addGroup("GROUP"), Queue::Success);
+
+	MessageProcessor::KeyValues outParams;
+	BOOST_REQUIRE_EQUAL(queue.connect(&client, nullptr, 0, outParams), Queue::Success);
+	BOOST_REQUIRE_EQUAL(queue.subscribe(&client, "GROUP"), Queue::Success);
+
+	queue.activate();
+
+	vector<MessagePtr> messages;
+	for ( size_t i = 0; i < count; ++i ) {
+		MessagePtr msg = new Message;
+		msg->type = Message::Type::Regular;
+		msg->target = "GROUP";
+		msg->payload = "message #" + Core::toString(i);
+		msg->object = new Core::DataMessage;
+		messages.push_back(msg);
+
+		BOOST_REQUIRE_EQUAL(queue.push(&client, msg.get()), Queue::Success);
+		// Publish whatever the first stage has finished in the meantime
+		// while the blocking stage is still busy
+		dispatcher.flush(&queue);
+	}
+
+	// Wait for both stages to finish
+	auto deadline = chrono::steady_clock::now() + chrono::seconds(30);
+	while ( ((client.published < count)
+	      || (processed(blockingProc) < count)
+	      || messages.back()->blockingPending)
+	     && (chrono::steady_clock::now() < deadline) ) {
+		dispatcher.flush(&queue);
+	}
+
+	BOOST_REQUIRE_EQUAL(client.published, count);
+	BOOST_REQUIRE_EQUAL(processed(blockingProc), count);
+
+	for ( size_t i = 0; i < count; ++i ) {
+		// The blocking stage must have seen the complete message in the
+		// order of arrival even if it has been sent already
+		BOOST_CHECK_EQUAL(blockingProc->payloads[i], "message #" + Core::toString(i));
+		BOOST_CHECK(blockingProc->objects[i]);
+
+		// Payload and object are released once all processors have run
+		BOOST_CHECK(!messages[i]->blockingPending);
+		BOOST_CHECK(messages[i]->payload.empty());
+		BOOST_CHECK(!messages[i]->object);
+		BOOST_CHECK_EQUAL(messages[i]->encodingWebSocket->data,
+		                  "message #" + Core::toString(i));
+	}
+
+	queue.shutdown();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -27,6 +27,7 @@
 #include <seiscomp/utils/files.h>
 
 #include "app.h"
+#include "reader.h"
 #include "settings.h"
 
 
@@ -61,6 +62,19 @@ bool Application::init() {
 
 	_server.setTriggerMode(Wired::DeviceGroup::LevelTriggered);
 
+	if ( global.fdsnws.workers > 0 ) {
+		_server.setWorkerCount(static_cast<size_t>(global.fdsnws.workers));
+	}
+
+	if ( global.fdsnws.readerThreads > 0 ) {
+		if ( global.fdsnws.prefetchChunks < 1 ) {
+			SEISCOMP_ERROR("fdsnws.prefetchChunks must be greater than 0");
+			return false;
+		}
+
+		readers.start(static_cast<size_t>(global.fdsnws.readerThreads));
+	}
+
 	Wired::IPACL globalAllow, globalDeny;
 
 	if ( global.fdsnws.port > 0 ) {
@@ -98,6 +112,7 @@ void Application::done() {
 
 	SEISCOMP_INFO("Shutdown server");
 	_server.shutdown();
+	readers.stop();
 	_server.clear();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -20,6 +20,7 @@
  * gempa GmbH.                                                             *
  ***************************************************************************/
 
+#include "reader.h"
 #include "session.h"
 #include "settings.h"
 #include "version.h"
@@ -34,11 +35,13 @@
 #include <seiscomp/io/recordstream/sdsarchive.h>
 #include <seiscomp/io/records/mseedrecord.h>
 #include <seiscomp/wired/protocols/http.h>
+#include <seiscomp/wired/reactor.h>
 
 #include <iostream>
 #include <ctype.h>
 #include <cerrno>
 #include <sstream>
+#include <mutex>
 
 
 using namespace Seiscomp;
@@ -127,61 +130,52 @@ char * toUpper(char *str) {
 
 DEFINE_SMARTPOINTER(ArchiveBuffer);
 struct ArchiveBuffer : Wired::Buffer {
-	ArchiveBuffer(IO::RecordStream *in,
-	              Array::DataType dt = Array::DOUBLE,
-	              Record::Hint h = Record::SAVE_RAW)
-	: stream(in), input(in, dt, h) {
+	ArchiveBuffer(IO::RecordStream *in)
+	: stream(in), starving(false) {
 		format = Wired::Buffer::Octetts;
 	}
 
+	~ArchiveBuffer() {
+		if ( prefetcher ) {
+			prefetcher->cancel();
+		}
+	}
+
+	virtual bool isComplete() const {
+		return false;
+	}
+
 	virtual bool updateBuffer() {
+		if ( prefetcher )
+			return updatePrefetched();
+
 		if ( !stream )
 			return false;
 
 		data.clear();
 
-		if ( buffered ) {
-			const Array *rec_data = buffered->raw();
-			data.append((const char*)rec_data->data(), rec_data->size()*rec_data->elementSize());
-			buffered = NULL;
+		if ( !buffered.empty() ) {
+			data.append(buffered.data(), buffered.size());
+			buffered.clear();
 		}
 
 		try {
-			RecordPtr rec;
 			while ( data.size() < MAX_CHUNK_SIZE ) {
-				rec = input.next();
-				if ( rec == NULL ) {
-					// End of stream: close stream and input
+				if ( !stream->nextRaw(record) ) {
+					// End of stream: close stream
 					stream = NULL;
 					break;
 				}
 
-				IO::MSeedRecord *mseed = IO::MSeedRecord::Cast(rec.get());
-
 				// Skip non mseed records
-				if ( mseed == NULL ) continue;
-
-				const Array *rec_data = mseed->raw();
-				if ( rec_data == NULL ) continue;
+				if ( !IO::MSeedRecord::ParseRawHeader(record.data(), record.size(), recordHeader) ) continue;
 
-				data.append((const char*)rec_data->data(), rec_data->size()*rec_data->elementSize());
+				data.append(record.data(), record.size());
 			}
 		}
 		catch ( ... ) {}
 
-		if ( data.empty() )
-			header = "0\r\n\r\n";
-		else {
-			char tmp[10]; tmp[0] = '\0';
-			sprintf(tmp, "%X\r\n", (int)data.size());
-			header = tmp;
-			data += "\r\n";
-
-			// Close transfer block
-			if ( !stream )
-				data += "0\r\n\r\n";
-		}
-
+		encodeChunk(!stream);
 		return true;
 	}
 
@@ -202,27 +196,95 @@ struct ArchiveBuffer : Wired::Buffer {
 			return false;
 
 		try {
-			while ( !buffered ) {
-				RecordPtr rec = input.next();
-				if ( rec ) {
-					buffered = IO::MSeedRecord::Cast(rec.get());
-					const Array *rec_data = buffered->raw();
-
-					if ( rec_data == NULL )
-						buffered = NULL;
-				}
-				else
+			while ( buffered.empty() ) {
+				if ( !stream->nextRaw(record) )
 					break;
+
+				if ( IO::MSeedRecord::ParseRawHeader(record.data(), record.size(), recordHeader) )
+					buffered.swap(record);
 			}
 		}
 		catch ( ... ) {}
 
-		return buffered != NULL;
+		return !buffered.empty();
+	}
+
+	/**
+	 * @brief Hands the record stream over to the reader pool which
+	 *        reads ahead up to maxChunks chunks. The stream must not be
+	 *        used anymore after this call.
+	 * @param ready Called from a reader thread whenever a chunk has been
+	 *              read or the end of the stream has been reached
+	 */
+	void startPrefetch(ReaderPool *pool, size_t maxChunks,
+	                   RecordPrefetcher::Callback ready) {
+		prefetcher = std::make_shared<RecordPrefetcher>(pool, stream.get(),
+		                                                maxChunks);
+		stream = NULL;
+		prefetcher->setReadyCallback(std::move(ready));
+		prefetcher->schedule();
+	}
+
+	/**
+	 * @brief Returns the state of the prefetched data. Available means
+	 *        that the stream has data, EndOfStream before the first
+	 *        chunk has been consumed means that there is no data.
+	 */
+	RecordPrefetcher::Status prefetchStatus() const {
+		return prefetcher ? prefetcher->status() : RecordPrefetcher::EndOfStream;
+	}
+
+	//! Returns whether the last update did not receive data because
+	//! the readers have not yet delivered the next chunk.
+	bool isStarving() const {
+		return starving;
 	}
 
 	IO::RecordStreamPtr stream;
-	IO::RecordInput     input;
-	IO::MSeedRecordPtr  buffered;
+	IO::MSeedRawHeader  recordHeader;
+	std::vector<char>   record;
+	std::vector<char>   buffered;
+	RecordPrefetcherPtr prefetcher;
+	bool                starving;
+
+
+	private:
+		bool updatePrefetched() {
+			header.clear();
+			data.clear();
+			starving = false;
+
+			switch ( prefetcher->pop(data) ) {
+				case RecordPrefetcher::Pending:
+					// Keep header and data empty to pause sending
+					starving = true;
+					break;
+				case RecordPrefetcher::Available:
+					encodeChunk(false);
+					break;
+				case RecordPrefetcher::EndOfStream:
+					encodeChunk(true);
+					prefetcher = nullptr;
+					break;
+			}
+
+			return true;
+		}
+
+		void encodeChunk(bool last) {
+			if ( data.empty() )
+				header = "0\r\n\r\n";
+			else {
+				char tmp[10]; tmp[0] = '\0';
+				sprintf(tmp, "%X\r\n", (int)data.size());
+				header = tmp;
+				data += "\r\n";
+
+				// Close transfer block
+				if ( last )
+					data += "0\r\n\r\n";
+			}
+		}
 };
 
 
@@ -233,14 +295,45 @@ class FDSNWSSession : public Wired::HttpSession {
 
 
 	public:
+		virtual void update() override;
+
 		virtual bool handleGETRequest(Wired::HttpRequest &req) override;
 		virtual bool handlePOSTRequest(Wired::HttpRequest &req) override;
 
 
+	protected:
+		virtual void bufferSent(Wired::Buffer *buf) override;
+
+
 	private:
 		ArchiveBuffer *createStreamBuffer();
+		void sendData(ArchiveBuffer *buf, const string &path,
+		              const string &options, bool noData404);
 		void sendError(const string &path, const string &options,
 		               Wired::HttpStatus status, const char *msg = NULL);
+		//! Called in the thread of the reactor when the readers
+		//! have delivered data
+		void prefetchReady();
+
+
+	private:
+		/**
+		 * @brief The session as seen by the reader threads. It is reset
+		 *        when the session is destroyed.
+		 */
+		struct Handle {
+			std::mutex     mutex;
+			FDSNWSSession *session;
+		};
+
+		std::shared_ptr<Handle> _handle;
+		// The response waiting for the first chunk of the reader pool
+		ArchiveBufferPtr  _pendingBuffer;
+		string            _pendingPath;
+		string            _pendingOptions;
+		bool              _pendingNoData404;
+		// The buffer currently streamed to the client
+		ArchiveBuffer    *_streamBuffer;
 };
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -270,14 +363,152 @@ Wired::Session *FDSNWSListener::createSession(Wired::Socket *socket) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 FDSNWSSession::FDSNWSSession(Wired::Socket *sock)
-: Wired::HttpSession(sock, "https") {}
+: Wired::HttpSession(sock, "https")
+, _handle(std::make_shared<Handle>())
+, _pendingNoData404(false), _streamBuffer(nullptr) {
+	_handle->session = this;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+FDSNWSSession::~FDSNWSSession() {
+	lock_guard<mutex> l(_handle->mutex);
+	_handle->session = nullptr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FDSNWSSession::update() {
+	Wired::HttpSession::update();
+
+	if ( !_device->isValid() ) {
+		return;
+	}
+
+	// Sending paused because the readers have not delivered the next
+	// chunk yet: do not wait for the socket to become writable until
+	// the readers signal new data.
+	if ( _streamBuffer && _streamBuffer->isStarving() ) {
+		_device->removeMode(Wired::Device::Write);
+	}
+}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-FDSNWSSession::~FDSNWSSession() {}
+void FDSNWSSession::prefetchReady() {
+	if ( !_device->isValid() ) {
+		return;
+	}
+
+	if ( _pendingBuffer ) {
+		switch ( _pendingBuffer->prefetchStatus() ) {
+			case RecordPrefetcher::Pending:
+				break;
+			case RecordPrefetcher::Available:
+			{
+				ArchiveBufferPtr buf;
+				buf.swap(_pendingBuffer);
+				_streamBuffer = buf.get();
+				sendResponse(buf.get(), Wired::HTTP_200, "application/vnd.fdsn.mseed");
+				break;
+			}
+			case RecordPrefetcher::EndOfStream:
+				_pendingBuffer = nullptr;
+				if ( _pendingNoData404 )
+					sendError(_pendingPath, _pendingOptions, Wired::HTTP_404);
+				else
+					sendResponse(Wired::HTTP_204);
+				break;
+		}
+	}
+	else if ( _streamBuffer && _streamBuffer->isStarving()
+	       && (_streamBuffer->prefetchStatus() != RecordPrefetcher::Pending) ) {
+		// Continue sending with the following update
+		_device->addMode(Wired::Device::Write);
+	}
+
+	// Not called from the run loop, remove the session if the response
+	// closed the connection. This must be the last statement.
+	if ( !_device->isValid() && parent() ) {
+		parent()->removeSession(this);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FDSNWSSession::bufferSent(Wired::Buffer *buf) {
+	if ( buf == _streamBuffer ) {
+		_streamBuffer = nullptr;
+	}
+
+	Wired::HttpSession::bufferSent(buf);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FDSNWSSession::sendData(ArchiveBuffer *buf, const string &path,
+                             const string &options, bool noData404) {
+	if ( !readers.isRunning() ) {
+		// Read synchronously in the thread of the reactor
+		if ( !buf->hasData() ) {
+			if ( noData404 )
+				sendError(path, options, Wired::HTTP_404);
+			else
+				sendResponse(Wired::HTTP_204);
+		}
+		else
+			sendResponse(buf, Wired::HTTP_200, "application/vnd.fdsn.mseed");
+
+		return;
+	}
+
+	// Whether data is available is known with the first chunk. Until
+	// then stop reading from the client and wait for the readers. They
+	// wake up the reactor of this session whenever they have read a chunk.
+	auto handle = _handle;
+	buf->startPrefetch(&readers, static_cast<size_t>(global.fdsnws.prefetchChunks), [handle] {
+		lock_guard<mutex> l(handle->mutex);
+		if ( !handle->session || !handle->session->parent() ) {
+			return;
+		}
+
+		handle->session->parent()->post([handle] {
+			FDSNWSSession *session;
+
+			{
+				lock_guard<mutex> l(handle->mutex);
+				session = handle->session;
+			}
+
+			if ( session ) {
+				session->prefetchReady();
+			}
+		});
+	});
+
+	_pendingBuffer = buf;
+	_pendingPath = path;
+	_pendingOptions = options;
+	_pendingNoData404 = noData404;
+
+	_device->setMode(Wired::Device::Idle);
+	finishReading();
+}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -301,7 +532,10 @@ ArchiveBuffer *FDSNWSSession::createStreamBuffer() {
 	}
 
 	stream->setSource(global.filebase);
-	return new ArchiveBuffer(stream.get(), Seiscomp::Array::INT, Seiscomp::Record::SAVE_RAW);
+	// Used by backends which do not read raw records
+	stream->setDataType(Seiscomp::Array::INT);
+	stream->setDataHint(Seiscomp::Record::SAVE_RAW);
+	return new ArchiveBuffer(stream.get());
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -380,10 +614,9 @@ bool FDSNWSSession::handleGETRequest(Wired::HttpRequest &req) {
 		return true;
 	}
 	else if ( path == "application.wadl" ) {
-		static string wadl;
-
-		if ( wadl.empty() )
-			wadl = wadlDataselectPre + global.fdsnws.baseUrl + wadlDataselectPost;
+		// Initialized once in a thread-safe way as sessions might be
+		// served by different workers
+		static const string wadl = wadlDataselectPre + global.fdsnws.baseUrl + wadlDataselectPost;
 
 		sendResponse(wadl, Wired::HTTP_200, "text/plain");
 		return true;
@@ -519,14 +752,7 @@ bool FDSNWSSession::handleGETRequest(Wired::HttpRequest &req) {
 			}
 		}
 
-		if ( !buf->hasData() ) {
-			if ( noData404 )
-				sendError(req.path, options, Wired::HTTP_404);
-			else
-				sendResponse(Wired::HTTP_204);
-		}
-		else
-			sendResponse(buf.get(), Wired::HTTP_200, "application/vnd.fdsn.mseed");
+		sendData(buf.get(), req.path, options, noData404);
 	}
 
 	return true;
@@ -698,18 +924,7 @@ bool FDSNWSSession::handlePOSTRequest(Wired::HttpRequest &req) {
 		                       item->startTime, item->endTime);
 	}
 
-	if ( !buf->hasData() ) {
-		if ( noData404 ) {
-			sendError(req.path, req.options, Wired::HTTP_404);
-		}
-		else {
-			sendResponse(Wired::HTTP_204);
-		}
-	}
-	else {
-		sendResponse(buf.get(), Wired::HTTP_200, "application/vnd.fdsn.mseed");
-	}
-
+	sendData(buf.get(), req.path, req.options, noData404);
 	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,355 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * Author: Jan Becker                                                      *
+ * Email: jabe@gempa.de                                                    *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_COMPONENT WFAS
+
+#include <seiscomp/logging/log.h>
+#include <seiscomp/io/records/mseedrecord.h>
+
+#include "reader.h"
+#include "session.h"
+
+
+using namespace std;
+
+
+namespace Seiscomp {
+namespace Applications {
+namespace Wfas {
+
+
+ReaderPool readers;
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ReaderPool::ReaderPool() : _running(false) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ReaderPool::~ReaderPool() {
+	stop();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ReaderPool::start(size_t threads) {
+	{
+		lock_guard<mutex> l(_mutex);
+		if ( _running ) {
+			return false;
+		}
+
+		_running = true;
+	}
+
+	for ( size_t i = 0; i < threads; ++i ) {
+		_threads.emplace_back(&ReaderPool::run, this);
+	}
+
+	SEISCOMP_DEBUG("Started %zu archive reader threads", threads);
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void ReaderPool::stop() {
+	deque<Task> tasks;
+
+	{
+		lock_guard<mutex> l(_mutex);
+		_running = false;
+		tasks.swap(_tasks);
+	}
+
+	_taskAvailable.notify_all();
+
+	for ( auto &thread : _threads ) {
+		thread.join();
+	}
+
+	_threads.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ReaderPool::isRunning() const {
+	lock_guard<mutex> l(_mutex);
+	return _running;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ReaderPool::submit(Task task) {
+	{
+		lock_guard<mutex> l(_mutex);
+		if ( !_running ) {
+			return false;
+		}
+
+		_tasks.push_back(std::move(task));
+	}
+
+	_taskAvailable.notify_one();
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void ReaderPool::run() {
+	for ( ;; ) {
+		Task task;
+
+		{
+			unique_lock<mutex> l(_mutex);
+			_taskAvailable.wait(l, [this] { return !_running || !_tasks.empty(); });
+			if ( !_running ) {
+				return;
+			}
+
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+
+		task();
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordPrefetcher::RecordPrefetcher(ReaderPool *pool, IO::RecordStream *stream,
+                                   size_t maxChunks)
+: _pool(pool), _stream(stream)
+, _maxChunks(maxChunks > 0 ? maxChunks : 1)
+, _reading(false), _endOfStream(false), _cancelled(false) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordPrefetcher::setReadyCallback(Callback cb) {
+	lock_guard<mutex> l(_mutex);
+	_readyCallback = std::move(cb);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordPrefetcher::schedule() {
+	{
+		lock_guard<mutex> l(_mutex);
+
+		if ( _reading || _endOfStream || _cancelled || (_chunks.size() >= _maxChunks) ) {
+			return;
+		}
+
+		_reading = true;
+
+		auto self = shared_from_this();
+		if ( _pool->submit([self] { self->read(); }) ) {
+			return;
+		}
+
+		// No reader available, finish the stream
+		_reading = false;
+		_endOfStream = true;
+	}
+
+	notify();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordPrefetcher::cancel() {
+	lock_guard<mutex> l(_mutex);
+	_cancelled = true;
+	_chunks.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordPrefetcher::Status RecordPrefetcher::status() const {
+	lock_guard<mutex> l(_mutex);
+
+	if ( !_chunks.empty() ) {
+		return Available;
+	}
+
+	return _endOfStream || _cancelled ? EndOfStream : Pending;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordPrefetcher::Status RecordPrefetcher::pop(string &chunk) {
+	Status status;
+
+	{
+		lock_guard<mutex> l(_mutex);
+
+		if ( !_chunks.empty() ) {
+			chunk = std::move(_chunks.front());
+			_chunks.pop_front();
+			status = Available;
+		}
+		else if ( _endOfStream || _cancelled ) {
+			return EndOfStream;
+		}
+		else {
+			status = Pending;
+		}
+	}
+
+	// Free slot, continue reading
+	schedule();
+	return status;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordPrefetcher::read() {
+	{
+		lock_guard<mutex> l(_mutex);
+		if ( _cancelled ) {
+			_reading = false;
+			return;
+		}
+	}
+
+	string chunk;
+	vector<char> record;
+	IO::MSeedRawHeader header;
+	bool endOfStream = false;
+
+	try {
+		while ( chunk.size() < MAX_CHUNK_SIZE ) {
+			if ( !_stream->nextRaw(record) ) {
+				endOfStream = true;
+				break;
+			}
+
+			// Skip non mseed records
+			if ( !IO::MSeedRecord::ParseRawHeader(record.data(), record.size(), header) )
+				continue;
+
+			chunk.append(record.data(), record.size());
+		}
+	}
+	catch ( exception &e ) {
+		SEISCOMP_WARNING("Failed to read from archive: %s", e.what());
+		endOfStream = true;
+	}
+
+	{
+		lock_guard<mutex> l(_mutex);
+
+		_reading = false;
+
+		if ( _cancelled ) {
+			return;
+		}
+
+		if ( !chunk.empty() ) {
+			_chunks.push_back(std::move(chunk));
+		}
+
+		if ( endOfStream ) {
+			_endOfStream = true;
+		}
+		// Read the next chunk with the next free thread to not block other
+		// requests with a large request
+		else if ( _chunks.size() < _maxChunks ) {
+			_reading = true;
+			auto self = shared_from_this();
+			if ( !_pool->submit([self] { self->read(); }) ) {
+				_reading = false;
+				_endOfStream = true;
+			}
+		}
+	}
+
+	notify();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordPrefetcher::notify() {
+	Callback cb;
+
+	{
+		lock_guard<mutex> l(_mutex);
+		if ( _cancelled ) {
+			return;
+		}
+
+		cb = _readyCallback;
+	}
+
+	if ( cb ) {
+		cb();
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+}
+}
+}
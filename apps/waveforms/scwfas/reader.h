@@ -0,0 +1,191 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * Author: Jan Becker                                                      *
+ * Email: jabe@gempa.de                                                    *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#ifndef SEISCOMP_APPS_SCWSAS_READER_H__
+#define SEISCOMP_APPS_SCWSAS_READER_H__
+
+
+#include <seiscomp/io/recordstream.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace Applications {
+namespace Wfas {
+
+
+/**
+ * @brief A pool of threads which read from the archive on behalf of
+ *        the sessions. Reading from disk blocks and must not be done in
+ *        the thread of a reactor which serves many sessions.
+ */
+class ReaderPool {
+	public:
+		typedef std::function<void()> Task;
+
+
+	public:
+		ReaderPool();
+		~ReaderPool();
+
+
+	public:
+		/**
+		 * @brief Starts the given number of reader threads.
+		 * @param threads The number of threads
+		 * @return Success flag
+		 */
+		bool start(size_t threads);
+
+		/**
+		 * @brief Stops all threads and drops all pending tasks.
+		 */
+		void stop();
+
+		//! Returns whether the threads are running
+		bool isRunning() const;
+
+		/**
+		 * @brief Queues a task which is executed by the next free thread.
+		 * @param task The task
+		 * @return false if the pool is not running
+		 */
+		bool submit(Task task);
+
+
+	private:
+		void run();
+
+
+	private:
+		std::vector<std::thread> _threads;
+		std::deque<Task>         _tasks;
+		mutable std::mutex       _mutex;
+		std::condition_variable  _taskAvailable;
+		bool                     _running;
+};
+
+
+/**
+ * @brief Reads raw miniSEED records from a record stream into chunks
+ *        with the threads of a reader pool.
+ *
+ * At most maxChunks chunks are read ahead. Reading continues as soon as
+ * the consumer pops chunks which ties reading from the archive to the
+ * speed of the client connection. The object is shared between the
+ * session and the reader threads and must therefore be managed by a
+ * std::shared_ptr.
+ */
+class RecordPrefetcher : public std::enable_shared_from_this<RecordPrefetcher> {
+	public:
+		typedef std::function<void()> Callback;
+
+		enum Status {
+			//! No chunk available yet but more will follow
+			Pending,
+			//! At least one chunk is available
+			Available,
+			//! All chunks have been consumed
+			EndOfStream
+		};
+
+
+	public:
+		/**
+		 * @brief Constructs a prefetcher. Streams must have been added to
+		 *        the record stream already and the record stream must
+		 *        not be used by the caller anymore.
+		 */
+		RecordPrefetcher(ReaderPool *pool, IO::RecordStream *stream,
+		                 size_t maxChunks);
+
+
+	public:
+		/**
+		 * @brief Sets the function which is called when a chunk has been
+		 *        read or the end of the stream has been reached. It is
+		 *        called from a reader thread and must not block.
+		 */
+		void setReadyCallback(Callback cb);
+
+		//! Schedules reading if the maximum number of chunks is not
+		//! yet reached.
+		void schedule();
+
+		//! Stops reading at the next chunk boundary.
+		void cancel();
+
+		//! Returns the current status without changing it.
+		Status status() const;
+
+		/**
+		 * @brief Pops the next chunk and schedules reading of more data.
+		 * @param chunk The target which receives the chunk data if
+		 *              Available is returned.
+		 * @return The status
+		 */
+		Status pop(std::string &chunk);
+
+
+	private:
+		//! Reads one chunk, called from a reader thread.
+		void read();
+
+		//! Calls the ready callback, must be called without the lock held.
+		void notify();
+
+
+	private:
+		ReaderPool              *_pool;
+		IO::RecordStreamPtr      _stream;
+		size_t                   _maxChunks;
+		mutable std::mutex       _mutex;
+		std::deque<std::string>  _chunks;
+		Callback                 _readyCallback;
+		bool                     _reading;
+		bool                     _endOfStream;
+		bool                     _cancelled;
+};
+
+
+typedef std::shared_ptr<RecordPrefetcher> RecordPrefetcherPtr;
+
+
+extern ReaderPool readers;
+
+
+}
+}
+}
+
+
+#endif
@@ -45,11 +45,17 @@ struct Settings : System::Application::AbstractSettings {
 			port = 8080;
 			baseUrl = "http://localhost:8080/fdsnws";
 			maxTimeWindow = 0;
+			workers = 0;
+			readerThreads = 0;
+			prefetchChunks = 4;
 		}
 
 		int         port;
 		std::string baseUrl;
 		int         maxTimeWindow;
+		int         workers;
+		int         readerThreads;
+		int         prefetchChunks;
 
 		void accept(System::Application::SettingsLinker &linker) {
 			linker
@@ -61,7 +67,10 @@ struct Settings : System::Application::AbstractSettings {
 			& cli(baseUrl, "Server", "fdsnws-baseurl",
 			      "The base URL for the FDSNWS service",
 			      true)
-			& cfg(maxTimeWindow, "maxTimeWindow");
+			& cfg(maxTimeWindow, "maxTimeWindow")
+			& cfg(workers, "workers")
+			& cfg(readerThreads, "readerThreads")
+			& cfg(prefetchChunks, "prefetchChunks");
 		}
 	} fdsnws;
 
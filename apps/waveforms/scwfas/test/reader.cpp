@@ -0,0 +1,314 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/core/genericrecord.h>
+#include <seiscomp/io/recordstream/file.h>
+#include <seiscomp/io/records/mseedrecord.h>
+#include <seiscomp/wired/reactor.h>
+
+#include "../reader.h"
+#include "../session.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Applications::Wfas;
+
+namespace fs = std::filesystem;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+const char *Channels[] = { "HHZ", "HHN", "HHE" };
+const int RecordsPerChannel = 60;
+const int SamplesPerRecord = 100;
+const double SamplingFrequency = 100;
+
+
+/**
+ * @brief Creates a miniSEED file with interleaved records of three
+ *        channels ordered by time. The data of a request for HHZ and
+ *        HHE is the expected output.
+ */
+struct Archive {
+	Archive() {
+		file = fs::temp_directory_path() / ("scwfas-reader-" + to_string(getpid()) + ".mseed");
+		ofstream ofs(file.string(), ios::binary);
+
+		Core::Time startTime;
+		startTime.set(2020, 1, 1, 0, 0, 0, 0);
+
+		for ( int i = 0; i < RecordsPerChannel; ++i ) {
+			for ( const char *cha : Channels ) {
+				GenericRecord rec("XX", "ABC", "", cha,
+				                  startTime + Core::TimeSpan(i * SamplesPerRecord / SamplingFrequency),
+				                  SamplingFrequency);
+
+				IntArrayPtr samples = new IntArray(SamplesPerRecord);
+				for ( int s = 0; s < SamplesPerRecord; ++s ) {
+					samples->set(s, i * SamplesPerRecord + s);
+				}
+
+				rec.setData(samples.get());
+
+				ostringstream os;
+				IO::MSeedRecord(rec, 512).write(os);
+				ofs << os.str();
+
+				if ( strcmp(cha, "HHN") ) {
+					expected += os.str();
+				}
+			}
+		}
+	}
+
+	~Archive() {
+		fs::remove(file);
+	}
+
+	IO::RecordStream *createStream() const {
+		auto *stream = new RecordStream::File();
+		BOOST_REQUIRE(stream->setSource(file.string()));
+		BOOST_REQUIRE(stream->addStream("XX", "ABC", "", "HHZ"));
+		BOOST_REQUIRE(stream->addStream("XX", "ABC", "", "HHE"));
+		return stream;
+	}
+
+	fs::path file;
+	string   expected;
+};
+
+
+/**
+ * @brief Consumes the chunks of a prefetcher in the thread of a reactor
+ *        as FDSNWSSession does. The prefetcher wakes up the reactor
+ *        whenever it has read a chunk.
+ */
+class Consumer {
+	public:
+		Consumer(RecordPrefetcherPtr prefetcher)
+		: _prefetcher(prefetcher) {
+			BOOST_REQUIRE(_reactor.setup());
+
+			_prefetcher->setReadyCallback([this] {
+				_reactor.post([this] { fetch(); });
+			});
+		}
+
+		//! Runs the reactor until the end of stream has been consumed
+		bool run() {
+			thread reactorThread([this] { _reactor.run(); });
+
+			_prefetcher->schedule();
+
+			bool finished;
+
+			{
+				unique_lock<mutex> l(_mutex);
+				finished = _finished.wait_for(l, chrono::seconds(10), [this] {
+					return _endOfStream;
+				});
+			}
+
+			_reactor.stop();
+			reactorThread.join();
+			return finished;
+		}
+
+		const vector<string> &chunks() const {
+			return _chunks;
+		}
+
+
+	private:
+		void fetch() {
+			string chunk;
+
+			for ( ;; ) {
+				switch ( _prefetcher->pop(chunk) ) {
+					case RecordPrefetcher::Pending:
+						return;
+					case RecordPrefetcher::Available:
+						_chunks.push_back(chunk);
+						break;
+					case RecordPrefetcher::EndOfStream:
+					{
+						lock_guard<mutex> l(_mutex);
+						// A late notification must not change anything
+						if ( !_endOfStream ) {
+							_endOfStream = true;
+							_finished.notify_all();
+						}
+						return;
+					}
+				}
+			}
+		}
+
+
+	private:
+		Wired::Reactor      _reactor;
+		RecordPrefetcherPtr _prefetcher;
+		vector<string>      _chunks;
+		mutex               _mutex;
+		condition_variable  _finished;
+		bool                _endOfStream{false};
+};
+
+
+void checkChunks(const Archive &archive, const vector<string> &chunks) {
+	string data;
+
+	BOOST_CHECK(chunks.size() > 1);
+
+	for ( const auto &chunk : chunks ) {
+		BOOST_CHECK(!chunk.empty());
+		BOOST_CHECK(chunk.size() < MAX_CHUNK_SIZE + 512);
+		BOOST_CHECK_EQUAL(chunk.size() % 512, 0);
+		data += chunk;
+	}
+
+	BOOST_CHECK_EQUAL(data.size(), archive.expected.size());
+	BOOST_CHECK(data == archive.expected);
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_FIXTURE_TEST_SUITE(scwfas_reader, Archive)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(SerialRead) {
+	// The reference: all records of the requested channels in file order
+	IO::RecordStreamPtr stream = createStream();
+	vector<char> record;
+	string data;
+
+	while ( stream->nextRaw(record) ) {
+		data.append(record.data(), record.size());
+	}
+
+	BOOST_CHECK_EQUAL(data.size(), 2 * RecordsPerChannel * 512);
+	BOOST_CHECK(data == expected);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(MultiChannelOrder) {
+	// A single read-ahead chunk forces the consumer to wait for the
+	// readers with almost every chunk, more chunks let the readers
+	// run ahead on different threads.
+	for ( size_t maxChunks : { 1, 2, 8 } ) {
+		BOOST_TEST_CONTEXT("maxChunks = " << maxChunks) {
+			ReaderPool pool;
+			BOOST_REQUIRE(pool.start(4));
+
+			auto prefetcher = make_shared<RecordPrefetcher>(&pool, createStream(), maxChunks);
+			Consumer consumer(prefetcher);
+			bool finished = consumer.run();
+
+			// Wait for the last notification before the consumer goes away
+			pool.stop();
+
+			BOOST_REQUIRE(finished);
+			checkChunks(*this, consumer.chunks());
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(NoData) {
+	ReaderPool pool;
+	BOOST_REQUIRE(pool.start(2));
+
+	auto *stream = new RecordStream::File();
+	BOOST_REQUIRE(stream->setSource(file.string()));
+	BOOST_REQUIRE(stream->addStream("XX", "ABC", "", "BHZ"));
+
+	auto prefetcher = make_shared<RecordPrefetcher>(&pool, stream, 2);
+	Consumer consumer(prefetcher);
+	bool finished = consumer.run();
+	pool.stop();
+
+	BOOST_REQUIRE(finished);
+	BOOST_CHECK(consumer.chunks().empty());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(NoReaders) {
+	// Scheduling fails without running readers and the stream ends
+	// immediately, the consumer must be notified nevertheless.
+	ReaderPool pool;
+
+	auto prefetcher = make_shared<RecordPrefetcher>(&pool, createStream(), 2);
+	Consumer consumer(prefetcher);
+	BOOST_REQUIRE(consumer.run());
+	BOOST_CHECK(consumer.chunks().empty());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
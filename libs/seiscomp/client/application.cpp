@@ -327,6 +327,7 @@ void Application::AppSettings::Database::accept(SettingsLinker &linker) {
 	& cfg(URI, "")
 	& cfgAsPath(inventoryDB, "inventory")
 	& cfgAsPath(configDB, "config")
+	& cfg(bulkLoading, "bulkLoading")
 
 	& cliSwitch(
 		showDrivers, "Database", "db-driver-list",
@@ -1843,6 +1844,8 @@ void Application::setDatabase(IO::DatabaseInterface* db) {
 	else {
 		_query->setDriver(_database.get());
 	}
+
+	_query->setBulkLoadingEnabled(_settings.database.bulkLoading);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -689,6 +689,8 @@ class SC_SYSTEM_CLIENT_API Application : public System::Application {
 
 				std::string inventoryDB;
 				std::string configDB;
+
+				bool        bulkLoading{true};
 			}                    database;
 
 			struct Inventory {
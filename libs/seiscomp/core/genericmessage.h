@@ -73,6 +73,16 @@ class GenericMessage : public ::Seiscomp::Core::Message {
 		bool attach(AttachmentType *attachment);
 		bool attach(typename Seiscomp::Core::SmartPointer<AttachmentType> &attachment);
 
+		/**
+		 * Appends a range of objects to the message without checking
+		 * whether they have been attached already. Use move iterators to
+		 * transfer the references without touching the reference counts.
+		 * @param first The begin of the range
+		 * @param last The end of the range
+		 */
+		template <typename InputIt>
+		void append(InputIt first, InputIt last);
+
 		/**
 		 * Detaches an already attached object from the message
 		 * @param  object Pointer to an object in the messagebody
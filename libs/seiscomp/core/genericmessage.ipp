@@ -107,6 +107,17 @@ inline bool GenericMessage<T>::attach(typename Seiscomp::Core::SmartPointer<Atta
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+template <typename T>
+template <typename InputIt>
+inline void GenericMessage<T>::append(InputIt first, InputIt last) {
+	_attachments.insert(_attachments.end(), first, last);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 template <typename T>
 inline bool GenericMessage<T>::detach(AttachmentType* attachment) {
@@ -36,7 +36,7 @@ namespace Core {
 
 
 /* SC_API_VERSION is (major << 16) + (minor << 8) + patch. */
-#define SC_API_VERSION 0x110000
+#define SC_API_VERSION 0x110100
 
 #define SC_API_VERSION_MAJOR(v) (v >> 16)
 #define SC_API_VERSION_MINOR(v) ((v >> 8) & 0xff)
@@ -46,6 +46,77 @@ namespace Core {
 /******************************************************************************
  API Changelog
  ******************************************************************************
+ "17.1.0"   0x110100
+   - Added Seiscomp::IO::RecordStream::nextRaw
+   - Added Seiscomp::IO::MSeedRecord::ReadRaw
+   - Added Seiscomp::IO::MSeedRecord::ParseRawHeader
+   - Changed Seiscomp::DataModel::PublicObject::PublicObjectMap to an unordered
+     map with std::string_view keys
+   - Changed Seiscomp::DataModel::PublicObject::Iterator to a forward iterator
+     over all registry shards
+   - Added Seiscomp::DataModel::PublicObjectMemoryBuffer
+   - Added Seiscomp::DataModel::PublicObjectCache::prefetch
+   - Added Seiscomp::DataModel::PublicObjectCache::statistics
+   - Added Seiscomp::DataModel::PublicObjectCache::memoryUsage
+   - Added Seiscomp::DataModel::DatabaseArchive::getObjectsByPublicID
+   - Added Seiscomp::TravelTimeTableInterface::computeTimes
+   - Added Seiscomp::computeDistances
+   - Added Seiscomp::matchesPhase
+   - Added Seiscomp::Geo::FeatureIndex
+   - Added Seiscomp::Processing::Regions::contains(feature, lat, lon)
+   - Added Seiscomp::Processing::Regions::containsPath
+   - Added Seiscomp::Processing::Regions::updateIndex
+   - Added Seiscomp::Processing::Regions::isIndexed
+   - Added Seiscomp::Geo::GeoFeatureSet::generation
+   - Added Seiscomp::Logging::FileOutput::setAsync
+   - Added Seiscomp::Logging::FileOutput::isAsync
+   - Added virtual Seiscomp::Logging::FileOutput::write
+   - Removed Seiscomp::Logging::FileRotatorOutput::log override
+   - Added SEISCOMP_LOG_COMPILED_LEVEL to compile away log calls of more
+     verbose levels
+   - Added Seiscomp::Logging::Discard
+   - Added Seiscomp::Processing::QcEngine
+   - Added Seiscomp::Processing::QcStatistics
+   - Added virtual Seiscomp::Processing::QcProcessor::setStateFromStatistics
+   - Added Seiscomp::Processing::QcProcessor::lastRecord
+   - Added Seiscomp::Processing::QcProcessor::lastSample
+   - Added Seiscomp::DataModel::DataExtentTracker
+   - Added Seiscomp::Math::Geo::StationTable
+   - Added Seiscomp::IO::GFTraceCache
+   - Added Seiscomp::Wired::Buffer::isComplete
+   - Added Seiscomp::Wired::Buffer::fileRegion
+   - Added Seiscomp::Wired::Buffer::consumeFileRegion
+   - Added Seiscomp::Wired::Device::writev
+   - Added Seiscomp::Wired::Device::sendFile
+   - Added Seiscomp::Wired::Server::setWorkerCount
+   - Added Seiscomp::Wired::Server::workerCount
+   - Added virtual Seiscomp::Wired::Server::selectWorker
+   - Added Seiscomp::IO::BinaryArchive(const char*, size_t) and
+     Seiscomp::IO::VBinaryArchive(const char*, size_t) constructors
+   - Added Seiscomp::IO::BinaryArchive::open(const char*, size_t) and
+     Seiscomp::IO::VBinaryArchive::open(const char*, size_t)
+   - Added Seiscomp::IO::BinaryArchive::readView
+   - Added Seiscomp::Core::GenericMessage::append(first, last)
+   - Added Seiscomp::DataModel::ImporterColumnar
+   - Added Seiscomp::DataModel::ExporterColumnar
+   - Added LOCSAT locator parameters LOCSAT.multiStart and
+     LOCSAT.multiStartRadius
+   - Added virtual Seiscomp::Client::Protocol::beginBatch
+   - Added virtual Seiscomp::Client::Protocol::endBatch
+   - Added Seiscomp::Client::Connection::beginBatch
+   - Added Seiscomp::Client::Connection::endBatch
+   - Added Seiscomp::Wired::Reactor::post
+   - Added Seiscomp::DataModel::DatabaseArchive::getObjects(parentIDs,
+     classType, ignorePublicObject)
+   - Added Seiscomp::DataModel::DatabaseReader::setBulkLoadingEnabled
+   - Added Seiscomp::DataModel::DatabaseReader::isBulkLoadingEnabled
+   - Added Seiscomp::DataModel::DatabaseReader::setBulkChunkSize
+   - Added Seiscomp::DataModel::DatabaseReader::bulkChunkSize
+   - Added Seiscomp::DataModel::ImporterTrunk::setStreamingEnabled
+   - Added Seiscomp::IO::XML::Importer::setStreamingEnabled
+   - Added Seiscomp::DataModel::ExporterTrunk::setThreads
+   - Added Seiscomp::DataModel::ExporterTrunk::setChunkSize
+
  "17.0.0"   0x110000
    - Added Seiscomp::Client::Application::handleSOH
    - Added Seiscomp::Processing::MagnitudeProcessor_MLc _c6, _H and _minDepth.
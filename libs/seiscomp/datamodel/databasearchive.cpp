@@ -800,6 +800,79 @@ DatabaseIterator DatabaseArchive::getObjects(const PublicObject *parent,
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DatabaseIterator DatabaseArchive::getObjects(const std::vector<OID> &parentIDs,
+                                             const Seiscomp::Core::RTTI &classType,
+                                             bool ignorePublicObject) {
+	if ( !validInterface() ) {
+		SEISCOMP_ERROR("no valid database interface");
+		return DatabaseIterator();
+	}
+
+	if ( parentIDs.empty() ) {
+		return DatabaseIterator();
+	}
+
+	std::stringstream ss;
+	bool ignorePOTable = ignorePublicObject || !classType.isTypeOf(PublicObject::TypeInfo());
+
+	if ( ignorePOTable ) {
+		ss << "select * from " << classType.className() << " where ";
+	}
+	else {
+		ss << "select " << PublicObject::ClassName() << "." << _publicIDColumn << ","
+		   << classType.className() << ".* from "
+		   << PublicObject::ClassName() << "," << classType.className()
+		   << " where " << PublicObject::ClassName() << "._oid="
+		   << classType.className() << "._oid and ";
+	}
+
+	ss << classType.className() << "._parent_oid in (";
+	for ( size_t i = 0; i < parentIDs.size(); ++i ) {
+		if ( i ) ss << ",";
+		ss << parentIDs[i];
+	}
+	ss << ")";
+
+	return getObjectIterator(ss.str(), classType);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DatabaseIterator DatabaseArchive::getObjectsByPublicID(const Seiscomp::Core::RTTI &classType,
+                                                       const std::vector<std::string> &publicIDs) {
+	if ( !validInterface() ) {
+		SEISCOMP_ERROR("no valid database interface");
+		return DatabaseIterator();
+	}
+
+	if ( publicIDs.empty() || !classType.isTypeOf(PublicObject::TypeInfo()) ) {
+		return DatabaseIterator();
+	}
+
+	std::stringstream ss;
+	ss << "select " << PublicObject::ClassName() << "." << _publicIDColumn << ","
+	   << classType.className() << ".* from "
+	   << PublicObject::ClassName() << "," << classType.className()
+	   << " where " << PublicObject::ClassName() << "._oid="
+	   << classType.className() << "._oid and "
+	   << PublicObject::ClassName() << "." << _publicIDColumn << " in (";
+	for ( size_t i = 0; i < publicIDs.size(); ++i ) {
+		if ( i ) ss << ",";
+		ss << "'" << toSQL(_db.get(), publicIDs[i]) << "'";
+	}
+	ss << ")";
+
+	return getObjectIterator(ss.str(), classType);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 size_t DatabaseArchive::getObjectCount(const std::string &parentID,
                                        const Seiscomp::Core::RTTI &classType) {
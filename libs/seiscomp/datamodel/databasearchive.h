@@ -28,6 +28,7 @@
 
 #include <list>
 #include <mutex>
+#include <vector>
 
 
 namespace Seiscomp {
@@ -322,6 +323,35 @@ class SC_SYSTEM_CORE_API DatabaseArchive : protected Core::Archive,
 		                            const Seiscomp::Core::RTTI &classType,
 		                            bool ignorePublicObject = false);
 
+		/**
+		 * Returns an iterator over all objects of a given type whose parent
+		 * database id is contained in a list of ids. This fetches the
+		 * children of many parents with a single query. The parent of
+		 * each object is reported by DatabaseIterator::parentOid().
+		 * @param parentIDs The database ids of the parent objects. If the
+		 *                  list is empty, an invalid iterator is returned.
+		 * @param classType The type of the objects to iterate over.
+		 * @param ignorePublicObject If true then the PublicObject table will
+		 *                           not be joined.
+		 * @return The database iterator
+		 */
+		DatabaseIterator getObjects(const std::vector<OID> &parentIDs,
+		                            const Seiscomp::Core::RTTI &classType,
+		                            bool ignorePublicObject = false);
+
+		/**
+		 * Returns an iterator over all objects of a given type whose
+		 * publicID is contained in a list of publicIDs. This fetches many
+		 * objects with a single query. Unknown publicIDs are ignored.
+		 * @param classType The type of the objects to iterate over. The
+		 *                  type has to be derived from PublicObject.
+		 * @param publicIDs The publicIDs of the objects to be read. If the
+		 *                  list is empty, an invalid iterator is returned.
+		 * @return The database iterator
+		 */
+		DatabaseIterator getObjectsByPublicID(const Seiscomp::Core::RTTI &classType,
+		                                      const std::vector<std::string> &publicIDs);
+
 		/**
 		 * Returns the number of objects of a given type.
 		 * @param parentID The publicID of the parent object. When empty,
@@ -529,6 +559,10 @@ class SC_SYSTEM_CORE_API DatabaseArchive : protected Core::Archive,
 
 		bool validInterface() const;
 
+		//! Queries for the database id of a PublicObject for
+		//! a given publicID
+		OID publicObjectId(const std::string& publicId);
+
 		//! Associates an objects with an id and caches
 		//! this information
 		void registerId(const Object*, OID id);
@@ -595,10 +629,6 @@ class SC_SYSTEM_CORE_API DatabaseArchive : protected Core::Archive,
 		                                   const Seiscomp::Core::RTTI& classType,
 		                                   bool ignorePublicObject = false);
 
-		//! Queries for the database id of a PublicObject for
-		//! a given publicID
-		OID publicObjectId(const std::string& publicId);
-
 		//! Queries for the database id of an Object
 		OID objectId(Object*, const std::string& parentID);
 
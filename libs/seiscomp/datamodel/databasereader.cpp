@@ -34,12 +34,32 @@
 #include <seiscomp/datamodel/comment.h>
 #include <seiscomp/datamodel/event.h>
 
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
 using namespace std;
 
 namespace Seiscomp {
 namespace DataModel {
 
 
+struct DatabaseReader::BulkStep {
+	BulkStep(const Core::RTTI &parent, const Core::RTTI &child,
+	         bool enabled = true, bool ignorePublicObject = false)
+	: parentType(&parent), childType(&child)
+	, enabled(enabled), ignorePublicObject(ignorePublicObject) {}
+
+	const Core::RTTI *parentType;
+	const Core::RTTI *childType;
+	bool              enabled;
+	bool              ignorePublicObject;
+};
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 DatabaseReader::DatabaseReader(Seiscomp::IO::DatabaseInterface* dbDriver)
 : DatabaseArchive(dbDriver) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -56,6 +76,132 @@ DatabaseReader::~DatabaseReader() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void DatabaseReader::setBulkLoadingEnabled(bool enable) {
+	_bulkLoading = enable;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool DatabaseReader::isBulkLoadingEnabled() const {
+	return _bulkLoading;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void DatabaseReader::setBulkChunkSize(size_t size) {
+	_bulkChunkSize = size > 0 ? size : 1;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t DatabaseReader::bulkChunkSize() const {
+	return _bulkChunkSize;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+int DatabaseReader::loadBulk(PublicObject *root, const std::vector<BulkStep> &steps) {
+	if ( !validInterface() || root == nullptr ) return 0;
+
+	OID rootID = getCachedId(root);
+	if ( !rootID ) {
+		rootID = publicObjectId(root->publicID());
+		if ( !rootID ) {
+			SEISCOMP_INFO("parent object with id '%s' not found in database",
+			              root->publicID().c_str());
+			return 0;
+		}
+		registerId(root, rootID);
+	}
+
+	// The database ids of all loaded public objects per type and the
+	// objects itself to link the children to
+	std::map<const Core::RTTI*, std::vector<OID>> ids;
+	std::unordered_map<OID, PublicObject*> objects;
+
+	ids[&root->typeInfo()].push_back(rootID);
+	objects[rootID] = root;
+
+	bool saveState = Notifier::IsEnabled();
+	Notifier::Disable();
+
+	size_t count = 0;
+
+	for ( const BulkStep &step : steps ) {
+		if ( !step.enabled ) continue;
+
+		auto pit = ids.find(step.parentType);
+		if ( pit == ids.end() || pit->second.empty() ) continue;
+
+		// std::map references stay valid on insertion
+		const std::vector<OID> &parentIDs = pit->second;
+		std::vector<OID> *childIDs = nullptr;
+		if ( step.childType->isTypeOf(PublicObject::TypeInfo()) )
+			childIDs = &ids[step.childType];
+
+		for ( size_t offset = 0; offset < parentIDs.size(); offset += _bulkChunkSize ) {
+			std::vector<OID> chunk(
+				parentIDs.begin() + offset,
+				parentIDs.begin() + std::min(parentIDs.size(), offset + _bulkChunkSize)
+			);
+
+			DatabaseIterator it;
+			it = getObjects(chunk, *step.childType, step.ignorePublicObject);
+			while ( *it ) {
+				Object *object = *it;
+				auto oit = objects.find(it.parentOid());
+
+				if ( oit == objects.end() ) {
+					SEISCOMP_WARNING("%s::add(%s) -> parent with id %lu not loaded",
+					                 step.parentType->className(),
+					                 step.childType->className(),
+					                 static_cast<unsigned long>(it.parentOid()));
+				}
+				else if ( object->parent() != nullptr ) {
+					SEISCOMP_INFO("%s::add(%s) -> %s has already another parent",
+					              step.parentType->className(),
+					              step.childType->className(),
+					              step.childType->className());
+				}
+				else if ( object->attachTo(oit->second) ) {
+					// Only direct children are counted as done by the
+					// per-parent loaders
+					if ( oit->second == root )
+						++count;
+					if ( childIDs ) {
+						childIDs->push_back(it.oid());
+						objects[it.oid()] = static_cast<PublicObject*>(object);
+					}
+				}
+
+				++it;
+			}
+			it.close();
+		}
+	}
+
+	Notifier::SetEnabled(saveState);
+
+	return count;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObject* DatabaseReader::loadObject(const Seiscomp::Core::RTTI& classType,
                                          const std::string& publicID) {
@@ -247,6 +393,43 @@ EventParameters* DatabaseReader::loadEventParameters() {
 int DatabaseReader::load(EventParameters* eventParameters) {
 	size_t count = 0;
 
+	if ( _bulkLoading ) {
+		return loadBulk(eventParameters, {
+			{ EventParameters::TypeInfo(), Pick::TypeInfo() },
+			{ Pick::TypeInfo(), Comment::TypeInfo() },
+			{ EventParameters::TypeInfo(), Amplitude::TypeInfo() },
+			{ Amplitude::TypeInfo(), Comment::TypeInfo() },
+			{ EventParameters::TypeInfo(), Reading::TypeInfo() },
+			{ Reading::TypeInfo(), PickReference::TypeInfo() },
+			{ Reading::TypeInfo(), AmplitudeReference::TypeInfo() },
+			{ EventParameters::TypeInfo(), Origin::TypeInfo() },
+			{ Origin::TypeInfo(), Comment::TypeInfo() },
+			{ Origin::TypeInfo(), CompositeTime::TypeInfo() },
+			{ Origin::TypeInfo(), Arrival::TypeInfo() },
+			{ Origin::TypeInfo(), StationMagnitude::TypeInfo() },
+			{ StationMagnitude::TypeInfo(), Comment::TypeInfo() },
+			{ Origin::TypeInfo(), Magnitude::TypeInfo() },
+			{ Magnitude::TypeInfo(), Comment::TypeInfo() },
+			{ Magnitude::TypeInfo(), StationMagnitudeContribution::TypeInfo() },
+			{ EventParameters::TypeInfo(), FocalMechanism::TypeInfo() },
+			{ FocalMechanism::TypeInfo(), Comment::TypeInfo() },
+			{ FocalMechanism::TypeInfo(), MomentTensor::TypeInfo() },
+			{ MomentTensor::TypeInfo(), Comment::TypeInfo() },
+			{ MomentTensor::TypeInfo(), DataUsed::TypeInfo() },
+			{ MomentTensor::TypeInfo(), MomentTensorPhaseSetting::TypeInfo() },
+			{ MomentTensor::TypeInfo(), MomentTensorStationContribution::TypeInfo() },
+			{ MomentTensorStationContribution::TypeInfo(), MomentTensorComponentContribution::TypeInfo() },
+			{ EventParameters::TypeInfo(), Catalog::TypeInfo(), supportsVersion<0,14>() },
+			{ Catalog::TypeInfo(), Comment::TypeInfo() },
+			{ Catalog::TypeInfo(), Event::TypeInfo() },
+			{ EventParameters::TypeInfo(), Event::TypeInfo() },
+			{ Event::TypeInfo(), EventDescription::TypeInfo() },
+			{ Event::TypeInfo(), Comment::TypeInfo() },
+			{ Event::TypeInfo(), OriginReference::TypeInfo() },
+			{ Event::TypeInfo(), FocalMechanismReference::TypeInfo() }
+		});
+	}
+
 	count += loadPicks(eventParameters);
 	{
 		size_t elementCount = eventParameters->pickCount();
@@ -1921,6 +2104,34 @@ Inventory* DatabaseReader::loadInventory() {
 int DatabaseReader::load(Inventory* inventory) {
 	size_t count = 0;
 
+	if ( _bulkLoading ) {
+		return loadBulk(inventory, {
+			{ Inventory::TypeInfo(), StationGroup::TypeInfo() },
+			{ StationGroup::TypeInfo(), StationReference::TypeInfo() },
+			{ Inventory::TypeInfo(), AuxDevice::TypeInfo() },
+			{ AuxDevice::TypeInfo(), AuxSource::TypeInfo() },
+			{ Inventory::TypeInfo(), Sensor::TypeInfo() },
+			{ Sensor::TypeInfo(), SensorCalibration::TypeInfo() },
+			{ Inventory::TypeInfo(), Datalogger::TypeInfo() },
+			{ Datalogger::TypeInfo(), DataloggerCalibration::TypeInfo() },
+			{ Datalogger::TypeInfo(), Decimation::TypeInfo() },
+			{ Inventory::TypeInfo(), ResponsePAZ::TypeInfo() },
+			{ Inventory::TypeInfo(), ResponseFIR::TypeInfo() },
+			{ Inventory::TypeInfo(), ResponseIIR::TypeInfo(), supportsVersion<0,10>() },
+			{ Inventory::TypeInfo(), ResponsePolynomial::TypeInfo() },
+			{ Inventory::TypeInfo(), ResponseFAP::TypeInfo(), supportsVersion<0,8>() },
+			{ Inventory::TypeInfo(), Network::TypeInfo() },
+			{ Network::TypeInfo(), Comment::TypeInfo(), supportsVersion<0,10>() },
+			{ Network::TypeInfo(), Station::TypeInfo() },
+			{ Station::TypeInfo(), Comment::TypeInfo(), supportsVersion<0,10>() },
+			{ Station::TypeInfo(), SensorLocation::TypeInfo() },
+			{ SensorLocation::TypeInfo(), Comment::TypeInfo(), supportsVersion<0,10>() },
+			{ SensorLocation::TypeInfo(), AuxStream::TypeInfo() },
+			{ SensorLocation::TypeInfo(), Stream::TypeInfo(), true, isLowerVersion<0,10>() },
+			{ Stream::TypeInfo(), Comment::TypeInfo(), supportsVersion<0,10>() }
+		});
+	}
+
 	count += loadStationGroups(inventory);
 	{
 		size_t elementCount = inventory->stationGroupCount();
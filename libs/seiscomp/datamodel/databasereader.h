@@ -120,6 +120,32 @@ class SC_SYSTEM_CORE_API DatabaseReader : public DatabaseArchive {
 		~DatabaseReader();
 
 
+	// ----------------------------------------------------------------------
+	//  Bulk loading
+	// ----------------------------------------------------------------------
+	public:
+		/**
+		 * @brief Enables or disables bulk loading.
+		 *
+		 * If enabled, load(EventParameters*) and load(Inventory*) fetch
+		 * each child table with one query per chunk of parent objects and
+		 * link the objects in memory instead of issuing one query per
+		 * parent object and child type. Bulk loading is enabled by
+		 * default.
+		 * @param enable The bulk loading state
+		 */
+		void setBulkLoadingEnabled(bool enable);
+		bool isBulkLoadingEnabled() const;
+
+		/**
+		 * @brief Sets the maximum number of parent ids passed to a single
+		 *        query while bulk loading.
+		 * @param size The chunk size. The default is 1000.
+		 */
+		void setBulkChunkSize(size_t size);
+		size_t bulkChunkSize() const;
+
+
 	// ----------------------------------------------------------------------
 	//  Read methods
 	// ----------------------------------------------------------------------
@@ -262,6 +288,33 @@ class SC_SYSTEM_CORE_API DatabaseReader : public DatabaseArchive {
 		int load(DataExtent*);
 		int loadDataSegments(DataExtent*);
 		int loadDataAttributeExtents(DataExtent*);
+
+
+	// ----------------------------------------------------------------------
+	//  Private methods
+	// ----------------------------------------------------------------------
+	private:
+		struct BulkStep;
+
+		/**
+		 * @brief Loads the tree below root by processing a list of
+		 *        parent/child relations top-down.
+		 * @param root The root object which must be stored in the database
+		 * @param steps The relations in load order. The parent type of
+		 *              each step must be the root type or the child type
+		 *              of a previous step.
+		 * @return The number of loaded direct children of root as
+		 *         returned by the per-parent loaders
+		 */
+		int loadBulk(PublicObject *root, const std::vector<BulkStep> &steps);
+
+
+	// ----------------------------------------------------------------------
+	//  Private members
+	// ----------------------------------------------------------------------
+	private:
+		bool   _bulkLoading{true};
+		size_t _bulkChunkSize{1000};
 };
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
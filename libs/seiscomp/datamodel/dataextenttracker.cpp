@@ -0,0 +1,408 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp/datamodel/dataextenttracker.h>
+
+#include <algorithm>
+#include <iterator>
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace Seiscomp {
+namespace DataModel {
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataExtentTracker::DataExtentTracker(DataExtent *extent, double jitter)
+: _jitter(jitter) {
+	setExtent(extent);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void DataExtentTracker::setExtent(DataExtent *extent) {
+	_segments.clear();
+	_changed.clear();
+	_removed.clear();
+	_extent = extent;
+
+	if ( !_extent ) {
+		return;
+	}
+
+	// Merge the stored segments as well. Overlapping or adjacent segments
+	// are joined and synced with the next call to sync().
+	for ( size_t i = 0; i < _extent->dataSegmentCount(); ++i ) {
+		DataSegment *seg = _extent->dataSegment(i);
+		merge(seg->start(), seg->end(), seg->sampleRate(), seg->quality(),
+		      seg->outOfOrder(), seg);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void DataExtentTracker::setJitter(double jitter) {
+	_jitter = jitter;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool DataExtentTracker::feed(const Core::Time &start, const Core::Time &end,
+                             double sampleRate, const std::string &quality) {
+	if ( end <= start ) {
+		return false;
+	}
+
+	merge(start, end, sampleRate, quality, false, nullptr);
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool DataExtentTracker::feed(const Record *rec, const std::string &quality) {
+	if ( !rec ) {
+		return false;
+	}
+
+	try {
+		return feed(rec->startTime(), rec->endTime(),
+		            rec->samplingFrequency(), quality);
+	}
+	catch ( Core::ValueException & ) {}
+
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void DataExtentTracker::merge(const Core::Time &start, const Core::Time &end,
+                              double sampleRate, const std::string &quality,
+                              bool outOfOrder, DataSegment *object) {
+	Core::TimeSpan tolerance(0, 0);
+	if ( sampleRate > 0 ) {
+		tolerance = Core::TimeSpan(_jitter / sampleRate);
+	}
+
+	Core::Time newStart = start;
+	Core::Time newEnd = end;
+	std::vector<DataSegmentPtr> objects;
+
+	if ( object ) {
+		objects.push_back(object);
+	}
+
+	// Segments do not overlap. Of the segments starting before the span
+	// only the last one can overlap or touch it.
+	auto it = _segments.upper_bound(start - tolerance);
+	if ( it != _segments.begin() ) {
+		auto prev = std::prev(it);
+		if ( prev->second.end + tolerance >= start ) {
+			it = prev;
+		}
+	}
+
+	while ( it != _segments.end() && it->first <= newEnd + tolerance ) {
+		Segment &seg = it->second;
+
+		if ( seg.sampleRate == sampleRate && seg.quality == quality ) {
+			if ( seg.end + tolerance < newStart ) {
+				++it;
+				continue;
+			}
+
+			// A fed span which does not append to the segment was received
+			// out of order
+			if ( !object && start + tolerance < seg.end ) {
+				outOfOrder = true;
+			}
+
+			outOfOrder = outOfOrder || seg.outOfOrder;
+			newStart = std::min(newStart, it->first);
+			newEnd = std::max(newEnd, seg.end);
+
+			if ( seg.object ) {
+				objects.push_back(seg.object);
+			}
+
+			it = _segments.erase(it);
+			continue;
+		}
+
+		// The span replaces the overlapped part of a segment with different
+		// attributes
+		if ( seg.end <= start || it->first >= end ) {
+			++it;
+			continue;
+		}
+
+		if ( seg.end > end ) {
+			Segment tail = seg;
+			tail.object = nullptr;
+			_segments.emplace(end, std::move(tail));
+			_changed.insert(end);
+		}
+
+		if ( it->first < start ) {
+			seg.end = start;
+			_changed.insert(it->first);
+			++it;
+		}
+		else {
+			release(seg);
+			it = _segments.erase(it);
+		}
+	}
+
+	Segment &seg = _segments[newStart];
+	seg.end = newEnd;
+	seg.sampleRate = sampleRate;
+	seg.quality = quality;
+	seg.outOfOrder = outOfOrder;
+	seg.object = nullptr;
+
+	// Keep the object which is stored with the same start time, it is
+	// updated in place. All others are removed.
+	for ( auto &obj : objects ) {
+		if ( !seg.object && obj->start() == newStart ) {
+			seg.object = obj;
+		}
+		else {
+			_removed.push_back(obj);
+		}
+	}
+
+	// A loaded segment which has not been merged is unchanged
+	if ( object && (objects.size() == 1) && (seg.object == object) &&
+	     (object->end() == newEnd) ) {
+		return;
+	}
+
+	_changed.insert(newStart);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void DataExtentTracker::release(Segment &seg) {
+	if ( seg.object ) {
+		_removed.push_back(seg.object);
+		seg.object = nullptr;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataExtentTracker::Segments::const_iterator
+DataExtentTracker::first(const Core::Time &time) const {
+	auto it = _segments.upper_bound(time);
+	if ( it != _segments.begin() ) {
+		auto prev = std::prev(it);
+		if ( prev->second.end > time ) {
+			return prev;
+		}
+	}
+
+	return it;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::TimeSpan DataExtentTracker::coverage(const Core::TimeWindow &tw) const {
+	Core::TimeSpan covered(0, 0);
+
+	for ( auto it = first(tw.startTime());
+	      it != _segments.end() && it->first < tw.endTime(); ++it ) {
+		Core::Time start = std::max(it->first, tw.startTime());
+		Core::Time end = std::min(it->second.end, tw.endTime());
+		if ( end > start ) {
+			covered += end - start;
+		}
+	}
+
+	return covered;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::vector<Core::TimeWindow>
+DataExtentTracker::gaps(const Core::TimeWindow &tw,
+                        const Core::TimeSpan &minLength) const {
+	std::vector<Core::TimeWindow> result;
+	Core::Time cursor = tw.startTime();
+
+	for ( auto it = first(tw.startTime());
+	      it != _segments.end() && it->first < tw.endTime(); ++it ) {
+		if ( it->first > cursor && it->first - cursor >= minLength ) {
+			result.emplace_back(cursor, it->first);
+		}
+
+		cursor = std::max(cursor, it->second.end);
+	}
+
+	if ( cursor < tw.endTime() && tw.endTime() - cursor >= minLength ) {
+		result.emplace_back(cursor, tw.endTime());
+	}
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::vector<Core::TimeWindow>
+DataExtentTracker::segments(const Core::TimeWindow &tw) const {
+	std::vector<Core::TimeWindow> result;
+
+	for ( auto it = first(tw.startTime());
+	      it != _segments.end() && it->first < tw.endTime(); ++it ) {
+		result.emplace_back(it->first, it->second.end);
+	}
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool DataExtentTracker::hasChanges() const {
+	return !_changed.empty() || !_removed.empty();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t DataExtentTracker::sync(const Core::Time &updated) {
+	size_t changes = 0;
+
+	if ( !_extent ) {
+		_changed.clear();
+		_removed.clear();
+		return changes;
+	}
+
+	// Remove first, a new segment may reuse the start time of a removed one
+	for ( auto &obj : _removed ) {
+		if ( obj->parent() == _extent.get() && _extent->remove(obj.get()) ) {
+			++changes;
+		}
+	}
+	_removed.clear();
+
+	for ( auto &start : _changed ) {
+		auto it = _segments.find(start);
+		if ( it == _segments.end() ) {
+			continue;
+		}
+
+		Segment &seg = it->second;
+		DataSegment *obj = seg.object.get();
+
+		if ( obj ) {
+			if ( obj->end() == seg.end && obj->sampleRate() == seg.sampleRate &&
+			     obj->quality() == seg.quality &&
+			     obj->outOfOrder() == seg.outOfOrder ) {
+				continue;
+			}
+
+			obj->setEnd(seg.end);
+			obj->setSampleRate(seg.sampleRate);
+			obj->setQuality(seg.quality);
+			obj->setOutOfOrder(seg.outOfOrder);
+			obj->setUpdated(updated);
+			obj->update();
+			++changes;
+		}
+		else {
+			DataSegmentPtr newObj = new DataSegment;
+			newObj->setStart(start);
+			newObj->setEnd(seg.end);
+			newObj->setSampleRate(seg.sampleRate);
+			newObj->setQuality(seg.quality);
+			newObj->setOutOfOrder(seg.outOfOrder);
+			newObj->setUpdated(updated);
+
+			if ( _extent->add(newObj.get()) ) {
+				seg.object = newObj;
+				++changes;
+			}
+		}
+	}
+	_changed.clear();
+
+	if ( changes && !_segments.empty() ) {
+		// Segments do not overlap, the last one ends last
+		Core::Time start = _segments.begin()->first;
+		Core::Time end = _segments.rbegin()->second.end;
+
+		if ( _extent->start() != start || _extent->end() != end ) {
+			_extent->setStart(start);
+			_extent->setEnd(end);
+			_extent->setUpdated(updated);
+			_extent->update();
+		}
+	}
+
+	return changes;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,176 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#ifndef SEISCOMP_DATAMODEL_DATAEXTENTTRACKER_H
+#define SEISCOMP_DATAMODEL_DATAEXTENTTRACKER_H
+
+
+#include <seiscomp/core/datetime.h>
+#include <seiscomp/core/record.h>
+#include <seiscomp/datamodel/dataextent.h>
+#include <seiscomp/datamodel/datasegment.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace DataModel {
+
+
+/**
+ * @brief Maintains the data segments of a DataExtent incrementally.
+ *
+ * Time spans are merged into non-overlapping segments held in a balanced
+ * tree ordered by start time. A span is merged in O(log n + k) where k is
+ * the number of segments it touches, and coverage and gap queries visit
+ * only the segments overlapping the requested window.
+ *
+ * Spans are merged with adjacent and overlapping segments of the same
+ * sampling rate and quality if the gap between them does not exceed
+ * the jitter. Where a span overlaps a segment with different attributes,
+ * the span takes precedence and the segment is cut.
+ *
+ * Changes are collected until sync() applies them to the extent. Only
+ * added, removed and modified segments are touched, so with the notifier
+ * pool enabled the resulting message carries notifiers for the changed
+ * segments only.
+ */
+class SC_SYSTEM_CORE_API DataExtentTracker {
+	// ----------------------------------------------------------------------
+	//  Xstruction
+	// ----------------------------------------------------------------------
+	public:
+		/**
+		 * @brief Constructor
+		 * @param extent The extent to maintain, see setExtent
+		 * @param jitter The tolerated gap between two spans in samples
+		 */
+		explicit DataExtentTracker(DataExtent *extent = nullptr,
+		                           double jitter = 0.5);
+
+
+	// ----------------------------------------------------------------------
+	//  Public interface
+	// ----------------------------------------------------------------------
+	public:
+		/**
+		 * @brief Sets the extent to maintain and loads its segments.
+		 *        Pending changes of a previous extent are discarded.
+		 * @param extent The extent or nullptr
+		 */
+		void setExtent(DataExtent *extent);
+		DataExtent *extent() const { return _extent.get(); }
+
+		//! Sets the tolerated gap in samples
+		void setJitter(double jitter);
+		double jitter() const { return _jitter; }
+
+		/**
+		 * @brief Merges a time span.
+		 * @param start The start time
+		 * @param end The end time, exclusive
+		 * @param sampleRate The sampling rate
+		 * @param quality The quality code
+		 * @return false if the span is empty
+		 */
+		bool feed(const Core::Time &start, const Core::Time &end,
+		          double sampleRate, const std::string &quality = std::string());
+
+		//! Merges the time window of a record
+		bool feed(const Record *rec, const std::string &quality = std::string());
+
+		//! Returns the number of segments
+		size_t segmentCount() const { return _segments.size(); }
+
+		//! Returns the time covered by segments within a time window
+		Core::TimeSpan coverage(const Core::TimeWindow &tw) const;
+
+		/**
+		 * @brief Returns the uncovered parts of a time window.
+		 * @param tw The time window
+		 * @param minLength The minimum length of a gap to be reported
+		 * @return The gaps in ascending order
+		 */
+		std::vector<Core::TimeWindow>
+		gaps(const Core::TimeWindow &tw,
+		     const Core::TimeSpan &minLength = Core::TimeSpan(0, 0)) const;
+
+		/**
+		 * @brief Returns the segments overlapping a time window.
+		 * @param tw The time window
+		 * @return The time windows of the segments in ascending order
+		 */
+		std::vector<Core::TimeWindow> segments(const Core::TimeWindow &tw) const;
+
+		//! Returns whether changes are pending
+		bool hasChanges() const;
+
+		/**
+		 * @brief Applies all changes since the last call to the extent.
+		 *        Segments are added, removed and updated with the
+		 *        regular object methods which create notifiers if the
+		 *        notifier pool is enabled. The extent's time window is
+		 *        updated as well.
+		 * @param updated The update time of changed objects
+		 * @return The number of added, removed and updated segments
+		 */
+		size_t sync(const Core::Time &updated = Core::Time::UTC());
+
+
+	// ----------------------------------------------------------------------
+	//  Private members
+	// ----------------------------------------------------------------------
+	private:
+		struct Segment {
+			Core::Time     end;
+			double         sampleRate;
+			std::string    quality;
+			bool           outOfOrder;
+			DataSegmentPtr object;
+		};
+
+		using Segments = std::map<Core::Time, Segment>;
+
+		void merge(const Core::Time &start, const Core::Time &end,
+		           double sampleRate, const std::string &quality,
+		           bool outOfOrder, DataSegment *object);
+
+		//! Moves the object of a segment to the removal list
+		void release(Segment &seg);
+
+		Segments::const_iterator first(const Core::Time &time) const;
+
+		DataExtentPtr               _extent;
+		double                      _jitter;
+		Segments                    _segments;
+		std::set<Core::Time>        _changed;
+		std::vector<DataSegmentPtr> _removed;
+};
+
+
+}
+}
+
+
+#endif
@@ -0,0 +1,1468 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_COMPONENT Columnar
+
+#include "columnar.h"
+
+#include <seiscomp/core/exceptions.h>
+#include <seiscomp/datamodel/amplitude.h>
+#include <seiscomp/datamodel/arrival.h>
+#include <seiscomp/datamodel/eventparameters.h>
+#include <seiscomp/datamodel/origin.h>
+#include <seiscomp/datamodel/pick.h>
+#include <seiscomp/datamodel/stationmagnitude.h>
+#include <seiscomp/logging/log.h>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace bio = boost::iostreams;
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace Seiscomp {
+namespace DataModel {
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+REGISTER_IMPORTER_INTERFACE(ImporterColumnar, "columnar");
+REGISTER_EXPORTER_INTERFACE(ExporterColumnar, "columnar");
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+/*
+ * Document layout, all integers in host byte order which is checked
+ * against the byte order mark when reading:
+ *
+ *   char[4]  magic "SCCF"
+ *   uint32   version
+ *   uint32   byte order mark 0x01020304
+ *   uint32   reserved
+ *
+ * followed by blocks until the end of the document:
+ *
+ *   uint32   table name length, table name, padding to 8 bytes
+ *   uint64   number of rows
+ *   uint32   number of columns
+ *   uint32   reserved
+ *
+ * and for each column:
+ *
+ *   uint32   column name length, column name
+ *   uint8    column type
+ *   uint8    encoding
+ *   uint16   reserved, padding to 8 bytes
+ *   uint64   decoded size
+ *   uint64   stored size
+ *   char[]   column data, padding to 8 bytes
+ *
+ * Decoded column data per type:
+ *
+ *   Int8:       int8[rows], -1 if not set
+ *   Int64:      int64[rows], times in microseconds since epoch,
+ *               INT64_MIN if not set
+ *   Double:     double[rows], NaN if not set
+ *   String:     uint64 offsets[rows+1], characters
+ *   Dictionary: uint32 entries, uint32 reserved,
+ *               uint64 offsets[entries+1], characters, padding to 8 bytes,
+ *               uint32 indexes[rows]
+ */
+const char     Magic[4] = { 'S', 'C', 'C', 'F' };
+const uint32_t Version = 1;
+const uint32_t ByteOrderMark = 0x01020304;
+const size_t   BlockRows = 65536;
+
+const int64_t  NoTime = std::numeric_limits<int64_t>::min();
+const double   NoValue = std::numeric_limits<double>::quiet_NaN();
+
+
+enum ColumnType : uint8_t {
+	CT_NONE       = 0,
+	CT_INT8       = 1,
+	CT_INT64      = 2,
+	CT_DOUBLE     = 3,
+	CT_STRING     = 4,
+	CT_DICTIONARY = 5
+};
+
+
+enum ColumnEncoding : uint8_t {
+	CE_RAW  = 0,
+	CE_ZLIB = 1
+};
+
+
+struct ColumnDefinition {
+	const char *name;
+	ColumnType  type;
+};
+
+
+struct TableDefinition {
+	const char             *name;
+	const ColumnDefinition *columns;
+	size_t                  columnCount;
+};
+
+
+enum PickColumn {
+	PK_PUBLIC_ID,
+	PK_STREAM,
+	PK_TIME,
+	PK_TIME_UNCERTAINTY,
+	PK_TIME_LOWER_UNCERTAINTY,
+	PK_TIME_UPPER_UNCERTAINTY,
+	PK_FILTER_ID,
+	PK_METHOD_ID,
+	PK_HORIZONTAL_SLOWNESS,
+	PK_BACKAZIMUTH,
+	PK_SLOWNESS_METHOD_ID,
+	PK_ONSET,
+	PK_PHASE_HINT,
+	PK_POLARITY,
+	PK_EVALUATION_MODE,
+	PK_EVALUATION_STATUS,
+	PK_AGENCY_ID,
+	PK_AUTHOR,
+	PK_CREATION_TIME,
+	PK_QUANTITY
+};
+
+const ColumnDefinition PickColumns[PK_QUANTITY] = {
+	{ "publicID", CT_STRING },
+	{ "stream", CT_DICTIONARY },
+	{ "time", CT_INT64 },
+	{ "timeUncertainty", CT_DOUBLE },
+	{ "timeLowerUncertainty", CT_DOUBLE },
+	{ "timeUpperUncertainty", CT_DOUBLE },
+	{ "filterID", CT_DICTIONARY },
+	{ "methodID", CT_DICTIONARY },
+	{ "horizontalSlowness", CT_DOUBLE },
+	{ "backazimuth", CT_DOUBLE },
+	{ "slownessMethodID", CT_DICTIONARY },
+	{ "onset", CT_INT8 },
+	{ "phaseHint", CT_DICTIONARY },
+	{ "polarity", CT_INT8 },
+	{ "evaluationMode", CT_INT8 },
+	{ "evaluationStatus", CT_INT8 },
+	{ "agencyID", CT_DICTIONARY },
+	{ "author", CT_DICTIONARY },
+	{ "creationTime", CT_INT64 }
+};
+
+
+enum AmplitudeColumn {
+	AM_PUBLIC_ID,
+	AM_STREAM,
+	AM_TYPE,
+	AM_AMPLITUDE,
+	AM_AMPLITUDE_LOWER_UNCERTAINTY,
+	AM_AMPLITUDE_UPPER_UNCERTAINTY,
+	AM_TIME_REFERENCE,
+	AM_TIME_BEGIN,
+	AM_TIME_END,
+	AM_PERIOD,
+	AM_SNR,
+	AM_UNIT,
+	AM_PICK_ID,
+	AM_FILTER_ID,
+	AM_METHOD_ID,
+	AM_SCALING_TIME,
+	AM_MAGNITUDE_HINT,
+	AM_EVALUATION_MODE,
+	AM_AGENCY_ID,
+	AM_AUTHOR,
+	AM_CREATION_TIME,
+	AM_QUANTITY
+};
+
+const ColumnDefinition AmplitudeColumns[AM_QUANTITY] = {
+	{ "publicID", CT_STRING },
+	{ "stream", CT_DICTIONARY },
+	{ "type", CT_DICTIONARY },
+	{ "amplitude", CT_DOUBLE },
+	{ "amplitudeLowerUncertainty", CT_DOUBLE },
+	{ "amplitudeUpperUncertainty", CT_DOUBLE },
+	{ "timeReference", CT_INT64 },
+	{ "timeBegin", CT_DOUBLE },
+	{ "timeEnd", CT_DOUBLE },
+	{ "period", CT_DOUBLE },
+	{ "snr", CT_DOUBLE },
+	{ "unit", CT_DICTIONARY },
+	{ "pickID", CT_STRING },
+	{ "filterID", CT_DICTIONARY },
+	{ "methodID", CT_DICTIONARY },
+	{ "scalingTime", CT_INT64 },
+	{ "magnitudeHint", CT_DICTIONARY },
+	{ "evaluationMode", CT_INT8 },
+	{ "agencyID", CT_DICTIONARY },
+	{ "author", CT_DICTIONARY },
+	{ "creationTime", CT_INT64 }
+};
+
+
+enum ArrivalColumn {
+	AR_PARENT_ID,
+	AR_PICK_ID,
+	AR_PHASE,
+	AR_TIME_CORRECTION,
+	AR_AZIMUTH,
+	AR_DISTANCE,
+	AR_TAKE_OFF_ANGLE,
+	AR_TIME_RESIDUAL,
+	AR_HORIZONTAL_SLOWNESS_RESIDUAL,
+	AR_BACKAZIMUTH_RESIDUAL,
+	AR_TIME_USED,
+	AR_HORIZONTAL_SLOWNESS_USED,
+	AR_BACKAZIMUTH_USED,
+	AR_WEIGHT,
+	AR_EARTH_MODEL_ID,
+	AR_PRELIMINARY,
+	AR_AGENCY_ID,
+	AR_AUTHOR,
+	AR_CREATION_TIME,
+	AR_QUANTITY
+};
+
+const ColumnDefinition ArrivalColumns[AR_QUANTITY] = {
+	{ "parentID", CT_DICTIONARY },
+	{ "pickID", CT_STRING },
+	{ "phase", CT_DICTIONARY },
+	{ "timeCorrection", CT_DOUBLE },
+	{ "azimuth", CT_DOUBLE },
+	{ "distance", CT_DOUBLE },
+	{ "takeOffAngle", CT_DOUBLE },
+	{ "timeResidual", CT_DOUBLE },
+	{ "horizontalSlownessResidual", CT_DOUBLE },
+	{ "backazimuthResidual", CT_DOUBLE },
+	{ "timeUsed", CT_INT8 },
+	{ "horizontalSlownessUsed", CT_INT8 },
+	{ "backazimuthUsed", CT_INT8 },
+	{ "weight", CT_DOUBLE },
+	{ "earthModelID", CT_DICTIONARY },
+	{ "preliminary", CT_INT8 },
+	{ "agencyID", CT_DICTIONARY },
+	{ "author", CT_DICTIONARY },
+	{ "creationTime", CT_INT64 }
+};
+
+
+enum StationMagnitudeColumn {
+	SM_PARENT_ID,
+	SM_PUBLIC_ID,
+	SM_ORIGIN_ID,
+	SM_MAGNITUDE,
+	SM_MAGNITUDE_UNCERTAINTY,
+	SM_TYPE,
+	SM_AMPLITUDE_ID,
+	SM_METHOD_ID,
+	SM_STREAM,
+	SM_PASSED_QC,
+	SM_AGENCY_ID,
+	SM_AUTHOR,
+	SM_CREATION_TIME,
+	SM_QUANTITY
+};
+
+const ColumnDefinition StationMagnitudeColumns[SM_QUANTITY] = {
+	{ "parentID", CT_DICTIONARY },
+	{ "publicID", CT_STRING },
+	{ "originID", CT_DICTIONARY },
+	{ "magnitude", CT_DOUBLE },
+	{ "magnitudeUncertainty", CT_DOUBLE },
+	{ "type", CT_DICTIONARY },
+	{ "amplitudeID", CT_STRING },
+	{ "methodID", CT_DICTIONARY },
+	{ "stream", CT_DICTIONARY },
+	{ "passedQC", CT_INT8 },
+	{ "agencyID", CT_DICTIONARY },
+	{ "author", CT_DICTIONARY },
+	{ "creationTime", CT_INT64 }
+};
+
+
+const TableDefinition PickTable = { "Pick", PickColumns, PK_QUANTITY };
+const TableDefinition AmplitudeTable = { "Amplitude", AmplitudeColumns, AM_QUANTITY };
+const TableDefinition ArrivalTable = { "Arrival", ArrivalColumns, AR_QUANTITY };
+const TableDefinition StationMagnitudeTable = { "StationMagnitude", StationMagnitudeColumns, SM_QUANTITY };
+
+
+int64_t toMicroseconds(const Core::Time &t) {
+	return t.epochSeconds() * 1000000 + t.microseconds();
+}
+
+
+Core::Time fromMicroseconds(int64_t value) {
+	int64_t secs = value / 1000000;
+	int64_t usecs = value % 1000000;
+	if ( usecs < 0 ) {
+		usecs += 1000000;
+		--secs;
+	}
+	return Core::Time(secs, usecs);
+}
+
+
+std::string toStreamID(const WaveformStreamID &wid) {
+	std::string id;
+	id.reserve(wid.networkCode().size() + wid.stationCode().size()
+	         + wid.locationCode().size() + wid.channelCode().size() + 3);
+	id += wid.networkCode();
+	id += '.';
+	id += wid.stationCode();
+	id += '.';
+	id += wid.locationCode();
+	id += '.';
+	id += wid.channelCode();
+	return id;
+}
+
+
+OPT(WaveformStreamID) fromStreamID(std::string_view id) {
+	std::string_view codes[4];
+	size_t n = 0;
+
+	while ( n < 3 ) {
+		auto pos = id.find('.');
+		if ( pos == std::string_view::npos ) {
+			return Core::None;
+		}
+		codes[n++] = id.substr(0, pos);
+		id.remove_prefix(pos + 1);
+	}
+
+	if ( id.find('.') != std::string_view::npos ) {
+		return Core::None;
+	}
+
+	codes[3] = id;
+
+	return WaveformStreamID(std::string(codes[0]), std::string(codes[1]),
+	                        std::string(codes[2]), std::string(codes[3]),
+	                        std::string());
+}
+
+
+// Accessors of optional attributes throw if the value is not set. These
+// helpers map unset values to the column specific null value.
+template <typename F>
+double realOrNull(F &&f) {
+	try {
+		return f();
+	}
+	catch ( Core::ValueException & ) {
+		return NoValue;
+	}
+}
+
+
+template <typename F>
+int int8OrNull(F &&f) {
+	try {
+		return f();
+	}
+	catch ( Core::ValueException & ) {
+		return -1;
+	}
+}
+
+
+template <typename F>
+int64_t timeOrNull(F &&f) {
+	try {
+		return toMicroseconds(f());
+	}
+	catch ( Core::ValueException & ) {
+		return NoTime;
+	}
+}
+
+
+void appendBytes(std::string &out, const void *data, size_t size) {
+	out.append(static_cast<const char*>(data), size);
+}
+
+
+void appendPadding(std::string &out) {
+	out.append((8 - out.size() % 8) % 8, '\0');
+}
+
+
+class ColumnBuilder {
+	public:
+		explicit ColumnBuilder(ColumnType type) : _type(type) {
+			if ( _type == CT_STRING ) {
+				_offsets.push_back(0);
+			}
+		}
+
+	public:
+		void addInt8(int value) {
+			_fixed.push_back(static_cast<char>(value));
+		}
+
+		void addInt64(int64_t value) {
+			appendBytes(_fixed, &value, sizeof(value));
+		}
+
+		void addDouble(double value) {
+			appendBytes(_fixed, &value, sizeof(value));
+		}
+
+		void addString(const std::string &value) {
+			_chars += value;
+			_offsets.push_back(_chars.size());
+		}
+
+		void addDictionary(const std::string &value) {
+			auto res = _dictionary.emplace(value, static_cast<uint32_t>(_entries.size()));
+			if ( res.second ) {
+				_entries.push_back(&res.first->first);
+			}
+			_indexes.push_back(res.first->second);
+		}
+
+		ColumnType type() const {
+			return _type;
+		}
+
+		void serialize(std::string &out) const {
+			out.clear();
+
+			switch ( _type ) {
+				case CT_STRING:
+					appendBytes(out, _offsets.data(), _offsets.size() * sizeof(uint64_t));
+					out += _chars;
+					break;
+				case CT_DICTIONARY:
+				{
+					uint32_t header[2] = { static_cast<uint32_t>(_entries.size()), 0 };
+					appendBytes(out, header, sizeof(header));
+					uint64_t offset = 0;
+					appendBytes(out, &offset, sizeof(offset));
+					for ( auto entry : _entries ) {
+						offset += entry->size();
+						appendBytes(out, &offset, sizeof(offset));
+					}
+					for ( auto entry : _entries ) {
+						out += *entry;
+					}
+					appendPadding(out);
+					appendBytes(out, _indexes.data(), _indexes.size() * sizeof(uint32_t));
+					break;
+				}
+				default:
+					out = _fixed;
+					break;
+			}
+		}
+
+	private:
+		using Dictionary = std::unordered_map<std::string, uint32_t>;
+
+		ColumnType                       _type;
+		std::string                      _fixed;
+		std::vector<uint64_t>            _offsets;
+		std::string                      _chars;
+		Dictionary                       _dictionary;
+		std::vector<const std::string*>  _entries;
+		std::vector<uint32_t>            _indexes;
+};
+
+
+class DocumentWriter;
+
+
+class TableBuilder {
+	public:
+		explicit TableBuilder(const TableDefinition &def) : _def(def) {
+			reset();
+		}
+
+	public:
+		const TableDefinition &definition() const {
+			return _def;
+		}
+
+		ColumnBuilder &operator[](size_t column) {
+			return _columns[column];
+		}
+
+		const std::vector<ColumnBuilder> &columns() const {
+			return _columns;
+		}
+
+		size_t rows() const {
+			return _rows;
+		}
+
+		//! Returns true if the block is full and needs to be flushed
+		bool commitRow() {
+			return ++_rows >= BlockRows;
+		}
+
+		void reset() {
+			_columns.clear();
+			_columns.reserve(_def.columnCount);
+			for ( size_t i = 0; i < _def.columnCount; ++i ) {
+				_columns.emplace_back(_def.columns[i].type);
+			}
+			_rows = 0;
+		}
+
+	private:
+		const TableDefinition      &_def;
+		std::vector<ColumnBuilder>  _columns;
+		size_t                      _rows{0};
+};
+
+
+template <typename T>
+void addCreationInfo(TableBuilder &table, size_t agencyColumn, const T *obj) {
+	try {
+		const CreationInfo &ci = obj->creationInfo();
+		table[agencyColumn].addDictionary(ci.agencyID());
+		table[agencyColumn+1].addDictionary(ci.author());
+		table[agencyColumn+2].addInt64(timeOrNull([&ci]() { return ci.creationTime(); }));
+	}
+	catch ( Core::ValueException & ) {
+		table[agencyColumn].addDictionary(std::string());
+		table[agencyColumn+1].addDictionary(std::string());
+		table[agencyColumn+2].addInt64(NoTime);
+	}
+}
+
+
+class DocumentWriter {
+	public:
+		DocumentWriter(std::streambuf *buf, bool compression)
+		: _buf(buf), _compression(compression)
+		, _picks(PickTable), _amplitudes(AmplitudeTable)
+		, _arrivals(ArrivalTable), _stationMagnitudes(StationMagnitudeTable) {}
+
+	public:
+		bool writeHeader() {
+			uint32_t header[3] = { Version, ByteOrderMark, 0 };
+			return write(Magic, sizeof(Magic)) && write(header, sizeof(header));
+		}
+
+		//! Adds an object and all supported children. Returns false if
+		//! the object type is not supported or writing failed.
+		bool add(Core::BaseObject *obj) {
+			if ( auto ep = EventParameters::Cast(obj) ) {
+				for ( size_t i = 0; i < ep->pickCount(); ++i ) {
+					if ( !add(ep->pick(i)) ) return false;
+				}
+				for ( size_t i = 0; i < ep->amplitudeCount(); ++i ) {
+					if ( !add(ep->amplitude(i)) ) return false;
+				}
+				for ( size_t i = 0; i < ep->originCount(); ++i ) {
+					if ( !add(ep->origin(i)) ) return false;
+				}
+				return true;
+			}
+			else if ( auto org = Origin::Cast(obj) ) {
+				for ( size_t i = 0; i < org->arrivalCount(); ++i ) {
+					if ( !add(org->arrival(i)) ) return false;
+				}
+				for ( size_t i = 0; i < org->stationMagnitudeCount(); ++i ) {
+					if ( !add(org->stationMagnitude(i)) ) return false;
+				}
+				return true;
+			}
+			else if ( auto pick = Pick::Cast(obj) ) {
+				return add(pick);
+			}
+			else if ( auto amp = Amplitude::Cast(obj) ) {
+				return add(amp);
+			}
+			else if ( auto arr = Arrival::Cast(obj) ) {
+				return add(arr);
+			}
+			else if ( auto mag = StationMagnitude::Cast(obj) ) {
+				return add(mag);
+			}
+
+			SEISCOMP_WARNING("columnar: unsupported object type: %s",
+			                 obj ? obj->className() : "null");
+			return false;
+		}
+
+		bool finish() {
+			return flush(_picks) && flush(_amplitudes)
+			    && flush(_arrivals) && flush(_stationMagnitudes);
+		}
+
+	private:
+		bool add(const Pick *pick) {
+			TableBuilder &t = _picks;
+			const TimeQuantity &time = pick->time();
+
+			t[PK_PUBLIC_ID].addString(pick->publicID());
+			t[PK_STREAM].addDictionary(toStreamID(pick->waveformID()));
+			t[PK_TIME].addInt64(toMicroseconds(time.value()));
+			t[PK_TIME_UNCERTAINTY].addDouble(realOrNull([&]() { return time.uncertainty(); }));
+			t[PK_TIME_LOWER_UNCERTAINTY].addDouble(realOrNull([&]() { return time.lowerUncertainty(); }));
+			t[PK_TIME_UPPER_UNCERTAINTY].addDouble(realOrNull([&]() { return time.upperUncertainty(); }));
+			t[PK_FILTER_ID].addDictionary(pick->filterID());
+			t[PK_METHOD_ID].addDictionary(pick->methodID());
+			t[PK_HORIZONTAL_SLOWNESS].addDouble(realOrNull([&]() { return pick->horizontalSlowness().value(); }));
+			t[PK_BACKAZIMUTH].addDouble(realOrNull([&]() { return pick->backazimuth().value(); }));
+			t[PK_SLOWNESS_METHOD_ID].addDictionary(pick->slownessMethodID());
+			t[PK_ONSET].addInt8(int8OrNull([&]() { return pick->onset().toInt(); }));
+			try {
+				t[PK_PHASE_HINT].addDictionary(pick->phaseHint().code());
+			}
+			catch ( Core::ValueException & ) {
+				t[PK_PHASE_HINT].addDictionary(std::string());
+			}
+			t[PK_POLARITY].addInt8(int8OrNull([&]() { return pick->polarity().toInt(); }));
+			t[PK_EVALUATION_MODE].addInt8(int8OrNull([&]() { return pick->evaluationMode().toInt(); }));
+			t[PK_EVALUATION_STATUS].addInt8(int8OrNull([&]() { return pick->evaluationStatus().toInt(); }));
+			addCreationInfo(t, PK_AGENCY_ID, pick);
+
+			return commit(t);
+		}
+
+		bool add(const Amplitude *amp) {
+			TableBuilder &t = _amplitudes;
+
+			t[AM_PUBLIC_ID].addString(amp->publicID());
+			try {
+				t[AM_STREAM].addDictionary(toStreamID(amp->waveformID()));
+			}
+			catch ( Core::ValueException & ) {
+				t[AM_STREAM].addDictionary(std::string());
+			}
+			t[AM_TYPE].addDictionary(amp->type());
+			t[AM_AMPLITUDE].addDouble(realOrNull([&]() { return amp->amplitude().value(); }));
+			t[AM_AMPLITUDE_LOWER_UNCERTAINTY].addDouble(realOrNull([&]() { return amp->amplitude().lowerUncertainty(); }));
+			t[AM_AMPLITUDE_UPPER_UNCERTAINTY].addDouble(realOrNull([&]() { return amp->amplitude().upperUncertainty(); }));
+			try {
+				const TimeWindow &tw = amp->timeWindow();
+				t[AM_TIME_REFERENCE].addInt64(toMicroseconds(tw.reference()));
+				t[AM_TIME_BEGIN].addDouble(tw.begin());
+				t[AM_TIME_END].addDouble(tw.end());
+			}
+			catch ( Core::ValueException & ) {
+				t[AM_TIME_REFERENCE].addInt64(NoTime);
+				t[AM_TIME_BEGIN].addDouble(NoValue);
+				t[AM_TIME_END].addDouble(NoValue);
+			}
+			t[AM_PERIOD].addDouble(realOrNull([&]() { return amp->period().value(); }));
+			t[AM_SNR].addDouble(realOrNull([&]() { return amp->snr(); }));
+			t[AM_UNIT].addDictionary(amp->unit());
+			t[AM_PICK_ID].addString(amp->pickID());
+			t[AM_FILTER_ID].addDictionary(amp->filterID());
+			t[AM_METHOD_ID].addDictionary(amp->methodID());
+			t[AM_SCALING_TIME].addInt64(timeOrNull([&]() { return amp->scalingTime().value(); }));
+			t[AM_MAGNITUDE_HINT].addDictionary(amp->magnitudeHint());
+			t[AM_EVALUATION_MODE].addInt8(int8OrNull([&]() { return amp->evaluationMode().toInt(); }));
+			addCreationInfo(t, AM_AGENCY_ID, amp);
+
+			return commit(t);
+		}
+
+		bool add(const Arrival *arr) {
+			TableBuilder &t = _arrivals;
+
+			t[AR_PARENT_ID].addDictionary(arr->origin() ? arr->origin()->publicID() : std::string());
+			t[AR_PICK_ID].addString(arr->pickID());
+			t[AR_PHASE].addDictionary(arr->phase().code());
+			t[AR_TIME_CORRECTION].addDouble(realOrNull([&]() { return arr->timeCorrection(); }));
+			t[AR_AZIMUTH].addDouble(realOrNull([&]() { return arr->azimuth(); }));
+			t[AR_DISTANCE].addDouble(realOrNull([&]() { return arr->distance(); }));
+			t[AR_TAKE_OFF_ANGLE].addDouble(realOrNull([&]() { return arr->takeOffAngle(); }));
+			t[AR_TIME_RESIDUAL].addDouble(realOrNull([&]() { return arr->timeResidual(); }));
+			t[AR_HORIZONTAL_SLOWNESS_RESIDUAL].addDouble(realOrNull([&]() { return arr->horizontalSlownessResidual(); }));
+			t[AR_BACKAZIMUTH_RESIDUAL].addDouble(realOrNull([&]() { return arr->backazimuthResidual(); }));
+			t[AR_TIME_USED].addInt8(int8OrNull([&]() { return arr->timeUsed() ? 1 : 0; }));
+			t[AR_HORIZONTAL_SLOWNESS_USED].addInt8(int8OrNull([&]() { return arr->horizontalSlownessUsed() ? 1 : 0; }));
+			t[AR_BACKAZIMUTH_USED].addInt8(int8OrNull([&]() { return arr->backazimuthUsed() ? 1 : 0; }));
+			t[AR_WEIGHT].addDouble(realOrNull([&]() { return arr->weight(); }));
+			t[AR_EARTH_MODEL_ID].addDictionary(arr->earthModelID());
+			t[AR_PRELIMINARY].addInt8(int8OrNull([&]() { return arr->preliminary() ? 1 : 0; }));
+			addCreationInfo(t, AR_AGENCY_ID, arr);
+
+			return commit(t);
+		}
+
+		bool add(const StationMagnitude *mag) {
+			TableBuilder &t = _stationMagnitudes;
+
+			t[SM_PARENT_ID].addDictionary(mag->origin() ? mag->origin()->publicID() : std::string());
+			t[SM_PUBLIC_ID].addString(mag->publicID());
+			t[SM_ORIGIN_ID].addDictionary(mag->originID());
+			t[SM_MAGNITUDE].addDouble(mag->magnitude().value());
+			t[SM_MAGNITUDE_UNCERTAINTY].addDouble(realOrNull([&]() { return mag->magnitude().uncertainty(); }));
+			t[SM_TYPE].addDictionary(mag->type());
+			t[SM_AMPLITUDE_ID].addString(mag->amplitudeID());
+			t[SM_METHOD_ID].addDictionary(mag->methodID());
+			try {
+				t[SM_STREAM].addDictionary(toStreamID(mag->waveformID()));
+			}
+			catch ( Core::ValueException & ) {
+				t[SM_STREAM].addDictionary(std::string());
+			}
+			t[SM_PASSED_QC].addInt8(int8OrNull([&]() { return mag->passedQC() ? 1 : 0; }));
+			addCreationInfo(t, SM_AGENCY_ID, mag);
+
+			return commit(t);
+		}
+
+		bool commit(TableBuilder &table) {
+			return !table.commitRow() || flush(table);
+		}
+
+		bool flush(TableBuilder &table) {
+			if ( !table.rows() ) {
+				return true;
+			}
+
+			const TableDefinition &def = table.definition();
+			uint64_t rows = table.rows();
+			uint32_t counts[2] = { static_cast<uint32_t>(def.columnCount), 0 };
+
+			if ( !writeName(def.name) || !pad()
+			  || !write(&rows, sizeof(rows)) || !write(counts, sizeof(counts)) ) {
+				return false;
+			}
+
+			for ( size_t i = 0; i < def.columnCount; ++i ) {
+				table.columns()[i].serialize(_raw);
+
+				ColumnEncoding encoding = CE_RAW;
+				const std::string *data = &_raw;
+
+				if ( _compression && !_raw.empty() ) {
+					_packed.clear();
+					{
+						// The filter chain is flushed when it goes out of scope
+						bio::filtering_ostreambuf filter;
+						filter.push(bio::zlib_compressor());
+						filter.push(bio::back_inserter(_packed));
+						filter.sputn(_raw.data(), static_cast<std::streamsize>(_raw.size()));
+					}
+
+					// Keep columns that do not compress well mappable
+					if ( _packed.size() < _raw.size() - _raw.size() / 8 ) {
+						encoding = CE_ZLIB;
+						data = &_packed;
+					}
+				}
+
+				uint8_t attributes[4] = { def.columns[i].type, encoding, 0, 0 };
+				uint64_t sizes[2] = { _raw.size(), data->size() };
+
+				if ( !writeName(def.columns[i].name)
+				  || !write(attributes, sizeof(attributes)) || !pad()
+				  || !write(sizes, sizeof(sizes))
+				  || !write(data->data(), data->size()) || !pad() ) {
+					return false;
+				}
+			}
+
+			table.reset();
+			return true;
+		}
+
+		bool writeName(const char *name) {
+			uint32_t len = static_cast<uint32_t>(strlen(name));
+			return write(&len, sizeof(len)) && write(name, len);
+		}
+
+		bool write(const void *data, size_t size) {
+			if ( _buf->sputn(static_cast<const char*>(data),
+			                 static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size) ) {
+				return false;
+			}
+			_pos += size;
+			return true;
+		}
+
+		bool pad() {
+			static const char zeros[8] = {};
+			return write(zeros, (8 - _pos % 8) % 8);
+		}
+
+	private:
+		std::streambuf *_buf;
+		bool            _compression;
+		size_t          _pos{0};
+		std::string     _raw;
+		std::string     _packed;
+		TableBuilder    _picks;
+		TableBuilder    _amplitudes;
+		TableBuilder    _arrivals;
+		TableBuilder    _stationMagnitudes;
+};
+
+
+class ColumnView {
+	public:
+		bool init(ColumnType type, const char *data, size_t size, size_t rows) {
+			switch ( type ) {
+				case CT_INT8:
+					if ( size != rows ) return false;
+					break;
+				case CT_INT64:
+				case CT_DOUBLE:
+					if ( size / 8 != rows || size % 8 ) return false;
+					break;
+				case CT_STRING:
+				{
+					// rows + 1 offsets precede the characters, written
+					// such that it cannot overflow for any rows value
+					if ( rows >= size / 8 ) return false;
+					_chars = data + (rows + 1) * 8;
+					size_t charsSize = size - (rows + 1) * 8;
+					uint64_t last = 0;
+					for ( size_t i = 0; i <= rows; ++i ) {
+						uint64_t offset = offsetAt(data, i);
+						if ( offset < last || offset > charsSize ) return false;
+						last = offset;
+					}
+					break;
+				}
+				case CT_DICTIONARY:
+				{
+					if ( size < 8 ) return false;
+					uint32_t entries;
+					memcpy(&entries, data, sizeof(entries));
+					size_t headerSize = 8 + (static_cast<size_t>(entries) + 1) * 8;
+					if ( size < headerSize ) return false;
+					const char *offsets = data + 8;
+					const char *chars = data + headerSize;
+					uint64_t charsSize = offsetAt(offsets, entries);
+					if ( charsSize > size - headerSize ) return false;
+					size_t indexStart = headerSize + charsSize;
+					indexStart += (8 - indexStart % 8) % 8;
+					if ( indexStart > size || (size - indexStart) / 4 != rows
+					  || (size - indexStart) % 4 ) {
+						return false;
+					}
+
+					_dictionary.clear();
+					_dictionary.reserve(entries);
+					uint64_t last = 0;
+					for ( size_t i = 1; i <= entries; ++i ) {
+						uint64_t offset = offsetAt(offsets, i);
+						if ( offset < last || offset > charsSize ) return false;
+						_dictionary.emplace_back(chars + last, offset - last);
+						last = offset;
+					}
+
+					data += indexStart;
+					for ( size_t i = 0; i < rows; ++i ) {
+						if ( indexAt(data, i) >= entries ) return false;
+					}
+					break;
+				}
+				default:
+					return false;
+			}
+
+			_type = type;
+			_data = data;
+			return true;
+		}
+
+		//! Decompresses the column data into the internal buffer and returns
+		//! it or nullptr on error
+		const char *inflate(const char *data, size_t size, size_t rawSize) {
+			try {
+				bio::filtering_istreambuf filter;
+				filter.push(bio::zlib_decompressor());
+				filter.push(bio::array_source(data, size));
+				_storage.resize(rawSize);
+				if ( filter.sgetn(&_storage[0], static_cast<std::streamsize>(rawSize))
+				     != static_cast<std::streamsize>(rawSize) ) {
+					return nullptr;
+				}
+			}
+			catch ( std::exception &e ) {
+				SEISCOMP_ERROR("columnar: %s", e.what());
+				return nullptr;
+			}
+
+			return _storage.data();
+		}
+
+		int int8(size_t row) const {
+			return _type == CT_INT8 ? static_cast<int8_t>(_data[row]) : -1;
+		}
+
+		int64_t int64(size_t row) const {
+			if ( _type != CT_INT64 ) return NoTime;
+			int64_t value;
+			memcpy(&value, _data + row * 8, sizeof(value));
+			return value;
+		}
+
+		double real(size_t row) const {
+			if ( _type != CT_DOUBLE ) return NoValue;
+			double value;
+			memcpy(&value, _data + row * 8, sizeof(value));
+			return value;
+		}
+
+		std::string_view string(size_t row) const {
+			switch ( _type ) {
+				case CT_STRING:
+				{
+					uint64_t begin = offsetAt(_data, row);
+					return std::string_view(_chars + begin, offsetAt(_data, row + 1) - begin);
+				}
+				case CT_DICTIONARY:
+					return _dictionary[indexAt(_data, row)];
+				default:
+					return std::string_view();
+			}
+		}
+
+	private:
+		static uint64_t offsetAt(const char *offsets, size_t i) {
+			uint64_t value;
+			memcpy(&value, offsets + i * 8, sizeof(value));
+			return value;
+		}
+
+		static uint32_t indexAt(const char *indexes, size_t i) {
+			uint32_t value;
+			memcpy(&value, indexes + i * 4, sizeof(value));
+			return value;
+		}
+
+	private:
+		ColumnType                    _type{CT_NONE};
+		const char                   *_data{nullptr};
+		const char                   *_chars{nullptr};
+		std::vector<std::string_view> _dictionary;
+		std::string                   _storage;
+};
+
+
+using Columns = std::vector<ColumnView>;
+
+
+OPT(double) optReal(const ColumnView &column, size_t row) {
+	double value = column.real(row);
+	if ( std::isnan(value) ) return Core::None;
+	return value;
+}
+
+
+OPT(bool) optBool(const ColumnView &column, size_t row) {
+	int value = column.int8(row);
+	if ( value < 0 ) return Core::None;
+	return value != 0;
+}
+
+
+OPT(Core::Time) optTime(const ColumnView &column, size_t row) {
+	int64_t value = column.int64(row);
+	if ( value == NoTime ) return Core::None;
+	return fromMicroseconds(value);
+}
+
+
+template <typename E>
+OPT(E) optEnum(const ColumnView &column, size_t row) {
+	int value = column.int8(row);
+	E e;
+	if ( value < 0 || !e.fromInt(value) ) return Core::None;
+	return e;
+}
+
+
+OPT(CreationInfo) optCreationInfo(const Columns &columns, size_t agencyColumn, size_t row) {
+	auto agencyID = columns[agencyColumn].string(row);
+	auto author = columns[agencyColumn+1].string(row);
+	auto creationTime = optTime(columns[agencyColumn+2], row);
+
+	if ( agencyID.empty() && author.empty() && !creationTime ) {
+		return Core::None;
+	}
+
+	CreationInfo ci;
+	ci.setAgencyID(std::string(agencyID));
+	ci.setAuthor(std::string(author));
+	ci.setCreationTime(creationTime);
+	return ci;
+}
+
+
+class DocumentReader {
+	public:
+		DocumentReader(const char *data, size_t size)
+		: _data(data), _size(size) {}
+
+	public:
+		EventParameters *read() {
+			char magic[4];
+			uint32_t header[3];
+
+			if ( !read(magic, sizeof(magic)) || memcmp(magic, Magic, sizeof(magic)) ) {
+				SEISCOMP_ERROR("columnar: invalid document header");
+				return nullptr;
+			}
+
+			if ( !read(header, sizeof(header)) ) {
+				SEISCOMP_ERROR("columnar: truncated document header");
+				return nullptr;
+			}
+
+			if ( header[1] != ByteOrderMark ) {
+				SEISCOMP_ERROR("columnar: document byte order does not match");
+				return nullptr;
+			}
+
+			if ( header[0] > Version ) {
+				SEISCOMP_ERROR("columnar: unsupported version %u", header[0]);
+				return nullptr;
+			}
+
+			_ep = new EventParameters;
+
+			while ( _pos < _size ) {
+				if ( !readBlock() ) {
+					delete _ep;
+					_ep = nullptr;
+					return nullptr;
+				}
+			}
+
+			return _ep;
+		}
+
+	private:
+		bool readBlock() {
+			std::string_view tableName;
+			uint64_t rows;
+			uint32_t counts[2];
+
+			if ( !readName(tableName) || !align()
+			  || !read(&rows, sizeof(rows)) || !read(counts, sizeof(counts)) ) {
+				SEISCOMP_ERROR("columnar: truncated block header");
+				return false;
+			}
+
+			// The exporter never writes more than BlockRows rows per block.
+			// Rejecting larger counts up front keeps the size arithmetic of
+			// the column checks and the row loops below in bounds.
+			if ( rows > BlockRows ) {
+				SEISCOMP_ERROR("columnar: invalid row count %llu in %s block",
+				               static_cast<unsigned long long>(rows),
+				               std::string(tableName).c_str());
+				return false;
+			}
+
+			const TableDefinition *def = nullptr;
+			for ( auto table : { &PickTable, &AmplitudeTable, &ArrivalTable, &StationMagnitudeTable } ) {
+				if ( tableName == table->name ) {
+					def = table;
+					break;
+				}
+			}
+
+			Columns columns(def ? def->columnCount : 0);
+
+			for ( uint32_t i = 0; i < counts[0]; ++i ) {
+				std::string_view columnName;
+				uint8_t attributes[4];
+				uint64_t sizes[2];
+				const char *data;
+
+				if ( !readName(columnName) || !read(attributes, sizeof(attributes))
+				  || !align() || !read(sizes, sizeof(sizes))
+				  || !(data = take(sizes[1])) || !align() ) {
+					SEISCOMP_ERROR("columnar: truncated column in %s block",
+					               std::string(tableName).c_str());
+					return false;
+				}
+
+				// Unknown tables, unknown columns and columns with a
+				// different type are skipped
+				if ( !def ) continue;
+
+				size_t index = 0;
+				while ( index < def->columnCount
+				     && (columnName != def->columns[index].name
+				      || attributes[0] != def->columns[index].type) ) {
+					++index;
+				}
+
+				if ( index >= def->columnCount ) continue;
+
+				if ( attributes[1] == CE_ZLIB ) {
+					data = columns[index].inflate(data, sizes[1], sizes[0]);
+				}
+				else if ( attributes[1] != CE_RAW || sizes[0] != sizes[1] ) {
+					data = nullptr;
+				}
+
+				if ( !data || !columns[index].init(def->columns[index].type, data, sizes[0], rows) ) {
+					SEISCOMP_ERROR("columnar: invalid column %s.%s",
+					               def->name, def->columns[index].name);
+					return false;
+				}
+			}
+
+			if ( def == &PickTable ) {
+				for ( size_t row = 0; row < rows; ++row ) readPick(columns, row);
+			}
+			else if ( def == &AmplitudeTable ) {
+				for ( size_t row = 0; row < rows; ++row ) readAmplitude(columns, row);
+			}
+			else if ( def == &ArrivalTable ) {
+				for ( size_t row = 0; row < rows; ++row ) readArrival(columns, row);
+			}
+			else if ( def == &StationMagnitudeTable ) {
+				for ( size_t row = 0; row < rows; ++row ) readStationMagnitude(columns, row);
+			}
+
+			return true;
+		}
+
+		void readPick(const Columns &c, size_t row) {
+			PickPtr pick = Pick::Create(std::string(c[PK_PUBLIC_ID].string(row)));
+			if ( !pick ) {
+				SEISCOMP_WARNING("columnar: pick %s: invalid or duplicate publicID",
+				                 std::string(c[PK_PUBLIC_ID].string(row)).c_str());
+				return;
+			}
+
+			auto wid = fromStreamID(c[PK_STREAM].string(row));
+			if ( wid ) {
+				pick->setWaveformID(*wid);
+			}
+
+			TimeQuantity time;
+			auto value = optTime(c[PK_TIME], row);
+			if ( value ) {
+				time.setValue(*value);
+			}
+			time.setUncertainty(optReal(c[PK_TIME_UNCERTAINTY], row));
+			time.setLowerUncertainty(optReal(c[PK_TIME_LOWER_UNCERTAINTY], row));
+			time.setUpperUncertainty(optReal(c[PK_TIME_UPPER_UNCERTAINTY], row));
+			pick->setTime(time);
+
+			pick->setFilterID(std::string(c[PK_FILTER_ID].string(row)));
+			pick->setMethodID(std::string(c[PK_METHOD_ID].string(row)));
+
+			auto slowness = optReal(c[PK_HORIZONTAL_SLOWNESS], row);
+			if ( slowness ) {
+				pick->setHorizontalSlowness(RealQuantity(*slowness));
+			}
+
+			auto baz = optReal(c[PK_BACKAZIMUTH], row);
+			if ( baz ) {
+				pick->setBackazimuth(RealQuantity(*baz));
+			}
+
+			pick->setSlownessMethodID(std::string(c[PK_SLOWNESS_METHOD_ID].string(row)));
+			pick->setOnset(optEnum<PickOnset>(c[PK_ONSET], row));
+
+			auto phaseHint = c[PK_PHASE_HINT].string(row);
+			if ( !phaseHint.empty() ) {
+				pick->setPhaseHint(Phase(std::string(phaseHint)));
+			}
+
+			pick->setPolarity(optEnum<PickPolarity>(c[PK_POLARITY], row));
+			pick->setEvaluationMode(optEnum<EvaluationMode>(c[PK_EVALUATION_MODE], row));
+			pick->setEvaluationStatus(optEnum<EvaluationStatus>(c[PK_EVALUATION_STATUS], row));
+			pick->setCreationInfo(optCreationInfo(c, PK_AGENCY_ID, row));
+
+			_ep->add(pick.get());
+		}
+
+		void readAmplitude(const Columns &c, size_t row) {
+			AmplitudePtr amp = Amplitude::Create(std::string(c[AM_PUBLIC_ID].string(row)));
+			if ( !amp ) {
+				SEISCOMP_WARNING("columnar: amplitude %s: invalid or duplicate publicID",
+				                 std::string(c[AM_PUBLIC_ID].string(row)).c_str());
+				return;
+			}
+
+			amp->setWaveformID(fromStreamID(c[AM_STREAM].string(row)));
+			amp->setType(std::string(c[AM_TYPE].string(row)));
+
+			auto value = optReal(c[AM_AMPLITUDE], row);
+			if ( value ) {
+				RealQuantity q(*value);
+				q.setLowerUncertainty(optReal(c[AM_AMPLITUDE_LOWER_UNCERTAINTY], row));
+				q.setUpperUncertainty(optReal(c[AM_AMPLITUDE_UPPER_UNCERTAINTY], row));
+				amp->setAmplitude(q);
+			}
+
+			auto reference = optTime(c[AM_TIME_REFERENCE], row);
+			if ( reference ) {
+				amp->setTimeWindow(TimeWindow(*reference, c[AM_TIME_BEGIN].real(row),
+				                              c[AM_TIME_END].real(row)));
+			}
+
+			auto period = optReal(c[AM_PERIOD], row);
+			if ( period ) {
+				amp->setPeriod(RealQuantity(*period));
+			}
+
+			amp->setSnr(optReal(c[AM_SNR], row));
+			amp->setUnit(std::string(c[AM_UNIT].string(row)));
+			amp->setPickID(std::string(c[AM_PICK_ID].string(row)));
+			amp->setFilterID(std::string(c[AM_FILTER_ID].string(row)));
+			amp->setMethodID(std::string(c[AM_METHOD_ID].string(row)));
+
+			auto scalingTime = optTime(c[AM_SCALING_TIME], row);
+			if ( scalingTime ) {
+				amp->setScalingTime(TimeQuantity(*scalingTime));
+			}
+
+			amp->setMagnitudeHint(std::string(c[AM_MAGNITUDE_HINT].string(row)));
+			amp->setEvaluationMode(optEnum<EvaluationMode>(c[AM_EVALUATION_MODE], row));
+			amp->setCreationInfo(optCreationInfo(c, AM_AGENCY_ID, row));
+
+			_ep->add(amp.get());
+		}
+
+		void readArrival(const Columns &c, size_t row) {
+			Origin *org = origin(c[AR_PARENT_ID].string(row));
+			if ( !org ) return;
+
+			ArrivalPtr arr = new Arrival;
+			arr->setPickID(std::string(c[AR_PICK_ID].string(row)));
+			arr->setPhase(Phase(std::string(c[AR_PHASE].string(row))));
+			arr->setTimeCorrection(optReal(c[AR_TIME_CORRECTION], row));
+			arr->setAzimuth(optReal(c[AR_AZIMUTH], row));
+			arr->setDistance(optReal(c[AR_DISTANCE], row));
+			arr->setTakeOffAngle(optReal(c[AR_TAKE_OFF_ANGLE], row));
+			arr->setTimeResidual(optReal(c[AR_TIME_RESIDUAL], row));
+			arr->setHorizontalSlownessResidual(optReal(c[AR_HORIZONTAL_SLOWNESS_RESIDUAL], row));
+			arr->setBackazimuthResidual(optReal(c[AR_BACKAZIMUTH_RESIDUAL], row));
+			arr->setTimeUsed(optBool(c[AR_TIME_USED], row));
+			arr->setHorizontalSlownessUsed(optBool(c[AR_HORIZONTAL_SLOWNESS_USED], row));
+			arr->setBackazimuthUsed(optBool(c[AR_BACKAZIMUTH_USED], row));
+			arr->setWeight(optReal(c[AR_WEIGHT], row));
+			arr->setEarthModelID(std::string(c[AR_EARTH_MODEL_ID].string(row)));
+			arr->setPreliminary(optBool(c[AR_PRELIMINARY], row));
+			arr->setCreationInfo(optCreationInfo(c, AR_AGENCY_ID, row));
+
+			if ( !org->add(arr.get()) ) {
+				SEISCOMP_WARNING("columnar: origin %s: duplicate arrival for pick %s",
+				                 org->publicID().c_str(), arr->pickID().c_str());
+			}
+		}
+
+		void readStationMagnitude(const Columns &c, size_t row) {
+			Origin *org = origin(c[SM_PARENT_ID].string(row));
+			if ( !org ) return;
+
+			StationMagnitudePtr mag = StationMagnitude::Create(std::string(c[SM_PUBLIC_ID].string(row)));
+			if ( !mag ) {
+				SEISCOMP_WARNING("columnar: station magnitude %s: invalid or duplicate publicID",
+				                 std::string(c[SM_PUBLIC_ID].string(row)).c_str());
+				return;
+			}
+
+			RealQuantity value(c[SM_MAGNITUDE].real(row));
+			value.setUncertainty(optReal(c[SM_MAGNITUDE_UNCERTAINTY], row));
+			mag->setMagnitude(value);
+			mag->setOriginID(std::string(c[SM_ORIGIN_ID].string(row)));
+			mag->setType(std::string(c[SM_TYPE].string(row)));
+			mag->setAmplitudeID(std::string(c[SM_AMPLITUDE_ID].string(row)));
+			mag->setMethodID(std::string(c[SM_METHOD_ID].string(row)));
+			mag->setWaveformID(fromStreamID(c[SM_STREAM].string(row)));
+			mag->setPassedQC(optBool(c[SM_PASSED_QC], row));
+			mag->setCreationInfo(optCreationInfo(c, SM_AGENCY_ID, row));
+
+			org->add(mag.get());
+		}
+
+		//! Returns the origin with the given publicID and creates it if it
+		//! has not been read yet
+		Origin *origin(std::string_view publicID) {
+			if ( publicID.empty() ) {
+				SEISCOMP_WARNING("columnar: skipping origin child without parentID");
+				return nullptr;
+			}
+
+			std::string id(publicID);
+			auto it = _origins.find(id);
+			if ( it != _origins.end() ) {
+				return it->second;
+			}
+
+			OriginPtr org = Origin::Create(id);
+			if ( !org ) {
+				SEISCOMP_WARNING("columnar: origin %s: duplicate publicID", id.c_str());
+				return nullptr;
+			}
+
+			_ep->add(org.get());
+			_origins[id] = org.get();
+			return org.get();
+		}
+
+		bool read(void *out, size_t size) {
+			const char *data = take(size);
+			if ( !data ) return false;
+			memcpy(out, data, size);
+			return true;
+		}
+
+		const char *take(size_t size) {
+			if ( _size - _pos < size ) return nullptr;
+			const char *data = _data + _pos;
+			_pos += size;
+			return data;
+		}
+
+		bool readName(std::string_view &name) {
+			uint32_t len;
+			if ( !read(&len, sizeof(len)) ) return false;
+			const char *data = take(len);
+			if ( !data ) return false;
+			name = std::string_view(data, len);
+			return true;
+		}
+
+		bool align() {
+			size_t padding = (8 - _pos % 8) % 8;
+			return take(padding) != nullptr;
+		}
+
+	private:
+		const char                              *_data;
+		size_t                                   _size;
+		size_t                                   _pos{0};
+		EventParameters                         *_ep{nullptr};
+		std::unordered_map<std::string, Origin*> _origins;
+};
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::BaseObject *ImporterColumnar::read(const char *data, size_t size) {
+	_hasErrors = false;
+	Core::BaseObject *obj = DocumentReader(data, size).read();
+	if ( !obj ) {
+		_hasErrors = true;
+	}
+	return obj;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::BaseObject *ImporterColumnar::get(std::streambuf* buf) {
+	std::string content;
+	char chunk[65536];
+	std::streamsize n;
+
+	while ( (n = buf->sgetn(chunk, sizeof(chunk))) > 0 ) {
+		content.append(chunk, static_cast<size_t>(n));
+	}
+
+	return read(content.data(), content.size());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void ExporterColumnar::setCompression(bool enable) {
+	_compression = enable;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ExporterColumnar::compression() const {
+	return _compression;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ExporterColumnar::put(std::streambuf* buf, Core::BaseObject *obj) {
+	if ( !buf || !obj ) return false;
+
+	DocumentWriter writer(buf, _compression);
+	return writer.writeHeader() && writer.add(obj) && writer.finish();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ExporterColumnar::put(std::streambuf* buf, const IO::ExportObjectList &objects) {
+	if ( !buf ) return false;
+
+	DocumentWriter writer(buf, _compression);
+	if ( !writer.writeHeader() ) return false;
+
+	for ( auto obj : objects ) {
+		if ( !writer.add(obj) ) return false;
+	}
+
+	return writer.finish();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
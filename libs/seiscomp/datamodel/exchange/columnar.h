@@ -0,0 +1,120 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#ifndef SEISCOMP_DATAMODEL_COLUMNAR_EXCHANGE_H
+#define SEISCOMP_DATAMODEL_COLUMNAR_EXCHANGE_H
+
+
+#include <seiscomp/io/importer.h>
+#include <seiscomp/io/exporter.h>
+
+
+namespace Seiscomp {
+namespace DataModel {
+
+
+/**
+ * @brief Reads picks, amplitudes, arrivals and station magnitudes written
+ *        by ExporterColumnar.
+ *
+ * The objects are returned attached to an EventParameters instance.
+ * Arrivals and station magnitudes are attached to origins which only carry
+ * the publicID stored with each row.
+ */
+class ImporterColumnar : public IO::Importer {
+	// ------------------------------------------------------------------
+	//  Xstruction
+	// ------------------------------------------------------------------
+	public:
+		//! C'tor
+		ImporterColumnar() = default;
+
+
+	// ------------------------------------------------------------------
+	//  Public interface
+	// ------------------------------------------------------------------
+	public:
+		using IO::Importer::read;
+
+		/**
+		 * @brief Decodes a columnar document from a contiguous memory
+		 *        block, e.g. a memory mapped file. Uncompressed columns
+		 *        are read in place.
+		 * @param data The start of the document
+		 * @param size The size of the document in bytes
+		 * @return An EventParameters instance or nullptr on error
+		 */
+		Core::BaseObject *read(const char *data, size_t size);
+
+
+	// ------------------------------------------------------------------
+	//  Importer interface
+	// ------------------------------------------------------------------
+	protected:
+		Core::BaseObject *get(std::streambuf* buf) override;
+};
+
+
+/**
+ * @brief Writes picks, amplitudes, arrivals and station magnitudes as
+ *        column blocks.
+ *
+ * Each object type is written as a sequence of blocks with one column per
+ * attribute. Repeating strings such as stream IDs, phase codes and authors
+ * are dictionary encoded. Columns are zlib compressed unless compression
+ * is disabled or does not pay off. Uncompressed column data is aligned to
+ * eight bytes so that a mapped file can be read without copying.
+ */
+class ExporterColumnar : public IO::Exporter {
+	// ------------------------------------------------------------------
+	//  Xstruction
+	// ------------------------------------------------------------------
+	public:
+		//! C'tor
+		ExporterColumnar() = default;
+
+
+	// ------------------------------------------------------------------
+	//  Public interface
+	// ------------------------------------------------------------------
+	public:
+		//! Enables or disables column compression. The default is true.
+		void setCompression(bool enable);
+		bool compression() const;
+
+
+	// ------------------------------------------------------------------
+	//  Exporter interface
+	// ------------------------------------------------------------------
+	protected:
+		bool put(std::streambuf* buf, Core::BaseObject *) override;
+		bool put(std::streambuf* buf, const IO::ExportObjectList &objects) override;
+
+
+	private:
+		bool _compression{true};
+};
+
+
+}
+}
+
+
+#endif
@@ -18,10 +18,27 @@
  ***************************************************************************/
 
 
+#define SEISCOMP_COMPONENT Trunk
 
 #include "trunk.h"
+#include <seiscomp/logging/log.h>
+#include <seiscomp/datamodel/notifier.h>
+#include <seiscomp/datamodel/publicobject.h>
 #include <seiscomp/io/archive/xmlarchive.h>
 
+#include <libxml/parser.h>
+#include <libxml/xmlreader.h>
+
+#include <deque>
+#include <future>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
 
 namespace Seiscomp {
 namespace DataModel {
@@ -34,6 +51,245 @@ REGISTER_EXPORTER_INTERFACE(ExporterTrunk, "trunk");
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+int streamBufReadCallback(void* context, char* buffer, int len) {
+	std::streambuf* buf = static_cast<std::streambuf*>(context);
+	if ( buf == nullptr ) return -1;
+
+	int count = 0;
+	int ch = buf->sgetc();
+	while ( ch != EOF && len-- && ch != '\0' ) {
+		*buffer++ = (char)buf->sbumpc();
+		ch = buf->sgetc();
+		++count;
+	}
+
+	return count;
+}
+
+
+int streamBufCloseCallback(void* context) {
+	return 0;
+}
+
+
+typedef std::unique_ptr<xmlTextReader, decltype(&xmlFreeTextReader)> ReaderPtr;
+typedef std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> DocumentPtr;
+
+
+/**
+ * An XML archive which reads the object below a node of a document that
+ * is built by the streaming importer. The document is not owned by the
+ * archive.
+ */
+class DocumentArchive : public IO::XMLArchive {
+	public:
+		Core::BaseObject *read(xmlDocPtr doc, xmlNodePtr container,
+		                       const Core::Version &version) {
+			Core::BaseObject *obj = nullptr;
+
+			if ( !Core::Archive::open(nullptr) )
+				return nullptr;
+
+			setVersion(version);
+			_document = doc;
+			_current = container;
+
+			*this >> obj;
+
+			_document = nullptr;
+			close();
+
+			return obj;
+		}
+};
+
+
+/**
+ * Collects the direct children of an object.
+ */
+class ChildCollector : public Visitor {
+	public:
+		ChildCollector(PublicObject *parent, std::vector<ObjectPtr> &children)
+		: _parent(parent), _children(children) {}
+
+		bool visit(PublicObject *po) override {
+			if ( po == _parent )
+				return true;
+
+			if ( po->parent() == _parent )
+				_children.push_back(po);
+
+			return false;
+		}
+
+		void visit(Object *o) override {
+			if ( o->parent() == _parent )
+				_children.push_back(o);
+		}
+
+	private:
+		PublicObject           *_parent;
+		std::vector<ObjectPtr> &_children;
+};
+
+
+/**
+ * An XML archive which writes an object with a range of its direct
+ * children only. The children are counted in the order they are written.
+ */
+class ChunkArchive : public IO::XMLArchive {
+	public:
+		ChunkArchive(const PublicObject *parent, size_t begin, size_t end)
+		: _parent(parent), _begin(begin), _end(end) {}
+
+		//! Adds an empty element to the top-level object which marks
+		//! the position of the children.
+		void addMarker(const char *name) {
+			xmlNodePtr root = xmlDocGetRootElement(static_cast<xmlDocPtr>(_document));
+			xmlNodePtr top = root ? xmlGetLastChild(root) : nullptr;
+			if ( top != nullptr )
+				xmlNewChild(top, nullptr, (const xmlChar*)name, nullptr);
+		}
+
+		size_t written() const {
+			return _written;
+		}
+
+	protected:
+		void serialize(RootType *object) override {
+			Object *o = Object::Cast(object);
+			if ( o != nullptr && o->parent() == _parent ) {
+				size_t index = _index++;
+				if ( index < _begin || index >= _end ) {
+					// Remove the element which has already been added
+					xmlNodePtr node = static_cast<xmlNodePtr>(_objectLocation);
+					xmlUnlinkNode(node);
+					xmlFreeNode(node);
+					_objectLocation = _current;
+					return;
+				}
+
+				++_written;
+			}
+
+			IO::XMLArchive::serialize(object);
+		}
+
+	private:
+		const PublicObject *_parent;
+		size_t              _begin;
+		size_t              _end;
+		size_t              _index{0};
+		size_t              _written{0};
+};
+
+
+const char *ChunkMarker = "__chunk__";
+
+
+struct Chunk {
+	std::string text;
+	size_t      children{0};
+};
+
+
+Chunk writeChunk(PublicObject *parent, size_t begin, size_t end,
+                 bool formatted, const char *marker = nullptr) {
+	Chunk chunk;
+	std::stringbuf buf;
+	ChunkArchive ar(parent, begin, end);
+	if ( !ar.create(&buf) )
+		return chunk;
+
+	ar.setFormattedOutput(formatted);
+	Core::BaseObject *obj = parent;
+	ar << obj;
+	if ( marker != nullptr )
+		ar.addMarker(marker);
+	ar.close();
+
+	chunk.text = buf.str();
+	chunk.children = ar.written();
+	return chunk;
+}
+
+
+size_t childCount(PublicObject *parent) {
+	std::vector<ObjectPtr> children;
+	ChildCollector collector(parent, children);
+	parent->accept(&collector);
+	return children.size();
+}
+
+
+Core::Version readVersion(xmlNodePtr node) {
+	xmlChar *version = xmlGetProp(node, (const xmlChar*)"version");
+	if ( version == nullptr )
+		return Core::Version(0,0);
+
+	Core::Version v;
+	char *separator = strchr((char*)version, '.');
+	if ( separator != nullptr ) {
+		*separator++ = '\0';
+		v = Core::Version(atoi((char*)version), atoi(separator));
+	}
+	else
+		v = Core::Version(atoi((char*)version), 0);
+
+	xmlFree(version);
+	return v;
+}
+
+
+/**
+ * Returns whether the element the reader is positioned at holds an
+ * object of the requested class. This follows the tag lookup of
+ * XMLArchive for unnamed objects.
+ */
+bool isObjectElement(xmlTextReaderPtr reader, const char *targetClass) {
+	xmlChar *role = xmlTextReaderGetAttribute(reader, (const xmlChar*)"role");
+	if ( role != nullptr ) {
+		bool hasRole = *role != '\0';
+		xmlFree(role);
+		if ( hasRole )
+			return false;
+	}
+
+	return Core::ClassFactory::IsTypeOf(
+		targetClass, (const char*)xmlTextReaderConstLocalName(reader)
+	);
+}
+
+
+/**
+ * Moves the reader to the next element at the current level which holds
+ * an object of the requested class. Returns 1 if an element has been
+ * found, 0 if the level has been finished and -1 on errors.
+ */
+int findObjectElement(xmlTextReaderPtr reader, int depth, const char *targetClass) {
+	int ret = 1;
+	while ( ret == 1 && xmlTextReaderDepth(reader) > depth ) {
+		if ( xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT
+		  && isObjectElement(reader, targetClass) )
+			return 1;
+
+		ret = xmlTextReaderNext(reader);
+	}
+
+	return ret < 0 ? -1 : 0;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 ImporterTrunk::ImporterTrunk() {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -41,8 +297,20 @@ ImporterTrunk::ImporterTrunk() {}
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void ImporterTrunk::setStreamingEnabled(bool e) {
+	_streaming = e;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Core::BaseObject *ImporterTrunk::get(std::streambuf* buf) {
+	if ( _streaming )
+		return stream(buf);
+
 	IO::XMLArchive ar;
 	ar.open(buf);
 	Core::BaseObject *obj = nullptr;
@@ -54,6 +322,148 @@ Core::BaseObject *ImporterTrunk::get(std::streambuf* buf) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::BaseObject *ImporterTrunk::stream(std::streambuf* buf) {
+	ReaderPtr reader(xmlReaderForIO(streamBufReadCallback,
+	                                streamBufCloseCallback,
+	                                buf, nullptr, nullptr, 0),
+	                 &xmlFreeTextReader);
+
+	if ( !reader )
+		return nullptr;
+
+	// Move to the root element
+	int ret;
+	while ( (ret = xmlTextReaderRead(reader.get())) == 1 ) {
+		if ( xmlTextReaderNodeType(reader.get()) == XML_READER_TYPE_ELEMENT )
+			break;
+	}
+
+	if ( ret != 1 )
+		return nullptr;
+
+	// The document holds the header, the top-level object with its members
+	// and the child element which is currently read. Without a header
+	// the document itself contains the object as XMLArchive does.
+	DocumentPtr doc(xmlNewDoc((const xmlChar*)"1.0"), &xmlFreeDoc);
+	xmlNodePtr container = reinterpret_cast<xmlNodePtr>(doc.get());
+	Core::Version version(0,0);
+
+	if ( !xmlStrcmp(xmlTextReaderConstLocalName(reader.get()), (const xmlChar*)"seiscomp") ) {
+		container = xmlDocCopyNode(xmlTextReaderCurrentNode(reader.get()), doc.get(), 2);
+		xmlDocSetRootElement(doc.get(), container);
+		version = readVersion(container);
+
+		if ( xmlTextReaderIsEmptyElement(reader.get()) )
+			return nullptr;
+
+		int depth = xmlTextReaderDepth(reader.get());
+		if ( xmlTextReaderRead(reader.get()) != 1 )
+			return nullptr;
+
+		if ( findObjectElement(reader.get(), depth, Core::BaseObject::ClassName()) != 1 )
+			return nullptr;
+	}
+	else if ( !isObjectElement(reader.get(), Core::BaseObject::ClassName()) )
+		return nullptr;
+
+	DocumentArchive ar;
+	Core::BaseObject *obj = nullptr;
+
+	if ( !Core::ClassFactory::IsTypeOf(PublicObject::ClassName(),
+	                                   (const char*)xmlTextReaderConstLocalName(reader.get()))
+	  || xmlTextReaderIsEmptyElement(reader.get()) ) {
+		// Objects without children are read as a whole
+		xmlNodePtr node = xmlTextReaderExpand(reader.get());
+		if ( node == nullptr )
+			return nullptr;
+
+		xmlNodePtr top = xmlDocCopyNode(node, doc.get(), 1);
+		if ( container == reinterpret_cast<xmlNodePtr>(doc.get()) )
+			xmlDocSetRootElement(doc.get(), top);
+		else
+			xmlAddChild(container, top);
+
+		obj = ar.read(doc.get(), container, version);
+	}
+	else {
+		xmlNodePtr top = xmlDocCopyNode(xmlTextReaderCurrentNode(reader.get()), doc.get(), 2);
+		if ( container == reinterpret_cast<xmlNodePtr>(doc.get()) )
+			xmlDocSetRootElement(doc.get(), top);
+		else
+			xmlAddChild(container, top);
+
+		std::vector<ObjectPtr> children;
+		bool notifierEnabled = Notifier::IsEnabled();
+
+		// Each child element is read together with the members of the
+		// object read so far into a temporary object and the children
+		// are taken from it.
+		int depth = xmlTextReaderDepth(reader.get());
+		ret = xmlTextReaderRead(reader.get());
+		while ( ret == 1 && xmlTextReaderDepth(reader.get()) > depth ) {
+			if ( xmlTextReaderNodeType(reader.get()) == XML_READER_TYPE_ELEMENT ) {
+				xmlNodePtr node = xmlTextReaderExpand(reader.get());
+				if ( node == nullptr )
+					return nullptr;
+
+				xmlNodePtr element = xmlDocCopyNode(node, doc.get(), 1);
+				xmlAddChild(top, element);
+
+				Core::BaseObjectPtr tmp = ar.read(doc.get(), container, version);
+				PublicObject *parent = PublicObject::Cast(tmp);
+				size_t count = children.size();
+
+				if ( parent ) {
+					ChildCollector collector(parent, children);
+					parent->accept(&collector);
+				}
+
+				// Elements which did not produce a child are kept. They are
+				// either members or they are read with the object finally.
+				if ( children.size() > count ) {
+					Notifier::SetEnabled(false);
+					for ( size_t i = count; i < children.size(); ++i )
+						children[i]->detach();
+					Notifier::SetEnabled(notifierEnabled);
+
+					xmlUnlinkNode(element);
+					xmlFreeNode(element);
+				}
+			}
+
+			ret = xmlTextReaderNext(reader.get());
+		}
+
+		if ( ret != 1 )
+			return nullptr;
+
+		obj = ar.read(doc.get(), container, version);
+		PublicObject *parent = PublicObject::Cast(obj);
+		if ( parent ) {
+			Notifier::SetEnabled(false);
+			for ( auto &child : children )
+				child->attachTo(parent);
+			Notifier::SetEnabled(notifierEnabled);
+		}
+	}
+
+	// Consume the rest of the document to catch syntax errors as
+	// the DOM parser would do
+	while ( (ret = xmlTextReaderRead(reader.get())) == 1 );
+
+	if ( ret < 0 ) {
+		delete obj;
+		return nullptr;
+	}
+
+	return obj;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 ExporterTrunk::ExporterTrunk() {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -61,8 +471,34 @@ ExporterTrunk::ExporterTrunk() {}
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void ExporterTrunk::setThreads(size_t threads) {
+	_threads = threads;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void ExporterTrunk::setChunkSize(size_t size) {
+	_chunkSize = size > 0 ? size : 1;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool ExporterTrunk::put(std::streambuf* buf, Core::BaseObject *obj) {
+	PublicObject *parent = PublicObject::Cast(obj);
+	size_t threads = _threads > 0 ? _threads : std::thread::hardware_concurrency();
+	if ( parent && threads > 1 ) {
+		size_t children = childCount(parent);
+		if ( children > _chunkSize )
+			return putChunked(buf, parent, children, threads);
+	}
+
 	IO::XMLArchive ar;
 	if ( !ar.create(buf) )
 		return false;
@@ -92,6 +528,87 @@ bool ExporterTrunk::put(std::streambuf* buf, const IO::ExportObjectList &objects
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool ExporterTrunk::putChunked(std::streambuf* buf, PublicObject *parent,
+                               size_t children, size_t threads) {
+	// libxml2 must be initialized before it is used by several threads
+	xmlInitParser();
+
+	// The document without children but with a marker element where the
+	// children go. Every chunk starts with the text in front of the
+	// marker and ends with the text after it.
+	std::string head = writeChunk(parent, 0, 0, _prettyPrint, ChunkMarker).text;
+	std::string markerTag = std::string("<") + ChunkMarker + "/>";
+	size_t pos = head.find(markerTag);
+	if ( pos == std::string::npos ) {
+		SEISCOMP_ERROR("Failed to write document frame");
+		return false;
+	}
+
+	std::string tail = head.substr(pos + markerTag.size());
+	head.resize(pos);
+
+	// The indentation in front of the first child separates the children
+	// of two chunks
+	std::string separator = head.substr(head.find_last_not_of(" \t\r\n") + 1);
+
+	if ( buf->sputn(head.data(), head.size()) != (std::streamsize)head.size() )
+		return false;
+
+	std::deque<std::future<Chunk>> pending;
+	bool first = true;
+	bool success = true;
+
+	auto flush = [&]() {
+		Chunk chunk = pending.front().get();
+		pending.pop_front();
+
+		if ( !success || !chunk.children )
+			return;
+
+		const std::string &text = chunk.text;
+		if ( text.size() < head.size() + tail.size()
+		  || text.compare(0, head.size(), head)
+		  || text.compare(text.size() - tail.size(), tail.size(), tail) ) {
+			SEISCOMP_ERROR("Unexpected document frame of chunk");
+			success = false;
+			return;
+		}
+
+		if ( !first )
+			buf->sputn(separator.data(), separator.size());
+		first = false;
+
+		std::streamsize size = text.size() - head.size() - tail.size();
+		if ( buf->sputn(text.data() + head.size(), size) != size )
+			success = false;
+	};
+
+	for ( size_t begin = 0; begin < children; begin += _chunkSize ) {
+		// The last chunk takes all remaining children
+		size_t end = children - begin > _chunkSize ?
+			begin + _chunkSize : std::numeric_limits<size_t>::max();
+
+		if ( pending.size() >= threads )
+			flush();
+
+		pending.push_back(std::async(std::launch::async, writeChunk, parent,
+		                             begin, end, _prettyPrint, nullptr));
+	}
+
+	while ( !pending.empty() )
+		flush();
+
+	if ( !success )
+		return false;
+
+	return buf->sputn(tail.data(), tail.size()) == (std::streamsize)tail.size();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 }
 }
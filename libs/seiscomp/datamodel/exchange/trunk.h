@@ -30,6 +30,9 @@ namespace Seiscomp {
 namespace DataModel {
 
 
+class PublicObject;
+
+
 class ImporterTrunk : public IO::Importer {
 	// ------------------------------------------------------------------
 	//  X'truction
@@ -39,11 +42,34 @@ class ImporterTrunk : public IO::Importer {
 		ImporterTrunk();
 
 
+	// ------------------------------------------------------------------
+	//  Public interface
+	// ------------------------------------------------------------------
+	public:
+		//! Enables/disables streaming import which is enabled by default.
+		//! If enabled, the document is not parsed into a complete DOM
+		//! tree. Instead the children of the top-level object are read
+		//! one after another and only a single child element is held in
+		//! memory at a time.
+		void setStreamingEnabled(bool);
+
+
 	// ------------------------------------------------------------------
 	//  Importer interface
 	// ------------------------------------------------------------------
 	protected:
 		Core::BaseObject *get(std::streambuf* buf) override;
+
+
+	// ------------------------------------------------------------------
+	//  Private interface
+	// ------------------------------------------------------------------
+	private:
+		Core::BaseObject *stream(std::streambuf* buf);
+
+
+	private:
+		bool _streaming{true};
 };
 
 
@@ -56,12 +82,43 @@ class ExporterTrunk : public IO::Exporter {
 		ExporterTrunk();
 
 
+	// ------------------------------------------------------------------
+	//  Public interface
+	// ------------------------------------------------------------------
+	public:
+		//! Sets the number of threads which write the children of the
+		//! exported object, e.g. the picks, origins and events of
+		//! EventParameters. The children are written in chunks which are
+		//! passed to the output in document order. The output does not
+		//! depend on the number of threads. 0 (the default) uses one
+		//! thread per CPU and 1 writes the document in the calling thread.
+		//! Object lists are always written in the calling thread.
+		void setThreads(size_t threads);
+
+		//! Sets the number of children per chunk, 1000 by default. Objects
+		//! with less children are written in the calling thread.
+		void setChunkSize(size_t size);
+
+
 	// ------------------------------------------------------------------
 	//  Exporter interface
 	// ------------------------------------------------------------------
 	protected:
 		bool put(std::streambuf* buf, Core::BaseObject *) override;
 		bool put(std::streambuf* buf, const IO::ExportObjectList &objects) override;
+
+
+	// ------------------------------------------------------------------
+	//  Private interface
+	// ------------------------------------------------------------------
+	private:
+		bool putChunked(std::streambuf* buf, PublicObject *parent,
+		                size_t children, size_t threads);
+
+
+	private:
+		size_t _threads{0};
+		size_t _chunkSize{1000};
 };
 
 
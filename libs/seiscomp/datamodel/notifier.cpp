@@ -24,7 +24,10 @@
 #include <seiscomp/datamodel/notifier.h>
 #include <seiscomp/datamodel/publicobject.h>
 #include <seiscomp/datamodel/metadata.h>
+#include <algorithm>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Seiscomp {
@@ -93,6 +96,69 @@ Core::MetaPropertyHandle objectProperty2(
 }
 
 
+/**
+ * The queued notifiers. Removed notifiers are reset to nullptr and skipped
+ * which keeps the indexes stable. The consumed prefix is dropped when the
+ * pool is drained or when it makes up half of the storage. The storage is
+ * reused for the next notifiers.
+ */
+struct NotifierPool {
+	typedef std::unordered_multimap<const Object*, size_t> Index;
+
+	std::vector<NotifierPtr> notifiers;
+	// Index of the first notifier not yet taken by GetMessage
+	size_t                   head{0};
+	// Number of queued notifiers
+	size_t                   count{0};
+	// Maps the object of a notifier to its index
+	Index                    index;
+
+	void push(Notifier *n) {
+		index.emplace(n->object(), notifiers.size());
+		notifiers.push_back(n);
+		++count;
+	}
+
+	void remove(Index::iterator it) {
+		notifiers[it->second] = nullptr;
+		index.erase(it);
+		--count;
+	}
+
+	void unindex(size_t pos) {
+		auto range = index.equal_range(notifiers[pos]->object());
+		for ( auto it = range.first; it != range.second; ++it ) {
+			if ( it->second == pos ) {
+				index.erase(it);
+				break;
+			}
+		}
+	}
+
+	// Drops the notifiers already taken by GetMessage. Pools which are
+	// never drained completely do not grow without bound that way, the
+	// amortized cost per notifier is constant.
+	void compact() {
+		if ( head < 64 || head * 2 < notifiers.size() )
+			return;
+
+		notifiers.erase(notifiers.begin(), notifiers.begin() + head);
+		for ( auto &item : index )
+			item.second -= head;
+		head = 0;
+	}
+
+	void clear() {
+		notifiers.clear();
+		index.clear();
+		head = count = 0;
+	}
+};
+
+
+NotifierPool pool;
+
+
 }
 
 
@@ -109,7 +175,6 @@ Notifier::MetaObject::MetaObject(const Core::RTTI* rtti) : Seiscomp::Core::MetaO
 IMPLEMENT_METAOBJECT(Notifier)
 
 IMPLEMENT_MESSAGE_FOR(Notifier, NotifierMessage, "notifier_message");
-Notifier::Pool Notifier::_notifiers;
 boost::thread_specific_ptr<bool> Notifier::_lock;
 bool Notifier::_checkOnCreate = true;
 
@@ -162,15 +227,19 @@ Notifier* Notifier::Create(const std::string& parentId,
 	NotifierPtr notifier = new Notifier(parentId, op, object);
 
 	if ( _checkOnCreate ) {
-		for ( auto it = _notifiers.begin(); it != _notifiers.end(); ++it ) {
-			CompareResult res = (*it)->cmp(notifier.get());
+		// Notifiers of different objects are always different, so only
+		// compare with the notifiers of the same object
+		auto range = pool.index.equal_range(object);
+		for ( auto it = range.first; it != range.second; ++it ) {
+			Notifier *stored = pool.notifiers[it->second].get();
+			CompareResult res = stored->cmp(notifier.get());
 			// If there is already an equal notifier stored, discard the
 			// current one
 			if ( res == CR_EQUAL ) {
 				SEISCOMP_DEBUG("equal notifiers found => discarding the given (%s(%s, %s), %s(%s, %s))",
-				               (*it)->parentID().c_str(),
-				               (*it)->operation().toString(),
-				               (*it)->object()->className(),
+				               stored->parentID().c_str(),
+				               stored->operation().toString(),
+				               stored->object()->className(),
 				               notifier->parentID().c_str(),
 				               notifier->operation().toString(),
 				               notifier->object()->className());
@@ -180,13 +249,13 @@ Notifier* Notifier::Create(const std::string& parentId,
 			// and discard the current one
 			else if ( res == CR_OPPOSITE ) {
 				SEISCOMP_DEBUG("opposite notifier found => removing the stored one");
-				_notifiers.erase(it);
+				pool.remove(it);
 				return nullptr;
 			}
 		}
 	}
 
-	_notifiers.push_back(notifier);
+	pool.push(notifier.get());
 	return notifier.get();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -212,20 +281,34 @@ Notifier* Notifier::Create(PublicObject* parent,
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 NotifierMessage* Notifier::GetMessage(bool allNotifier) {
-	if ( _notifiers.empty() )
+	if ( !pool.count )
 		return nullptr;
 
 	NotifierMessage* msg = new NotifierMessage;
-	PoolIterator it = _notifiers.begin();
 
 	if ( allNotifier ) {
-		for ( ; it != _notifiers.end(); ++it )
-			msg->attach((*it).get());
-		_notifiers.clear();
+		// Drop removed notifiers and move the remaining ones into the
+		// message. The pool entries are unique, no need to check
+		// for duplicates.
+		auto first = pool.notifiers.begin() + pool.head;
+		auto last = std::remove(first, pool.notifiers.end(), NotifierPtr());
+		msg->append(std::make_move_iterator(first), std::make_move_iterator(last));
+		pool.clear();
 	}
 	else {
-		msg->attach((*it).get());
-		_notifiers.erase(it);
+		while ( !pool.notifiers[pool.head] )
+			++pool.head;
+
+		pool.unindex(pool.head);
+		msg->attach(pool.notifiers[pool.head].get());
+		pool.notifiers[pool.head] = nullptr;
+		++pool.head;
+		--pool.count;
+
+		if ( !pool.count )
+			pool.clear();
+		else
+			pool.compact();
 	}
 
 	return msg;
@@ -237,7 +320,7 @@ NotifierMessage* Notifier::GetMessage(bool allNotifier) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 size_t Notifier::Size() {
-	return _notifiers.size();
+	return pool.count;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -246,7 +329,7 @@ size_t Notifier::Size() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Notifier::Clear() {
-	_notifiers.clear();
+	pool.clear();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -56,15 +56,6 @@ class SC_SYSTEM_CORE_API Notifier : public Seiscomp::Core::BaseObject {
 			CR_QUANTITY
 		};
 
-	// ------------------------------------------------------------------
-	//  Types
-	// ------------------------------------------------------------------
-	private:
-		typedef std::list<NotifierPtr> Pool;
-		typedef Pool::iterator PoolIterator;
-		typedef Pool::const_iterator PoolConstIterator;
-
-
 	// ----------------------------------------------------------------------
 	//  Xstruction
 	// ----------------------------------------------------------------------
@@ -106,7 +97,9 @@ class SC_SYSTEM_CORE_API Notifier : public Seiscomp::Core::BaseObject {
 		//! Enables/disables checking previous inserted notifiers
 		//! when a new notifiers is about to be queued. When
 		//! enabled, and OP_ADD and OP_UPDATE of the same object
-		//! results in only one OP_ADD notifier.
+		//! results in only one OP_ADD notifier. Only notifiers of
+		//! the same object are compared which are looked up in
+		//! constant time.
 		static void SetCheckEnabled(bool);
 
 		//! Returns the current 'check' state
@@ -210,7 +203,6 @@ class SC_SYSTEM_CORE_API Notifier : public Seiscomp::Core::BaseObject {
 		ObjectPtr _object;
 
 		static boost::thread_specific_ptr<bool> _lock;
-		static Pool _notifiers;
 		static bool _checkOnCreate;
 
 	DECLARE_SC_CLASSFACTORY_FRIEND(Notifier);
@@ -25,12 +25,58 @@
 #include <seiscomp/logging/log.h>
 #include <seiscomp/datamodel/publicobject.h>
 #include <seiscomp/utils/replace.h>
+#include <atomic>
+#include <functional>
 #include <mutex>
 
 
 namespace {
 
-std::mutex cacheMutex;
+using Seiscomp::DataModel::PublicObject;
+
+
+// The registration map is split into shards with their own locks that
+// threads creating and destroying objects concurrently do not contend on a
+// single mutex. The number of shards must be a power of two.
+const size_t RegistryShardCount = 64;
+
+struct RegistryShard {
+	std::mutex                    mutex;
+	PublicObject::PublicObjectMap objects;
+};
+
+RegistryShard registry[RegistryShardCount];
+std::atomic<size_t> registryCount(0);
+
+// Set if the current thread holds all shard locks via PublicObject::Lock
+thread_local bool registryLocked = false;
+
+
+RegistryShard &registryShard(std::string_view publicID) {
+	size_t hash = std::hash<std::string_view>()(publicID);
+	// Bits 16 and up select the shard. The lower bits select the bucket
+	// of the shard's hash map which would otherwise see only the keys of
+	// every 64th bucket.
+	return registry[(hash >> 16) & (RegistryShardCount-1)];
+}
+
+
+// Locks a shard unless the current thread has locked the whole registry
+class ShardLock {
+	public:
+		ShardLock(RegistryShard &shard)
+		: _mutex(registryLocked ? nullptr : &shard.mutex) {
+			if ( _mutex ) _mutex->lock();
+		}
+
+		~ShardLock() {
+			if ( _mutex ) _mutex->unlock();
+		}
+
+	private:
+		std::mutex *_mutex;
+};
+
 
 }
 
@@ -81,7 +127,6 @@ IMPLEMENT_SC_ABSTRACT_CLASS_DERIVED(PublicObject,
                                     Object,
                                     "PublicObject");
 
-PublicObject::PublicObjectMap PublicObject::_publicObjects;
 bool PublicObject::_generateIds = false;
 std::string PublicObject::_idPattern = "@classname@/@time/%Y%m%d%H%M%S.%f@.@id@";
 unsigned long PublicObject::_publicObjectId = 0;
@@ -91,6 +136,96 @@ boost::thread_specific_ptr<bool> PublicObject::_registerObjects;
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObject::Iterator::Iterator() : _shard(RegistryShardCount) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObject::Iterator::Iterator(size_t shard)
+: _shard(shard), _it(registry[shard].objects.begin()) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void PublicObject::Iterator::skipEmpty() {
+	while ( _it == registry[_shard].objects.end() ) {
+		if ( ++_shard >= RegistryShardCount ) {
+			_it = PublicObjectMap::const_iterator();
+			return;
+		}
+
+		_it = registry[_shard].objects.begin();
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObject::Iterator::reference PublicObject::Iterator::operator*() const {
+	return *_it;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObject::Iterator::pointer PublicObject::Iterator::operator->() const {
+	return &*_it;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObject::Iterator &PublicObject::Iterator::operator++() {
+	++_it;
+	skipEmpty();
+	return *this;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObject::Iterator PublicObject::Iterator::operator++(int) {
+	Iterator tmp(*this);
+	++*this;
+	return tmp;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PublicObject::Iterator::operator==(const Iterator &other) const {
+	if ( _shard != other._shard ) return false;
+	return _shard >= RegistryShardCount || _it == other._it;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PublicObject::Iterator::operator!=(const Iterator &other) const {
+	return !(*this == other);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObject::PublicObject()
  : _registered(false) {
@@ -159,11 +294,13 @@ bool PublicObject::registerMe() {
 
 	if ( _publicID.empty() ) return false;
 
-	std::lock_guard<std::mutex> lk(cacheMutex);
+	RegistryShard &shard = registryShard(_publicID);
+	ShardLock lk(shard);
 
-	PublicObjectMap::iterator it = _publicObjects.find(_publicID);
-	if ( it == _publicObjects.end() ) {
-		_publicObjects[_publicID] = this;
+	// The key refers to the publicID of this object which is not changed
+	// while being registered
+	if ( shard.objects.emplace(_publicID, this).second ) {
+		++registryCount;
 		_registered = true;
 		return true;
 	}
@@ -183,11 +320,13 @@ bool PublicObject::deregisterMe() {
 	if ( _publicID.empty() || !_registered )
 		return false;
 
-	std::lock_guard<std::mutex> lk(cacheMutex);
+	RegistryShard &shard = registryShard(_publicID);
+	ShardLock lk(shard);
 
-	PublicObjectMap::iterator it = _publicObjects.find(_publicID);
-	if ( it != _publicObjects.end() ) {
-		_publicObjects.erase(it);
+	PublicObjectMap::iterator it = shard.objects.find(_publicID);
+	if ( it != shard.objects.end() ) {
+		shard.objects.erase(it);
+		--registryCount;
 		_registered = false;
 		return true;
 	}
@@ -239,8 +378,11 @@ bool PublicObject::validId() const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObject* PublicObject::Find(const std::string& publicID) {
-	PublicObjectMap::iterator it = _publicObjects.find(publicID);
-	if ( it == _publicObjects.end() ) return nullptr;
+	RegistryShard &shard = registryShard(publicID);
+	ShardLock lk(shard);
+
+	PublicObjectMap::iterator it = shard.objects.find(publicID);
+	if ( it == shard.objects.end() ) return nullptr;
 	return (*it).second;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -250,7 +392,7 @@ PublicObject* PublicObject::Find(const std::string& publicID) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 size_t PublicObject::ObjectCount() {
-	return _publicObjects.size();
+	return registryCount;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -259,7 +401,9 @@ size_t PublicObject::ObjectCount() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObject::Iterator PublicObject::Begin() {
-	return _publicObjects.begin();
+	Iterator it(0);
+	it.skipEmpty();
+	return it;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -268,7 +412,7 @@ PublicObject::Iterator PublicObject::Begin() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObject::Iterator PublicObject::End() {
-	return _publicObjects.end();
+	return Iterator();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -277,7 +421,9 @@ PublicObject::Iterator PublicObject::End() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void PublicObject::Lock() {
-	cacheMutex.lock();
+	for ( auto &shard : registry )
+		shard.mutex.lock();
+	registryLocked = true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -286,7 +432,9 @@ void PublicObject::Lock() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void PublicObject::Unlock() {
-	cacheMutex.unlock();
+	registryLocked = false;
+	for ( auto &shard : registry )
+		shard.mutex.unlock();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -25,8 +25,10 @@
 
 #include <seiscomp/datamodel/object.h>
 #include <boost/thread/tss.hpp>
+#include <iterator>
 #include <string>
-#include <map>
+#include <string_view>
+#include <unordered_map>
 
 
 namespace Seiscomp {
@@ -46,8 +48,42 @@ class SC_SYSTEM_CORE_API PublicObject : public Object {
 	//  Public types
 	// ------------------------------------------------------------------
 	public:
-		typedef std::map<std::string, PublicObject*> PublicObjectMap;
-		typedef PublicObjectMap::const_iterator Iterator;
+		//! The registration map of a single shard. The keys refer to the
+		//! publicID of the registered object.
+		typedef std::unordered_map<std::string_view, PublicObject*> PublicObjectMap;
+
+		//! Iterates over all shards of the registration map
+		class SC_SYSTEM_CORE_API Iterator {
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef PublicObjectMap::value_type value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const value_type *pointer;
+				typedef const value_type &reference;
+
+			public:
+				Iterator();
+
+			public:
+				reference operator*() const;
+				pointer operator->() const;
+
+				Iterator &operator++();
+				Iterator operator++(int);
+
+				bool operator==(const Iterator &other) const;
+				bool operator!=(const Iterator &other) const;
+
+			private:
+				Iterator(size_t shard);
+				void skipEmpty();
+
+			private:
+				size_t                          _shard;
+				PublicObjectMap::const_iterator _it;
+
+			friend class PublicObject;
+		};
 
 
 	// ------------------------------------------------------------------
@@ -142,7 +178,8 @@ class SC_SYSTEM_CORE_API PublicObject : public Object {
 
 		/**
 		 * Returns an iterator to the first element of
-		 * the static PublicObject registration map
+		 * the static PublicObject registration map. The map is split
+		 * into shards and has no particular order.
 		 */
 		static Iterator Begin();
 
@@ -154,7 +191,9 @@ class SC_SYSTEM_CORE_API PublicObject : public Object {
 
 		/**
 		 * Locks registration of PublicObjects and allows syncrhonized access
-		 * to Begin() and End() iterators.
+		 * to Begin() and End() iterators. This locks all shards of the
+		 * registration map. Find() can still be called by the locking
+		 * thread.
 		 */
 		static void Lock();
 
@@ -241,8 +280,6 @@ class SC_SYSTEM_CORE_API PublicObject : public Object {
 		std::string _publicID;
 		bool _registered;
 
-		static PublicObjectMap _publicObjects;
-
 		static bool _generateIds;
 		static std::string _idPattern;
 		static unsigned long _publicObjectId;
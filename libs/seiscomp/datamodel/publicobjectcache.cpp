@@ -23,12 +23,46 @@
 #include <seiscomp/logging/log.h>
 #include <seiscomp/datamodel/publicobjectcache.h>
 #include <seiscomp/datamodel/databasearchive.h>
+#include <seiscomp/io/archive/binarchive.h>
 
+#include <algorithm>
 #include <cassert>
+#include <streambuf>
 
 
 namespace Seiscomp {
 namespace DataModel {
+
+
+namespace {
+
+
+// Maximum number of publicIDs per prefetch query
+const size_t PrefetchChunkSize = 500;
+
+
+// Stream buffer which only counts the bytes written
+class CountingBuffer : public std::streambuf {
+	public:
+		size_t count() const { return _count; }
+
+	protected:
+		int_type overflow(int_type c) override {
+			if ( !traits_type::eq_int_type(c, traits_type::eof()) ) ++_count;
+			return traits_type::not_eof(c);
+		}
+
+		std::streamsize xsputn(const char *, std::streamsize n) override {
+			_count += n;
+			return n;
+		}
+
+	private:
+		size_t _count{0};
+};
+
+
+}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -129,7 +163,7 @@ PublicObjectCache::const_iterator::operator++(int) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObjectCache::PublicObjectCache() : _archive(nullptr), _size(0),
-    _front(nullptr), _back(nullptr) {}
+    _memoryUsage(0), _front(nullptr), _back(nullptr) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -137,7 +171,7 @@ PublicObjectCache::PublicObjectCache() : _archive(nullptr), _size(0),
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 PublicObjectCache::PublicObjectCache(DatabaseArchive* ar)
- : _archive(ar), _size(0), _front(nullptr), _back(nullptr) {}
+ : _archive(ar), _size(0), _memoryUsage(0), _front(nullptr), _back(nullptr) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -229,6 +263,7 @@ bool PublicObjectCache::remove(PublicObject *po) {
 		else
 			_back = item->prev;
 
+		_memoryUsage -= item->footprint;
 		delete item;
 		--_size;
 	}
@@ -252,6 +287,7 @@ void PublicObjectCache::clear() {
 
 	_front = _back = nullptr;
 	_size = 0;
+	_memoryUsage = 0;
 	_lookup.clear();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -283,6 +319,7 @@ PublicObject *PublicObjectCache::find(const Seiscomp::Core::RTTI &classType,
                                       const std::string &publicID) {
 	bool cached = true;
 	PublicObject *po = PublicObject::Find(publicID);
+	Statistics &stats = _statistics[&classType];
 
 	if ( !po ) {
 		auto it = _lookup.find(publicID);
@@ -301,6 +338,11 @@ PublicObject *PublicObjectCache::find(const Seiscomp::Core::RTTI &classType,
 		return nullptr;
 	}
 
+	if ( cached )
+		++stats.hits;
+	else
+		++stats.misses;
+
 	setCached(cached);
 	if ( po ) {
 		feed(po);
@@ -313,6 +355,74 @@ PublicObject *PublicObjectCache::find(const Seiscomp::Core::RTTI &classType,
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t PublicObjectCache::prefetch(const Seiscomp::Core::RTTI &classType,
+                                   const std::vector<std::string> &publicIDs) {
+	if ( !_archive || !_archive->driver() ) {
+		return 0;
+	}
+
+	std::vector<std::string> missing;
+	for ( const auto &publicID : publicIDs ) {
+		if ( publicID.empty() || PublicObject::Find(publicID)
+		  || _lookup.find(publicID) != _lookup.end() ) {
+			continue;
+		}
+
+		missing.push_back(publicID);
+	}
+
+	std::sort(missing.begin(), missing.end());
+	missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+	size_t count = 0;
+	std::vector<std::string> chunk;
+	std::vector<PublicObjectPtr> objects;
+
+	for ( size_t i = 0; i < missing.size(); i += PrefetchChunkSize ) {
+		chunk.assign(missing.begin() + i,
+		             missing.begin() + std::min(i + PrefetchChunkSize, missing.size()));
+
+		// Collect the objects first and feed them when the query is
+		// finished because pop callbacks might access the database
+		DatabaseIterator it = _archive->getObjectsByPublicID(classType, chunk);
+		while ( *it ) {
+			PublicObject *po = PublicObject::Cast(*it);
+			if ( po ) {
+				objects.push_back(po);
+			}
+			++it;
+		}
+		it.close();
+
+		for ( auto &po : objects ) {
+			feed(po.get());
+		}
+
+		count += objects.size();
+		objects.clear();
+	}
+
+	if ( count ) {
+		_statistics[&classType].prefetched += count;
+	}
+
+	return count;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void PublicObjectCache::resetStatistics() {
+	_statistics.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Core::TimeWindow PublicObjectCache::timeWindow() const {
 	Core::TimeWindow tw;
@@ -337,7 +447,7 @@ Core::Time PublicObjectCache::oldest() const {
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void PublicObjectCache::push(PublicObject* obj) {
+void PublicObjectCache::push(PublicObject* obj, size_t footprint) {
 	std::pair<CacheLookup::iterator, bool>
 		itp = _lookup.insert(CacheLookup::value_type(obj->publicID(), nullptr));
 
@@ -362,10 +472,12 @@ void PublicObjectCache::push(PublicObject* obj) {
 			item->next->prev = item->prev;
 		else
 			_back = item->prev;
+
+		_memoryUsage -= item->footprint;
 	}
 	else {
 		item = new CacheItem;
-		item->lookup = itp.first;
+		item->publicID = &itp.first->first;
 		itp.first->second = item;
 		++_size;
 	}
@@ -373,6 +485,9 @@ void PublicObjectCache::push(PublicObject* obj) {
 	// Update object pointer
 	item->object = obj;
 
+	item->footprint = footprint;
+	_memoryUsage += footprint;
+
 	// Update current timestamp
 	item->timestamp = Core::Time::Now().epochSeconds();
 
@@ -392,6 +507,21 @@ void PublicObjectCache::push(PublicObject* obj) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PublicObjectCache::cachedFootprint(const PublicObject *obj,
+                                        size_t &footprint) const {
+	auto it = _lookup.find(obj->publicID());
+	if ( it == _lookup.end() || it->second->object != obj )
+		return false;
+
+	footprint = it->second->footprint;
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void PublicObjectCache::pop() {
 	if ( !_front ) return;
@@ -410,8 +540,9 @@ void PublicObjectCache::pop() {
 	else
 		_back = item->prev;
 
-	_lookup.erase(item->lookup);
+	_lookup.erase(*item->publicID);
 
+	_memoryUsage -= item->footprint;
 	delete item;
 	--_size;
 }
@@ -548,6 +679,82 @@ bool PublicObjectTimeSpanBuffer::feed(PublicObject* po) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObjectMemoryBuffer::PublicObjectMemoryBuffer()
+ : _memoryLimit(0) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PublicObjectMemoryBuffer::PublicObjectMemoryBuffer(DatabaseArchive* ar,
+                                                   size_t memoryLimit)
+ : PublicObjectCache(ar), _memoryLimit(memoryLimit) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PublicObjectMemoryBuffer::setMemoryLimit(size_t memoryLimit) {
+	_memoryLimit = memoryLimit;
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t PublicObjectMemoryBuffer::memoryLimit() const {
+	return _memoryLimit;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PublicObjectMemoryBuffer::feed(PublicObject* po) {
+	if ( !po ) {
+		return false;
+	}
+
+	// Serializing an object is expensive, the footprint is only estimated
+	// when the object enters the cache and reused on each hit
+	size_t objectFootprint;
+	if ( !cachedFootprint(po, objectFootprint) )
+		objectFootprint = footprint(po);
+
+	push(po, objectFootprint);
+
+	// Ensure that the last object which was just pushed to the buffer is
+	// not removed even if it exceeds the limit on its own
+	while ( size() > 1 && memoryUsage() > _memoryLimit ) {
+		pop();
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t PublicObjectMemoryBuffer::footprint(PublicObject* po) const {
+	CountingBuffer buf;
+	IO::BinaryArchive ar(&buf, false);
+	ar << po;
+	ar.close();
+	return buf.count();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 }
 }
@@ -26,6 +26,8 @@
 #include <seiscomp/datamodel/publicobject.h>
 #include <queue>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Seiscomp {
@@ -60,7 +62,8 @@ struct SC_SYSTEM_CORE_API CachePopCallback {
  *
  * The cache encapsulates this code in a single function and can implement
  * several strategies for storing objects in memory. Currently a cache size
- * based strategy and a time span based strategy are implemented.
+ * based strategy, a time span based strategy and a memory footprint based
+ * strategy are implemented.
  *
  * The cache receives an optional pointer to the database archive to load
  * objects from database if required. That makes the object lookup a breeze:
@@ -106,20 +109,35 @@ struct SC_SYSTEM_CORE_API CachePopCallback {
  * // it.
  * Pick *pick = PublicObject::Find(publicID);
  * @endcode
+ *
+ * If many objects are going to be looked up, e.g. the picks of all arrivals
+ * of an origin, they should be prefetched. All objects which are neither
+ * registered nor cached are then read with a few queries instead of one
+ * query per object:
+ *
+ * @code
+ * std::vector<std::string> pickIDs;
+ * for ( size_t i = 0; i < origin->arrivalCount(); ++i )
+ *     pickIDs.push_back(origin->arrival(i)->pickID());
+ * _cache.prefetch<Pick>(pickIDs);
+ * @endcode
  */
 class SC_SYSTEM_CORE_API PublicObjectCache : public Core::BaseObject {
 	private:
 		struct CacheItem;
 
-		typedef std::map<std::string, CacheItem*> CacheLookup;
+		typedef std::unordered_map<std::string, CacheItem*> CacheLookup;
 
 		// Simple double linked list
 		struct CacheItem {
-			PublicObjectPtr       object;
-			time_t                timestamp;
-			CacheItem            *prev;
-			CacheItem            *next;
-			CacheLookup::iterator lookup;
+			PublicObjectPtr    object;
+			time_t             timestamp;
+			size_t             footprint;
+			CacheItem         *prev;
+			CacheItem         *next;
+			// Points to the key in the lookup table which stays valid
+			// when the table is rehashed
+			const std::string *publicID;
 		};
 
 
@@ -127,6 +145,19 @@ class SC_SYSTEM_CORE_API PublicObjectCache : public Core::BaseObject {
 		typedef std::function<void (PublicObject*)> PopCallback;
 		typedef std::function<void (PublicObject*)> PushCallback;
 
+		//! Lookup statistics of a class
+		struct Statistics {
+			//! Number of objects found in the registry or in the cache
+			size_t hits{0};
+			//! Number of objects which had to be read from the database
+			//! or which were not found at all
+			size_t misses{0};
+			//! Number of objects read by prefetch
+			size_t prefetched{0};
+		};
+
+		typedef std::unordered_map<const Core::RTTI*, Statistics> StatisticsMap;
+
 
 	public:
 		class const_iterator {
@@ -250,6 +281,33 @@ class SC_SYSTEM_CORE_API PublicObjectCache : public Core::BaseObject {
 			return static_cast<T*>(find(T::TypeInfo(), publicID));
 		}
 
+		/**
+		 * @brief Reads all objects of a list of publicIDs which are neither
+		 *        registered nor cached from the database and feeds them
+		 *        into the cache.
+		 *
+		 * The objects are read in chunks with one query per chunk. Later
+		 * calls to find for those objects do not require a database
+		 * round trip as long as the objects are not evicted.
+		 *
+		 * @param classType The type of the objects to be read
+		 * @param publicIDs The publicIDs of the objects
+		 * @return The number of objects read from the database
+		 */
+		size_t prefetch(const Core::RTTI &classType,
+		                const std::vector<std::string> &publicIDs);
+
+		template <typename T>
+		size_t prefetch(const std::vector<std::string> &publicIDs) {
+			return prefetch(T::TypeInfo(), publicIDs);
+		}
+
+		//! Returns the lookup statistics per requested class type
+		const StatisticsMap &statistics() const { return _statistics; }
+
+		//! Resets all lookup statistics
+		void resetStatistics();
+
 		//! Returns the time of the oldest entry
 		Core::Time oldest() const;
 
@@ -259,6 +317,11 @@ class SC_SYSTEM_CORE_API PublicObjectCache : public Core::BaseObject {
 		//! Returns the number of cached elements
 		size_t size() const { return _size; }
 
+		//! Returns the approximate memory footprint of all cached
+		//! elements in bytes. This is only tracked by caches which
+		//! evict by memory, otherwise 0 is returned.
+		size_t memoryUsage() const { return _memoryUsage; }
+
 		const_iterator begin() const;
 		const_iterator end() const;
 
@@ -280,7 +343,16 @@ class SC_SYSTEM_CORE_API PublicObjectCache : public Core::BaseObject {
 
 	protected:
 		void pop();
-		void push(PublicObject *obj);
+		void push(PublicObject *obj, size_t footprint = 0);
+
+		/**
+		 * @brief Returns the footprint stored with the cache entry of an
+		 *        object.
+		 * @param obj The object
+		 * @param footprint The stored footprint
+		 * @return false if the object is not cached, true otherwise
+		 */
+		bool cachedFootprint(const PublicObject *obj, size_t &footprint) const;
 
 		void setCached(bool cached) { _cached = cached; }
 		DatabaseArchive *databaseArchive() { return _archive.get(); }
@@ -289,10 +361,12 @@ class SC_SYSTEM_CORE_API PublicObjectCache : public Core::BaseObject {
 	private:
 		DatabaseArchivePtr _archive;
 		size_t             _size;
+		size_t             _memoryUsage;
 		CacheItem         *_front;
 		CacheItem         *_back;
 		CacheLookup        _lookup;
 		bool               _cached;
+		StatisticsMap      _statistics;
 
 		PushCallback       _pushCallback;
 		PopCallback        _popCallback;
@@ -331,6 +405,42 @@ class SC_SYSTEM_CORE_API PublicObjectTimeSpanBuffer : public PublicObjectCache {
 };
 
 
+/**
+ * @brief The PublicObjectMemoryBuffer class evicts the oldest objects if the
+ *        approximate memory footprint of all cached objects exceeds a limit.
+ *
+ * The footprint of an object includes all of its children. It is estimated
+ * by footprint() when the object is inserted into the cache and stored with
+ * its entry. Later changes to a cached object are not taken into account.
+ */
+class SC_SYSTEM_CORE_API PublicObjectMemoryBuffer : public PublicObjectCache {
+	public:
+		PublicObjectMemoryBuffer();
+		PublicObjectMemoryBuffer(DatabaseArchive *ar,
+		                         size_t memoryLimit);
+
+	public:
+		//! Sets the memory limit in bytes
+		bool setMemoryLimit(size_t memoryLimit);
+		size_t memoryLimit() const;
+
+		bool feed(PublicObject *po) override;
+
+	protected:
+		/**
+		 * @brief Estimates the memory footprint of an object. The default
+		 *        implementation uses the size of the binary
+		 *        serialization of the object and all its children.
+		 * @param po The object
+		 * @return The footprint in bytes
+		 */
+		virtual size_t footprint(PublicObject *po) const;
+
+	private:
+		size_t _memoryLimit;
+};
+
+
 }
 }
 
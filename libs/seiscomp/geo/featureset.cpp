@@ -162,6 +162,7 @@ void GeoFeatureSet::clear() {
 		delete feature;
 	}
 	_features.clear();
+	++_generation;
 
 	// Delete all Categories
 	for ( const auto *category : _categories ) {
@@ -231,6 +232,7 @@ size_t GeoFeatureSet::readBNADir(const string& dirPath) {
 
 	// Sort the features according to their rank
  	sort(_features.begin(), _features.end(), compareByRank);
+	++_generation;
 
 	return fileCount;
 }
@@ -262,6 +264,7 @@ size_t GeoFeatureSet::readDir(const std::string &dirPath) {
 
 	// Sort the features according to their rank
  	sort(_features.begin(), _features.end(), compareByRank);
+	++_generation;
 
 	return fileCount;
 }
@@ -437,6 +440,7 @@ ssize_t GeoFeatureSet::readFile(const std::string &filename,
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool GeoFeatureSet::addFeature(GeoFeature *feature) {
 	_features.push_back(feature);
+	++_generation;
 	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
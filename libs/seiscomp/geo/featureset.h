@@ -138,6 +138,15 @@ class SC_SYSTEM_CORE_API GeoFeatureSet : public Core::BaseObject {
 		/** Returns reference to Category vector */
 		const Categories &categories() const { return _categories; };
 
+		/**
+		 * @brief Returns a counter which changes whenever features are
+		 *        added, removed or reordered. Caches of the feature list
+		 *        such as a FeatureIndex compare it to detect that they are
+		 *        outdated. Changes of the features themselves are not
+		 *        tracked.
+		 */
+		uint64_t generation() const { return _generation; }
+
 
 	private:
 		/** Copy constructor, private -> non copyable */
@@ -174,6 +183,9 @@ class SC_SYSTEM_CORE_API GeoFeatureSet : public Core::BaseObject {
 		/** Vector of Categories */
 		Categories _categories;
 
+		/** Changed with each update of _features */
+		uint64_t   _generation{0};
+
 		typedef std::vector<GeoFeatureSetObserver*> ObserverList;
 		ObserverList _observers;
 };
@@ -0,0 +1,425 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#include <seiscomp/geo/index/featureindex.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Seiscomp {
+namespace Geo {
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+// Margin in degrees added to all extents to be safe against rounding
+// errors when assigning edges and features to buckets and cells
+const double Eps = 1E-6;
+
+// The targeted number of edges per longitude bucket
+const size_t EdgesPerBucket = 4;
+const size_t MaxBuckets = 4096;
+
+
+inline double sub(double a, double b) {
+	return GeoCoordinate::normalizeLon(a - b);
+}
+
+
+// Same test as in Geo::contains for the edge from polygon[j] to polygon[i]
+inline bool crosses(const GeoCoordinate &v,
+                    const GeoCoordinate &pi, const GeoCoordinate &pj) {
+	GeoCoordinate::ValueType relLonLeft = sub(pi.lon, v.lon);
+	GeoCoordinate::ValueType relLonRight = sub(pj.lon, v.lon);
+	GeoCoordinate::ValueType relWidth = relLonLeft-relLonRight;
+	if ( fabs(relWidth) > 180 ) {
+		if ( relWidth < -180 )
+			relWidth += 360;
+		else
+			relWidth -= 360;
+
+		relLonLeft = relLonRight+relWidth;
+	}
+
+	if ( (relLonLeft > 0) == (relLonRight > 0) ) return false;
+	return v.lat < (pj.lat-pi.lat) * sub(v.lon, pi.lon) / sub(pj.lon, pi.lon) + pi.lat;
+}
+
+
+inline long floorIndex(double v, double width) {
+	return static_cast<long>(std::floor(v / width));
+}
+
+
+inline size_t wrapIndex(long k, size_t n) {
+	long m = k % static_cast<long>(n);
+	return static_cast<size_t>(m < 0 ? m + static_cast<long>(n) : m);
+}
+
+
+template <typename F>
+void forEachIndex(double from, double to, double width, size_t n,
+                  bool wraps, F func) {
+	long k0 = floorIndex(from, width);
+	long k1 = floorIndex(to, width);
+
+	if ( wraps ) {
+		if ( k1 - k0 + 1 >= static_cast<long>(n) ) {
+			for ( size_t i = 0; i < n; ++i ) func(i);
+			return;
+		}
+
+		for ( long k = k0; k <= k1; ++k ) func(wrapIndex(k, n));
+		return;
+	}
+
+	k0 = std::max(k0, 0L);
+	k1 = std::min(k1, static_cast<long>(n) - 1);
+	for ( long k = k0; k <= k1; ++k ) func(static_cast<size_t>(k));
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool FeatureIndex::Ring::crossings(const GeoCoordinate &gc) const {
+	// An edge is only crossed by the ray towards north if the point lies
+	// below it
+	if ( gc.lat >= latMax + Eps ) {
+		return false;
+	}
+
+	double t = std::fmod(gc.lon - lonMin, 360.0);
+	if ( t < 0 ) t += 360.0;
+
+	if ( !wraps && t > lonSpan + Eps ) {
+		if ( t < 360.0 - Eps ) {
+			return false;
+		}
+
+		t = 0;
+	}
+
+	size_t nb = bucketStart.size() - 1;
+	size_t b = std::min(static_cast<size_t>(t / bucketWidth), nb - 1);
+	bool oddCrossings = false;
+
+	for ( uint32_t k = bucketStart[b]; k < bucketStart[b+1]; ++k ) {
+		const Edge &e = edges[bucketEdges[k]];
+		if ( crosses(gc, e.to, e.from) ) {
+			oddCrossings = !oddCrossings;
+		}
+	}
+
+	return oddCrossings;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool FeatureIndex::Prepared::contains(const GeoCoordinate &gc) const {
+	bool isInside = false;
+
+	for ( const Ring &ring : rings ) {
+		if ( ring.crossings(gc) ) {
+			isInside = !isInside;
+		}
+	}
+
+	return isInside;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FeatureIndex::build(const std::vector<GeoFeature*> &features,
+                         double cellSize) {
+	clear();
+
+	if ( !(cellSize > 0) || cellSize > 90 ) {
+		cellSize = 1.0;
+	}
+
+	_features = features.size();
+	_rows = static_cast<size_t>(std::ceil(180.0 / cellSize));
+	_columns = static_cast<size_t>(std::ceil(360.0 / cellSize));
+	_cellHeight = 180.0 / _rows;
+	_cellWidth = 360.0 / _columns;
+
+	// Extents of all rings of a feature in the grid
+	struct Extent {
+		double latMin, latMax;
+		double lonMin, lonMax;
+		bool   wraps;
+	};
+
+	std::vector<std::vector<Extent>> extents;
+	std::vector<double> unwrapped;
+
+	for ( GeoFeature *feature : features ) {
+		if ( !feature || !feature->closedPolygon() ) {
+			continue;
+		}
+
+		Prepared prepared;
+		prepared.feature = feature;
+		std::vector<Extent> featureExtents;
+
+		const auto &vertices = feature->vertices();
+		const auto &subFeatures = feature->subFeatures();
+		size_t startIdx = 0;
+
+		for ( size_t s = 0; s <= subFeatures.size(); ++s ) {
+			size_t endIdx = (s == subFeatures.size() ? vertices.size() : subFeatures[s]);
+			const GeoCoordinate *polygon = &vertices[startIdx];
+			size_t sides = endIdx - startIdx;
+			startIdx = endIdx;
+
+			if ( !sides ) {
+				continue;
+			}
+
+			if ( polygon[0] == polygon[sides-1] ) {
+				--sides;
+			}
+
+			// Geo::contains returns false for less than three sides
+			if ( sides < 3 ) {
+				continue;
+			}
+
+			// Unwrap the longitudes along the ring to get a continuous
+			// longitude range
+			unwrapped.resize(sides + 1);
+			unwrapped[0] = GeoCoordinate::normalizeLon(polygon[0].lon);
+			for ( size_t i = 1; i <= sides; ++i ) {
+				unwrapped[i] = unwrapped[i-1] + sub(polygon[i % sides].lon, polygon[i-1].lon);
+			}
+
+			Ring ring;
+			Extent extent;
+
+			auto lons = std::minmax_element(unwrapped.begin(), unwrapped.end());
+			extent.lonMin = *lons.first;
+			extent.lonMax = *lons.second;
+			extent.latMin = extent.latMax = polygon[0].lat;
+			for ( size_t i = 1; i < sides; ++i ) {
+				extent.latMin = std::min(extent.latMin, polygon[i].lat);
+				extent.latMax = std::max(extent.latMax, polygon[i].lat);
+			}
+
+			extent.wraps = extent.lonMax - extent.lonMin >= 360.0 - Eps;
+
+			// A ring which encloses a pole is crossed by every meridian
+			// and contains all points south of it
+			if ( std::fabs(unwrapped[sides] - unwrapped[0]) > 180 ) {
+				extent.latMin = -90;
+			}
+
+			ring.lonMin = extent.lonMin;
+			ring.lonSpan = extent.wraps ? 360.0 : extent.lonMax - extent.lonMin;
+			ring.latMax = extent.latMax;
+			ring.wraps = extent.wraps;
+
+			size_t nb = std::min(std::max(sides / EdgesPerBucket, size_t(1)), MaxBuckets);
+			ring.bucketWidth = std::max(ring.lonSpan, Eps) / nb;
+			ring.bucketStart.assign(nb + 1, 0);
+			ring.edges.resize(sides);
+
+			// Edge i connects polygon[i-1] (polygon[sides-1] for i = 0)
+			// with polygon[i] as in Geo::contains
+			auto forEachBucket = [&](size_t i, auto func) {
+				double u0 = (i == 0 ? unwrapped[sides-1] : unwrapped[i-1]) - ring.lonMin;
+				double u1 = (i == 0 ? unwrapped[sides] : unwrapped[i]) - ring.lonMin;
+				if ( u0 > u1 ) std::swap(u0, u1);
+
+				// The direction of edges spanning half of the globe
+				// depends on the tested point
+				if ( u1 - u0 >= 180.0 - Eps ) {
+					for ( size_t b = 0; b < nb; ++b ) func(b);
+					return;
+				}
+
+				forEachIndex(u0 - Eps, u1 + Eps, ring.bucketWidth, nb,
+				             ring.wraps, func);
+			};
+
+			for ( size_t i = 0; i < sides; ++i ) {
+				ring.edges[i].from = polygon[i == 0 ? sides-1 : i-1];
+				ring.edges[i].to = polygon[i];
+				forEachBucket(i, [&](size_t b) { ++ring.bucketStart[b+1]; });
+			}
+
+			for ( size_t b = 0; b < nb; ++b ) {
+				ring.bucketStart[b+1] += ring.bucketStart[b];
+			}
+
+			std::vector<uint32_t> fill(ring.bucketStart.begin(), ring.bucketStart.end() - 1);
+			ring.bucketEdges.resize(ring.bucketStart.back());
+			for ( size_t i = 0; i < sides; ++i ) {
+				forEachBucket(i, [&](size_t b) {
+					ring.bucketEdges[fill[b]++] = static_cast<uint32_t>(i);
+				});
+			}
+
+			prepared.rings.push_back(std::move(ring));
+			featureExtents.push_back(extent);
+		}
+
+		_index[feature] = static_cast<uint32_t>(_prepared.size());
+		_prepared.push_back(std::move(prepared));
+		extents.push_back(std::move(featureExtents));
+	}
+
+	// Assign the features to the grid cells in two passes: count and fill.
+	// The features of each cell keep the build order.
+	size_t cells = _rows * _columns;
+	std::vector<uint32_t> lastFeature(cells, 0);
+	_cellStart.assign(cells + 1, 0);
+
+	auto forEachCell = [&](size_t f, auto func) {
+		for ( const Extent &e : extents[f] ) {
+			forEachIndex(e.latMin - Eps + 90, e.latMax + Eps + 90, _cellHeight,
+			             _rows, false, [&](size_t row) {
+				forEachIndex(e.lonMin - Eps + 180, e.lonMax + Eps + 180, _cellWidth,
+				             _columns, true, [&](size_t col) {
+					size_t c = row * _columns + col;
+					// Rings of the same feature can overlap
+					if ( lastFeature[c] == f + 1 ) return;
+					lastFeature[c] = static_cast<uint32_t>(f + 1);
+					func(c);
+				});
+			});
+		}
+	};
+
+	for ( size_t f = 0; f < _prepared.size(); ++f ) {
+		forEachCell(f, [&](size_t c) { ++_cellStart[c+1]; });
+	}
+
+	for ( size_t c = 0; c < cells; ++c ) {
+		_cellStart[c+1] += _cellStart[c];
+	}
+
+	std::fill(lastFeature.begin(), lastFeature.end(), 0);
+	std::vector<uint32_t> fill(_cellStart.begin(), _cellStart.end() - 1);
+	_cellFeatures.resize(_cellStart.back());
+
+	for ( size_t f = 0; f < _prepared.size(); ++f ) {
+		forEachCell(f, [&](size_t c) {
+			_cellFeatures[fill[c]++] = static_cast<uint32_t>(f);
+		});
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FeatureIndex::clear() {
+	_features = 0;
+	_rows = _columns = 0;
+	_prepared.clear();
+	_cellStart.clear();
+	_cellFeatures.clear();
+	_index.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t FeatureIndex::cell(double lat, double lon) const {
+	size_t row = std::min(static_cast<size_t>((lat + 90) / _cellHeight), _rows - 1);
+	size_t col = wrapIndex(floorIndex(GeoCoordinate::normalizeLon(lon) + 180, _cellWidth),
+	                       _columns);
+	return row * _columns + col;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+GeoFeature *FeatureIndex::findFirst(const GeoCoordinate &gc) const {
+	if ( _prepared.empty() ) {
+		return nullptr;
+	}
+
+	if ( !(gc.lat >= -90 && gc.lat <= 90) || !std::isfinite(gc.lon) ) {
+		// Not covered by the grid, test all features
+		for ( const Prepared &prepared : _prepared ) {
+			if ( prepared.feature->contains(gc) ) {
+				return prepared.feature;
+			}
+		}
+
+		return nullptr;
+	}
+
+	size_t c = cell(gc.lat, gc.lon);
+	for ( uint32_t k = _cellStart[c]; k < _cellStart[c+1]; ++k ) {
+		const Prepared &prepared = _prepared[_cellFeatures[k]];
+		if ( prepared.contains(gc) ) {
+			return prepared.feature;
+		}
+	}
+
+	return nullptr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool FeatureIndex::contains(const GeoFeature *feature,
+                            const GeoCoordinate &gc) const {
+	auto it = _index.find(feature);
+	if ( it == _index.end() || !std::isfinite(gc.lon) ) {
+		return feature && feature->contains(gc);
+	}
+
+	return _prepared[it->second].contains(gc);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
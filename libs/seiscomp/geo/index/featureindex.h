@@ -0,0 +1,139 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#ifndef SEISCOMP_GEO_INDEX_FEATUREINDEX_H
+#define SEISCOMP_GEO_INDEX_FEATUREINDEX_H
+
+
+#include <seiscomp/geo/feature.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace Geo {
+
+
+/**
+ * @brief A read-only point location index over closed polygon features.
+ *
+ * The index divides the globe into a regular latitude/longitude grid where
+ * each cell lists the features which can contain a point of that cell.
+ * Each feature is prepared by sorting its polygon edges into longitude
+ * buckets such that a containment test only visits the edges which
+ * span the longitude of the tested point.
+ *
+ * The results are identical to GeoFeature::contains. Features keep the
+ * order they were passed to build() which is the order in which
+ * findFirst() tests them. The features are not owned and must not be
+ * changed or deleted as long as the index is used. Querying the index
+ * from multiple threads is safe.
+ */
+class SC_SYSTEM_CORE_API FeatureIndex {
+	public:
+		FeatureIndex() = default;
+
+	public:
+		/**
+		 * @brief Builds the index over a list of features and replaces
+		 *        the previous content. Features which are not closed
+		 *        polygons are skipped.
+		 * @param features The features to index
+		 * @param cellSize The size of the grid cells in degrees
+		 */
+		void build(const std::vector<GeoFeature*> &features,
+		           double cellSize = 1.0);
+
+		//! Removes all features from the index
+		void clear();
+
+		//! Returns the number of features passed to the last build()
+		size_t size() const { return _features; }
+
+		bool empty() const { return _features == 0; }
+
+		/**
+		 * @brief Returns the first feature in build order which contains
+		 *        a point.
+		 * @param gc The point to test
+		 * @return The feature or nullptr
+		 */
+		GeoFeature *findFirst(const GeoCoordinate &gc) const;
+
+		/**
+		 * @brief Checks whether a feature contains a point. If the feature
+		 *        is not part of the index then GeoFeature::contains is
+		 *        called.
+		 * @param feature The feature
+		 * @param gc The point to test
+		 * @return true if the feature contains the point
+		 */
+		bool contains(const GeoFeature *feature, const GeoCoordinate &gc) const;
+
+
+	private:
+		struct Edge {
+			GeoCoordinate from;
+			GeoCoordinate to;
+		};
+
+		struct Ring {
+			double                lonMin;
+			double                lonSpan;
+			double                latMax;
+			double                bucketWidth;
+			bool                  wraps;
+			std::vector<uint32_t> bucketStart;
+			std::vector<uint32_t> bucketEdges;
+			std::vector<Edge>     edges;
+
+			bool crossings(const GeoCoordinate &gc) const;
+		};
+
+		struct Prepared {
+			GeoFeature        *feature;
+			std::vector<Ring>  rings;
+
+			bool contains(const GeoCoordinate &gc) const;
+		};
+
+		size_t cell(double lat, double lon) const;
+
+		using Index = std::unordered_map<const GeoFeature*, uint32_t>;
+
+		size_t                 _features{0};
+		size_t                 _rows{0};
+		size_t                 _columns{0};
+		double                 _cellHeight{0};
+		double                 _cellWidth{0};
+		std::vector<Prepared>  _prepared;
+		std::vector<uint32_t>  _cellStart;
+		std::vector<uint32_t>  _cellFeatures;
+		Index                  _index;
+};
+
+
+}
+}
+
+
+#endif
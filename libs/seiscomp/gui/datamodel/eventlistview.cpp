@@ -5329,6 +5329,13 @@ void EventListView::insertOrigin(Seiscomp::DataModel::Origin* origin,
 
 	Notifier::Enable();
 
+	// Picks, amplitudes and the origin are written to the broker in
+	// one batch
+	auto connection = !SC_D._updateLocalEPInstance ? SCApp->connection() : nullptr;
+	if ( connection ) {
+		connection->beginBatch();
+	}
+
 	// Send picks
 	for ( const auto &pickItem : changedPicks ) {
 		if ( pickItem.second ) {
@@ -5383,6 +5390,10 @@ void EventListView::insertOrigin(Seiscomp::DataModel::Origin* origin,
 		}
 	}
 
+	if ( connection ) {
+		connection->endBatch();
+	}
+
 	Notifier::SetEnabled(wasEnabled);
 
 	for ( auto &notifier : *msg ) {
@@ -5635,6 +5635,12 @@ void OriginLocatorView::importArrivals() {
 
 	PickedPhases sourcePhases, targetPhases, *sourcePhasesPtr, *targetPhasesPtr;
 
+	// Read all missing picks with a few queries
+	std::vector<std::string> pickIDs;
+	for ( PhasePicks::iterator it = sourcePhasePicks.begin(); it != sourcePhasePicks.end(); ++it )
+		pickIDs.push_back(it->first);
+	cache.prefetch<Pick>(pickIDs);
+
 	// Collect source phases grouped by stream
 	for ( PhasePicks::iterator it = sourcePhasePicks.begin(); it != sourcePhasePicks.end(); ++it ) {
 		PickPtr pick = cache.get<Pick>(it->first);
@@ -6276,6 +6282,12 @@ void OriginLocatorView::mergeOrigins(QList<DataModel::Origin*> orgs) {
 
 	PickedPhases sourcePhases, targetPhases;
 
+	// Read all missing picks with a few queries
+	std::vector<std::string> pickIDs;
+	for ( PhasePicks::iterator it = sourcePhasePicks.begin(); it != sourcePhasePicks.end(); ++it )
+		pickIDs.push_back(it->first);
+	cache.prefetch<Pick>(pickIDs);
+
 	// Collect source phases grouped by stream
 	for ( PhasePicks::iterator it = sourcePhasePicks.begin(); it != sourcePhasePicks.end(); ++it ) {
 		PickPtr pick = cache.get<Pick>(it->first);
@@ -105,7 +105,8 @@ namespace IO {
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-BinaryArchive::BinaryArchive() : _buf(nullptr), _deleteOnClose(false) {
+BinaryArchive::BinaryArchive()
+: _buf(nullptr), _readPtr(nullptr), _readEnd(nullptr), _deleteOnClose(false) {
 	_sequenceSize = -1;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -116,6 +117,7 @@ BinaryArchive::BinaryArchive() : _buf(nullptr), _deleteOnClose(false) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BinaryArchive::BinaryArchive(std::streambuf* buf, bool isReading) {
 	_buf = buf;
+	_readPtr = _readEnd = nullptr;
 	_isReading = isReading;
 	_deleteOnClose = false;
 	_sequenceSize = -1;
@@ -125,6 +127,20 @@ BinaryArchive::BinaryArchive(std::streambuf* buf, bool isReading) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BinaryArchive::BinaryArchive(const char *data, size_t size) {
+	_buf = nullptr;
+	_readPtr = data;
+	_readEnd = data + size;
+	_isReading = true;
+	_deleteOnClose = false;
+	_sequenceSize = -1;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BinaryArchive::~BinaryArchive() {
 	close();
@@ -173,6 +189,20 @@ bool BinaryArchive::open(std::streambuf* buf) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool BinaryArchive::open(const char *data, size_t size) {
+	close();
+	_readPtr = data;
+	_readEnd = data + size;
+	_deleteOnClose = false;
+
+	return Seiscomp::Core::Archive::open(nullptr);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool BinaryArchive::create(const char* file) {
 	close();
@@ -223,6 +253,35 @@ void BinaryArchive::close() {
 	_sequenceSize = -1;
 
 	_buf = nullptr;
+	_readPtr = _readEnd = nullptr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+inline bool BinaryArchive::hasInput() const {
+	return _buf || _readPtr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+inline int BinaryArchive::readBytes(void* buf, int size) {
+	if ( _readPtr ) {
+		// Memory block: copy without going through a stream buffer
+		if ( size > _readEnd - _readPtr )
+			size = static_cast<int>(_readEnd - _readPtr);
+		if ( size <= 0 ) return 0;
+		memcpy(buf, _readPtr, size);
+		_readPtr += size;
+		return size;
+	}
+
+	return _buf ? _buf->sgetn(static_cast<char*>(buf), size) : 0;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -232,7 +291,7 @@ void BinaryArchive::close() {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 template <typename T>
 void BinaryArchive::readInt(T& value) {
-	int size = _buf?_buf->sgetn((char*)&value, sizeof(T)):0;
+	int size = readBytes(&value, sizeof(T));
 	if ( size != sizeof(T) ) {
 		SEISCOMP_ERROR("read(int): expected %d bytes from stream, got %d", (int)sizeof(T), size);
 		setValidity(false);
@@ -281,7 +340,7 @@ void BinaryArchive::read(int64_t& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(float& value) {
-	int size = _buf?_buf->sgetn((char*)&value, sizeof(float)):0;
+	int size = readBytes(&value, sizeof(float));
 	if ( size != sizeof(float) ) {
 		SEISCOMP_ERROR("read(float): expected %d bytes from stream, got %d", (int)sizeof(float), size);
 		setValidity(false);
@@ -294,7 +353,7 @@ void BinaryArchive::read(float& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(double& value) {
-	int size = _buf?_buf->sgetn((char*)&value, sizeof(double)):0;
+	int size = readBytes(&value, sizeof(double));
 	if ( size != sizeof(double) ) {
 		SEISCOMP_ERROR("read(double): expected %d bytes from stream, got %d", (int)sizeof(double), size);
 		setValidity(false);
@@ -307,13 +366,13 @@ void BinaryArchive::read(double& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::vector<char>& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -322,7 +381,7 @@ void BinaryArchive::read(std::vector<char>& value) {
 
 	value.resize(vsize);
 	vsize = vsize * sizeof(char);
-	size = _buf->sgetn((char*)value.data(), vsize);
+	size = readBytes(value.data(), vsize);
 	if ( size != vsize ) {
 		SEISCOMP_ERROR("read(char*): expected %d bytes from stream, got %d", vsize, size);
 		setValidity(false);
@@ -336,13 +395,13 @@ void BinaryArchive::read(std::vector<char>& value) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 template <typename T>
 void BinaryArchive::readIntVector(std::vector<T>& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -351,7 +410,7 @@ void BinaryArchive::readIntVector(std::vector<T>& value) {
 
 	value.resize(vsize);
 	vsize = vsize * sizeof(int);
-	size = _buf->sgetn((char*)value.data(), vsize);
+	size = readBytes(value.data(), vsize);
 	if ( size != vsize ) {
 		SEISCOMP_ERROR("read(int*): expected %d bytes from stream, got %d", vsize, size);
 		setValidity(false);
@@ -400,13 +459,13 @@ void BinaryArchive::read(std::vector<int64_t>& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::vector<float>& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -415,7 +474,7 @@ void BinaryArchive::read(std::vector<float>& value) {
 
 	value.resize(vsize);
 	vsize = vsize * sizeof(float);
-	size = _buf->sgetn((char*)value.data(), vsize);
+	size = readBytes(value.data(), vsize);
 	if ( size != vsize ) {
 		SEISCOMP_ERROR("read(float*): expected %d bytes from stream, got %d", vsize, size);
 		setValidity(false);
@@ -428,13 +487,13 @@ void BinaryArchive::read(std::vector<float>& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::vector<double>& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -443,7 +502,7 @@ void BinaryArchive::read(std::vector<double>& value) {
 
 	value.resize(vsize);
 	vsize = vsize * sizeof(double);
-	size = _buf->sgetn((char*)value.data(), vsize);
+	size = readBytes(value.data(), vsize);
 	if ( size != vsize ) {
 		SEISCOMP_ERROR("read(double*): expected %d bytes from stream, got %d", vsize, size);
 		setValidity(false);
@@ -456,13 +515,13 @@ void BinaryArchive::read(std::vector<double>& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::vector<std::string>& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -482,13 +541,13 @@ void BinaryArchive::read(std::vector<std::string>& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::vector<Core::Time>& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -508,7 +567,7 @@ void BinaryArchive::read(std::vector<Core::Time>& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::complex<float>& value) {
-	int size = _buf?_buf->sgetn((char*)&value, sizeof(std::complex<float>)):0;
+	int size = readBytes(&value, sizeof(std::complex<float>));
 	if ( size != sizeof(std::complex<float>) ) {
 		SEISCOMP_ERROR("read(complex<float>): expected %d bytes from stream, got %d", (int)sizeof(std::complex<float>), size);
 		setValidity(false);
@@ -521,7 +580,7 @@ void BinaryArchive::read(std::complex<float>& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::complex<double>& value) {
-	int size = _buf?_buf->sgetn((char*)&value, sizeof(std::complex<double>)):0;
+	int size = readBytes(&value, sizeof(std::complex<double>));
 	if ( size != sizeof(std::complex<double>) ) {
 		SEISCOMP_ERROR("read(complex<double>): expected %d bytes from stream, got %d", (int)sizeof(std::complex<double>), size);
 		setValidity(false);
@@ -535,7 +594,7 @@ void BinaryArchive::read(std::complex<double>& value) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(bool& value) {
 	char tmp;
-	int size = _buf?_buf->sgetn(&tmp, sizeof(char)):0;
+	int size = readBytes(&tmp, sizeof(char));
 	if ( size != sizeof(char) ) {
 		SEISCOMP_ERROR("read(bool): expected %d bytes from stream, got %d", (int)sizeof(char), size);
 		setValidity(false);
@@ -550,13 +609,13 @@ void BinaryArchive::read(bool& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::vector<std::complex<double> >& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int vsize;
-	int size = _buf->sgetn((char*)&vsize, sizeof(int));
+	int size = readBytes(&vsize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(array.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -565,7 +624,7 @@ void BinaryArchive::read(std::vector<std::complex<double> >& value) {
 
 	value.resize(vsize);
 	vsize = vsize * sizeof(std::complex<double>);
-	size = _buf->sgetn((char*)value.data(), vsize);
+	size = readBytes(value.data(), vsize);
 
 	if ( size != vsize ) {
 		SEISCOMP_ERROR("read(complex<double>*): expected %d bytes from stream, got %d", vsize, size);
@@ -579,13 +638,13 @@ void BinaryArchive::read(std::vector<std::complex<double> >& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(std::string& value) {
-	if ( !_buf ) {
+	if ( !hasInput() ) {
 		setValidity(false);
 		return;
 	}
 
 	int ssize;
-	int size = _buf->sgetn((char*)&ssize, sizeof(int));
+	int size = readBytes(&ssize, sizeof(int));
 	if ( size != sizeof(int) ) {
 		SEISCOMP_ERROR("read(string.len): expected %d bytes from stream, got %d", (int)sizeof(int), size);
 		setValidity(false);
@@ -597,7 +656,7 @@ void BinaryArchive::read(std::string& value) {
 	else {
 		value.resize(ssize);
 		ssize = ssize * sizeof(std::string::value_type);
-		size = _buf->sgetn((char*)value.data(), ssize);
+		size = readBytes(value.data(), ssize);
 		if ( size != ssize ) {
 			SEISCOMP_ERROR("read(string): expected %d bytes from stream, got %d", ssize, size);
 			setValidity(false);
@@ -612,8 +671,8 @@ void BinaryArchive::read(std::string& value) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BinaryArchive::read(Seiscomp::Core::Time& value) {
 	dateint tmpSeconds, tmpUSeconds;
-	int size = _buf?_buf->sgetn((char*)&tmpSeconds, sizeof(tmpSeconds)):0;
-	size += _buf?_buf->sgetn((char*)&tmpUSeconds, sizeof(tmpUSeconds)):0;
+	int size = readBytes(&tmpSeconds, sizeof(tmpSeconds));
+	size += readBytes(&tmpUSeconds, sizeof(tmpUSeconds));
 	if ( size != sizeof(tmpSeconds) + sizeof(tmpUSeconds) ) {
 		SEISCOMP_ERROR("read(datetime): expected %d bytes from stream, got %d", int(sizeof(tmpSeconds) + sizeof(tmpUSeconds)), size);
 		setValidity(false);
@@ -872,7 +931,7 @@ void BinaryArchive::write(Seiscomp::Core::Time& value) {
 bool BinaryArchive::locateObjectByName(const char* name,
                                        const char* targetClass,
                                        bool nullable) {
-	if ( !_buf ) return false;
+	if ( !hasInput() ) return false;
 
 	if ( isReading() ) {
 		// if the first object of a sequence has to be read and
@@ -1077,6 +1136,16 @@ VBinaryArchive::VBinaryArchive(std::streambuf* buf, bool isReading,
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+VBinaryArchive::VBinaryArchive(const char *data, size_t size)
+: BinaryArchive(data, size), _forceWriteVersion(-1) {
+	if ( !readHeader() ) throw Core::StreamException(errorMsg());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void VBinaryArchive::setWriteVersion(int version) {
 	_forceWriteVersion = version;
@@ -1122,6 +1191,24 @@ bool VBinaryArchive::open(std::streambuf *buf) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool VBinaryArchive::open(const char *data, size_t size) {
+	_error = "";
+
+	if ( !BinaryArchive::open(data, size) ) return false;
+
+	if ( !readHeader() ) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool VBinaryArchive::create(const char* file) {
 	_error = "";
@@ -1190,24 +1277,49 @@ void VBinaryArchive::writeHeader() {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool VBinaryArchive::readHeader() {
 	const char *magic = MAGIC;
-	while ( *magic != '\0' ) {
-		if ( _buf->sgetc() == *magic ) {
-			++magic;
-			_buf->snextc();
-			continue;
+
+	if ( _readPtr ) {
+		const char *ptr = _readPtr;
+		while ( *magic != '\0' ) {
+			if ( ptr < _readEnd && *ptr == *magic ) {
+				++magic;
+				++ptr;
+				continue;
+			}
+			else {
+				_error = "invalid header, expected ";
+				_error += *magic;
+				break;
+			}
+		}
+
+		// Only consume the header if it is complete
+		if ( _error.empty() )
+			_readPtr = ptr;
+	}
+	else {
+		while ( *magic != '\0' ) {
+			if ( _buf->sgetc() == *magic ) {
+				++magic;
+				_buf->snextc();
+				continue;
+			}
+			else {
+				_error = "invalid header, expected ";
+				_error += *magic;
+				break;
+			}
 		}
-		else {
-			_error = "invalid header, expected ";
-			_error += *magic;
-			break;
+
+		if ( !_error.empty() ) {
+			while ( magic > MAGIC ) {
+				_buf->sungetc();
+				--magic;
+			}
 		}
 	}
 
 	if ( !_error.empty() ) {
-		while ( magic > MAGIC ) {
-			_buf->sungetc();
-			--magic;
-		}
 		_version = 0;
 		SEISCOMP_DEBUG("reading unversioned binary");
 		return true;
@@ -44,6 +44,10 @@ class SC_SYSTEM_CORE_API BinaryArchive : public Seiscomp::Core::Archive {
 		//! Constructor with predefined buffer and mode
 		BinaryArchive(std::streambuf* buf, bool isReading = true);
 
+		//! Constructor which reads from a contiguous memory block.
+		//! The memory must stay valid until the archive is closed.
+		BinaryArchive(const char *data, size_t size);
+
 		//! Destructor
 		~BinaryArchive();
 
@@ -55,6 +59,18 @@ class SC_SYSTEM_CORE_API BinaryArchive : public Seiscomp::Core::Archive {
 		bool open(const char* file) override;
 		bool open(std::streambuf*);
 
+		/**
+		 * @brief Opens a contiguous memory block for reading.
+		 *
+		 * The data are decoded directly from memory without going
+		 * through a stream buffer. The memory is not copied and must stay
+		 * valid until the archive is closed.
+		 * @param data The start of the block
+		 * @param size The size of the block in bytes
+		 * @return Success flag
+		 */
+		bool open(const char *data, size_t size);
+
 		bool create(const char* file) override;
 		bool create(std::streambuf*);
 
@@ -168,8 +184,11 @@ class SC_SYSTEM_CORE_API BinaryArchive : public Seiscomp::Core::Archive {
 		//! Implements derived virtual method
 		void serialize(SerializeDispatcher&) override;
 
+		int readBytes(void*, int);
 		int writeBytes(const void*, int);
 
+		bool hasInput() const;
+
 
 	// ----------------------------------------------------------------------
 	//  Implementation
@@ -189,6 +208,8 @@ class SC_SYSTEM_CORE_API BinaryArchive : public Seiscomp::Core::Archive {
 
 	protected:
 		std::streambuf* _buf;
+		const char*     _readPtr;
+		const char*     _readEnd;
 
 	private:
 		bool _deleteOnClose;
@@ -218,6 +239,10 @@ class SC_SYSTEM_CORE_API VBinaryArchive : public BinaryArchive {
 		VBinaryArchive(std::streambuf* buf, bool isReading = true,
 		               int forceWriteVersion = -1);
 
+		//! Constructor which reads from a contiguous memory block.
+		//! The memory must stay valid until the archive is closed.
+		VBinaryArchive(const char *data, size_t size);
+
 
 	// ----------------------------------------------------------------------
 	//  Public Interface
@@ -227,6 +252,7 @@ class SC_SYSTEM_CORE_API VBinaryArchive : public BinaryArchive {
 
 		bool open(const char* file) override;
 		bool open(std::streambuf*);
+		bool open(const char *data, size_t size);
 
 		bool create(const char* file) override;
 		bool create(std::streambuf*);
@@ -28,6 +28,7 @@
 #include <seiscomp/core/greensfunction.h>
 #include <seiscomp/core/system.h>
 #include <seiscomp/io/gfarchive/helmberger.h>
+#include <seiscomp/io/gfarchive/tracecache.h>
 #include <seiscomp/math/geo.h>
 
 #include <iostream>
@@ -479,6 +480,34 @@ Core::GreensFunction* HelmbergerArchive::get() {
 Core::GreensFunction* HelmbergerArchive::read(const std::string &file,
                                               const Core::TimeSpan &ts,
                                               double timeOfs) {
+	auto &cache = GFTraceCache::Instance();
+	if ( !cache.enabled() ) {
+		return decode(file, ts, timeOfs);
+	}
+
+	std::string key = file + "@" + Core::toString(ts.length())
+	                + "@" + Core::toString(timeOfs);
+	auto trace = cache.find(key);
+	if ( trace ) {
+		return GFTraceCache::ToGreensFunction(*trace);
+	}
+
+	Core::GreensFunction *gf = decode(file, ts, timeOfs);
+	if ( gf ) {
+		cache.insert(key, GFTraceCache::FromGreensFunction(gf));
+	}
+
+	return gf;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::GreensFunction* HelmbergerArchive::decode(const std::string &file,
+                                                const Core::TimeSpan &ts,
+                                                double timeOfs) {
 	if ( timeOfs >= (double)ts )
 		return nullptr;
 
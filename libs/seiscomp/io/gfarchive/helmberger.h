@@ -87,6 +87,9 @@ class SC_SYSTEM_CORE_API HelmbergerArchive : public GFArchive {
 		bool hasModel(const std::string &) const;
 		Core::GreensFunction* read(const std::string &file,
 		                           const Core::TimeSpan &ts, double timeOfs);
+		static Core::GreensFunction* decode(const std::string &file,
+		                                    const Core::TimeSpan &ts,
+		                                    double timeOfs);
 
 
 	// ----------------------------------------------------------------------
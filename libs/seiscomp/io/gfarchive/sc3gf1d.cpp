@@ -28,6 +28,7 @@
 #include <seiscomp/core/system.h>
 #include <seiscomp/math/geo.h>
 #include <seiscomp/io/gfarchive/sc3gf1d.h>
+#include <seiscomp/io/gfarchive/tracecache.h>
 #include <seiscomp/io/records/sacrecord.h>
 
 #include <rapidjson/document.h>
@@ -40,6 +41,9 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/regex.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/stream.hpp>
 
 
 /******************************************************************************
@@ -86,6 +90,7 @@
 
 
 namespace fs = boost::filesystem;
+namespace bio = boost::iostreams;
 
 namespace Seiscomp {
 namespace IO {
@@ -201,6 +206,45 @@ bool interpolate(Core::GreensFunction *gf1, const Core::GreensFunction *gf2,
 }
 
 
+std::string nodeFile(const std::string &pathprefix, double dep, double dist) {
+	char dep_str[10], dist_str[10];
+	snprintf(dep_str, 10, "%04d", (int)dep*10);
+	snprintf(dist_str, 10, "%05d", (int)dist);
+	return pathprefix + dep_str + "/" + dist_str + "/" + dep_str + "." + dist_str + ".";
+}
+
+
+std::string cacheKey(const std::string &file, const Core::TimeSpan &ts) {
+	return file + "@" + Core::toString(ts.length());
+}
+
+
+// Returns the grid value before lower and the one after upper if they exist
+std::vector<double> adjacent(const std::set<double> &values,
+                             double lower, double upper) {
+	std::vector<double> result;
+	auto from = values.find(lower);
+	auto to = values.find(upper);
+	if ( from == values.end() || to == values.end() ) {
+		return result;
+	}
+
+	if ( from != values.begin() ) {
+		result.push_back(*std::prev(from));
+	}
+
+	if ( ++to != values.end() ) {
+		result.push_back(*to);
+	}
+
+	return result;
+}
+
+
+// The maximum number of grid nodes waiting to be prefetched
+const size_t MaxPrefetchNodes = 16;
+
+
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -375,6 +419,18 @@ bool SC3GF1DArchive::setSource(std::string source) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void SC3GF1DArchive::close() {
+	// The worker finishes the queued nodes before it exits
+	{
+		std::lock_guard<std::mutex> lock(_prefetchMutex);
+		_prefetchStop = true;
+	}
+
+	_prefetchCondition.notify_all();
+	if ( _prefetchThread.joinable() ) {
+		_prefetchThread.join();
+	}
+
+	_prefetchStop = false;
 	_requests.clear();
 	_models.clear();
 }
@@ -612,10 +668,7 @@ Core::GreensFunction* SC3GF1DArchive::get() {
 		Core::GreensFunction *gf_22;
 
 		if ( (dist == dist1) || (dist == dist2) || (dist1 == dist2) ) {
-			char dep_str[10], dist_str[10];
-			snprintf(dep_str, 10, "%04d", (int)dep*10);
-			snprintf(dist_str, 10, "%05d", (int)dist);
-			std::string file = pathprefix + dep_str + "/" + dist_str + "/" + dep_str + "." + dist_str + ".";
+			std::string file = nodeFile(pathprefix, dep, dist);
 
 			Core::TimeSpan ts = _defaultTimespan;
 			if ( req.timeSpan ) ts = req.timeSpan;
@@ -637,12 +690,8 @@ Core::GreensFunction* SC3GF1DArchive::get() {
 			}
 		}
 		else {
-			char dep_str[10], dist1_str[10], dist2_str[10];
-			snprintf(dep_str, 10, "%04d", (int)dep*10);
-			snprintf(dist1_str, 10, "%05d", (int)dist1);
-			snprintf(dist2_str, 10, "%05d", (int)dist2);
-			std::string file1 = pathprefix + dep_str + "/" + dist1_str + "/" + dep_str + "." + dist1_str + ".";
-			std::string file2 = pathprefix + dep_str + "/" + dist2_str + "/" + dep_str + "." + dist2_str + ".";
+			std::string file1 = nodeFile(pathprefix, dep, dist1);
+			std::string file2 = nodeFile(pathprefix, dep, dist2);
 
 			Core::TimeSpan ts = _defaultTimespan;
 			if ( req.timeSpan ) ts = req.timeSpan;
@@ -684,10 +733,7 @@ Core::GreensFunction* SC3GF1DArchive::get() {
 		}
 		else {
 			if ( (dist == dist1) || (dist == dist2) || (dist1 == dist2) ) {
-				char dep_str[10], dist_str[10];
-				snprintf(dep_str, 10, "%04d", (int)alt_dep*10);
-				snprintf(dist_str, 10, "%05d", (int)dist);
-				std::string file = pathprefix + dep_str + "/" + dist_str + "/" + dep_str + "." + dist_str + ".";
+				std::string file = nodeFile(pathprefix, alt_dep, dist);
 
 				Core::TimeSpan ts = _defaultTimespan;
 				if ( req.timeSpan ) ts = req.timeSpan;
@@ -708,12 +754,8 @@ Core::GreensFunction* SC3GF1DArchive::get() {
 				}
 			}
 			else {
-				char dep_str[10], dist1_str[10], dist2_str[10];
-				snprintf(dep_str, 10, "%04d", (int)alt_dep*10);
-				snprintf(dist1_str, 10, "%05d", (int)dist1);
-				snprintf(dist2_str, 10, "%05d", (int)dist2);
-				std::string file1 = pathprefix + dep_str + "/" + dist1_str + "/" + dep_str + "." + dist1_str + ".";
-				std::string file2 = pathprefix + dep_str + "/" + dist2_str + "/" + dep_str + "." + dist2_str + ".";
+				std::string file1 = nodeFile(pathprefix, alt_dep, dist1);
+				std::string file2 = nodeFile(pathprefix, alt_dep, dist2);
 
 				Core::TimeSpan ts = _defaultTimespan;
 				if ( req.timeSpan ) ts = req.timeSpan;
@@ -758,6 +800,12 @@ Core::GreensFunction* SC3GF1DArchive::get() {
 			if ( gf_21 && ((gf_21 != gf_11) && (gf_21 != gf_12)) ) delete gf_21;
 			if ( gf_22 && ((gf_22 != gf_11) && (gf_22 != gf_12) && (gf_22 != gf_21)) ) delete gf_22;
 
+			// Subsequent requests, e.g. of the next iteration of an
+			// inversion, usually hit the neighbouring grid nodes
+			prefetch(mit->second, pathprefix,
+			         req.timeSpan ? req.timeSpan : _defaultTimespan,
+			         dist1, dist2, dep1, dep2);
+
 			return gf_11;
 		}
 
@@ -774,7 +822,140 @@ Core::GreensFunction* SC3GF1DArchive::get() {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Core::GreensFunction *SC3GF1DArchive::read(const std::string &file,
                                            const Core::TimeSpan &ts,
-                                           double timeOfs) {
+                                           double) {
+	auto &cache = GFTraceCache::Instance();
+	if ( !cache.enabled() ) {
+		return decode(file, ts);
+	}
+
+	std::string key = cacheKey(file, ts);
+	auto trace = cache.find(key);
+	if ( trace ) {
+		return GFTraceCache::ToGreensFunction(*trace);
+	}
+
+	Core::GreensFunction *gf = decode(file, ts);
+	if ( gf ) {
+		cache.insert(key, GFTraceCache::FromGreensFunction(gf));
+	}
+
+	return gf;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void SC3GF1DArchive::prefetch(const ModelConfig &config,
+                              const std::string &pathprefix,
+                              const Core::TimeSpan &ts,
+                              double dist1, double dist2,
+                              double dep1, double dep2) {
+	auto &cache = GFTraceCache::Instance();
+	if ( !cache.enabled() ) {
+		return;
+	}
+
+	std::vector<std::string> files;
+
+	// The nodes of the cells which share an edge with the interpolation
+	// cell. The diagonal cells are left out.
+	for ( auto dep : {dep1, dep2} ) {
+		for ( auto dist : adjacent(config.distances, dist1, dist2) ) {
+			files.push_back(nodeFile(pathprefix, dep, dist));
+		}
+
+		if ( dep2 == dep1 ) {
+			break;
+		}
+	}
+
+	for ( auto dist : {dist1, dist2} ) {
+		for ( auto dep : adjacent(config.depths, dep1, dep2) ) {
+			files.push_back(nodeFile(pathprefix, dep, dist));
+		}
+
+		if ( dist2 == dist1 ) {
+			break;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_prefetchMutex);
+
+		for ( auto &file : files ) {
+			std::string key = cacheKey(file, ts);
+			if ( cache.contains(key) || !_prefetchKeys.insert(key).second ) {
+				continue;
+			}
+
+			_prefetchQueue.push_back({file, key, ts});
+
+			// Older nodes are less likely to be requested next
+			while ( _prefetchQueue.size() > MaxPrefetchNodes ) {
+				_prefetchKeys.erase(_prefetchQueue.front().key);
+				_prefetchQueue.pop_front();
+			}
+		}
+
+		if ( _prefetchQueue.empty() ) {
+			return;
+		}
+
+		if ( !_prefetchThread.joinable() ) {
+			_prefetchThread = std::thread(&SC3GF1DArchive::runPrefetches, this);
+		}
+	}
+
+	_prefetchCondition.notify_one();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void SC3GF1DArchive::runPrefetches() {
+	auto &cache = GFTraceCache::Instance();
+	std::unique_lock<std::mutex> lock(_prefetchMutex);
+
+	while ( true ) {
+		_prefetchCondition.wait(lock, [this]() {
+			return _prefetchStop || !_prefetchQueue.empty();
+		});
+
+		if ( _prefetchQueue.empty() ) {
+			break;
+		}
+
+		PrefetchNode node = std::move(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+
+		lock.unlock();
+
+		if ( !cache.contains(node.key) ) {
+			Core::GreensFunctionPtr gf = decode(node.file, node.timeSpan);
+			if ( gf ) {
+				cache.insert(node.key, GFTraceCache::FromGreensFunction(gf.get()));
+			}
+		}
+
+		lock.lock();
+
+		// Keep the key until the node is cached to not queue it again
+		// while it is decoded
+		_prefetchKeys.erase(node.key);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::GreensFunction *SC3GF1DArchive::decode(const std::string &file,
+                                             const Core::TimeSpan &ts) {
 #if SC_API_VERSION >= SC_API_VERSION_CHECK(13,0,0)
 #define GF_COMPS 10
 #else
@@ -798,15 +979,24 @@ Core::GreensFunction *SC3GF1DArchive::read(const std::string &file,
 	};
 
 	Core::GreensFunction *gf = nullptr;
+	double timeOfs;
 
 	for ( int i = 0; i < GF_COMPS; ++i ) {
 		std::string filename = file + comps[i].toString();
-		std::ifstream ifs(filename .c_str());
-		if ( !ifs.good() ) {
+		bio::mapped_file_source map;
+		try {
+			map.open(filename);
+		}
+		catch ( ... ) {}
+
+		if ( !map.is_open() ) {
 			SEISCOMP_DEBUG("Green's functions - %s: not found", filename.c_str());
+			if ( gf ) delete gf;
 			return nullptr;
 		}
 
+		bio::stream<bio::array_source> ifs(map.data(), map.size());
+
 		IO::SACRecord sac;
 		try {
 			sac.read(ifs);
@@ -25,10 +25,14 @@
 #include <seiscomp/io/gfarchive.h>
 #include <seiscomp/seismology/ttt.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <map>
 #include <list>
 #include <set>
+#include <thread>
 
 
 namespace Seiscomp {
@@ -84,9 +88,25 @@ class SC_SYSTEM_CORE_API SC3GF1DArchive : public GFArchive {
 	//  Private member
 	// ----------------------------------------------------------------------
 	private:
+		struct ModelConfig;
+
 		bool hasModel(const std::string &) const;
 		Core::GreensFunction* read(const std::string &file,
 		                           const Core::TimeSpan &ts, double timeOfs);
+		static Core::GreensFunction* decode(const std::string &file,
+		                                    const Core::TimeSpan &ts);
+
+		/**
+		 * @brief Queues the grid nodes of the cells adjacent to a distance
+		 *        and depth cell to be loaded into the trace cache by the
+		 *        prefetch worker.
+		 */
+		void prefetch(const ModelConfig &config, const std::string &pathprefix,
+		              const Core::TimeSpan &ts, double dist1, double dist2,
+		              double dep1, double dep2);
+
+		//! The prefetch worker which decodes the queued nodes
+		void runPrefetches();
 
 
 	// ----------------------------------------------------------------------
@@ -121,10 +141,23 @@ class SC_SYSTEM_CORE_API SC3GF1DArchive : public GFArchive {
 
 		typedef std::map<std::string, ModelConfig> ModelMap;
 
+		struct PrefetchNode {
+			std::string    file;
+			std::string    key;
+			Core::TimeSpan timeSpan;
+		};
+
 		ModelMap           _models;
 		std::string        _baseDirectory;
 		Core::TimeSpan     _defaultTimespan;
 		RequestList        _requests;
+
+		std::thread              _prefetchThread;
+		std::mutex               _prefetchMutex;
+		std::condition_variable  _prefetchCondition;
+		std::deque<PrefetchNode> _prefetchQueue;
+		std::set<std::string>    _prefetchKeys;
+		bool                     _prefetchStop{false};
 };
 
 }
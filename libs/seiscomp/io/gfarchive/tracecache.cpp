@@ -0,0 +1,230 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp/core/typedarray.h>
+#include <seiscomp/io/gfarchive/tracecache.h>
+
+
+namespace Seiscomp {
+namespace IO {
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t GFTraceCache::Trace::bytes() const {
+	size_t bytes = 0;
+	for ( auto &comp : components ) {
+		bytes += comp.size() * sizeof(float);
+	}
+	return bytes;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+GFTraceCache &GFTraceCache::Instance() {
+	static GFTraceCache instance;
+	return instance;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void GFTraceCache::setCapacity(size_t bytes) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_capacity = bytes;
+	evict();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t GFTraceCache::capacity() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _capacity;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t GFTraceCache::size() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _size;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t GFTraceCache::count() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _lru.size();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+GFTraceCache::TracePtr GFTraceCache::find(const std::string &key) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _index.find(key);
+	if ( it == _index.end() ) {
+		return nullptr;
+	}
+
+	_lru.splice(_lru.begin(), _lru, it->second);
+	return it->second->second;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool GFTraceCache::contains(const std::string &key) const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _index.find(key) != _index.end();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+GFTraceCache::TracePtr GFTraceCache::insert(const std::string &key, TracePtr trace) {
+	if ( !trace ) {
+		return trace;
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _index.find(key);
+	if ( it != _index.end() ) {
+		_lru.splice(_lru.begin(), _lru, it->second);
+		return it->second->second;
+	}
+
+	size_t bytes = trace->bytes();
+	if ( bytes > _capacity ) {
+		return trace;
+	}
+
+	_lru.emplace_front(key, trace);
+	_index[key] = _lru.begin();
+	_size += bytes;
+
+	evict();
+
+	return trace;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void GFTraceCache::clear() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_lru.clear();
+	_index.clear();
+	_size = 0;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void GFTraceCache::evict() {
+	while ( _size > _capacity && !_lru.empty() ) {
+		_size -= _lru.back().second->bytes();
+		_index.erase(_lru.back().first);
+		_lru.pop_back();
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+GFTraceCache::TracePtr
+GFTraceCache::FromGreensFunction(const Core::GreensFunction *gf) {
+	if ( !gf ) {
+		return nullptr;
+	}
+
+	auto trace = std::make_shared<Trace>();
+	trace->samplingFrequency = gf->samplingFrequency();
+	trace->timeOffset = gf->timeOffset();
+
+	for ( int i = 0; i < Core::GreensFunctionComponent::Quantity; ++i ) {
+		auto data = FloatArray::ConstCast(gf->data(i));
+		if ( !data ) {
+			continue;
+		}
+
+		trace->mask |= 1 << i;
+		trace->components[i].assign(data->typedData(),
+		                            data->typedData() + data->size());
+	}
+
+	return trace;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::GreensFunction *GFTraceCache::ToGreensFunction(const Trace &trace) {
+	auto gf = new Core::GreensFunction();
+	gf->setSamplingFrequency(trace.samplingFrequency);
+	gf->setTimeOffset(trace.timeOffset);
+
+	for ( int i = 0; i < Core::GreensFunctionComponent::Quantity; ++i ) {
+		if ( !(trace.mask & (1 << i)) ) {
+			continue;
+		}
+
+		const auto &samples = trace.components[i];
+		gf->setData(i, new FloatArray(static_cast<int>(samples.size()),
+		                              samples.data()));
+	}
+
+	return gf;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
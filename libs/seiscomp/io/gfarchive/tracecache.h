@@ -0,0 +1,145 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#ifndef SEISCOMP_IO_GFARCHIVE_TRACECACHE_H
+#define SEISCOMP_IO_GFARCHIVE_TRACECACHE_H
+
+
+#include <seiscomp/core/greensfunction.h>
+#include <seiscomp/core.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace IO {
+
+
+/**
+ * @brief A process wide, size bounded LRU cache of decoded Green's
+ *        functions.
+ *
+ * Green's function archives decode the samples of a grid node once and
+ * store them with a key which identifies the archive, model, depth,
+ * distance and requested time span. Subsequent requests for the same node
+ * create a new Core::GreensFunction from the cached samples without
+ * reading the files again.
+ *
+ * The cached traces are immutable and not reference counted by
+ * Core::BaseObject which makes the cache safe to be used by concurrent
+ * readers. When the capacity is exceeded, the least recently used traces
+ * are dropped. A capacity of 0 disables the cache.
+ */
+class SC_SYSTEM_CORE_API GFTraceCache {
+	public:
+		struct Trace {
+			double             samplingFrequency{0};
+			double             timeOffset{0};
+			//! Bit i is set if component i is present
+			uint32_t           mask{0};
+			std::vector<float> components[Core::GreensFunctionComponent::Quantity];
+
+			//! Returns the number of bytes used by the samples
+			size_t bytes() const;
+		};
+
+		using TracePtr = std::shared_ptr<const Trace>;
+
+
+	private:
+		GFTraceCache() = default;
+
+
+	public:
+		//! Returns the shared cache instance
+		static GFTraceCache &Instance();
+
+		/**
+		 * @brief Sets the maximum number of bytes of all cached samples.
+		 *        The default is 256 MiB.
+		 */
+		void setCapacity(size_t bytes);
+		size_t capacity() const;
+
+		//! Returns the number of bytes of all cached samples
+		size_t size() const;
+
+		//! Returns the number of cached traces
+		size_t count() const;
+
+		//! Returns whether the cache is enabled
+		bool enabled() const { return capacity() > 0; }
+
+		/**
+		 * @brief Looks up a trace and marks it as recently used.
+		 * @return The trace or nullptr
+		 */
+		TracePtr find(const std::string &key);
+
+		//! Checks whether a trace is cached without changing its rank
+		bool contains(const std::string &key) const;
+
+		/**
+		 * @brief Inserts a trace. If another thread has inserted the same
+		 *        key already then the existing trace is kept.
+		 * @return The cached trace
+		 */
+		TracePtr insert(const std::string &key, TracePtr trace);
+
+		//! Removes all traces
+		void clear();
+
+
+	public:
+		//! Copies the float components of a Green's function
+		static TracePtr FromGreensFunction(const Core::GreensFunction *gf);
+
+		//! Creates a new Green's function with copies of the samples
+		static Core::GreensFunction *ToGreensFunction(const Trace &trace);
+
+
+	private:
+		void evict();
+
+
+	private:
+		using LRUList = std::list<std::pair<std::string, TracePtr>>;
+		using Index = std::unordered_map<std::string, LRUList::iterator>;
+
+		mutable std::mutex _mutex;
+		LRUList            _lru;
+		Index              _index;
+		size_t             _capacity{256 * 1024 * 1024};
+		size_t             _size{0};
+};
+
+
+}
+}
+
+
+#endif
@@ -743,13 +743,11 @@ void error(std::istream &is, const char *msg, size_t fp) {
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void MSeedRecord::read(std::istream &is) {
+void MSeedRecord::ReadRaw(std::istream &is, std::vector<char> &buffer) {
 #define HEADER_BLOCK_LEN 64
 	int reclen = -1;
-	MSRecord *prec = nullptr;
 	bool swapflag = false;
 	char header[HEADER_BLOCK_LEN];
-	std::vector<char> buffer;
 
 	while ( is.good() ) {
 		if ( is.read(header, sizeof(header))
@@ -864,6 +862,21 @@ void MSeedRecord::read(std::istream &is) {
 		throw Core::EndOfStreamException("Invalid Mini SEED record, too small");
 	}
 
+	buffer.resize(reclen);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSeedRecord::read(std::istream &is) {
+	MSRecord *prec = nullptr;
+	std::vector<char> buffer;
+
+	ReadRaw(is, buffer);
+	int reclen = static_cast<int>(buffer.size());
+
 	int r = msr_unpack(buffer.data(), reclen, &prec, 0, 0);
 	if ( r != MS_NOERROR ) {
 		throw LibmseedException(fmt::format("Unpacking of Mini SEED record failed: {}", r));
@@ -1008,6 +1021,107 @@ void MSeedRecord::write(std::ostream& out) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSeedRecord::ParseRawHeader(const char *data, size_t len,
+                                 MSeedRawHeader &header) {
+	if ( (len < sizeof(fsdh_s)) || !MS_ISVALIDHEADER(data) ) {
+		return false;
+	}
+
+	// Copy the fixed header to not modify the record while swapping
+	fsdh_s fsdh;
+	memcpy(&fsdh, data, sizeof(fsdh));
+
+	bool swapflag = !MS_ISVALIDYEARDAY(fsdh.start_time.year, fsdh.start_time.day);
+	if ( swapflag ) {
+		MS_SWAPBTIME(&fsdh.start_time);
+		ms_gswap2(&fsdh.numsamples);
+		ms_gswap2(&fsdh.samprate_fact);
+		ms_gswap2(&fsdh.samprate_mult);
+		ms_gswap4(&fsdh.time_correct);
+		ms_gswap2(&fsdh.blockette_offset);
+	}
+
+	char code[6];
+	ms_strncpclean(code, fsdh.network, 2);
+	header.networkCode = code;
+	ms_strncpclean(code, fsdh.station, 5);
+	header.stationCode = code;
+	ms_strncpclean(code, fsdh.location, 2);
+	header.locationCode = code;
+	ms_strncpclean(code, fsdh.channel, 3);
+	header.channelCode = code;
+
+	hptime_t hptime = ms_btime2hptime(&fsdh.start_time);
+	if ( hptime == HPTERROR ) {
+		return false;
+	}
+
+	// Apply the time correction if not yet applied, same as msr_unpack
+	if ( (fsdh.time_correct != 0) && !(fsdh.act_flags & 0x02) ) {
+		hptime += hptime_t(fsdh.time_correct) * (HPTMODULUS / 10000);
+	}
+
+	header.startTime = Seiscomp::Core::Time::FromEpoch(hptime_t(hptime / HPTMODULUS), hptime_t(hptime % HPTMODULUS));
+
+	// The actual sampling rate of blockette 100 has precedence over the
+	// nominal sampling rate
+	double samprate = ms_nomsamprate(fsdh.samprate_fact, fsdh.samprate_mult);
+	uint16_t blkt_offset = fsdh.blockette_offset;
+
+	while ( (blkt_offset != 0) && (size_t(blkt_offset) + 4 <= len) ) {
+		uint16_t blkt_type, next_blkt;
+		memcpy(&blkt_type, data + blkt_offset, sizeof(blkt_type));
+		memcpy(&next_blkt, data + blkt_offset + 2, sizeof(next_blkt));
+
+		if ( swapflag ) {
+			ms_gswap2(&blkt_type);
+			ms_gswap2(&next_blkt);
+		}
+
+		if ( blkt_type == 100 ) {
+			if ( size_t(blkt_offset) + 4 + sizeof(blkt_100_s) > len ) {
+				break;
+			}
+
+			blkt_100_s blkt_100;
+			memcpy(&blkt_100, data + blkt_offset + 4, sizeof(blkt_100));
+			if ( swapflag ) {
+				ms_gswap4(&blkt_100.samprate);
+			}
+
+			samprate = blkt_100.samprate;
+			break;
+		}
+
+		if ( (next_blkt != 0) && (next_blkt <= blkt_offset) ) {
+			break;
+		}
+
+		blkt_offset = next_blkt;
+	}
+
+	if ( samprate <= 0 ) {
+		return false;
+	}
+
+	header.endTime = header.startTime + Core::TimeSpan(fsdh.numsamples / samprate);
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::string MSeedRawHeader::streamID() const {
+	return networkCode + "." + stationCode + "." + locationCode + "." + channelCode;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 }
 }
@@ -27,6 +27,7 @@
 #include <seiscomp/core.h>
 
 #include <string>
+#include <vector>
 #include <cstdint>
 
 
@@ -46,6 +47,23 @@ class SC_SYSTEM_CORE_API LibmseedException : public Core::StreamException {
 };
 
 
+/**
+ * @brief The stream identification and time span of a miniSEED record
+ *        extracted from its fixed header without unpacking the record.
+ */
+struct SC_SYSTEM_CORE_API MSeedRawHeader {
+	std::string          networkCode;
+	std::string          stationCode;
+	std::string          locationCode;
+	std::string          channelCode;
+	Seiscomp::Core::Time startTime;
+	Seiscomp::Core::Time endTime;
+
+	//! Returns the stream id as NET.STA.LOC.CHA
+	std::string streamID() const;
+};
+
+
 /**
  * Uses seiscomp error logging as component MSEEDRECORD.
  **/
@@ -161,6 +179,27 @@ class SC_SYSTEM_CORE_API MSeedRecord: public Record {
 		//! Encode the record into the given stream
 		void write(std::ostream& out) override;
 
+		/**
+		 * @brief Reads the next miniSEED record from a stream without
+		 *        unpacking it. Throws the same exceptions as read().
+		 * @param in The input stream
+		 * @param buffer Receives the record data, its size is the
+		 *               record length.
+		 */
+		static void ReadRaw(std::istream &in, std::vector<char> &buffer);
+
+		/**
+		 * @brief Extracts the stream identification and the time span
+		 *        from the fixed header and the blockettes of a raw record.
+		 * @param data The record data
+		 * @param len The record length
+		 * @param header The output header
+		 * @return false if the header is invalid or the sampling rate
+		 *         is not positive
+		 */
+		static bool ParseRawHeader(const char *data, size_t len,
+		                           MSeedRawHeader &header);
+
 	private:
 		void _setDataAttributes(int reclen, char *data) const;
 
@@ -78,6 +78,29 @@ bool RecordStream::setRecordType(const char *type) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool RecordStream::nextRaw(std::vector<char> &data) {
+	for ( ;; ) {
+		RecordPtr rec = next();
+		if ( !rec ) {
+			return false;
+		}
+
+		const Array *raw = rec->raw();
+		if ( !raw ) {
+			continue;
+		}
+
+		const char *bytes = static_cast<const char*>(raw->data());
+		data.assign(bytes, bytes + raw->size() * raw->elementSize());
+		return true;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void RecordStream::setDataType(Array::DataType dataType) {
 	_dataType = dataType;
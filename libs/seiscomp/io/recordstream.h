@@ -26,6 +26,8 @@
 #include <seiscomp/core/record.h>
 #include <seiscomp/io/recordstreamexceptions.h>
 
+#include <vector>
+
 
 namespace Seiscomp {
 namespace IO {
@@ -213,6 +215,20 @@ class SC_SYSTEM_CORE_API RecordStream : public Core::InterruptibleObject {
 		 */
 		virtual Record *next() = 0;
 
+		/**
+		 * @brief Returns the next record in its raw encoded form without
+		 *        creating and decoding a record object. This is useful
+		 *        to pass data through, e.g. to serve miniSEED.
+		 *
+		 * The default implementation calls next() and copies the raw data
+		 * of the record. Records without raw data are skipped.
+		 * Implementations which read miniSEED from disk override this
+		 * method and only parse the fixed header for filtering.
+		 * @param data Receives the raw record data
+		 * @return false if the end of the stream has been reached
+		 */
+		virtual bool nextRaw(std::vector<char> &data);
+
 
 	// ------------------------------------------------------------------
 	//  RecordStream static interface
@@ -21,6 +21,7 @@
 #define SEISCOMP_COMPONENT RECORDFILE
 #include "file.h"
 #include <seiscomp/core/strings.h>
+#include <seiscomp/io/records/mseedrecord.h>
 #include <seiscomp/core/system.h>
 #include <seiscomp/logging/log.h>
 #include <seiscomp/system/environment.h>
@@ -207,6 +208,7 @@ bool File::setRecordType(const char *type) {
 	}
 
 	_factory = factory;
+	_rawMSeed = factory == RecordFactory::Find("mseed");
 	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -216,8 +218,15 @@ bool File::setRecordType(const char *type) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 const File::TimeWindowFilter* File::findTimeWindowFilter(Record *rec) {
-	const string streamID = rec->streamID();
+	return findTimeWindowFilter(rec->streamID());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const File::TimeWindowFilter* File::findTimeWindowFilter(const string &streamID) {
 	// First look for fully qualified stream id (no wildcards)
 	const auto &it = _filter.find(streamID);
 	if ( it != _filter.end() ) {
@@ -245,18 +254,27 @@ const File::TimeWindowFilter* File::findTimeWindowFilter(Record *rec) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void File::finishClose() {
+	if ( _current == &_fstream ) {
+		_fstream.close();
+	}
+	else {
+		_current = &_fstream;
+	}
+	_filter.clear();
+	_reFilter.clear();
+	_closeRequested = false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Record *File::next() {
 	if ( _closeRequested ) {
-		if ( _current == &_fstream ) {
-			_fstream.close();
-		}
-		else {
-			_current = &_fstream;
-		}
-		_filter.clear();
-		_reFilter.clear();
-		_closeRequested = false;
+		finishClose();
 		return nullptr;
 	}
 
@@ -345,6 +363,81 @@ Record *File::next() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool File::nextRaw(std::vector<char> &data) {
+	// Other formats need to be decoded
+	if ( !_rawMSeed ) {
+		return IO::RecordStream::nextRaw(data);
+	}
+
+	if ( _closeRequested ) {
+		finishClose();
+		return false;
+	}
+
+	if ( !*_current ) {
+		return false;
+	}
+
+	IO::MSeedRawHeader header;
+
+	while ( !_closeRequested ) {
+		try {
+			IO::MSeedRecord::ReadRaw(*_current, data);
+		}
+		catch ( Core::EndOfStreamException & ) {
+			return false;
+		}
+		catch ( std::exception &e ) {
+			SEISCOMP_ERROR("file read exception: %s", e.what());
+			if ( !*_current ) {
+				return false;
+			}
+			continue;
+		}
+
+		if ( !IO::MSeedRecord::ParseRawHeader(data.data(), data.size(), header) ) {
+			SEISCOMP_ERROR("file read exception: invalid Mini SEED header");
+			continue;
+		}
+
+		OPT(Core::Time) startTime = _startTime;
+		OPT(Core::Time) endTime = _endTime;
+
+		if ( !_filter.empty() || !_reFilter.empty() ) {
+			const auto *twf = findTimeWindowFilter(header.streamID());
+			// Not subscribed
+			if ( !twf ) {
+				continue;
+			}
+
+			if ( twf->start ) {
+				startTime = twf->start;
+			}
+
+			if ( twf->end ) {
+				endTime = twf->end;
+			}
+		}
+
+		if ( startTime && (header.endTime < *startTime) ) {
+			continue;
+		}
+
+		if ( endTime && (header.startTime >= *endTime) ) {
+			continue;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 string File::name() const {
 	return _name;
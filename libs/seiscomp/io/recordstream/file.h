@@ -89,6 +89,10 @@ class SC_SYSTEM_CORE_API File : public Seiscomp::IO::RecordStream {
 
 		Record *next() override;
 
+		//! Reads miniSEED records without decoding them if the record
+		//! type is mseed. Other record types are decoded.
+		bool nextRaw(std::vector<char> &data) override;
+
 
 	// ----------------------------------------------------------------------
 	//  Public file specific interface
@@ -119,8 +123,11 @@ class SC_SYSTEM_CORE_API File : public Seiscomp::IO::RecordStream {
 		using ReFilterList = std::vector<std::pair<std::string,TimeWindowFilter> >;
 
 		const TimeWindowFilter *findTimeWindowFilter(Record *rec);
+		const TimeWindowFilter *findTimeWindowFilter(const std::string &streamID);
+		void finishClose();
 
 		RecordFactory   *_factory{nullptr};
+		bool             _rawMSeed{false};
 		std::string      _name;
 		bool             _closeRequested;
 		std::fstream     _fstream;
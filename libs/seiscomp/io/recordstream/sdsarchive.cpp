@@ -751,43 +751,7 @@ bool SDSArchive::setStart(const string &fname, bool bsearch) {
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-Seiscomp::Record *SDSArchive::next() {
-	lock_guard<mutex> l(_mutex);
-
-	if ( _file.is_open() ) {
-		while ( !_closeRequested ) {
-			Seiscomp::IO::MSeedRecord *rec = new Seiscomp::IO::MSeedRecord(_dataType, _hint);
-
-			try {
-				rec->read(_file);
-				if ( rec->startTime() > _curidx->etime ) {
-					delete rec;
-					break;
-				}
-
-				return rec;
-			}
-			catch ( EndOfStreamException &e ) {
-				// EOF for this file, do nothing
-				delete rec;
-				SEISCOMP_DEBUG("exc: %s", e.what());
-				break;
-			}
-			catch( exception &e ) {
-				// Invalid record, delete it
-				delete rec;
-				SEISCOMP_ERROR("exc: %d, %s", (int)_file.tellg(), e.what());
-				if ( !_file.good() )
-					break;
-			}
-		}
-
-		_file.close();
-	}
-	else {
-		_curiter = _orderedRequests.begin();
-	}
-
+bool SDSArchive::openNextFile() {
 	while ( !_fnames.empty() || _curiter != _orderedRequests.end() ) {
 		while ( _fnames.empty() && _curiter != _orderedRequests.end() ) {
 			if ( !_etime )
@@ -811,61 +775,134 @@ Seiscomp::Record *SDSArchive::next() {
 			}
 		}
 
-		if ( !_fnames.empty() ) {
-			while ( !_fnames.empty() ) {
-				File file = _fnames.front();
-				_fnames.pop();
+		while ( !_fnames.empty() ) {
+			File file = _fnames.front();
+			_fnames.pop();
 
-				_file.open(file.first.c_str(), ifstream::in | ifstream::binary);
-				if ( !_file.is_open() ) {
-					SEISCOMP_DEBUG("R %s (not found)",file.first.c_str());
-					_file.clear();
-				}
-				else {
-					SEISCOMP_DEBUG("R %s (first: %d)",file.first.c_str(), file.second);
-					// File part of start time
-					if ( file.second ) {
-						if ( !setStart(file.first, true) ) {
-							if ( !setStart(file.first, false) ) {
-								SEISCOMP_WARNING("Error reading file %s; start of time window maybe incorrect",
-								                 file.first.c_str());
-								_file.close();
-								continue;
-							}
-						}
-					}
+			_file.open(file.first.c_str(), ifstream::in | ifstream::binary);
+			if ( !_file.is_open() ) {
+				SEISCOMP_DEBUG("R %s (not found)",file.first.c_str());
+				_file.clear();
+				continue;
+			}
 
-					while ( !_closeRequested ) {
-						Seiscomp::IO::MSeedRecord *rec = new Seiscomp::IO::MSeedRecord(_dataType, _hint);
-						try {
-							rec->read(_file);
-							if ( rec->startTime() > _curidx->etime ) {
-								delete rec;
-								break;
-							}
-
-							return rec;
-						}
-						catch ( EndOfStreamException &e ) {
-							delete rec;
-							SEISCOMP_DEBUG("exc: %s", e.what());
-							// EOF for this file, do nothing
-							break;
-						}
-						catch( exception &e ) {
-							delete rec;
-							SEISCOMP_ERROR("exc: %d, %s", (int)_file.tellg(), e.what());
-							if ( !_file.good() )
-								break;
-						}
+			SEISCOMP_DEBUG("R %s (first: %d)",file.first.c_str(), file.second);
+			// File part of start time
+			if ( file.second ) {
+				if ( !setStart(file.first, true) ) {
+					if ( !setStart(file.first, false) ) {
+						SEISCOMP_WARNING("Error reading file %s; start of time window maybe incorrect",
+						                 file.first.c_str());
+						_file.close();
+						continue;
 					}
-
-					_file.close();
 				}
 			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Seiscomp::Record *SDSArchive::readRecord() {
+	while ( !_closeRequested ) {
+		Seiscomp::IO::MSeedRecord *rec = new Seiscomp::IO::MSeedRecord(_dataType, _hint);
+
+		try {
+			rec->read(_file);
+			if ( rec->startTime() > _curidx->etime ) {
+				delete rec;
+				break;
+			}
+
+			return rec;
+		}
+		catch ( EndOfStreamException &e ) {
+			// EOF for this file, do nothing
+			delete rec;
+			SEISCOMP_DEBUG("exc: %s", e.what());
+			break;
+		}
+		catch( exception &e ) {
+			// Invalid record, delete it
+			delete rec;
+			SEISCOMP_ERROR("exc: %d, %s", (int)_file.tellg(), e.what());
+			if ( !_file.good() )
+				break;
 		}
 	}
 
+	return nullptr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool SDSArchive::readRawRecord(std::vector<char> &data) {
+	IO::MSeedRawHeader header;
+
+	while ( !_closeRequested ) {
+		try {
+			IO::MSeedRecord::ReadRaw(_file, data);
+			if ( !IO::MSeedRecord::ParseRawHeader(data.data(), data.size(), header) ) {
+				SEISCOMP_ERROR("exc: %d, invalid Mini SEED header", (int)_file.tellg());
+				continue;
+			}
+
+			if ( header.startTime > _curidx->etime ) {
+				break;
+			}
+
+			return true;
+		}
+		catch ( EndOfStreamException &e ) {
+			// EOF for this file, do nothing
+			SEISCOMP_DEBUG("exc: %s", e.what());
+			break;
+		}
+		catch( exception &e ) {
+			SEISCOMP_ERROR("exc: %d, %s", (int)_file.tellg(), e.what());
+			if ( !_file.good() )
+				break;
+		}
+	}
+
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Seiscomp::Record *SDSArchive::next() {
+	lock_guard<mutex> l(_mutex);
+
+	if ( !_file.is_open() ) {
+		_curiter = _orderedRequests.begin();
+	}
+
+	do {
+		if ( _file.is_open() ) {
+			Seiscomp::Record *rec = readRecord();
+			if ( rec ) {
+				return rec;
+			}
+
+			_file.close();
+		}
+	}
+	while ( openNextFile() );
+
 	SEISCOMP_DEBUG("[sds] end of data");
 	return nullptr;
 }
@@ -874,4 +911,31 @@ Seiscomp::Record *SDSArchive::next() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool SDSArchive::nextRaw(std::vector<char> &data) {
+	lock_guard<mutex> l(_mutex);
+
+	if ( !_file.is_open() ) {
+		_curiter = _orderedRequests.begin();
+	}
+
+	do {
+		if ( _file.is_open() ) {
+			if ( readRawRecord(data) ) {
+				return true;
+			}
+
+			_file.close();
+		}
+	}
+	while ( openNextFile() );
+
+	SEISCOMP_DEBUG("[sds] end of data");
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
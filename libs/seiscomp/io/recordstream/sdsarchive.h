@@ -79,6 +79,10 @@ class SDSArchive : public Seiscomp::IO::RecordStream {
 
 		Record *next() override;
 
+		//! Reads the raw miniSEED records from the files and only parses
+		//! the fixed header to check the end of the time window.
+		bool nextRaw(std::vector<char> &data) override;
+
 
 	// ----------------------------------------------------------------------
 	//  Implementation
@@ -129,6 +133,9 @@ class SDSArchive : public Seiscomp::IO::RecordStream {
 		int getDoy(const Seiscomp::Core::Time &time);
 		void resolveRequest();
 		bool setStart(const std::string &fname, bool bsearch);
+		bool openNextFile();
+		Record *readRecord();
+		bool readRawRecord(std::vector<char> &data);
 
 		bool resolveNet(std::string &path,
 		                const std::string &net, const std::string &sta,
@@ -63,6 +63,39 @@ int streamBufCloseCallback(void* context) {
 }
 
 
+/**
+ * Returns whether the handler can process the child element by its name
+ * only. This holds for generic type lookups and for child objects of a
+ * class while plain members need the element content.
+ */
+bool isObjectElement(NodeHandler *handler, xmlNodePtr child) {
+	if ( dynamic_cast<GenericHandler*>(handler) ) {
+		return true;
+	}
+
+	ClassHandler *classHandler = dynamic_cast<ClassHandler*>(handler);
+	if ( classHandler == nullptr ) {
+		return false;
+	}
+
+	for ( auto &member : classHandler->elements ) {
+		if ( !member.tag.empty()
+		  && classHandler->equalsTag(child, member.tag.c_str(), member.nameSpace.c_str()) ) {
+			return false;
+		}
+	}
+
+	for ( auto &member : classHandler->childs ) {
+		if ( !member.tag.empty()
+		  && classHandler->equalsTag(child, member.tag.c_str(), member.nameSpace.c_str()) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -80,6 +113,7 @@ NoneHandler Importer::_none;
 Importer::Importer() {
 	_typemap = nullptr;
 	_strictNamespaceCheck = true;
+	_streaming = true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -113,6 +147,15 @@ void Importer::setStrictNamespaceCheck(bool e) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Importer::setStreamingEnabled(bool e) {
+	_streaming = e;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Importer::setRootName(std::string h) {
 	_headerNode = h;
@@ -128,6 +171,11 @@ Core::BaseObject *Importer::get(std::streambuf* buf) {
 	if ( buf == nullptr ) return nullptr;
 
 	_result = nullptr;
+	_any.mapper = _typemap;
+
+	if ( _streaming ) {
+		return stream(buf);
+	}
 
 	xmlDocPtr doc;
 	doc = xmlReadIO(streamBufReadCallback,
@@ -143,8 +191,6 @@ Core::BaseObject *Importer::get(std::streambuf* buf) {
 		return nullptr;
 	}
 
-	_any.mapper = _typemap;
-
 	bool saveStrictNsCheck = NodeHandler::strictNsCheck;
 
 	if ( !_headerNode.empty() ) {
@@ -176,9 +222,85 @@ Core::BaseObject *Importer::get(std::streambuf* buf) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::BaseObject *Importer::stream(std::streambuf* buf) {
+	xmlTextReaderPtr reader;
+	reader = xmlReaderForIO(streamBufReadCallback,
+	                        streamBufCloseCallback,
+	                        buf, nullptr, nullptr, XML_PARSE_BIG_LINES);
+
+	if ( reader == nullptr )
+		return nullptr;
+
+	// Move to the root element
+	int ret;
+	while ( (ret = xmlTextReaderRead(reader)) == 1 ) {
+		if ( xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT )
+			break;
+	}
+
+	if ( ret != 1 ) {
+		xmlFreeTextReader(reader);
+		return nullptr;
+	}
+
+	xmlNodePtr cur = xmlTextReaderCurrentNode(reader);
+
+	if ( !_headerNode.empty()
+	  && xmlStrcmp(cur->name, (const xmlChar*)_headerNode.c_str()) ) {
+		SEISCOMP_WARNING("Invalid root tag: %s, expected: %s",
+		                 reinterpret_cast<const char*>(cur->name),
+		                 _headerNode.c_str());
+		xmlFreeTextReader(reader);
+		return nullptr;
+	}
+
+	bool saveStrictNsCheck = NodeHandler::strictNsCheck;
+	NodeHandler::strictNsCheck = _strictNamespaceCheck;
+
+	try {
+		if ( !_headerNode.empty() ) {
+			_hasErrors = traverseStream(&_any, reader, nullptr) == false;
+		}
+		else {
+			ChildList remaining;
+			TagSet mandatory;
+
+			_any.init(nullptr, nullptr, mandatory);
+			bool result = visit(&_any, nullptr, cur, nullptr, remaining, mandatory, reader);
+			_hasErrors = (finish(&_any, nullptr, nullptr, remaining, mandatory) && result) == false;
+		}
+	}
+	catch ( ... ) {
+		NodeHandler::strictNsCheck = saveStrictNsCheck;
+		xmlFreeTextReader(reader);
+		throw;
+	}
+
+	NodeHandler::strictNsCheck = saveStrictNsCheck;
+
+	// Consume the rest of the document to catch syntax errors as
+	// the DOM parser would do
+	while ( (ret = xmlTextReaderRead(reader)) == 1 );
+
+	xmlFreeTextReader(reader);
+
+	if ( ret < 0 ) {
+		if ( _result ) {
+			delete _result;
+			_result = nullptr;
+		}
+	}
+
+	return _result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool Importer::traverse(NodeHandler *handler, void *n, void *c, Core::BaseObject *target) {
-	xmlNodePtr node = reinterpret_cast<xmlNodePtr>(n);
 	xmlNodePtr childs = reinterpret_cast<xmlNodePtr>(c);
 	ChildList remaining;
 	TagSet mandatory;
@@ -192,112 +314,219 @@ bool Importer::traverse(NodeHandler *handler, void *n, void *c, Core::BaseObject
 			continue;
 		}
 
-		handler->propagate(nullptr, false, true);
+		if ( !visit(handler, n, child, target, remaining, mandatory, nullptr) )
+			result = false;
+	}
 
-		try {
-			handler->get(target, child);
-		}
-		catch ( std::exception &e ) {
-			if ( handler->isOptional ) {
-				SEISCOMP_WARNING("L%ld: (optional) %s.%s: %s",
-				                 xmlGetLineNo(node),
-				                 reinterpret_cast<const char*>(node->name),
-				                 reinterpret_cast<const char*>(child->name),
-				                 e.what());
+	return finish(handler, n, target, remaining, mandatory) && result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Importer::traverseStream(NodeHandler *handler, void *r, Core::BaseObject *target) {
+	xmlTextReaderPtr reader = reinterpret_cast<xmlTextReaderPtr>(r);
+	xmlNodePtr node = xmlTextReaderCurrentNode(reader);
+	ChildList remaining;
+	TagSet mandatory;
+
+	handler->init(target, node, mandatory);
+
+	bool result = true;
+
+	if ( !xmlTextReaderIsEmptyElement(reader) ) {
+		int depth = xmlTextReaderDepth(reader);
+		int ret = xmlTextReaderRead(reader);
+
+		while ( ret == 1 && xmlTextReaderDepth(reader) > depth ) {
+			if ( xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT ) {
+				ret = xmlTextReaderRead(reader);
+				continue;
+			}
+
+			xmlNodePtr child = xmlTextReaderCurrentNode(reader);
+
+			if ( isObjectElement(handler, child) ) {
+				if ( !visit(handler, node, child, target, remaining, mandatory, reader) )
+					result = false;
 			}
 			else {
-				throw e;
+				// Plain members need their content. Expand the element
+				// which is released again when the reader moves on.
+				child = xmlTextReaderExpand(reader);
+				if ( child == nullptr ) {
+					ret = -1;
+					break;
+				}
+
+				if ( !visit(handler, node, child, target, remaining, mandatory, nullptr) )
+					result = false;
 			}
+
+			if ( xmlTextReaderReadState(reader) == XML_TEXTREADER_MODE_ERROR ) {
+				ret = -1;
+				break;
+			}
+
+			ret = xmlTextReaderNext(reader);
 		}
 
-		if ( !handler->isOptional )
-			mandatory.erase((const char*)child->name);
+		if ( ret < 0 )
+			result = false;
+	}
 
-		if ( handler->object == nullptr && handler->isAnyType ) {
-			if ( _any.get(target, child) ) {
-				handler->object = _any.object;
-				handler->childHandler = _any.childHandler;
-				handler->newInstance = _any.newInstance;
-			}
+	return finish(handler, node, target, remaining, mandatory) && result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Importer::visit(NodeHandler *handler, void *n, void *c,
+                     Core::BaseObject *target, ChildList &remaining,
+                     TagSet &mandatory, void *reader) {
+	xmlNodePtr node = reinterpret_cast<xmlNodePtr>(n);
+	xmlNodePtr child = reinterpret_cast<xmlNodePtr>(c);
+	bool result = true;
+
+	handler->propagate(nullptr, false, true);
+
+	try {
+		handler->get(target, child);
+	}
+	catch ( std::exception &e ) {
+		if ( handler->isOptional ) {
+			SEISCOMP_WARNING("L%ld: (optional) %s.%s: %s",
+			                 xmlGetLineNo(node),
+			                 reinterpret_cast<const char*>(node->name),
+			                 reinterpret_cast<const char*>(child->name),
+			                 e.what());
+		}
+		else {
+			throw e;
 		}
+	}
 
-		Core::BaseObject *newTarget = handler->object;
-		MemberNodeHandler *memberHandler = handler->memberHandler;
-		NodeHandler *childHandler = handler->childHandler;
-		bool newInstance = handler->newInstance;
-		bool optional = handler->isOptional;
+	if ( !handler->isOptional )
+		mandatory.erase((const char*)child->name);
 
-		if ( newTarget ) {
+	if ( handler->object == nullptr && handler->isAnyType ) {
+		if ( _any.get(target, child) ) {
+			handler->object = _any.object;
+			handler->childHandler = _any.childHandler;
+			handler->newInstance = _any.newInstance;
+		}
+	}
+
+	Core::BaseObject *newTarget = handler->object;
+	MemberNodeHandler *memberHandler = handler->memberHandler;
+	NodeHandler *childHandler = handler->childHandler;
+	bool newInstance = handler->newInstance;
+	bool optional = handler->isOptional;
+
+	if ( newTarget ) {
+		if ( childHandler == nullptr ) {
+			childHandler = _typemap->getHandler(newTarget->className());
 			if ( childHandler == nullptr ) {
-				childHandler = _typemap->getHandler(newTarget->className());
-				if ( childHandler == nullptr ) {
-					SEISCOMP_WARNING("No class handler for %s", newTarget->className());
-					if ( newInstance )
-						delete newTarget;
-					handler->object = nullptr;
-					newTarget = nullptr;
-					childHandler = &_none;
-				}
+				SEISCOMP_WARNING("No class handler for %s", newTarget->className());
+				if ( newInstance )
+					delete newTarget;
+				handler->object = nullptr;
+				newTarget = nullptr;
+				childHandler = &_none;
 			}
 		}
-		else
-			childHandler = &_none;
+	}
+	else
+		childHandler = &_none;
 
-		try {
-			if ( traverse(childHandler, child, child->children, handler->object) ) {
-				if ( newTarget && newInstance && !memberHandler )
-					remaining.push_back(newTarget);
+	try {
+		bool valid;
 
+		if ( reader == nullptr ) {
+			valid = traverse(childHandler, child, child->children, handler->object);
+		}
+		else {
+			ClassHandler *classHandler = dynamic_cast<ClassHandler*>(childHandler);
+			if ( classHandler && !classHandler->cdataUsed ) {
+				valid = traverseStream(childHandler, reader, handler->object);
 			}
 			else {
-				if ( newTarget && newInstance )
-					delete newTarget;
-				newTarget = nullptr;
-				if ( optional )
-					SEISCOMP_INFO("L%ld: Invalid %s element: ignoring",
-					              xmlGetLineNo(child),
-					              reinterpret_cast<const char*>(child->name));
-				else {
-					SEISCOMP_WARNING("L%ld: %s is not optional within %s",
-					                 xmlGetLineNo(child),
-					                 reinterpret_cast<const char*>(child->name),
-					                 reinterpret_cast<const char*>(node->name));
-					result = false;
-				}
+				child = xmlTextReaderExpand(reinterpret_cast<xmlTextReaderPtr>(reader));
+				valid = child && traverse(childHandler, child, child->children, handler->object);
+				if ( child == nullptr ) child = reinterpret_cast<xmlNodePtr>(c);
 			}
 		}
-		catch ( std::exception &e ) {
-			SEISCOMP_WARNING("L%ld: %s: %s", xmlGetLineNo(child),
-			                 reinterpret_cast<const char*>(child->name), e.what());
-			if ( newTarget ) {
-				if ( newInstance )
-					delete newTarget;
 
-				if ( !optional ) {
-					SEISCOMP_WARNING("L%ld: %s is not optional within %s",
-					                 xmlGetLineNo(child),
-					                 reinterpret_cast<const char*>(child->name),
-					                 reinterpret_cast<const char*>(node->name));
-					result = false;
-				}
-				else
-					SEISCOMP_WARNING("L%ld: %s: ignoring optional member %s: invalid",
-					                 xmlGetLineNo(child),
-					                 reinterpret_cast<const char*>(node->name),
-					                 reinterpret_cast<const char*>(child->name));
+		if ( valid ) {
+			if ( newTarget && newInstance && !memberHandler )
+				remaining.push_back(newTarget);
 
-				newTarget = nullptr;
+		}
+		else {
+			if ( newTarget && newInstance )
+				delete newTarget;
+			newTarget = nullptr;
+			if ( optional )
+				SEISCOMP_INFO("L%ld: Invalid %s element: ignoring",
+				              xmlGetLineNo(child),
+				              reinterpret_cast<const char*>(child->name));
+			else {
+				SEISCOMP_WARNING("L%ld: %s is not optional within %s",
+				                 xmlGetLineNo(child),
+				                 reinterpret_cast<const char*>(child->name),
+				                 reinterpret_cast<const char*>(node->name));
+				result = false;
 			}
 		}
+	}
+	catch ( std::exception &e ) {
+		SEISCOMP_WARNING("L%ld: %s: %s", xmlGetLineNo(child),
+		                 reinterpret_cast<const char*>(child->name), e.what());
+		if ( newTarget ) {
+			if ( newInstance )
+				delete newTarget;
 
-		if ( memberHandler ) {
-			if ( !memberHandler->finalize(target, newTarget) ) {
-				if ( newTarget && newInstance )
-					remaining.push_back(newTarget);
+			if ( !optional ) {
+				SEISCOMP_WARNING("L%ld: %s is not optional within %s",
+				                 xmlGetLineNo(child),
+				                 reinterpret_cast<const char*>(child->name),
+				                 reinterpret_cast<const char*>(node->name));
+				result = false;
 			}
+			else
+				SEISCOMP_WARNING("L%ld: %s: ignoring optional member %s: invalid",
+				                 xmlGetLineNo(child),
+				                 reinterpret_cast<const char*>(node->name),
+				                 reinterpret_cast<const char*>(child->name));
+
+			newTarget = nullptr;
 		}
 	}
 
+	if ( memberHandler ) {
+		if ( !memberHandler->finalize(target, newTarget) ) {
+			if ( newTarget && newInstance )
+				remaining.push_back(newTarget);
+		}
+	}
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Importer::finish(NodeHandler *handler, void *n,
+                      Core::BaseObject *target, ChildList &remaining,
+                      TagSet &mandatory) {
+	xmlNodePtr node = reinterpret_cast<xmlNodePtr>(n);
+
 	handler->finalize(target, &remaining);
 
 	if ( target ) {
@@ -333,7 +562,7 @@ bool Importer::traverse(NodeHandler *handler, void *n, void *c, Core::BaseObject
 		return false;
 	}
 
-	return result;
+	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -54,6 +54,14 @@ class SC_SYSTEM_CORE_API Importer : public IO::Importer {
 		//! multiple namespaces will still fail.
 		void setStrictNamespaceCheck(bool);
 
+		//! Enables/disables streaming import which is enabled by default.
+		//! If enabled, the document is not parsed into a complete DOM
+		//! tree. Instead each child object is materialized while it is
+		//! read and only elements holding plain members are expanded.
+		//! This bounds the memory to the objects created and the largest
+		//! leaf element rather than the whole document.
+		void setStreamingEnabled(bool);
+
 	// ----------------------------------------------------------------------
 	// Protected Inteface
 	// ----------------------------------------------------------------------
@@ -71,15 +79,33 @@ class SC_SYSTEM_CORE_API Importer : public IO::Importer {
 	//  Private interface
 	// ------------------------------------------------------------------
 	private:
+		Core::BaseObject *stream(std::streambuf* buf);
+
 		bool traverse(NodeHandler *handler,
 		              void *node, void *childs,
 		              Core::BaseObject *target);
 
+		//! Traverses the element the reader is positioned at. Returns
+		//! with the reader positioned at the end of the element.
+		bool traverseStream(NodeHandler *handler, void *reader,
+		                    Core::BaseObject *target);
+
+		//! Handles a single child element of node. If reader is set,
+		//! child is the unexpanded element the reader is positioned at.
+		bool visit(NodeHandler *handler, void *node, void *child,
+		           Core::BaseObject *target, ChildList &remaining,
+		           TagSet &mandatory, void *reader);
+
+		bool finish(NodeHandler *handler, void *node,
+		            Core::BaseObject *target, ChildList &remaining,
+		            TagSet &mandatory);
+
 
 	private:
 		static NoneHandler _none;
 		GenericHandler _any;
 		bool _strictNamespaceCheck;
+		bool _streaming;
 
 		Core::BaseObject *_result;
 		std::string _headerNode;
@@ -22,9 +22,17 @@
 
 #include <seiscomp/logging/file.h>
 
-#include <cstdarg>
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -35,6 +43,353 @@ namespace Logging {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+// Appends "YYYY/MM/DD hh:mm:ss " to a line. The formatted time is cached
+// per thread because consecutive messages usually share the same second.
+void appendTime(std::string &line, time_t time, bool utc) {
+	thread_local time_t lastTime = -1;
+	thread_local bool lastUTC = false;
+	thread_local char formatted[32];
+	thread_local int length = 0;
+
+	if ( time != lastTime || utc != lastUTC ) {
+		tm t;
+		if ( utc )
+			gmtime_r(&time, &t);
+		else
+			localtime_r(&time, &t);
+
+		length = snprintf(formatted, sizeof(formatted),
+		                  "%d/%02d/%02d %02d:%02d:%02d ",
+		                  t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
+		                  t.tm_hour, t.tm_min, t.tm_sec);
+		if ( length < 0 ) length = 0;
+		lastTime = time;
+		lastUTC = utc;
+	}
+
+	line.append(formatted, length);
+}
+
+
+// Single producer single consumer byte ring holding the log lines of
+// one thread. Each record is a header followed by the line, padded to
+// eight bytes. Records never wrap, the producer skips the remainder of
+// the buffer instead.
+class Ring {
+	public:
+		struct Header {
+			uint64_t sequence;
+			int64_t  time;
+			uint32_t size;
+			uint32_t skip;
+		};
+
+	public:
+		explicit Ring(size_t capacity)
+		: _buffer(capacity), _mask(capacity - 1) {}
+
+		size_t capacity() const { return _buffer.size(); }
+
+		bool push(uint64_t sequence, time_t time, const char *data, size_t size) {
+			size_t need = padded(sizeof(Header) + size);
+			size_t head = _head.load(std::memory_order_relaxed);
+			size_t tail = _tail.load(std::memory_order_acquire);
+			size_t pos = head & _mask;
+			size_t toEnd = _buffer.size() - pos;
+			size_t pad = toEnd < need ? toEnd : 0;
+
+			if ( head + pad + need - tail > _buffer.size() ) {
+				return false;
+			}
+
+			if ( pad ) {
+				if ( toEnd >= sizeof(Header) ) {
+					Header h{0, 0, 0, 1};
+					memcpy(&_buffer[pos], &h, sizeof(h));
+				}
+				head += pad;
+				pos = 0;
+			}
+
+			Header h{sequence, static_cast<int64_t>(time), static_cast<uint32_t>(size), 0};
+			memcpy(&_buffer[pos], &h, sizeof(h));
+			memcpy(&_buffer[pos + sizeof(h)], data, size);
+			_head.store(head + need, std::memory_order_release);
+			return true;
+		}
+
+		// Returns the next record or nullptr if the ring is empty
+		const Header *front() {
+			size_t tail = _tail.load(std::memory_order_relaxed);
+
+			while ( tail != _head.load(std::memory_order_acquire) ) {
+				size_t pos = tail & _mask;
+				size_t toEnd = _buffer.size() - pos;
+				if ( toEnd >= sizeof(Header) ) {
+					const Header *h = reinterpret_cast<const Header*>(&_buffer[pos]);
+					if ( !h->skip ) {
+						return h;
+					}
+				}
+
+				tail += toEnd;
+				_tail.store(tail, std::memory_order_release);
+			}
+
+			return nullptr;
+		}
+
+		void pop(const Header *h) {
+			_tail.store(_tail.load(std::memory_order_relaxed)
+			          + padded(sizeof(Header) + h->size),
+			            std::memory_order_release);
+		}
+
+		static size_t padded(size_t size) {
+			return (size + 7) & ~size_t(7);
+		}
+
+		// Called by the producer when its thread exits. No record is
+		// pushed afterwards and the consumer may release the ring once
+		// it is empty.
+		void orphan() { _orphaned.store(true, std::memory_order_release); }
+		bool orphaned() const { return _orphaned.load(std::memory_order_acquire); }
+
+	private:
+		std::vector<char>              _buffer;
+		size_t                         _mask;
+		alignas(64) std::atomic<size_t> _head{0};
+		alignas(64) std::atomic<size_t> _tail{0};
+		std::atomic<bool>              _orphaned{false};
+};
+
+
+struct ThreadRing {
+	uint64_t           writer;
+	// Only used by the writer's push() which implies that the writer and
+	// therefore the ring are alive
+	Ring              *ring;
+	std::weak_ptr<Ring> owner;
+};
+
+
+// The rings of the current thread, one per writer. When the thread exits
+// its rings are handed over to their writers for removal.
+struct ThreadRings : std::vector<ThreadRing> {
+	~ThreadRings() {
+		for ( const ThreadRing &tr : *this ) {
+			auto ring = tr.owner.lock();
+			if ( ring ) {
+				ring->orphan();
+			}
+		}
+	}
+};
+
+
+// Writers are identified by a unique id rather than by their address
+// which can be reused
+std::atomic<uint64_t> writerIds{0};
+thread_local ThreadRings threadRings;
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+struct FileOutput::AsyncWriter {
+	AsyncWriter(FileOutput *output, size_t bufferSize, OverflowPolicy policy)
+	: output(output), id(++writerIds), policy(policy) {
+		// The ring capacity must be a power of two
+		capacity = 4096;
+		while ( capacity < bufferSize ) capacity <<= 1;
+		thread = std::thread(&AsyncWriter::run, this);
+	}
+
+	~AsyncWriter() {
+		stop = true;
+		wake.notify_one();
+		thread.join();
+	}
+
+	Ring *threadRing() {
+		for ( const ThreadRing &tr : threadRings ) {
+			if ( tr.writer == id ) {
+				return tr.ring;
+			}
+		}
+
+		// First message of this thread. The ring is kept until the thread
+		// exits and the writer has written its remaining lines or until
+		// the writer is destroyed. Entries of destroyed writers are
+		// dropped on the way.
+		threadRings.erase(
+			std::remove_if(threadRings.begin(), threadRings.end(),
+			               [](const ThreadRing &tr) { return tr.owner.expired(); }),
+			threadRings.end()
+		);
+
+		auto ring = std::make_shared<Ring>(capacity);
+		threadRings.push_back({id, ring.get(), ring});
+
+		std::lock_guard<std::mutex> l(ringsMutex);
+		rings.push_back(std::move(ring));
+		return rings.back().get();
+	}
+
+	void push(time_t time, const char *data, size_t size) {
+		Ring *ring = threadRing();
+
+		// Truncate lines which can never fit
+		size_t maxSize = ring->capacity() / 2 - sizeof(Ring::Header);
+		if ( size > maxSize ) {
+			size = maxSize;
+		}
+
+		uint64_t seq = sequence.fetch_add(1, std::memory_order_relaxed);
+
+		while ( !ring->push(seq, time, data, size) ) {
+			if ( policy == OverflowPolicy::Drop || stop ) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			wake.notify_one();
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		if ( sleeping.load(std::memory_order_relaxed) ) {
+			wake.notify_one();
+		}
+	}
+
+	// Writes all pending lines of all threads in sequence order
+	bool drain() {
+		{
+			std::lock_guard<std::mutex> l(ringsMutex);
+			active.clear();
+			for ( auto it = rings.begin(); it != rings.end(); ) {
+				// The orphaned flag must be read before the ring is checked
+				// for remaining lines
+				if ( (*it)->orphaned() && !(*it)->front() ) {
+					it = rings.erase(it);
+					continue;
+				}
+
+				active.push_back(it->get());
+				++it;
+			}
+		}
+
+		bool written = false;
+
+		for ( ;; ) {
+			Ring *next = nullptr;
+			const Ring::Header *nextHeader = nullptr;
+
+			// A line is only written if a complete pass over all rings
+			// after it has been found reveals no earlier line. A thread
+			// takes its sequence number before pushing the line, so a
+			// single pass can miss the earlier line of another thread
+			// which was logged before the candidate.
+			for ( bool changed = true; changed; ) {
+				changed = false;
+				for ( Ring *ring : active ) {
+					const Ring::Header *h = ring->front();
+					if ( h && (!nextHeader || h->sequence < nextHeader->sequence) ) {
+						next = ring;
+						nextHeader = h;
+						changed = true;
+					}
+				}
+			}
+
+			if ( !next ) {
+				break;
+			}
+
+			output->write(reinterpret_cast<const char*>(nextHeader + 1),
+			              nextHeader->size, nextHeader->time, false);
+			next->pop(nextHeader);
+			written = true;
+		}
+
+		size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+		if ( lost ) {
+			time_t now = ::time(nullptr);
+			std::string line;
+			appendTime(line, now, output->_useUTC);
+			line += "[warning/log] ";
+			line += std::to_string(lost);
+			line += " log messages dropped due to full buffers\n";
+			output->write(line.data(), line.size(), now, false);
+			written = true;
+		}
+
+		if ( written ) {
+			output->_stream.flush();
+		}
+
+		return written;
+	}
+
+	bool pending() {
+		std::lock_guard<std::mutex> l(ringsMutex);
+		for ( const auto &ring : rings ) {
+			if ( ring->front() ) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void run() {
+		while ( !stop ) {
+			if ( drain() ) {
+				continue;
+			}
+
+			std::unique_lock<std::mutex> l(wakeMutex);
+			sleeping = true;
+			if ( !stop && !pending() ) {
+				wake.wait_for(l, std::chrono::milliseconds(100));
+			}
+			sleeping = false;
+		}
+
+		drain();
+	}
+
+	FileOutput                        *output;
+	const uint64_t                     id;
+	const OverflowPolicy               policy;
+	size_t                             capacity;
+
+	std::mutex                         ringsMutex;
+	std::vector<std::shared_ptr<Ring>> rings;
+	std::vector<Ring*>                 active;
+
+	std::atomic<uint64_t>              sequence{0};
+	std::atomic<size_t>                dropped{0};
+	std::atomic<bool>                  sleeping{false};
+	std::atomic<bool>                  stop{false};
+	std::mutex                         wakeMutex;
+	std::condition_variable            wake;
+	std::thread                        thread;
+};
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 FileOutput::FileOutput()
  : _stream() {
@@ -55,6 +410,7 @@ FileOutput::FileOutput(const char* filename)
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 FileOutput::~FileOutput() {
+	_async.reset();
 	_stream.close();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -82,37 +438,76 @@ bool FileOutput::isOpen() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FileOutput::setAsync(bool enable, size_t bufferSize, OverflowPolicy policy) {
+	// Stop a running writer first which writes all pending lines
+	_async.reset();
+
+	if ( enable ) {
+		_async.reset(new AsyncWriter(this, bufferSize, policy));
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool FileOutput::isAsync() const {
+	return static_cast<bool>(_async);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void FileOutput::log(const char* channelName,
                      LogLevel level,
                      const char* msg,
                      time_t time) {
-	tm currentTime;
-
-	currentTime = _useUTC ? *gmtime(&time) : *localtime(&time);
-
-	_stream << (currentTime.tm_year + 1900) << "/";
-
-	int w = _stream.width();
-	char f = _stream.fill();
+	thread_local std::string line;
+
+	line.clear();
+	appendTime(line, time, _useUTC);
+
+	line += '[';
+	line += channelName;
+	if ( likely(_logComponent) ) {
+		line += '/';
+		line += component();
+	}
+	line += "] ";
+	if ( unlikely(_logContext) ) {
+		char lineNumber[16];
+		snprintf(lineNumber, sizeof(lineNumber), "%d", lineNum());
+		line += '(';
+		line += fileName();
+		line += ':';
+		line += lineNumber;
+		line += ") ";
+	}
+	line += msg;
+	line += '\n';
+
+	if ( _async ) {
+		_async->push(time, line.data(), line.size());
+	}
+	else {
+		write(line.data(), line.size(), time, true);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
-	_stream << std::setfill('0') << std::setw(2) << (currentTime.tm_mon + 1) << "/"
-	        << std::setfill('0') << std::setw(2) << currentTime.tm_mday << " ";
 
-	_stream << std::setfill('0') << std::setw(2) << currentTime.tm_hour << ":"
-	        << std::setfill('0') << std::setw(2) << currentTime.tm_min << ":"
-	        << std::setfill('0') << std::setw(2) << currentTime.tm_sec << " ";
 
-	_stream.width(w);
-	_stream.fill(f);
 
-	_stream << "[" << channelName;
-	if ( likely(_logComponent) )
-		_stream << "/" << component();
-	_stream << "] ";
-	if ( unlikely(_logContext) )
-		_stream << "(" << fileName() << ':' << lineNum() << ") ";
-	_stream << msg << std::endl;
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FileOutput::write(const char *data, size_t size, time_t, bool flush) {
+	_stream.write(data, size);
+	if ( flush ) {
+		_stream.flush();
+	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
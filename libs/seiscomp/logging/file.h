@@ -23,6 +23,7 @@
 
 #include <seiscomp/logging/output.h>
 #include <fstream>
+#include <memory>
 
 
 namespace Seiscomp {
@@ -30,6 +31,17 @@ namespace Logging {
 
 
 class SC_SYSTEM_CORE_API FileOutput : public Output {
+	public:
+		//! What to do with a message if the buffer of a thread is full
+		//! in asynchronous mode
+		enum class OverflowPolicy {
+			//! Discard the message and report the number of discarded
+			//! messages in the log
+			Drop,
+			//! Wait until the writer has made space
+			Block
+		};
+
 	public:
 		FileOutput();
 		FileOutput(const char* filename);
@@ -38,6 +50,29 @@ class SC_SYSTEM_CORE_API FileOutput : public Output {
 		virtual bool open(const char* filename);
 		bool isOpen();
 
+		/**
+		 * @brief Enables or disables asynchronous output.
+		 *
+		 * In asynchronous mode the logging thread formats the message and
+		 * pushes it into a lock-free buffer owned by that thread. A
+		 * background thread collects the messages of all threads and
+		 * writes them in batches followed by a single flush. Messages of
+		 * one thread keep their order, as do messages of different threads
+		 * if one was logged before the other started. Concurrent messages
+		 * can appear in either order. The buffer of a thread is released
+		 * after the thread has exited and its messages have been written.
+		 * Disabling asynchronous mode writes all pending messages and stops
+		 * the background thread.
+		 *
+		 * @param enable Whether to enable asynchronous output
+		 * @param bufferSize The size of the buffer of each logging thread
+		 *                   in bytes
+		 * @param policy The policy if a buffer is full
+		 */
+		void setAsync(bool enable, size_t bufferSize = 1024*1024,
+		              OverflowPolicy policy = OverflowPolicy::Drop);
+		bool isAsync() const;
+
 	protected:
 		/** Callback method for receiving log messages */
 		void log(const char* channelName,
@@ -45,9 +80,27 @@ class SC_SYSTEM_CORE_API FileOutput : public Output {
 		         const char* msg,
 		         time_t time) override;
 
+		/**
+		 * @brief Writes a formatted log line to the stream. It is called
+		 *        from the logging thread in synchronous mode and from
+		 *        the writer thread in asynchronous mode. Derived classes
+		 *        which override this method must disable asynchronous
+		 *        mode in their destructor.
+		 * @param data The line including the trailing newline
+		 * @param size The length of the line
+		 * @param time The time of the log message
+		 * @param flush Whether to flush the stream after writing. The
+		 *              writer thread flushes once after each batch.
+		 */
+		virtual void write(const char *data, size_t size, time_t time,
+		                   bool flush);
+
 	protected:
+		struct AsyncWriter;
+
 		std::string _filename;
 		mutable std::ofstream _stream;
+		std::unique_ptr<AsyncWriter> _async;
 };
 
 
@@ -66,6 +66,16 @@ FileRotatorOutput::FileRotatorOutput(const char* filename, int timeSpan, int his
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+FileRotatorOutput::~FileRotatorOutput() {
+	// Stop the writer thread before this part of the object is destroyed
+	setAsync(false);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool FileRotatorOutput::open(const char* filename) {
 	if ( !FileOutput::open(filename) ) return false;
@@ -84,10 +94,8 @@ bool FileRotatorOutput::open(const char* filename) {
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void FileRotatorOutput::log(const char* channelName,
-                            LogLevel level,
-                            const char* msg,
-                            time_t time) {
+void FileRotatorOutput::write(const char *data, size_t size, time_t time,
+                              bool flush) {
 	std::lock_guard<std::mutex> l(outputMutex);
 
 	int currentInterval = (int)(time / (time_t)_timeSpan);
@@ -104,7 +112,7 @@ void FileRotatorOutput::log(const char* channelName,
 			rotateLogs();
 	}
 
-	FileOutput::log(channelName, level, msg, time);
+	FileOutput::write(data, size, time, flush);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -25,6 +25,7 @@
 #include <seiscomp/logging/fd.h>
 
 #include <unistd.h>
+#include <iterator>
 #include <mutex>
 
 
@@ -394,13 +395,17 @@ void VPublish(PublishLoc *loc, Channel *, const char *format, va_list ap) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void VPublish(PublishLoc *loc, Channel *,
               fmt::string_view format, fmt::format_args args) {
-	auto line = fmt::vformat(format, args);
+	// Format into a stack buffer, most lines fit and do not need a heap
+	// allocation
+	fmt::memory_buffer line;
+	fmt::vformat_to(std::back_inserter(line), format, args);
+	line.push_back('\0');
 
 	Data data;
 
 	data.publisher = loc;
 	data.time = time(0);
-	data.msg = line.c_str();
+	data.msg = line.data();
 
 	loc->pub->publish(data);
 }
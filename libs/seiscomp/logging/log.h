@@ -104,6 +104,60 @@ enum LogLevel {
 #define _scv(ID, CHANNEL, format, args) \
 	do { SEISCOMP_LOGGING_CALL(ID, SEISCOMP_COMPONENT, CHANNEL, Seiscomp::Logging::VPublish, format, args) } while(0)
 
+/* A call which is compiled away. The arguments are neither evaluated nor
+   formatted but are still referenced to not trigger unused variable warnings
+   in code that only logs them.
+ */
+#define _scnone(ID, CHANNEL, ...) \
+	do { if ( false ) { Seiscomp::Logging::Discard(__VA_ARGS__); } } while(0)
+
+
+/*! @def SEISCOMP_LOG_COMPILED_LEVEL
+    @brief The most verbose level which is compiled in.
+
+    All calls of the level macros (SEISCOMP_[LEVEL], SC_FMT_[LEVEL],
+    SEISCOMP_V[LEVEL] and SEISCOMP_[LEVEL]_S) with a more verbose level
+    expand to no code at all. Their arguments are not evaluated. The
+    value is the numeric value of the LogLevel enumeration and defaults
+    to 6 (LL_DEBUG) which keeps all calls. Configure the build with
+    e.g. -DSC_LOG_COMPILED_LEVEL=5 to remove all debug messages.
+
+    Calls to SEISCOMP_LOG with a custom channel are not affected.
+*/
+#ifndef SEISCOMP_LOG_COMPILED_LEVEL
+#  define SEISCOMP_LOG_COMPILED_LEVEL 6
+#endif
+
+#if SEISCOMP_LOG_COMPILED_LEVEL >= 2
+#  define _scerror(FUNC, ...) FUNC(__VA_ARGS__)
+#else
+#  define _scerror(FUNC, ...) _scnone(__VA_ARGS__)
+#endif
+
+#if SEISCOMP_LOG_COMPILED_LEVEL >= 3
+#  define _scwarning(FUNC, ...) FUNC(__VA_ARGS__)
+#else
+#  define _scwarning(FUNC, ...) _scnone(__VA_ARGS__)
+#endif
+
+#if SEISCOMP_LOG_COMPILED_LEVEL >= 4
+#  define _scnotice(FUNC, ...) FUNC(__VA_ARGS__)
+#else
+#  define _scnotice(FUNC, ...) _scnone(__VA_ARGS__)
+#endif
+
+#if SEISCOMP_LOG_COMPILED_LEVEL >= 5
+#  define _scinfo(FUNC, ...) FUNC(__VA_ARGS__)
+#else
+#  define _scinfo(FUNC, ...) _scnone(__VA_ARGS__)
+#endif
+
+#if SEISCOMP_LOG_COMPILED_LEVEL >= 6
+#  define _scdebug(FUNC, ...) FUNC(__VA_ARGS__)
+#else
+#  define _scdebug(FUNC, ...) _scnone(__VA_ARGS__)
+#endif
+
 
 /*! @addtogroup LoggingMacros
   These macros are the primary interface for logging messages:
@@ -130,13 +184,13 @@ enum LogLevel {
     Note that unless there are subscribers to this message, it will do nothing.
 */
 #define SEISCOMP_DEBUG(...) \
-	_scprintf(_SCLOGID, Seiscomp::Logging::_SCDebugChannel, ##__VA_ARGS__)
+	_scdebug(_scprintf, _SCLOGID, Seiscomp::Logging::_SCDebugChannel, ##__VA_ARGS__)
 
 #define SC_FMT_DEBUG(...) \
-	_scfmt(_SCLOGID, Seiscomp::Logging::_SCDebugChannel, ##__VA_ARGS__)
+	_scdebug(_scfmt, _SCLOGID, Seiscomp::Logging::_SCDebugChannel, ##__VA_ARGS__)
 
 #define SEISCOMP_VDEBUG(format, args) \
-	_scv(_SCLOGID, Seiscomp::Logging::_SCDebugChannel, format, args)
+	_scdebug(_scv, _SCLOGID, Seiscomp::Logging::_SCDebugChannel, format, args)
 
 /*! @def SEISCOMP_INFO(format, ...)
     @brief Log a message to the "info" channel.  Takes printf style arguments.
@@ -152,13 +206,13 @@ enum LogLevel {
     Note that unless there are subscribers to this message, it will do nothing.
 */
 #define SEISCOMP_INFO(...) \
-	_scprintf(_SCLOGID, Seiscomp::Logging::_SCInfoChannel, ##__VA_ARGS__)
+	_scinfo(_scprintf, _SCLOGID, Seiscomp::Logging::_SCInfoChannel, ##__VA_ARGS__)
 
 #define SC_FMT_INFO(...) \
-	_scfmt(_SCLOGID, Seiscomp::Logging::_SCInfoChannel, ##__VA_ARGS__)
+	_scinfo(_scfmt, _SCLOGID, Seiscomp::Logging::_SCInfoChannel, ##__VA_ARGS__)
 
 #define SEISCOMP_VINFO(format, args) \
-	_scv(_SCLOGID, Seiscomp::Logging::_SCInfoChannel, format, args)
+	_scinfo(_scv, _SCLOGID, Seiscomp::Logging::_SCInfoChannel, format, args)
 
 /*! @def SEISCOMP_WARNING(format, ...)
     @brief Log a message to the "warning" channel.  Takes printf style
@@ -178,13 +232,13 @@ enum LogLevel {
     Note that unless there are subscribers to this message, it will do nothing.
 */
 #define SEISCOMP_WARNING(...) \
-	_scprintf(_SCLOGID, Seiscomp::Logging::_SCWarningChannel, ##__VA_ARGS__)
+	_scwarning(_scprintf, _SCLOGID, Seiscomp::Logging::_SCWarningChannel, ##__VA_ARGS__)
 
 #define SC_FMT_WARNING(...) \
-	_scfmt(_SCLOGID, Seiscomp::Logging::_SCWarningChannel, ##__VA_ARGS__)
+	_scwarning(_scfmt, _SCLOGID, Seiscomp::Logging::_SCWarningChannel, ##__VA_ARGS__)
 
 #define SEISCOMP_VWARNING(format, args) \
-	_scv(_SCLOGID, Seiscomp::Logging::_SCWarningChannel, format, args)
+	_scwarning(_scv, _SCLOGID, Seiscomp::Logging::_SCWarningChannel, format, args)
 
 /*! @def SEISCOMP_ERROR(...)
     @brief Log a message to the "error" channel. Takes printf style arguments.
@@ -202,13 +256,13 @@ enum LogLevel {
     Note that unless there are subscribers to this message, it will do nothing.
 */
 #define SEISCOMP_ERROR(...) \
-	_scprintf(_SCLOGID, Seiscomp::Logging::_SCErrorChannel, ##__VA_ARGS__)
+	_scerror(_scprintf, _SCLOGID, Seiscomp::Logging::_SCErrorChannel, ##__VA_ARGS__)
 
 #define SC_FMT_ERROR(...) \
-	_scfmt(_SCLOGID, Seiscomp::Logging::_SCErrorChannel, ##__VA_ARGS__)
+	_scerror(_scfmt, _SCLOGID, Seiscomp::Logging::_SCErrorChannel, ##__VA_ARGS__)
 
 #define SEISCOMP_VERROR(format, args) \
-	_scv(_SCLOGID, Seiscomp::Logging::_SCErrorChannel, format, args)
+	_scerror(_scv, _SCLOGID, Seiscomp::Logging::_SCErrorChannel, format, args)
 
 /*! @def SEISCOMP_NOTICE(...)
     @brief Log a message to the "notice" channel. Takes printf style arguments.
@@ -226,13 +280,13 @@ enum LogLevel {
     Note that unless there are subscribers to this message, it will do nothing.
 */
 #define SEISCOMP_NOTICE(...) \
-  _scprintf(_SCLOGID, Seiscomp::Logging::_SCNoticeChannel, ##__VA_ARGS__)
+  _scnotice(_scprintf, _SCLOGID, Seiscomp::Logging::_SCNoticeChannel, ##__VA_ARGS__)
 
 #define SC_FMT_NOTICE(...) \
-	_scfmt(_SCLOGID, Seiscomp::Logging::_SCNoticeChannel, ##__VA_ARGS__)
+	_scnotice(_scfmt, _SCLOGID, Seiscomp::Logging::_SCNoticeChannel, ##__VA_ARGS__)
 
 #define SEISCOMP_VNOTICE(format, args) \
-	_scv(_SCLOGID, Seiscomp::Logging::_SCNoticeChannel, format, args)
+	_scnotice(_scv, _SCLOGID, Seiscomp::Logging::_SCNoticeChannel, format, args)
 
 /*! @def SEISCOMP_LOG(channel,format,...)
     @brief Log a message to a user defined channel. Takes a channel and printf
@@ -311,19 +365,19 @@ enum LogLevel {
 
 
 #define SEISCOMP_DEBUG_S(str) \
-	_scplain(_SCLOGID, Seiscomp::Logging::_SCDebugChannel, str)
+	_scdebug(_scplain, _SCLOGID, Seiscomp::Logging::_SCDebugChannel, str)
 
 #define SEISCOMP_INFO_S(str) \
-	_scplain(_SCLOGID, Seiscomp::Logging::_SCInfoChannel, str)
+	_scinfo(_scplain, _SCLOGID, Seiscomp::Logging::_SCInfoChannel, str)
 
 #define SEISCOMP_WARNING_S(str) \
-	_scplain(_SCLOGID, Seiscomp::Logging::_SCWarningChannel, str)
+	_scwarning(_scplain, _SCLOGID, Seiscomp::Logging::_SCWarningChannel, str)
 
 #define SEISCOMP_ERROR_S(str) \
-	_scplain(_SCLOGID, Seiscomp::Logging::_SCErrorChannel, str)
+	_scerror(_scplain, _SCLOGID, Seiscomp::Logging::_SCErrorChannel, str)
 
 #define SEISCOMP_NOTICE_S(str) \
-	_scplain(_SCLOGID, Seiscomp::Logging::_SCNoticeChannel, str)
+	_scnotice(_scplain, _SCLOGID, Seiscomp::Logging::_SCNoticeChannel, str)
 
 #define SEISCOMP_LOG_S(channel, str) \
 	_scplain(_SCLOGID, channel, str)
@@ -93,6 +93,11 @@ void VPublish(PublishLoc *, Channel *,
               fmt::printf_args args);
 
 
+//! Swallows the arguments of log calls which are compiled away
+template <typename... Args>
+inline void Discard(Args &&...) {}
+
+
 template <typename S, typename... Args>
 inline void PublishF(PublishLoc *loc, Channel *channel,
                      const S &format, Args &&...args) {
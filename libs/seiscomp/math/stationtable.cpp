@@ -0,0 +1,443 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp/math/stationtable.h>
+#include <seiscomp/math/math.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Seiscomp {
+namespace Math {
+namespace Geo {
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+// Squared chord length between two unit vectors which are an angle in
+// degrees apart. Used to prune the k-d tree, a small margin keeps points
+// at exactly the requested distance.
+double chord2(double dist) {
+	if ( dist >= 180.0 ) {
+		return 4.0 + 1E-9;
+	}
+
+	return 2.0 - 2.0 * cos(deg2rad(dist)) + 1E-9;
+}
+
+
+double angle(double cosc) {
+	return rad2deg(acos(std::min(1.0, std::max(-1.0, cosc))));
+}
+
+
+bool closer(const StationTable::Neighbor &a, const StationTable::Neighbor &b) {
+	if ( a.distance != b.distance ) {
+		return a.distance < b.distance;
+	}
+
+	return a.index < b.index;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+StationTable::StationTable(const StationTable &other) {
+	*this = other;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+StationTable &StationTable::operator=(const StationTable &other) {
+	if ( this == &other ) {
+		return *this;
+	}
+
+	_lat = other._lat;
+	_lon = other._lon;
+	_x = other._x;
+	_y = other._y;
+	_z = other._z;
+	_cosLat = other._cosLat;
+	_sinLon = other._sinLon;
+	_cosLon = other._cosLon;
+
+	_tree.clear();
+	_axis.clear();
+	_indexed = false;
+
+	return *this;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t StationTable::add(double lat, double lon) {
+	double rlat = deg2rad(lat);
+	double rlon = deg2rad(lon);
+	double cosLat = cos(rlat);
+	double sinLon = sin(rlon);
+	double cosLon = cos(rlon);
+
+	_lat.push_back(lat);
+	_lon.push_back(lon);
+	_x.push_back(cosLat * cosLon);
+	_y.push_back(cosLat * sinLon);
+	_z.push_back(sin(rlat));
+	_cosLat.push_back(cosLat);
+	_sinLon.push_back(sinLon);
+	_cosLon.push_back(cosLon);
+
+	_indexed = false;
+
+	return _lat.size() - 1;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StationTable::reserve(size_t count) {
+	_lat.reserve(count);
+	_lon.reserve(count);
+	_x.reserve(count);
+	_y.reserve(count);
+	_z.reserve(count);
+	_cosLat.reserve(count);
+	_sinLon.reserve(count);
+	_cosLon.reserve(count);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StationTable::clear() {
+	_lat.clear();
+	_lon.clear();
+	_x.clear();
+	_y.clear();
+	_z.clear();
+	_cosLat.clear();
+	_sinLon.clear();
+	_cosLon.clear();
+	_tree.clear();
+	_axis.clear();
+	_indexed = false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StationTable::delazi(double lat, double lon, double *dist,
+                          double *azi, double *baz) const {
+	double rlat = deg2rad(lat);
+	double rlon = deg2rad(lon);
+	double sinLat = sin(rlat);
+	double cosLat = cos(rlat);
+	double sinLon = sin(rlon);
+	double cosLon = cos(rlon);
+	size_t n = size();
+
+	if ( dist ) {
+		// The cosine of the distance is the dot product of the unit
+		// vectors. This loop does not branch and is vectorized by the
+		// compiler.
+		const double x = cosLat * cosLon;
+		const double y = cosLat * sinLon;
+		const double z = sinLat;
+		const double *sx = _x.data();
+		const double *sy = _y.data();
+		const double *sz = _z.data();
+
+		for ( size_t i = 0; i < n; ++i ) {
+			dist[i] = x * sx[i] + y * sy[i] + z * sz[i];
+		}
+
+		for ( size_t i = 0; i < n; ++i ) {
+			dist[i] = angle(dist[i]);
+		}
+	}
+
+	if ( !azi && !baz ) {
+		// Same as delazi for coincident points
+		if ( dist ) {
+			for ( size_t i = 0; i < n; ++i ) {
+				if ( _lat[i] == lat && _lon[i] == lon ) {
+					dist[i] = 0;
+				}
+			}
+		}
+		return;
+	}
+
+	for ( size_t i = 0; i < n; ++i ) {
+		if ( _lat[i] == lat && _lon[i] == lon ) {
+			if ( dist ) dist[i] = 0;
+			if ( azi ) azi[i] = 0;
+			if ( baz ) baz[i] = 0;
+			continue;
+		}
+
+		// Sine and cosine of the longitude difference station - source
+		double sinGam = _sinLon[i] * cosLon - _cosLon[i] * sinLon;
+		double cosGam = _cosLon[i] * cosLon + _sinLon[i] * sinLon;
+
+		if ( azi ) {
+			double a = rad2deg(atan2(sinGam * _cosLat[i],
+			                         cosLat * _z[i] - sinLat * _cosLat[i] * cosGam));
+			azi[i] = a < 0 ? a + 360.0 : a;
+		}
+
+		if ( baz ) {
+			double b = rad2deg(atan2(-sinGam * cosLat,
+			                         _cosLat[i] * sinLat - _z[i] * cosLat * cosGam));
+			baz[i] = b < 0 ? b + 360.0 : b;
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+StationTable::Neighbors
+StationTable::nearest(double lat, double lon, size_t count,
+                      double maxDist) const {
+	Neighbors result;
+
+	if ( !count || empty() || maxDist < 0 ) {
+		return result;
+	}
+
+	buildIndex();
+
+	double rlat = deg2rad(lat);
+	double rlon = deg2rad(lon);
+	double p[3] = { cos(rlat) * cos(rlon), cos(rlat) * sin(rlon), sin(rlat) };
+	double maxChord2 = chord2(maxDist);
+	double limit = maxChord2;
+
+	// Max heap of the squared chord lengths of the best candidates
+	std::vector<std::pair<double, size_t>> heap;
+	heap.reserve(std::min(count, size()));
+
+	auto visit = [&](size_t index, double d2, double &bound) {
+		if ( d2 > bound ) {
+			return;
+		}
+
+		if ( heap.size() == count ) {
+			std::pop_heap(heap.begin(), heap.end());
+			heap.pop_back();
+		}
+
+		heap.emplace_back(d2, index);
+		std::push_heap(heap.begin(), heap.end());
+
+		if ( heap.size() == count ) {
+			bound = std::min(maxChord2, heap.front().first);
+		}
+	};
+
+	search(0, _tree.size(), p, limit, visit);
+
+	result.reserve(heap.size());
+	for ( auto &item : heap ) {
+		size_t i = item.second;
+		double d = (_lat[i] == lat && _lon[i] == lon) ?
+		           0.0 : angle(p[0] * _x[i] + p[1] * _y[i] + p[2] * _z[i]);
+		if ( d <= maxDist ) {
+			result.push_back({i, d});
+		}
+	}
+
+	std::sort(result.begin(), result.end(), closer);
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+StationTable::Neighbors
+StationTable::within(double lat, double lon, double radius) const {
+	Neighbors result;
+
+	if ( empty() || radius < 0 ) {
+		return result;
+	}
+
+	buildIndex();
+
+	double rlat = deg2rad(lat);
+	double rlon = deg2rad(lon);
+	double p[3] = { cos(rlat) * cos(rlon), cos(rlat) * sin(rlon), sin(rlat) };
+	double limit = chord2(radius);
+
+	auto visit = [&](size_t i, double d2, double &bound) {
+		if ( d2 > bound ) {
+			return;
+		}
+
+		double d = (_lat[i] == lat && _lon[i] == lon) ?
+		           0.0 : angle(p[0] * _x[i] + p[1] * _y[i] + p[2] * _z[i]);
+		if ( d <= radius ) {
+			result.push_back({i, d});
+		}
+	};
+
+	search(0, _tree.size(), p, limit, visit);
+
+	std::sort(result.begin(), result.end(), closer);
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StationTable::buildIndex() const {
+	if ( _indexed.load(std::memory_order_acquire) ) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(_indexMutex);
+	if ( _indexed.load(std::memory_order_relaxed) ) {
+		return;
+	}
+
+	_tree.resize(size());
+	_axis.assign(size(), 0);
+	for ( size_t i = 0; i < _tree.size(); ++i ) {
+		_tree[i] = i;
+	}
+
+	buildIndex(0, _tree.size());
+
+	_indexed.store(true, std::memory_order_release);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StationTable::buildIndex(size_t from, size_t to) const {
+	if ( to - from < 2 ) {
+		return;
+	}
+
+	const std::vector<double> *coords[3] = { &_x, &_y, &_z };
+
+	// Split along the axis with the largest extent
+	uint8_t axis = 0;
+	double extent = -1;
+	for ( uint8_t a = 0; a < 3; ++a ) {
+		const auto &c = *coords[a];
+		double lo = c[_tree[from]], hi = lo;
+		for ( size_t i = from + 1; i < to; ++i ) {
+			lo = std::min(lo, c[_tree[i]]);
+			hi = std::max(hi, c[_tree[i]]);
+		}
+		if ( hi - lo > extent ) {
+			extent = hi - lo;
+			axis = a;
+		}
+	}
+
+	const auto &c = *coords[axis];
+	size_t mid = from + (to - from) / 2;
+	std::nth_element(_tree.begin() + from, _tree.begin() + mid, _tree.begin() + to,
+	                 [&c](size_t a, size_t b) { return c[a] < c[b]; });
+	_axis[mid] = axis;
+
+	buildIndex(from, mid);
+	buildIndex(mid + 1, to);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+template <typename Visitor>
+void StationTable::search(size_t from, size_t to, const double *p,
+                          double &limit, Visitor &visit) const {
+	if ( from >= to ) {
+		return;
+	}
+
+	size_t mid = from + (to - from) / 2;
+	size_t index = _tree[mid];
+	double q[3] = { _x[index], _y[index], _z[index] };
+
+	double dx = p[0] - q[0];
+	double dy = p[1] - q[1];
+	double dz = p[2] - q[2];
+	visit(index, dx * dx + dy * dy + dz * dz, limit);
+
+	double diff = p[_axis[mid]] - q[_axis[mid]];
+
+	if ( diff < 0 ) {
+		search(from, mid, p, limit, visit);
+		if ( diff * diff <= limit ) {
+			search(mid + 1, to, p, limit, visit);
+		}
+	}
+	else {
+		search(mid + 1, to, p, limit, visit);
+		if ( diff * diff <= limit ) {
+			search(from, mid, p, limit, visit);
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
+}
@@ -0,0 +1,166 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#ifndef SEISCOMP_MATH_GEO_STATIONTABLE_H
+#define SEISCOMP_MATH_GEO_STATIONTABLE_H
+
+
+#include <seiscomp/core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace Math {
+namespace Geo {
+
+
+/**
+ * @brief A table of station locations with precomputed geometry.
+ *
+ * For each station the unit vector and the sine and cosine of its latitude
+ * and longitude are stored in separate arrays such that the distances and
+ * azimuths from one source to all stations are computed in a single pass
+ * without evaluating trigonometric functions of the station coordinates.
+ * The results are those of Math::Geo::delazi which uses the same
+ * spherical earth.
+ *
+ * Nearest station and radius queries are answered by a k-d tree over the
+ * unit vectors which is built on the first query after the table has been
+ * changed. Concurrent queries are safe, changing the table while it is
+ * being queried is not.
+ */
+class SC_SYSTEM_CORE_API StationTable {
+	public:
+		struct Neighbor {
+			//! The index of the station in the table
+			size_t index;
+			//! The distance in degrees
+			double distance;
+		};
+
+		using Neighbors = std::vector<Neighbor>;
+
+
+	public:
+		StationTable() = default;
+		StationTable(const StationTable &other);
+
+		StationTable &operator=(const StationTable &other);
+
+
+	public:
+		/**
+		 * @brief Appends a station.
+		 * @param lat The latitude in degrees
+		 * @param lon The longitude in degrees
+		 * @return The index of the station
+		 */
+		size_t add(double lat, double lon);
+
+		//! Reserves space for a number of stations
+		void reserve(size_t count);
+
+		//! Removes all stations
+		void clear();
+
+		size_t size() const { return _lat.size(); }
+		bool empty() const { return _lat.empty(); }
+
+		double latitude(size_t index) const { return _lat[index]; }
+		double longitude(size_t index) const { return _lon[index]; }
+
+		/**
+		 * @brief Computes the distances and azimuths from a source to
+		 *        all stations. Each output array must hold size() values
+		 *        and can be null if not required.
+		 * @param lat The source latitude in degrees
+		 * @param lon The source longitude in degrees
+		 * @param dist The distances in degrees
+		 * @param azi The azimuths of the stations seen from the source
+		 * @param baz The azimuths of the source seen from the stations
+		 */
+		void delazi(double lat, double lon, double *dist,
+		            double *azi = nullptr, double *baz = nullptr) const;
+
+		/**
+		 * @brief Returns the nearest stations of a location sorted by
+		 *        increasing distance.
+		 * @param lat The latitude in degrees
+		 * @param lon The longitude in degrees
+		 * @param count The maximum number of stations to return
+		 * @param maxDist The maximum distance in degrees
+		 * @return The stations and their distances
+		 */
+		Neighbors nearest(double lat, double lon, size_t count,
+		                  double maxDist = 180.0) const;
+
+		/**
+		 * @brief Returns all stations within a radius of a location
+		 *        sorted by increasing distance.
+		 * @param lat The latitude in degrees
+		 * @param lon The longitude in degrees
+		 * @param radius The radius in degrees
+		 * @return The stations and their distances
+		 */
+		Neighbors within(double lat, double lon, double radius) const;
+
+
+	private:
+		void buildIndex() const;
+		void buildIndex(size_t from, size_t to) const;
+
+		template <typename Visitor>
+		void search(size_t from, size_t to, const double *p,
+		            double &limit, Visitor &visit) const;
+
+
+	private:
+		// Coordinates in degrees
+		std::vector<double>           _lat;
+		std::vector<double>           _lon;
+		// Unit vectors, the z component is the sine of the latitude
+		std::vector<double>           _x;
+		std::vector<double>           _y;
+		std::vector<double>           _z;
+		std::vector<double>           _cosLat;
+		std::vector<double>           _sinLon;
+		std::vector<double>           _cosLon;
+
+		// The k-d tree is stored implicitly as permutation of the station
+		// indices where the median of each range is the node and the
+		// split axis of each node is stored at the same position.
+		mutable std::vector<size_t>   _tree;
+		mutable std::vector<uint8_t>  _axis;
+		mutable std::atomic<bool>     _indexed{false};
+		mutable std::mutex            _indexMutex;
+};
+
+
+}
+}
+}
+
+
+#endif
@@ -208,6 +208,20 @@ class SC_SYSTEM_CLIENT_API Connection : public Core::BaseObject {
 		 */
 		Result syncOutbox();
 
+		/**
+		 * @brief Starts a batch of messages.
+		 *        See Protocol::beginBatch().
+		 * @return Result code
+		 */
+		Result beginBatch();
+
+		/**
+		 * @brief Ends a batch of messages and sends them.
+		 *        See Protocol::endBatch().
+		 * @return Result code
+		 */
+		Result endBatch();
+
 		/**
 		 * @brief Reads a message from the backend. If no message is available
 		 *        locally the call will block until a message arrives.
@@ -79,19 +79,8 @@ class ImportXMLArchive : public IO::XMLArchive {
 };
 
 
-template <typename AR>
-inline void parse(Core::Message *&msg, const char *blob, size_t blob_length,
-                  Protocol::ContentEncoding encoding) {
-	bio::stream_buffer<bio::array_source> buf(blob, blob_length);
-
-	if ( encoding == Protocol::Identity ) {
-		AR ar(&buf, true);
-		ar >> msg;
-		return;
-	}
-
-	bio::filtering_istreambuf filtered_buf;
-
+void pushDecompressor(bio::filtering_istreambuf &filtered_buf,
+                      Protocol::ContentEncoding encoding) {
 	switch ( encoding ) {
 		case Protocol::Deflate:
 			filtered_buf.push(boost::iostreams::zlib_decompressor());
@@ -105,13 +94,58 @@ inline void parse(Core::Message *&msg, const char *blob, size_t blob_length,
 		default:
 			throw runtime_error("Invalid encoding type");
 	}
+}
+
+
+template <typename AR>
+inline void parse(Core::Message *&msg, const char *blob, size_t blob_length,
+                  Protocol::ContentEncoding encoding) {
+	bio::stream_buffer<bio::array_source> buf(blob, blob_length);
+
+	if ( encoding == Protocol::Identity ) {
+		AR ar(&buf, true);
+		ar >> msg;
+		return;
+	}
 
+	bio::filtering_istreambuf filtered_buf;
+	pushDecompressor(filtered_buf, encoding);
 	filtered_buf.push(buf);
 	AR ar(&filtered_buf, true);
 	ar >> msg;
 }
 
 
+// Binary messages are decoded directly from memory. Compressed payloads
+// are inflated into a single block first which is cheaper than pulling
+// every field through the filter chain.
+template <>
+inline void parse<IO::VBinaryArchive>(Core::Message *&msg, const char *blob,
+                                      size_t blob_length,
+                                      Protocol::ContentEncoding encoding) {
+	if ( encoding == Protocol::Identity ) {
+		IO::VBinaryArchive ar(blob, blob_length);
+		ar >> msg;
+		return;
+	}
+
+	bio::stream_buffer<bio::array_source> buf(blob, blob_length);
+	bio::filtering_istreambuf filtered_buf;
+	pushDecompressor(filtered_buf, encoding);
+	filtered_buf.push(buf);
+
+	std::string data;
+	char chunk[16384];
+	std::streamsize size;
+	data.reserve(blob_length * 4);
+	while ( (size = filtered_buf.sgetn(chunk, sizeof(chunk))) > 0 )
+		data.append(chunk, size);
+
+	IO::VBinaryArchive ar(data.data(), data.size());
+	ar >> msg;
+}
+
+
 template <typename AR>
 inline bool write(std::string &blob, const Core::Message *&msg,
                   Protocol::ContentEncoding encoding, int schemaVersion) {
@@ -214,6 +248,24 @@ const Protocol::Groups &Protocol::groups() const {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result Protocol::beginBatch() {
+	return OK;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result Protocol::endBatch() {
+	return OK;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Protocol::handleInterrupt(int) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
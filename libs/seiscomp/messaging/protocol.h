@@ -431,6 +431,26 @@ class SC_SYSTEM_CLIENT_API Protocol : public Core::InterruptibleObject {
 		 */
 		virtual Result syncOutbox() = 0;
 
+		/**
+		 * @brief Starts a batch of regular messages.
+		 * @details Messages sent until \ref endBatch is called are collected
+		 *          and written with as few system calls as possible. The
+		 *          connection does not block on the acknowledgement window
+		 *          for each message but once for the whole batch, relying
+		 *          on cumulative acknowledgements from the server. This is
+		 *          useful to send bursts of many small messages. The default
+		 *          implementation does nothing.
+		 * @return Result code
+		 */
+		virtual Result beginBatch();
+
+		/**
+		 * @brief Ends a batch started with \ref beginBatch and sends all
+		 *        collected messages.
+		 * @return Result code
+		 */
+		virtual Result endBatch();
+
 		/**
 		 * @brief Disconnects gracefully from the broker. It sends a disconnect
 		 *        message and wait for the receipt. In contrast to close, this
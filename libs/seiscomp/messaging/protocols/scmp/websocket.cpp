@@ -53,6 +53,12 @@ typedef Core::ContainerSink<string> StringSink;
 typedef boost::iostreams::stream<StringSink> osstream;
 
 
+// The number of bytes collected in batch mode before the batch is sent
+const size_t MaxBatchSize = 256*1024;
+// The maximum number of memory blocks passed to a single writev call
+const int MaxIOVectors = 512;
+
+
 /*
 HTTP/1.1 101 Switching Protocols
 Upgrade: websocket
@@ -251,6 +257,8 @@ REGISTER_CONNECTION_PROTOCOL(SecureWebsocketConnection, "scmps");
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 WebsocketConnection::WebsocketConnection() {
 	_inboxWaterLevel = 0;
+	_batchMode = false;
+	_batchBytes = 0;
 	_select.setTriggerMode(DeviceGroup::LevelTriggered);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -278,6 +286,10 @@ Result WebsocketConnection::connect(const char *address,
 		_supportsDeleteTree = false;
 		_extendedParameters = KeyValueStore();
 		_state = State();
+		// Unsent batched messages are either part of the backlog or lost
+		// if acknowledgements are disabled
+		_batch.clear();
+		_batchBytes = 0;
 		_select.clear();
 		_groups.clear();
 		_errorMessage = string();
@@ -927,11 +939,12 @@ Result WebsocketConnection::fetchInbox() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Result WebsocketConnection::syncOutbox() {
-	Result r = OK;
+	lock_guard<mutex> lw(_writeMutex);
 
-	if ( _ackWindow == 0 ) return r;
+	Result r = flushBatch();
+	if ( r != OK ) return r;
 
-	lock_guard<mutex> lw(_writeMutex);
+	if ( _ackWindow == 0 ) return r;
 
 	while ( !_outbox.empty() ) {
 		_writeMutex.unlock();
@@ -978,6 +991,36 @@ Result WebsocketConnection::syncOutbox() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result WebsocketConnection::beginBatch() {
+	lock_guard<mutex> lw(_writeMutex);
+	_batchMode = true;
+	return OK;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result WebsocketConnection::endBatch() {
+	lock_guard<mutex> lw(_writeMutex);
+	_batchMode = false;
+
+	Result r = flushBatch();
+	if ( (r == OK) && _ackWindow ) {
+		_writeMutex.unlock();
+		waitForAck();
+		_writeMutex.lock();
+	}
+
+	return r;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Result WebsocketConnection::recv(Packet &p) {
 	while ( true ) {
@@ -1392,6 +1435,16 @@ Result WebsocketConnection::readFrame(Wired::Websocket::Frame &frame,
 Result WebsocketConnection::send(Buffer *msg, WSFrame::Type type, bool isRegular) {
 	Result r;
 
+	if ( isRegular && _batchMode ) {
+		return queueBatch(msg, type);
+	}
+
+	// Keep the order of batched messages and all other frames
+	r = flushBatch();
+	if ( r != OK ) {
+		return r;
+	}
+
 	_sockMutex.lock();
 	if ( !_socket || !_socket->isValid() ) {
 		_sockMutex.unlock();
@@ -1482,6 +1535,150 @@ Result WebsocketConnection::sendSocket(const char *data, int len) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result WebsocketConnection::sendSocket(struct iovec *iov, int count) {
+	while ( count > 0 ) {
+		if ( !iov->iov_len ) {
+			++iov;
+			--count;
+			continue;
+		}
+
+		ssize_t written = _socket->writev(iov, min(count, MaxIOVectors));
+		++_state.systemWriteCalls;
+		if ( written < 0 ) {
+			if ( SIGNIFICANT_ERRNO ) {
+				// Close the session
+				closeSocketWithoutLock(strerror(errno));
+				return SystemError;
+			}
+
+			_sockMutex.unlock();
+			_readMutex.lock();
+			if ( !_inWait ) {
+				wait(&_readMutex, &_waitMutex);
+			}
+			else {
+				_waitMutex.lock();
+				_waitMutex.unlock();
+			}
+			_readMutex.unlock();
+			_sockMutex.lock();
+		}
+		else if ( written == 0 ) {
+			// Closed by peer
+			closeSocketWithoutLock("Connection closed by peer");
+			return ConnectionClosedByPeer;
+		}
+		else {
+			_state.bytesSent += written;
+
+			// Skip all blocks which have been sent completely and
+			// advance the partially sent block
+			size_t bytes = static_cast<size_t>(written);
+			while ( bytes > 0 ) {
+				if ( bytes >= iov->iov_len ) {
+					bytes -= iov->iov_len;
+					++iov;
+					--count;
+				}
+				else {
+					iov->iov_base = static_cast<char*>(iov->iov_base) + bytes;
+					iov->iov_len -= bytes;
+					bytes = 0;
+				}
+			}
+		}
+	}
+
+	return OK;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result WebsocketConnection::queueBatch(Buffer *msg, WSFrame::Type type) {
+	{
+		lock_guard<mutex> lsock(_sockMutex);
+		if ( !_socket || !_socket->isValid() ) {
+			_errorMessage = "Not connected";
+			return NotConnected;
+		}
+	}
+
+	Wired::Websocket::Frame::finalizeBuffer(msg, type);
+
+	_batch.push_back(msg);
+	_batchBytes += msg->header.size() + msg->data.size();
+
+	_state.bytesBuffered += msg->data.size();
+	++_state.localSequenceNumber;
+	++_state.sentMessages;
+
+	// The message is added to the outbox already. The server acknowledges
+	// cumulatively and we wait for the acknowledgement only after the
+	// batch has been sent.
+	if ( _ackWindow ) {
+		_outbox.push_back(msg);
+	}
+
+	if ( _batchBytes < MaxBatchSize ) {
+		return OK;
+	}
+
+	Result r = flushBatch();
+	if ( (r == OK) && _ackWindow ) {
+		_writeMutex.unlock();
+		waitForAck();
+		_writeMutex.lock();
+	}
+
+	return r;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Result WebsocketConnection::flushBatch() {
+	if ( _batch.empty() ) {
+		return OK;
+	}
+
+	vector<struct iovec> iov;
+	iov.reserve(_batch.size() * 2);
+	for ( auto &&msg : _batch ) {
+		iov.push_back({const_cast<char*>(msg->header.data()), msg->header.size()});
+		iov.push_back({const_cast<char*>(msg->data.data()), msg->data.size()});
+	}
+
+	Result r;
+
+	_sockMutex.lock();
+	if ( !_socket || !_socket->isValid() ) {
+		_errorMessage = "Not connected";
+		r = NotConnected;
+	}
+	else {
+		_socket->addMode(Wired::Device::Write);
+		r = sendSocket(iov.data(), static_cast<int>(iov.size()));
+		_socket->removeMode(Wired::Device::Write);
+	}
+	_sockMutex.unlock();
+
+	_batch.clear();
+	_batchBytes = 0;
+
+	return r;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void WebsocketConnection::updateReceiveBuffer() {
 	lock_guard<mutex> l(_readMutex);
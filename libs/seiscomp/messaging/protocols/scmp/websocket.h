@@ -65,6 +65,9 @@ class WebsocketConnection : public Socket {
 		virtual Result fetchInbox() override;
 		virtual Result syncOutbox() override;
 
+		virtual Result beginBatch() override;
+		virtual Result endBatch() override;
+
 		virtual Result recv(Packet &p) override;
 		virtual Packet *recv(Result *result = nullptr) override;
 
@@ -94,6 +97,23 @@ class WebsocketConnection : public Socket {
 		 */
 		Result send(Wired::Buffer *msg, WSFrame::Type type, bool isRegular);
 		Result sendSocket(const char *data, int len);
+		Result sendSocket(struct iovec *iov, int count);
+
+		/**
+		 * Adds a regular message to the current batch and sends the
+		 * batch if it exceeds its size limit.
+		 * @pre _writeMutex is locked
+		 * @post _writeMutex is locked
+		 */
+		Result queueBatch(Wired::Buffer *msg, WSFrame::Type type);
+
+		/**
+		 * Sends all messages of the current batch with as few system
+		 * calls as possible.
+		 * @pre _writeMutex is locked
+		 * @post _writeMutex is locked
+		 */
+		Result flushBatch();
 
 		void updateReceiveBuffer();
 		void closeSocket(const char *errorMessage = nullptr,
@@ -112,6 +132,9 @@ class WebsocketConnection : public Socket {
 		mutable std::mutex _waitMutex;
 		WSFrame            _recvFrame;
 		size_t             _inboxWaterLevel;
+		bool               _batchMode;
+		BufferQueue        _batch;
+		size_t             _batchBytes;
 };
 
 
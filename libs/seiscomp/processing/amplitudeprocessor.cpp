@@ -105,7 +105,7 @@ typedef vector<AmplitudeProcessor::Locale> Regionalization;
 DEFINE_SMARTPOINTER(TypeSpecificRegionalization);
 class TypeSpecificRegionalization : public Core::BaseObject {
 	public:
-		const Regions   *regions;
+		const Regions   *regions{nullptr};
 		Regionalization  regionalization;
 };
 
@@ -1400,7 +1400,7 @@ void AmplitudeProcessor::setEnvironment(const DataModel::Origin *hypocenter,
 		if ( profile.feature ) {
 			switch ( profile.check ) {
 				case Locale::Source:
-					if ( !profile.feature->contains(Geo::GeoCoordinate(hypoLat, hypoLon)) ) {
+					if ( !tsr->regions->contains(profile.feature, hypoLat, hypoLon) ) {
 						notFoundStatus = EpicenterOutOfRegions;
 						continue;
 					}
@@ -1408,18 +1408,18 @@ void AmplitudeProcessor::setEnvironment(const DataModel::Origin *hypocenter,
 					break;
 
 				case Locale::SourceReceiver:
-					if ( !profile.feature->contains(Geo::GeoCoordinate(hypoLat, hypoLon)) ) {
+					if ( !tsr->regions->contains(profile.feature, hypoLat, hypoLon) ) {
 						notFoundStatus = EpicenterOutOfRegions;
 						continue;
 					}
-					if ( !profile.feature->contains(Geo::GeoCoordinate(recvLat, recvLon)) ) {
+					if ( !tsr->regions->contains(profile.feature, recvLat, recvLon) ) {
 						notFoundStatus = ReceiverOutOfRegions;
 						continue;
 					}
 					break;
 
 				case Locale::SourceReceiverPath:
-					if ( !Regions::contains(profile.feature, hypoLat, hypoLon, recvLat, recvLon) ) {
+					if ( !tsr->regions->containsPath(profile.feature, hypoLat, hypoLon, recvLat, recvLon) ) {
 						notFoundStatus = RayPathOutOfRegions;
 						continue;
 					}
@@ -89,7 +89,7 @@ using Regionalization = vector<MagnitudeProcessor::Locale>;
 DEFINE_SMARTPOINTER(TypeSpecificRegionalization);
 class TypeSpecificRegionalization : public Core::BaseObject {
 	public:
-		const Regions   *regions;
+		const Regions   *regions{nullptr};
 		Regionalization  regionalization;
 };
 
@@ -738,7 +738,7 @@ MagnitudeProcessor::computeMagnitude(double amplitudeValue,
 					if ( profile.feature ) {
 						switch ( profile.check ) {
 							case Locale::Source:
-								if ( !profile.feature->contains(Geo::GeoCoordinate(hypoLat, hypoLon)) ) {
+								if ( !tsr->regions->contains(profile.feature, hypoLat, hypoLon) ) {
 									notFoundStatus = EpicenterOutOfRegions;
 									continue;
 								}
@@ -746,18 +746,18 @@ MagnitudeProcessor::computeMagnitude(double amplitudeValue,
 								break;
 
 							case Locale::SourceReceiver:
-								if ( !profile.feature->contains(Geo::GeoCoordinate(hypoLat, hypoLon)) ) {
+								if ( !tsr->regions->contains(profile.feature, hypoLat, hypoLon) ) {
 									notFoundStatus = EpicenterOutOfRegions;
 									continue;
 								}
-								if ( !profile.feature->contains(Geo::GeoCoordinate(recvLat, recvLon)) ) {
+								if ( !tsr->regions->contains(profile.feature, recvLat, recvLon) ) {
 									notFoundStatus = ReceiverOutOfRegions;
 									continue;
 								}
 								break;
 
 							case Locale::SourceReceiverPath:
-								if ( !Regions::contains(profile.feature, hypoLat, hypoLon, recvLat, recvLon) ) {
+								if ( !tsr->regions->containsPath(profile.feature, hypoLat, hypoLon, recvLat, recvLon) ) {
 									notFoundStatus = RayPathOutOfRegions;
 									continue;
 								}
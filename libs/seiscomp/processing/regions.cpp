@@ -40,6 +40,42 @@ namespace {
 std::mutex registryMutex;
 std::map<std::string, RegionsPtr> registry;
 
+
+template <typename CONTAINS>
+bool sampledPathContains(const CONTAINS &contains,
+                         double lat0, double lon0, double lat1, double lon1,
+                         double samplingDistance) {
+	double dist, az, baz;
+
+	if ( !contains(lat0, lon0) ) {
+		return false;
+	}
+
+	if ( samplingDistance <= 0.0 ) {
+		return contains(lat1, lon1);
+	}
+
+	Math::Geo::delazi_wgs84(lat0, lon0, lat1, lon1, &dist, &az, &baz);
+
+	// Convert to km
+	dist = Math::Geo::deg2km(dist);
+
+	int steps = dist / samplingDistance;
+
+	for ( int i = 1; i <= steps; ++i ) {
+		Math::Geo::delandaz2coord(
+			Math::Geo::km2deg(dist*i/steps), az,
+			lat0, lon0, &lat1, &lon1
+		);
+
+		if ( !contains(lat1, lon1) ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -48,6 +84,10 @@ std::map<std::string, RegionsPtr> registry;
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Geo::GeoFeature *Regions::find(double lat, double lon) const {
+	if ( isIndexed() ) {
+		return _index.findFirst(Geo::GeoCoordinate(lat, lon));
+	}
+
 	for ( Geo::GeoFeature *feature : featureSet.features() ) {
 		if ( feature->contains(Geo::GeoCoordinate(lat, lon)) )
 			return feature;
@@ -124,39 +164,67 @@ bool Regions::contains(const Geo::GeoFeature *feature,
                        double lat0, double lon0,
                        double lat1, double lon1,
                        double samplingDistance) {
-	double dist, az, baz;
-
 	if ( !feature ) {
 		return false;
 	}
 
-	if ( !feature->contains(Geo::GeoCoordinate(lat0, lon0)) ) {
+	return sampledPathContains([feature](double lat, double lon) {
+		return feature->contains(Geo::GeoCoordinate(lat, lon));
+	}, lat0, lon0, lat1, lon1, samplingDistance);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Regions::contains(const Geo::GeoFeature *feature,
+                       double lat, double lon) const {
+	if ( !feature ) {
 		return false;
 	}
 
-	if ( samplingDistance <= 0.0 ) {
-		return feature->contains(Geo::GeoCoordinate(lat1, lon1));
+	// A stale index may refer to deleted features
+	return isIndexed()
+	     ? _index.contains(feature, Geo::GeoCoordinate(lat, lon))
+	     : feature->contains(Geo::GeoCoordinate(lat, lon));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Regions::containsPath(const Geo::GeoFeature *feature,
+                           double lat0, double lon0,
+                           double lat1, double lon1,
+                           double samplingDistance) const {
+	if ( !feature ) {
+		return false;
 	}
 
-	Math::Geo::delazi_wgs84(lat0, lon0, lat1, lon1, &dist, &az, &baz);
+	return sampledPathContains([this, feature](double lat, double lon) {
+		return contains(feature, lat, lon);
+	}, lat0, lon0, lat1, lon1, samplingDistance);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
-	// Convert to km
-	dist = Math::Geo::deg2km(dist);
 
-	int steps = dist / samplingDistance;
 
-	for ( int i = 1; i <= steps; ++i ) {
-		Math::Geo::delandaz2coord(
-			Math::Geo::km2deg(dist*i/steps), az,
-			lat0, lon0, &lat1, &lon1
-		);
 
-		if ( !feature->contains(Geo::GeoCoordinate(lat1, lon1)) ) {
-			return false;
-		}
-	}
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Regions::updateIndex() {
+	_index.build(featureSet.features());
+	_indexGeneration = featureSet.generation();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
-	return true;
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Regions::isIndexed() const {
+	return _indexGeneration == featureSet.generation();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -176,6 +244,7 @@ const Regions *Regions::load(const std::string &filename) {
 		return nullptr;
 	}
 
+	regions->updateIndex();
 	registry[filename] = regions;
 	return regions.get();
 }
@@ -27,6 +27,7 @@
 
 #include <seiscomp/config/config.h>
 #include <seiscomp/geo/featureset.h>
+#include <seiscomp/geo/index/featureindex.h>
 
 
 namespace Seiscomp {
@@ -92,10 +93,48 @@ class Regions : public Core::BaseObject {
 		                     double lat1, double lon1,
 		                     double samplingDistance = 10);
 
+		/**
+		 * @brief Checks whether a feature contains a point. Features of
+		 *        this region set are tested with the spatial index.
+		 * @param feature The feature to test against
+		 * @param lat The latitude of the point
+		 * @param lon The longitude of the point
+		 * @return true if contained, false otherwise
+		 */
+		bool contains(const Geo::GeoFeature *feature,
+		              double lat, double lon) const;
+
+		/**
+		 * @brief Same as the static contains() for a path but uses the
+		 *        spatial index for features of this region set.
+		 */
+		bool containsPath(const Geo::GeoFeature *feature,
+		                  double lat0, double lon0,
+		                  double lat1, double lon1,
+		                  double samplingDistance = 10) const;
+
+		/**
+		 * @brief Rebuilds the spatial index from featureSet. This must be
+		 *        called after featureSet has been changed, otherwise
+		 *        find() tests all features in order. Regions returned by
+		 *        load() are indexed already.
+		 */
+		void updateIndex();
+
+		/**
+		 * @brief Returns whether the spatial index reflects the current
+		 *        features of featureSet.
+		 */
+		bool isIndexed() const;
+
 		static const Regions *load(const std::string& filename);
 
 	public:
 		Geo::GeoFeatureSet featureSet;
+
+	private:
+		Geo::FeatureIndex  _index;
+		uint64_t           _indexGeneration{0};
 };
 
 
@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#ifndef SEISCOMP_PROCESSING_QCENGINE_H
+#define SEISCOMP_PROCESSING_QCENGINE_H
+
+
+#include <seiscomp/qc/qcprocessor.h>
+
+#include <vector>
+
+
+namespace Seiscomp {
+namespace Processing {
+
+
+DEFINE_SMARTPOINTER(QcEngine);
+
+/**
+ * @brief Feeds a set of QC processors of one stream with a single pass over
+ *        the data.
+ *
+ * Each record is decoded and checked for gaps and overlaps once by the
+ * engine. The sample statistics required by the mean, RMS and spike
+ * processors are computed in one pass and passed to all processors
+ * through QcProcessor::setStateFromStatistics. The processors notify
+ * their observers as if they had been fed directly.
+ *
+ * Processors added to an engine must not be fed directly. Their own
+ * filters are not applied, a filter set on the engine applies to all
+ * processors.
+ */
+class SC_SYSTEM_CLIENT_API QcEngine : public WaveformProcessor {
+	DECLARE_SC_CLASS(QcEngine);
+
+	public:
+		using Processors = std::vector<QcProcessorPtr>;
+
+	public:
+		//! Constructor
+		QcEngine(const Core::TimeSpan &deadTime=0.0,
+		         const Core::TimeSpan &gapThreshold=300.0);
+
+		//! Destructor
+		~QcEngine() override;
+
+	public:
+		//! Adds a processor. Returns false if it has been added already.
+		bool add(QcProcessor *proc);
+
+		//! Removes a processor. Returns false if it has not been added.
+		bool remove(QcProcessor *proc);
+
+		//! Removes all processors
+		void clear();
+
+		const Processors &processors() const { return _processors; }
+
+		//! Returns the statistics of the last processed record
+		const QcStatistics &statistics() const { return _statistics; }
+
+	protected:
+		void process(const Record *record, const DoubleArray &data) override;
+
+	private:
+		Processors   _processors;
+		QcStatistics _statistics;
+};
+
+
+}
+}
+
+
+#endif
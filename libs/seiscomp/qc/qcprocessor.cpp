@@ -20,6 +20,9 @@
 
 #include <seiscomp/qc/qcprocessor.h>
 
+#include <algorithm>
+#include <cmath>
+
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 namespace Seiscomp {
@@ -100,8 +103,118 @@ QcParameter* QcProcessor::getState() const {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void QcStatistics::compute(const DoubleArray &data) {
+	const double *samples = data.typedData();
+	size_t n = static_cast<size_t>(data.size());
+
+	count = n;
+	if ( !n ) {
+		mean = rms = min = max = 0;
+		return;
+	}
+
+	// The sums are accumulated in independent lanes which the compiler
+	// maps to vector registers. The samples are shifted by the first
+	// sample to keep the sum of squares accurate for records with a large
+	// offset.
+	const size_t Lanes = 4;
+	double shift = samples[0];
+	double sum[Lanes] = {0, 0, 0, 0};
+	double sqr[Lanes] = {0, 0, 0, 0};
+	double lo[Lanes] = {shift, shift, shift, shift};
+	double hi[Lanes] = {shift, shift, shift, shift};
+	size_t i = 0;
+
+	for ( ; i + Lanes <= n; i += Lanes ) {
+		for ( size_t k = 0; k < Lanes; ++k ) {
+			double v = samples[i+k];
+			double d = v - shift;
+			sum[k] += d;
+			sqr[k] += d * d;
+			lo[k] = v < lo[k] ? v : lo[k];
+			hi[k] = v > hi[k] ? v : hi[k];
+		}
+	}
+
+	for ( size_t k = 0; i < n; ++i, ++k ) {
+		double v = samples[i];
+		double d = v - shift;
+		sum[k] += d;
+		sqr[k] += d * d;
+		lo[k] = v < lo[k] ? v : lo[k];
+		hi[k] = v > hi[k] ? v : hi[k];
+	}
+
+	double s = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+	double q = (sqr[0] + sqr[1]) + (sqr[2] + sqr[3]);
+	double d = s / n;
+	double var = q / n - d * d;
+
+	mean = shift + d;
+	rms = var > 0 ? sqrt(var) : 0;
+	min = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+	max = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool QcProcessor::setStateFromStatistics(const Record *record,
+                                         const DoubleArray &data,
+                                         const QcStatistics &) {
+	return setState(record, data);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const Record *QcProcessor::lastRecord() const {
+	return _sharedStream ? _sharedStream->lastRecord.get() : _stream.lastRecord.get();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+double QcProcessor::lastSample() const {
+	return _sharedStream ? _sharedStream->lastSample : _stream.lastSample;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void QcProcessor::process(const Record *record, const DoubleArray &data) {
+	update(record, data, nullptr);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void QcProcessor::process(const Record *record, const DoubleArray &data,
+                          const QcStatistics &stats,
+                          const StreamState &stream) {
+	_sharedStream = &stream;
+	update(record, data, &stats);
+	_sharedStream = nullptr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void QcProcessor::update(const Record *record, const DoubleArray &data,
+                         const QcStatistics *stats) {
 	if ( !record ) {
 		return;
 	}
@@ -115,7 +228,9 @@ void QcProcessor::process(const Record *record, const DoubleArray &data) {
 		_qcp->recordSamplingFrequency = record->samplingFrequency();
 
 		_setFlag = true;
-		_validFlag = setState(record, data);
+		_validFlag = stats ?
+			setStateFromStatistics(record, data, *stats) :
+			setState(record, data);
 	}
 
 	for ( auto &obs : _observers ) {
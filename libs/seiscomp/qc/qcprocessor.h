@@ -62,6 +62,24 @@ class SC_SYSTEM_CLIENT_API QcParameter : public Core::BaseObject {
 };
 
 
+//! Sample statistics of a record which are shared by all processors
+//! of a QcEngine.
+struct SC_SYSTEM_CLIENT_API QcStatistics {
+	size_t count{0};
+	double mean{0};
+	//! The root mean square of the samples with the mean removed
+	double rms{0};
+	double min{0};
+	double max{0};
+
+	//! Computes all values in one pass over the samples
+	void compute(const DoubleArray &data);
+};
+
+
+class QcEngine;
+
+
 DEFINE_SMARTPOINTER(QcProcessor);
 class SC_SYSTEM_CLIENT_API QcProcessor : public WaveformProcessor {
 	DECLARE_SC_CLASS(QcProcessor);
@@ -85,6 +103,12 @@ class SC_SYSTEM_CLIENT_API QcProcessor : public WaveformProcessor {
 		//! Calculates the specific result in derived classes
 		virtual bool setState(const Record* record, const DoubleArray& data) = 0;
 
+		//! Calculates the specific result in derived classes if fed by
+		//! a QcEngine. The default implementation calls setState.
+		virtual bool setStateFromStatistics(const Record *record,
+		                                    const DoubleArray &data,
+		                                    const QcStatistics &stats);
+
 		//! Returns true if QC processing result is successfully initialized; false otherwise
 		bool isSet() const;
 
@@ -96,12 +120,29 @@ class SC_SYSTEM_CLIENT_API QcProcessor : public WaveformProcessor {
 		//! Notifies registered observers
 		virtual void process(const Record* record, const DoubleArray& data) override;
 
+		//! Returns the record fed before the current one. If fed by a
+		//! QcEngine this is the previous record of the engine.
+		const Record *lastRecord() const;
+
+		//! Returns the value of the last sample of the stream
+		double lastSample() const;
+
 		QcParameterPtr _qcp;
 
 	private:
+		void update(const Record *record, const DoubleArray &data,
+		            const QcStatistics *stats);
+
+		//! Called by QcEngine with its statistics and stream state
+		void process(const Record *record, const DoubleArray &data,
+		             const QcStatistics &stats, const StreamState &stream);
+
 		std::deque<QcProcessorObserver *> _observers;
+		const StreamState *_sharedStream{nullptr};
 		bool _setFlag;
 		bool _validFlag;
+
+	friend class QcEngine;
 };
 
 
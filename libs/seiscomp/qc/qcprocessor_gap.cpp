@@ -33,9 +33,9 @@ IMPLEMENT_SC_CLASS_DERIVED(QcProcessorGap, QcProcessor, "QcProcessorGap");
 QcProcessorGap::QcProcessorGap() : QcProcessor() {}
 
 bool QcProcessorGap::setState(const Record *record, const DoubleArray &data) {
-	if ( _stream.lastRecord && record->samplingFrequency() > 0 ) {
+	if ( lastRecord() && record->samplingFrequency() > 0 ) {
 		try {
-			double diff = (double)(record->startTime() - _stream.lastRecord->endTime());
+			double diff = (double)(record->startTime() - lastRecord()->endTime());
 			if (diff >= (0.5 / record->samplingFrequency())) {
 				_qcp->parameter = diff;
 				return true;
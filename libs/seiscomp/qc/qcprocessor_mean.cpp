@@ -35,6 +35,12 @@ bool QcProcessorMean::setState(const Record *record, const DoubleArray &data) {
 	return true;
 }
 
+bool QcProcessorMean::setStateFromStatistics(const Record *, const DoubleArray &,
+                                               const QcStatistics &stats) {
+	_qcp->parameter = stats.mean;
+	return true;
+}
+
 double QcProcessorMean::getMean() {
 	try {
 		return boost::any_cast<double>(_qcp->parameter);
@@ -39,6 +39,9 @@ class SC_SYSTEM_CLIENT_API QcProcessorMean : public QcProcessor {
 
 		double getMean();
 		bool setState(const Record* record, const DoubleArray& data) override;
+		bool setStateFromStatistics(const Record *record,
+		                            const DoubleArray &data,
+		                            const QcStatistics &stats) override;
 };
 
 
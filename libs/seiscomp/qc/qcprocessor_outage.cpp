@@ -36,9 +36,9 @@ void QcProcessorOutage::setThreshold(int threshold) {
 }
 
 bool QcProcessorOutage::setState(const Record *record, const DoubleArray &data) {
-	if (_stream.lastRecord) {
+	if ( lastRecord() ) {
 		try {
-			Core::Time lastRecEnd = _stream.lastRecord->endTime();
+			Core::Time lastRecEnd = lastRecord()->endTime();
 			Core::Time curRecStart = record->startTime();
 			double diff = 0.0;
 
@@ -30,9 +30,9 @@ IMPLEMENT_SC_CLASS_DERIVED(QcProcessorOverlap, QcProcessor, "QcProcessorOverlap"
 QcProcessorOverlap::QcProcessorOverlap() : QcProcessor() {}
 
 bool QcProcessorOverlap::setState(const Record *record, const DoubleArray &data) {
-	if (_stream.lastRecord && record->samplingFrequency() > 0) {
+	if (lastRecord() && record->samplingFrequency() > 0) {
 		try {
-			double diff = (double)(record->startTime() - _stream.lastRecord->endTime());
+			double diff = (double)(record->startTime() - lastRecord()->endTime());
 
 			if (diff < (-0.5 / record->samplingFrequency())) {
 				_qcp->parameter = -1.0*diff;
@@ -34,6 +34,12 @@ bool QcProcessorRms::setState(const Record *record, const DoubleArray &data) {
 	return true;
 }
 
+bool QcProcessorRms::setStateFromStatistics(const Record *, const DoubleArray &,
+                                              const QcStatistics &stats) {
+	_qcp->parameter = stats.rms;
+	return true;
+}
+
 double QcProcessorRms::getRms() {
 	try {
 		return boost::any_cast<double>(_qcp->parameter);
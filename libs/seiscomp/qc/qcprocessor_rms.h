@@ -38,6 +38,9 @@ class SC_SYSTEM_CLIENT_API QcProcessorRms : public QcProcessor {
 		QcProcessorRms();
 		double getRms();
 		bool setState(const Record* record, const DoubleArray& data) override;
+		bool setStateFromStatistics(const Record *record,
+		                            const DoubleArray &data,
+		                            const QcStatistics &stats) override;
 };
 
 
@@ -59,6 +59,31 @@ void QcProcessorSpike::_setFilter(double fsamp) {
 //! *** P R E L I M I N A R Y ***
 //! spike finder test --> TODO replace with better one...
 bool QcProcessorSpike::setState(const Record *rec, const DoubleArray &data) {
+	if ( data.size() < 3 ) {
+		return false;
+	}
+
+	//! rms and mean from filtered data
+	double mean = data.mean();
+	bool found = detect(rec, data, mean, data.rms(mean));
+
+	_stream.lastSample = data[data.size()-1];
+
+	return found;
+}
+
+bool QcProcessorSpike::setStateFromStatistics(const Record *rec,
+                                              const DoubleArray &data,
+                                              const QcStatistics &stats) {
+	if ( data.size() < 3 ) {
+		return false;
+	}
+
+	return detect(rec, data, stats.mean, stats.rms);
+}
+
+bool QcProcessorSpike::detect(const Record *rec, const DoubleArray &data,
+                              double mean, double rms) {
 	int size = data.size();
 	double fsamp = rec->samplingFrequency();
 
@@ -68,21 +93,18 @@ bool QcProcessorSpike::setState(const Record *rec, const DoubleArray &data) {
 
 	Spikes spikes;
 
-	//! rms and mean from filtered data
-	double mean = data.mean();
-	double rms = data.rms(mean);
-
 	double p1, p2;
+	double last = lastSample();
 	int last_i = (int)(-fsamp/2 - 1);
 
 	for ( int i = 0; i < size; i++ ) {
 
 		if ( i != 0 ) {
-			_stream.lastSample = data[i-1];
+			last = data[i-1];
 		}
 
 		if ( i < size -1 ) {
-			p1 = (_stream.lastSample-mean) - (data[i]-mean);
+			p1 = (last-mean) - (data[i]-mean);
 			p2 = (data[i]-mean) - (data[i+1]-mean);
 		}
 		else {
@@ -96,8 +118,6 @@ bool QcProcessorSpike::setState(const Record *rec, const DoubleArray &data) {
 		}
 	}
 
-	_stream.lastSample = data[size-1];
-
 	if ( !spikes.empty() ) {
 		_qcp->parameter = spikes;
 		return true;
@@ -45,6 +45,13 @@ class SC_SYSTEM_CLIENT_API QcProcessorSpike : public QcProcessor {
 		void _setFilter(double fsamp);
 
 		bool setState(const Record* record, const DoubleArray& data) override;
+		bool setStateFromStatistics(const Record *record,
+		                            const DoubleArray &data,
+		                            const QcStatistics &stats) override;
+
+	private:
+		bool detect(const Record *record, const DoubleArray &data,
+		            double mean, double rms);
 
 	private:
 		bool _initFilter;
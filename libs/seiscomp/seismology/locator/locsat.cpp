@@ -31,6 +31,8 @@
 #include <list>
 #include <algorithm>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <sstream>
 
 #include "locsat_private.h"
@@ -154,6 +156,47 @@ bool travelTimeP(double lat, double lon, double depth, double delta, double azi,
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/**
+ * @brief Returns the travel time tables of a prefix. The tables are
+ *        shared by all instances with the same prefix and stay resident
+ *        as long as one of them holds them. LOCSAT only reads them once
+ *        they are set up which makes sharing them among threads safe.
+ *        Tables which could not be read are shared as well so that the
+ *        files are not read again with each location. They are read again
+ *        once no instance holds them anymore.
+ * @param prefix The directory and prefix of the tables
+ * @return The tables which are empty if they could not be read.
+ */
+std::shared_ptr<LOCSAT_TTT> travelTimeTables(const char *prefix) {
+	static std::mutex registryMutex;
+	static std::map<std::string, std::weak_ptr<LOCSAT_TTT>> registry;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	auto &entry = registry[prefix];
+	auto tables = entry.lock();
+	if ( tables ) {
+		return tables;
+	}
+
+	tables = std::shared_ptr<LOCSAT_TTT>(new LOCSAT_TTT, [](LOCSAT_TTT *ttt) {
+		sc_locsat_free_ttt(ttt);
+		delete ttt;
+	});
+
+	sc_locsat_init_ttt(tables.get());
+
+	sc_locsat_setup_tttables(tables.get(), prefix, 0);
+	entry = tables;
+
+	return tables;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 const std::string LOCSAT::_defaultTablePrefix = "iasp91";
 const LOCSAT::IDList LOCSAT::_allowedParameters = {
@@ -190,7 +233,6 @@ LOCSAT::LOCSAT() {
 	reset();
 	LOCSAT::setProfile(_defaultTablePrefix);
 	setDefaultLocatorParams();
-	sc_locsat_init_ttt(&_ttt);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -199,7 +241,6 @@ LOCSAT::LOCSAT() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 LOCSAT::~LOCSAT() {
-	sc_locsat_free_ttt(&_ttt);
 	delete[] _params.prefix;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -273,6 +314,24 @@ bool LOCSAT::init(const Config::Config &config) {
 	}
 	catch ( ... ) {}
 
+	try {
+		_multiStartTrials = config.getInt("LOCSAT.multiStart");
+		if ( _multiStartTrials < 0 ) {
+			SEISCOMP_ERROR("LOCSAT.multiStart: must be >= 0");
+			return false;
+		}
+	}
+	catch ( ... ) {}
+
+	try {
+		_multiStartRadius = config.getDouble("LOCSAT.multiStartRadius");
+		if ( _multiStartRadius <= 0 ) {
+			SEISCOMP_ERROR("LOCSAT.multiStartRadius: must be > 0");
+			return false;
+		}
+	}
+	catch ( ... ) {}
+
 	if ( _enableDebugOutput )
 		SEISCOMP_INFO("LOCSAT: enabled locator-specific debug output");
 
@@ -858,6 +917,9 @@ void LOCSAT::setProfile(const std::string &prefix) {
 
 	_stationCorrection.clear();
 	_tablePrefix = prefix;
+	// Release the tables so that they are looked up again with the next
+	// location which also retries tables that could not be read before.
+	_ttt.reset();
 	const char *tablePath = getenv("SEISCOMP_LOCSAT_TABLE_DIR");
 	if ( tablePath ) {
 		SC_FS_DECLARE_PATH(path, tablePath);
@@ -1163,6 +1225,7 @@ void LOCSAT::reset() {
 	static const LOCSAT_Origerr Na_Origerr = Na_Origerr_Init;
 
 	_sites.clear();
+	_siteIndex.clear();
 	_arrivals.clear();
 	_assocs.clear();
 	_errors.clear();
@@ -1215,12 +1278,7 @@ DataModel::Origin *LOCSAT::locate() {
 	std::cerr << _params << std::endl;
 #endif
 
-	int ierr = sc_locsat_locate_event(
-		&_ttt, _sites.data(), static_cast<int>(_sites.size()),
-		_arrivals.data(), _assocs.data(),
-		&_origin, &_origerr, &_params,
-		_errors.data(), static_cast<int>(_arrivals.size())
-	);
+	int ierr = solve();
 
 	//std::cerr << "ierr = locate_event: " <<  ierr << std::endl;
 
@@ -1743,13 +1801,143 @@ DataModel::Origin *LOCSAT::locate() {
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void LOCSAT::addSite(const char *station, float lat, float lon, float elev) {
-	for ( auto &site : _sites ) {
-		if ( !strcmp(station, site.sta) ) {
-			return;
+int LOCSAT::solve() {
+	if ( !_ttt || (_tttPrefix != P(prefix)) ) {
+		_tttPrefix = P(prefix);
+		_ttt = travelTimeTables(P(prefix));
+	}
+
+	// The solver sets up the tables itself if their directory does not
+	// match the prefix which it only does with tables that could not be
+	// read. As those are shared they must not be passed to the solver at
+	// all. Tables which were read successfully are left untouched and can
+	// be used by any number of trials concurrently.
+	if ( !_ttt->num_phases ) {
+		return LOCSAT_TTerror1;
+	}
+
+	// The trial epicentres of the multi-start mode are placed on a circle
+	// around the initial location or around the station with the earliest
+	// arrival if the initial location is not used.
+	const LOCSAT_Site *reference = nullptr;
+	double refLat = _origin.lat;
+	double refLon = _origin.lon;
+
+	if ( (_multiStartTrials > 0) && (P(use_location) != TRUE) ) {
+		const LOCSAT_Arrival *first = nullptr;
+		for ( auto &arr : _arrivals ) {
+			if ( !first || arr.time < first->time ) {
+				first = &arr;
+			}
+		}
+
+		for ( auto &site : _sites ) {
+			if ( !strcmp(site.sta, first->sta) ) {
+				reference = &site;
+				refLat = site.lat;
+				refLon = site.lon;
+				break;
+			}
 		}
 	}
 
+	if ( (_multiStartTrials <= 0) || ((P(use_location) != TRUE) && !reference) ) {
+		return sc_locsat_locate_event(
+			_ttt.get(), _sites.data(), static_cast<int>(_sites.size()),
+			_arrivals.data(), _assocs.data(),
+			&_origin, &_origerr, &_params,
+			_errors.data(), static_cast<int>(_arrivals.size())
+		);
+	}
+
+	struct Trial {
+		std::vector<LOCSAT_Site>   sites;
+		std::vector<LOCSAT_Assoc>  assocs;
+		std::vector<LOCSAT_Errors> errors;
+		LOCSAT_Origin              origin;
+		LOCSAT_Origerr             origerr;
+		LOCSAT_Params              params;
+		int                        ierr;
+	};
+
+	// The first trial is the regular run with the configured parameters,
+	// all others start from one of the trial epicentres. The solver
+	// writes to the sites, assocs, errors and the origin which is why
+	// each trial works on its own copy. The arrivals and the travel time
+	// tables are only read.
+	std::vector<Trial> trials(static_cast<size_t>(_multiStartTrials) + 1,
+	                          Trial{_sites, _assocs, _errors, _origin,
+	                                _origerr, _params, LOCSAT_NoError});
+
+	for ( int i = 1; i <= _multiStartTrials; ++i ) {
+		double lat, lon;
+		Math::Geo::delandaz2coord(_multiStartRadius,
+		                          360.0 * (i - 1) / _multiStartTrials,
+		                          refLat, refLon, &lat, &lon);
+		trials[i].origin.lat = lat;
+		trials[i].origin.lon = lon;
+		trials[i].params.use_location = TRUE;
+	}
+
+	auto run = [this](Trial &trial) {
+		trial.ierr = sc_locsat_locate_event(
+			_ttt.get(), trial.sites.data(), static_cast<int>(trial.sites.size()),
+			_arrivals.data(), trial.assocs.data(),
+			&trial.origin, &trial.origerr, &trial.params,
+			trial.errors.data(), static_cast<int>(_arrivals.size())
+		);
+	};
+
+	std::vector<std::future<void>> pending;
+	for ( size_t i = 1; i < trials.size(); ++i ) {
+		pending.push_back(std::async(std::launch::async, run, std::ref(trials[i])));
+	}
+
+	run(trials[0]);
+
+	for ( auto &f : pending ) {
+		f.get();
+	}
+
+	// Prefer the solution with the most defining observations and among
+	// those the one with the smallest standard error of the observations
+	Trial *best = &trials[0];
+	for ( auto &trial : trials ) {
+		if ( trial.ierr != LOCSAT_NoError ) {
+			continue;
+		}
+
+		if ( (best->ierr != LOCSAT_NoError)
+		  || (trial.origin.ndef > best->origin.ndef)
+		  || ((trial.origin.ndef == best->origin.ndef)
+		   && (trial.origerr.sdobs < best->origerr.sdobs)) ) {
+			best = &trial;
+		}
+	}
+
+	SEISCOMP_DEBUG("LOCSAT: multi-start selected trial %d of %d",
+	               static_cast<int>(best - trials.data()),
+	               static_cast<int>(trials.size()));
+
+	_sites = std::move(best->sites);
+	_assocs = std::move(best->assocs);
+	_errors = std::move(best->errors);
+	_origin = best->origin;
+	_origerr = best->origerr;
+
+	return best->ierr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void LOCSAT::addSite(const char *station, float lat, float lon, float elev) {
+	if ( !_siteIndex.insert(station).second ) {
+		return;
+	}
+
 	_sites.push_back(LOCSAT_Site());
 
 	_sites.back().sta[sizeof(LOCSAT_Site::sta) - 1] = '\0';
@@ -30,9 +30,11 @@
 #include <seiscomp/seismology/locatorinterface.h>
 #include <seiscomp/core.h>
 
+#include <map>
+#include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
-#include <map>
 
 extern "C" {
 	#include "loc.h"
@@ -92,6 +94,14 @@ class SC_SYSTEM_CORE_API LOCSAT : public Seismology::LocatorInterface {
 		void reset();
 		DataModel::Origin *locate();
 
+		/**
+		 * @brief Runs the LOCSAT solver on the current arrivals. If
+		 *        multi-start is enabled then the trial epicentres are
+		 *        solved concurrently and the best solution is kept.
+		 * @return The LOCSAT error code
+		 */
+		int solve();
+
 		void addSite(const char* station, float lat, float lon, float elev);
 
 		void addArrival(long arrival_id, const char* station, const char* phase,
@@ -120,16 +130,20 @@ class SC_SYSTEM_CORE_API LOCSAT : public Seismology::LocatorInterface {
 		bool                        _usePickSlowness{true};
 
 		bool                        _enableDebugOutput;
+		int                         _multiStartTrials{0};
+		double                      _multiStartRadius{1.0};
 
 		IDList                      _profiles;
 
 		std::vector<LOCSAT_Arrival> _arrivals;
 		std::vector<LOCSAT_Assoc>   _assocs;
 		std::vector<LOCSAT_Site>    _sites;
+		std::unordered_set<std::string> _siteIndex;
 		LOCSAT_Origerr              _origerr;
 		LOCSAT_Origin               _origin;
 		LOCSAT_Params               _params;
-		LOCSAT_TTT                  _ttt;
+		std::shared_ptr<LOCSAT_TTT> _ttt;
+		std::string                 _tttPrefix;
 		std::vector<LOCSAT_Errors>  _errors;
 };
 
@@ -395,6 +395,154 @@ BOOST_AUTO_TEST_CASE(RelocateMultiThreaded) {
 
 
 
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(MultiStartSharedTables) {
+	std::vector<sd::EventParametersPtr> eps;
+	std::vector<sd::OriginPtr> origins;
+	for (const auto &entry : fs::directory_iterator("data/events") ) {
+		eps.push_back(new sd::EventParameters);
+		readEventParameters(*eps.back(), entry.path());
+		origins.push_back(eps.back()->origin(0));
+	}
+
+	Seiscomp::Config::Config config;
+	config.setInt("LOCSAT.multiStart", 4);
+
+	// All instances share the same tables and each of them runs its trials
+	// concurrently.
+	int numThreads = 3;
+	std::vector<Seiscomp::Seismology::LocatorInterfacePtr> locators;
+	for ( int i = 0; i < numThreads; ++i ) {
+		auto *loc = Seiscomp::Seismology::LocatorInterface::Create("LOCSAT");
+		BOOST_REQUIRE(loc->init(config));
+		loc->setProfile("iasp91");
+		locators.push_back(loc);
+	}
+
+	std::vector<std::vector<sd::OriginPtr>> results(numThreads);
+	std::vector<std::thread> threads;
+
+	for ( int i = 0; i < numThreads; ++i ) {
+		threads.emplace_back([&, i]() {
+			for ( auto &origin : origins ) {
+				sd::OriginPtr relocatedOrigin;
+				try {
+					relocatedOrigin = locators[i]->relocate(origin.get());
+				}
+				catch ( ... ) {}
+				results[i].push_back(relocatedOrigin);
+			}
+		});
+	}
+
+	for ( auto &thread : threads ) {
+		thread.join();
+	}
+
+	for ( size_t i = 0; i < origins.size(); ++i ) {
+		auto publicID = origins[i]->publicID();
+		boost::replace_all(publicID, "/", "-");
+		auto it = refData.find(publicID);
+		BOOST_REQUIRE(it != refData.end());
+
+		// The regular run is one of the trials, hence multi-start must
+		// succeed whenever the regular locator does.
+		if ( it->second ) {
+			BOOST_CHECK(results[0][i]);
+		}
+
+		// All instances must come to the same result
+		for ( int t = 1; t < numThreads; ++t ) {
+			BOOST_CHECK_EQUAL(static_cast<bool>(results[0][i]),
+			                  static_cast<bool>(results[t][i]));
+			if ( !results[0][i] || !results[t][i] ) {
+				continue;
+			}
+
+			checkRealQuantity(results[0][i]->latitude(), results[t][i]->latitude(), 0.0000001);
+			checkRealQuantity(results[0][i]->longitude(), results[t][i]->longitude(), 0.0000001);
+			checkRealQuantity(results[0][i]->depth(), results[t][i]->depth(), 0.0000001);
+			checkTimeQuantity(results[0][i]->time(), results[t][i]->time());
+		}
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(MissingTables) {
+	std::vector<sd::EventParametersPtr> eps;
+	std::vector<sd::OriginPtr> origins;
+	for (const auto &entry : fs::directory_iterator("data/events") ) {
+		eps.push_back(new sd::EventParameters);
+		readEventParameters(*eps.back(), entry.path());
+		origins.push_back(eps.back()->origin(0));
+	}
+
+	BOOST_REQUIRE(!origins.empty());
+
+	Seiscomp::Config::Config config, multiStartConfig;
+	multiStartConfig.setInt("LOCSAT.multiStart", 4);
+
+	// Tables which cannot be read must fail every location, also if they
+	// are shared by several instances which locate concurrently with
+	// multi-start trials.
+	int numThreads = 3;
+	std::vector<Seiscomp::Seismology::LocatorInterfacePtr> locators;
+	for ( int i = 0; i < numThreads; ++i ) {
+		auto *loc = Seiscomp::Seismology::LocatorInterface::Create("LOCSAT");
+		BOOST_REQUIRE(loc->init(i ? multiStartConfig : config));
+		loc->setProfile("nonexistent");
+		locators.push_back(loc);
+	}
+
+	std::vector<int> failures(numThreads, 0);
+	std::vector<std::thread> threads;
+
+	for ( int i = 0; i < numThreads; ++i ) {
+		threads.emplace_back([&, i]() {
+			for ( int round = 0; round < 2; ++round ) {
+				for ( auto &origin : origins ) {
+					try {
+						locators[i]->relocate(origin.get());
+					}
+					catch ( const Seiscomp::Seismology::LocatorException & ) {
+						++failures[i];
+					}
+				}
+			}
+		});
+	}
+
+	for ( auto &thread : threads ) {
+		thread.join();
+	}
+
+	for ( int i = 0; i < numThreads; ++i ) {
+		BOOST_CHECK_EQUAL(failures[i], static_cast<int>(origins.size() * 2));
+	}
+
+	// Switching back to valid tables must work again
+	locators[0]->setProfile("iasp91");
+	for ( auto &origin : origins ) {
+		auto publicID = origin->publicID();
+		boost::replace_all(publicID, "/", "-");
+		auto it = refData.find(publicID);
+		if ( it == refData.end() || !it->second ) {
+			continue;
+		}
+
+		BOOST_CHECK_NO_THROW(locators[0]->relocate(origin.get()));
+		break;
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
 //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 BOOST_AUTO_TEST_SUITE_END()
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
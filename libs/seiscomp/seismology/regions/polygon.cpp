@@ -59,6 +59,8 @@ size_t PolyRegions::read(const std::string& location) {
 	}
 
 	_regions.readDir(directory.string());
+	_index.build(_regions.features());
+	_indexGeneration = _regions.generation();
 
 	info();
 
@@ -70,6 +72,8 @@ size_t PolyRegions::read(const std::string& location) {
 
 
 void PolyRegions::addRegion(GeoFeature *r) {
+	// The index is outdated by the new generation and rebuilt with the
+	// next read()
 	_regions.addFeature(r);
 }
 
@@ -119,6 +123,10 @@ void PolyRegions::info() {
 
 GeoFeature *PolyRegions::findRegion(double lat, double lon) const {
 	auto gc = GeoCoordinate(lat, lon).normalize();
+	if ( _indexGeneration == _regions.generation() ) {
+		return _index.findFirst(gc);
+	}
+
 	for ( auto *f : _regions.features() ) {
 		if ( f->contains(gc) ) {
 			return f;
@@ -25,6 +25,7 @@
 #include <seiscomp/core.h>
 #include <seiscomp/geo/feature.h>
 #include <seiscomp/geo/featureset.h>
+#include <seiscomp/geo/index/featureindex.h>
 #include <vector>
 
 
@@ -42,6 +43,11 @@ class SC_SYSTEM_CORE_API PolyRegions {
 		void print();
 		void info();
 
+		/**
+		 * @brief Returns the first region which contains a point. Regions
+		 *        read with read() are looked up with a spatial index,
+		 *        regions added with addRegion() are tested in order.
+		 */
 		GeoFeature *findRegion(double lat, double lon) const;
 		std::string findRegionName(double lat, double lon) const;
 
@@ -55,6 +61,8 @@ class SC_SYSTEM_CORE_API PolyRegions {
 
 	private:
 		GeoFeatureSet _regions;
+		FeatureIndex _index;
+		uint64_t _indexGeneration{0};
 		std::string _dataDir;
 };
 
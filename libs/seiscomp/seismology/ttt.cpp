@@ -22,6 +22,10 @@
 #include <seiscomp/math/geo.h>
 #include <seiscomp/core/interfacefactory.ipp>
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+
 extern "C" {
 #include "loc.h"
 }
@@ -92,87 +96,129 @@ void TravelTimeList::sortByTime() {
 }
 
 
-const TravelTime *getPhase(const TravelTimeList *list, const std::string &phase) {
-	TravelTimeList::const_iterator it;
+bool matchesPhase(const char *code, const char *phase, double delta) {
+	// direct match
+	if ( !strcmp(code, phase) ) return true;
 
-	for ( it = list->begin(); it != list->end(); ++it ) {
-		// direct match
-		if ( (*it).phase == phase ) break;
+	// no match for 1st character -> don't keep trying
+	if ( code[0] != phase[0] )
+		return false;
 
-		// no match for 1st character -> don't keep trying
-		if ( (*it).phase[0] != phase[0] )
-			continue;
-
-		if ( phase == "P" ) {
-			if ( list->delta < 120 ) {
-				if ( (*it).phase == "Pn"    ) break;
-				if ( (*it).phase == "Pb"    ) break;
-				if ( (*it).phase == "Pg"    ) break;
-				if ( (*it).phase == "Pdiff" ) break;
-			}
-			else
-				if ( (*it).phase.substr(0,3) == "PKP" ) break;
+	if ( !strcmp(phase, "P") ) {
+		if ( delta < 120 ) {
+			if ( !strcmp(code, "Pn"   ) ) return true;
+			if ( !strcmp(code, "Pb"   ) ) return true;
+			if ( !strcmp(code, "Pg"   ) ) return true;
+			if ( !strcmp(code, "Pdiff") ) return true;
 		}
-		else if ( phase == "pP" ) {
-			if ( list->delta < 120 ) {
-				if ( (*it).phase == "pPn"   ) break;
-				if ( (*it).phase == "pPb"   ) break;
-				if ( (*it).phase == "pPg"   ) break;
-				if ( (*it).phase == "pPdiff") break;
-			}
-			else {
-				if ( (*it).phase.substr(0,4) == "pPKP" ) break;
-			}
+		else
+			if ( !strncmp(code, "PKP", 3) ) return true;
+	}
+	else if ( !strcmp(phase, "pP") ) {
+		if ( delta < 120 ) {
+			if ( !strcmp(code, "pPn"   ) ) return true;
+			if ( !strcmp(code, "pPb"   ) ) return true;
+			if ( !strcmp(code, "pPg"   ) ) return true;
+			if ( !strcmp(code, "pPdiff") ) return true;
 		}
-		else if ( phase == "PKP" ) {
-			if ( list->delta > 100 ) {
-				if ( (*it).phase == "PKPab" ) break;
-				if ( (*it).phase == "PKPbc" ) break;
-				if ( (*it).phase == "PKPdf" ) break;
-			}
+		else {
+			if ( !strncmp(code, "pPKP", 4) ) return true;
 		}
-		else if ( phase == "PKKP" ) {
-			if ( list->delta > 100 && list->delta < 130 ) {
-				if ( (*it).phase == "PKKPab" ) break;
-				if ( (*it).phase == "PKKPbc" ) break;
-				if ( (*it).phase == "PKKPdf" ) break;
-			}
+	}
+	else if ( !strcmp(phase, "PKP") ) {
+		if ( delta > 100 ) {
+			if ( !strcmp(code, "PKPab") ) return true;
+			if ( !strcmp(code, "PKPbc") ) return true;
+			if ( !strcmp(code, "PKPdf") ) return true;
 		}
-		else if ( phase == "SKP" ) {
-			if ( list->delta > 115 && list->delta < 145 ) {
-				if ( (*it).phase == "SKPab" ) break;
-				if ( (*it).phase == "SKPbc" ) break;
-				if ( (*it).phase == "SKPdf" ) break;
-			}
+	}
+	else if ( !strcmp(phase, "PKKP") ) {
+		if ( delta > 100 && delta < 130 ) {
+			if ( !strcmp(code, "PKKPab") ) return true;
+			if ( !strcmp(code, "PKKPbc") ) return true;
+			if ( !strcmp(code, "PKKPdf") ) return true;
 		}
-		else if ( phase == "PP" ) {
-			if ( (*it).phase == "PnPn" ) break;
+	}
+	else if ( !strcmp(phase, "SKP") ) {
+		if ( delta > 115 && delta < 145 ) {
+			if ( !strcmp(code, "SKPab") ) return true;
+			if ( !strcmp(code, "SKPbc") ) return true;
+			if ( !strcmp(code, "SKPdf") ) return true;
 		}
-		else if ( phase == "sP" ) {
-			if ( list->delta < 120 ) {
-				if ( (*it).phase == "sPn"   ) break;
-				if ( (*it).phase == "sPb"   ) break;
-				if ( (*it).phase == "sPg"   ) break;
-				if ( (*it).phase == "sPdiff") break;
-			}
-			else {
-				if ( (*it).phase.substr(0,4)=="sPKP" ) break;
-			}
+	}
+	else if ( !strcmp(phase, "PP") ) {
+		if ( !strcmp(code, "PnPn") ) return true;
+	}
+	else if ( !strcmp(phase, "sP") ) {
+		if ( delta < 120 ) {
+			if ( !strcmp(code, "sPn"   ) ) return true;
+			if ( !strcmp(code, "sPb"   ) ) return true;
+			if ( !strcmp(code, "sPg"   ) ) return true;
+			if ( !strcmp(code, "sPdiff") ) return true;
 		}
-		else if ( phase == "S" ) {
-			if ( (*it).phase == "Sn"   ) break;
-			if ( (*it).phase == "Sb"   ) break;
-			if ( (*it).phase == "Sg"   ) break;
-			if ( (*it).phase == "S"    ) break;
-			if ( (*it).phase == "Sdiff") break;
-			if ( (*it).phase.substr(0,3) == "SKS" ) break;
+		else {
+			if ( !strncmp(code, "sPKP", 4) ) return true;
 		}
 	}
+	else if ( !strcmp(phase, "S") ) {
+		if ( !strcmp(code, "Sn"   ) ) return true;
+		if ( !strcmp(code, "Sb"   ) ) return true;
+		if ( !strcmp(code, "Sg"   ) ) return true;
+		if ( !strcmp(code, "S"    ) ) return true;
+		if ( !strcmp(code, "Sdiff") ) return true;
+		if ( !strncmp(code, "SKS", 3) ) return true;
+	}
 
-	if ( it == list->end() )
-		return nullptr;
+	return false;
+}
 
-	return &(*it);
+
+const TravelTime *getPhase(const TravelTimeList *list, const std::string &phase) {
+	for ( const auto &tt : *list ) {
+		if ( matchesPhase(tt.phase.c_str(), phase.c_str(), list->delta) ) {
+			return &tt;
+		}
+	}
+
+	return nullptr;
+}
+
+
+void computeDistances(double lat1, double lon1, size_t count,
+                      const double *lat2, const double *lon2,
+                      double *delta, double *azimuth) {
+	// Same as sc_locsat_distaz2 but with the source terms computed once
+	const double esq = (1.0 - 1.0 / 298.25) * (1.0 - 1.0 / 298.25);
+	const double d2r = M_PI / 180.0;
+	const double r2d = 180.0 / M_PI;
+
+	double rlat1 = atan(tan(lat1 * d2r) * esq);
+	double slat1 = sin(rlat1);
+	double clat1 = cos(rlat1);
+
+	for ( size_t i = 0; i < count; ++i ) {
+		double rlat2 = atan(tan(lat2[i] * d2r) * esq);
+		double rdlon = (lon2[i] - lon1) * d2r;
+		double slat2 = sin(rlat2);
+		double clat2 = cos(rlat2);
+		double cdlon = cos(rdlon);
+		double sdlon = sin(rdlon);
+
+		double cdel = slat1 * slat2 + clat1 * clat2 * cdlon;
+		cdel = (cdel <  1.0) ? cdel :  1.0;
+		cdel = (cdel > -1.0) ? cdel : -1.0;
+		delta[i] = acos(cdel) * r2d;
+
+		if ( azimuth ) {
+			double azi = atan2(sdlon * clat2, clat1 * slat2 - slat1 * clat2 * cdlon) * r2d;
+			azimuth[i] = azi < 0 ? azi + 360.0 : azi;
+		}
+
+		if ( lat2[i] == lat1 && lon2[i] == lon1 ) {
+			delta[i] = 0;
+			if ( azimuth ) azimuth[i] = 0;
+		}
+	}
 }
 
 
@@ -244,6 +290,32 @@ double TravelTimeTableInterface::computeTime(const char *phase,
 }
 
 
+size_t TravelTimeTableInterface::computeTimes(const char *phase,
+                                              double lat1, double lon1, double dep1,
+                                              size_t count,
+                                              const double *lat2, const double *lon2,
+                                              const double *elev2, double *times,
+                                              int ellc) {
+	size_t found = 0;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		double elev = elev2 ? elev2[i] : 0.0;
+
+		try {
+			times[i] = phase
+			         ? computeTime(phase, lat1, lon1, dep1, lat2[i], lon2[i], elev, ellc)
+			         : computeFirst(lat1, lon1, dep1, lat2[i], lon2[i], elev, ellc).time;
+			++found;
+		}
+		catch ( NoPhaseError & ) {
+			times[i] = std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+
+	return found;
+}
+
+
 TravelTimeTableInterfacePtr TravelTimeTable::_interface;
 
 
@@ -202,6 +202,35 @@ class SC_SYSTEM_CORE_API TravelTimeTableInterface : public Core::BaseObject {
 		            double lat1, double lon1, double dep1,
 		            double lat2, double lon2, double elev2=0.,
 		            int ellc = 1);
+
+		/**
+		 * Computes the travel times of one phase from one source to many
+		 * receivers into a caller provided array. Implementations set up
+		 * the source once and compute the distances of all receivers in
+		 * one pass without allocating a TravelTimeList per receiver. The
+		 * default implementation calls computeTime or computeFirst for
+		 * each receiver.
+		 *
+		 * @param phase The phase code as passed to computeTime or nullptr
+		 *              for the first arrival as returned by computeFirst
+		 * @param lat1 Latitude of source
+		 * @param lon1 Longitude of source
+		 * @param dep1 The source depth in km
+		 * @param count The number of receivers
+		 * @param lat2 Latitudes of the receivers
+		 * @param lon2 Longitudes of the receivers
+		 * @param elev2 Elevations of the receivers in m or nullptr
+		 * @param times The travel times in seconds. Receivers for which
+		 *              the phase does not exist are set to NaN.
+		 * @param ellc Apply ellipticity correction (1 = on, 0 = off)
+		 * @returns The number of receivers with a travel time
+		 */
+		virtual size_t
+		computeTimes(const char *phase,
+		             double lat1, double lon1, double dep1,
+		             size_t count, const double *lat2, const double *lon2,
+		             const double *elev2, double *times,
+		             int ellc = 1);
 };
 
 
@@ -257,6 +286,34 @@ double ellipticityCorrection(const std::string &phase,
                              double lat1, double lon1, double depth,
                              double lat2, double lon2);
 
+/**
+ * @brief Computes the distances and azimuths from one source to many
+ *        receivers in the same way as LOCSAT and libtau do for a single
+ *        receiver, using geocentric latitudes.
+ * @param lat1 Source latitude in degrees
+ * @param lon1 Source longitude in degrees
+ * @param count The number of receivers
+ * @param lat2 Receiver latitudes in degrees
+ * @param lon2 Receiver longitudes in degrees
+ * @param delta The output distances in degrees
+ * @param azimuth The output azimuths in degrees or nullptr
+ */
+SC_SYSTEM_CORE_API
+void computeDistances(double lat1, double lon1, size_t count,
+                      const double *lat2, const double *lon2,
+                      double *delta, double *azimuth);
+
+/**
+ * @brief Checks if a phase code returned by a travel time interface
+ *        satisfies a requested phase, e.g. "Pn" for "P" below 120 degrees.
+ *        getPhase returns the first travel time which satisfies it.
+ * @param code The returned phase code
+ * @param phase The requested phase
+ * @param delta The distance in degrees
+ */
+SC_SYSTEM_CORE_API
+bool matchesPhase(const char *code, const char *phase, double delta);
+
 // Retrieve traveltime for the specified phase. Returns true if phase was
 // found, false otherwise.
 SC_SYSTEM_CORE_API
@@ -0,0 +1,874 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_COMPONENT TTTGrid
+
+#include <seiscomp/seismology/ttt/grid.h>
+#include <seiscomp/core/strings.h>
+#include <seiscomp/logging/log.h>
+#include <seiscomp/system/application.h>
+#include <seiscomp/system/environment.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+
+extern "C" {
+
+#include "geog.h"
+#include "loc.h"
+
+}
+
+
+using namespace std;
+
+
+namespace Seiscomp {
+namespace TTT {
+
+
+namespace {
+
+
+const char     Magic[4] = { 'S', 'C', 'T', 'G' };
+const uint32_t Version = 1;
+
+
+struct Settings {
+	string         interface;
+	string         model;
+	double         distanceStep{0.5};  // degrees
+	double         maxDistance{180};   // degrees
+	double         depthStep{5};       // km
+	double         maxDepth{700};      // km
+	double         tolerance{0.05};    // seconds
+	vector<string> phases{"P", "S"};
+	string         file;
+
+	bool read(const string &name);
+	string key() const;
+};
+
+
+void readOptional(const Config::Config *cfg, const string &name, string &value) {
+	try { value = cfg->getString(name); } catch ( ... ) {}
+}
+
+
+void readOptional(const Config::Config *cfg, const string &name, double &value) {
+	try { value = cfg->getDouble(name); } catch ( ... ) {}
+}
+
+
+void readOptional(const Config::Config *cfg, const string &name, vector<string> &value) {
+	try { value = cfg->getStrings(name); } catch ( ... ) {}
+}
+
+
+bool Settings::read(const string &name) {
+	auto app = Seiscomp::System::Application::Instance();
+	const Config::Config *cfg = nullptr;
+	Config::Config tmp;
+
+	if ( app ) {
+		cfg = &app->configuration();
+	}
+	else if ( Environment::Instance()->initConfig(&tmp, "") ) {
+		cfg = &tmp;
+	}
+
+	string base = "ttt.grid." + name + ".";
+
+	if ( cfg ) {
+		readOptional(cfg, base + "interface", interface);
+	}
+
+	if ( interface.empty() ) {
+		// No profile, expect "interface:model"
+		auto pos = name.find(':');
+		if ( pos == string::npos ) {
+			return false;
+		}
+
+		interface = name.substr(0, pos);
+		model = name.substr(pos + 1);
+	}
+	else {
+		readOptional(cfg, base + "model", model);
+		readOptional(cfg, base + "distanceStep", distanceStep);
+		readOptional(cfg, base + "maxDistance", maxDistance);
+		readOptional(cfg, base + "depthStep", depthStep);
+		readOptional(cfg, base + "maxDepth", maxDepth);
+		readOptional(cfg, base + "tolerance", tolerance);
+		readOptional(cfg, base + "phases", phases);
+		readOptional(cfg, base + "file", file);
+
+		if ( !file.empty() ) {
+			file = Environment::Instance()->absolutePath(file);
+		}
+	}
+
+	return !interface.empty()
+	    && distanceStep > 0 && maxDistance >= distanceStep && maxDistance <= 180
+	    && depthStep > 0 && maxDepth >= depthStep
+	    && tolerance >= 0;
+}
+
+
+string Settings::key() const {
+	string k = Core::stringify("%s|%s|%f|%f|%f|%f|%f|%s|",
+	                           interface.c_str(), model.c_str(),
+	                           distanceStep, maxDistance, depthStep, maxDepth,
+	                           tolerance, file.c_str());
+	for ( const auto &phase : phases ) {
+		k += phase;
+		k += ',';
+	}
+	return k;
+}
+
+
+void writeString(ostream &os, const string &str) {
+	uint32_t len = static_cast<uint32_t>(str.size());
+	os.write(reinterpret_cast<const char*>(&len), sizeof(len));
+	os.write(str.data(), len);
+}
+
+
+bool readString(istream &is, string &str) {
+	uint32_t len;
+	if ( !is.read(reinterpret_cast<char*>(&len), sizeof(len)) || len > 0xffff ) {
+		return false;
+	}
+	str.resize(len);
+	return static_cast<bool>(is.read(&str[0], len));
+}
+
+
+template <typename T>
+void writeValue(ostream &os, const T &value) {
+	os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+template <typename T>
+bool readValue(istream &is, T &value) {
+	return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+struct Grid::Tables {
+	struct Node {
+		float    time;    // NaN if the phase does not exist at this node
+		float    dtdd;
+		float    dtdh;
+		float    dddp;
+		float    takeoff;
+		uint32_t phase;   // index into Table::names
+	};
+
+	static_assert(sizeof(Node) == 24, "unexpected node padding");
+
+	struct Table {
+		explicit Table(string k) : key(move(k)) {}
+
+		string            key;    // requested phase, empty for first arrivals
+		vector<string>    names;  // phase names returned by the interface
+		vector<Node>      nodes;  // depth major
+		vector<uint8_t>   cells;  // 1 if a cell can be interpolated
+		atomic<bool>      ready{false};
+	};
+
+	static shared_ptr<Tables> Get(const Settings &settings);
+
+	const Table *table(size_t index);
+	const Table *table(const char *phase);
+
+	bool interpolate(const Table &table, double delta, double depth,
+	                 TravelTime &tt) const;
+
+	void precompute();
+	void build(Table &table);
+	void updateCells(Table &table);
+
+	size_t load(const string &filename);
+	bool save(const string &filename) const;
+
+	Settings                    settings;
+	size_t                      distances;
+	size_t                      depths;
+	TravelTimeTableInterfacePtr sampler;
+	vector<unique_ptr<Table>>   tables;  // first arrivals followed by phases
+	mutex                       buildMutex;
+};
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+shared_ptr<Grid::Tables> Grid::Tables::Get(const Settings &settings) {
+	static mutex registryMutex;
+	static map<string, weak_ptr<Tables>> registry;
+
+	lock_guard<mutex> lock(registryMutex);
+
+	string key = settings.key();
+	auto tables = registry[key].lock();
+	if ( tables ) {
+		return tables;
+	}
+
+	tables = make_shared<Tables>();
+	tables->settings = settings;
+	tables->distances = static_cast<size_t>(floor(settings.maxDistance / settings.distanceStep)) + 1;
+	tables->depths = static_cast<size_t>(floor(settings.maxDepth / settings.depthStep)) + 1;
+	tables->sampler = TravelTimeTableInterface::Create(settings.interface.c_str());
+
+	if ( !tables->sampler || !tables->sampler->setModel(settings.model) ) {
+		return nullptr;
+	}
+
+	tables->tables.emplace_back(new Table(string()));
+	for ( const auto &phase : settings.phases ) {
+		tables->tables.emplace_back(new Table(phase));
+	}
+
+	if ( !settings.file.empty() ) {
+		if ( tables->load(settings.file) < tables->tables.size() ) {
+			tables->precompute();
+			if ( !tables->save(settings.file) ) {
+				SEISCOMP_WARNING("Failed to write travel time grid to %s",
+				                 settings.file.c_str());
+			}
+		}
+	}
+
+	registry[key] = tables;
+	return tables;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const Grid::Tables::Table *Grid::Tables::table(size_t index) {
+	Table &t = *tables[index];
+
+	if ( !t.ready.load(memory_order_acquire) ) {
+		lock_guard<mutex> lock(buildMutex);
+		if ( !t.ready.load(memory_order_relaxed) ) {
+			build(t);
+			t.ready.store(true, memory_order_release);
+		}
+	}
+
+	return &t;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const Grid::Tables::Table *Grid::Tables::table(const char *phase) {
+	for ( size_t i = 1; i < tables.size(); ++i ) {
+		if ( tables[i]->key == phase ) {
+			return table(i);
+		}
+	}
+
+	return nullptr;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::Tables::interpolate(const Table &t, double delta, double depth,
+                               TravelTime &tt) const {
+	double x = delta / settings.distanceStep;
+	double y = depth / settings.depthStep;
+
+	// This comparison also rejects NaN
+	if ( !(x >= 0) || !(y >= 0) ) {
+		return false;
+	}
+
+	size_t j = static_cast<size_t>(x);
+	size_t i = static_cast<size_t>(y);
+
+	// Values on the last grid line belong to the last cell
+	if ( j >= distances - 1 ) {
+		if ( x > distances - 1 ) return false;
+		j = distances - 2;
+	}
+
+	if ( i >= depths - 1 ) {
+		if ( y > depths - 1 ) return false;
+		i = depths - 2;
+	}
+
+	if ( !t.cells[i * (distances - 1) + j] ) {
+		return false;
+	}
+
+	double fx = x - j;
+	double fy = y - i;
+	const Node &n00 = t.nodes[i * distances + j];
+	const Node &n01 = t.nodes[i * distances + j + 1];
+	const Node &n10 = t.nodes[(i + 1) * distances + j];
+	const Node &n11 = t.nodes[(i + 1) * distances + j + 1];
+
+	auto lerp = [&](float Node::*v) {
+		return (1 - fy) * ((1 - fx) * n00.*v + fx * n01.*v)
+		     + fy * ((1 - fx) * n10.*v + fx * n11.*v);
+	};
+
+	tt = TravelTime(t.names[n00.phase], lerp(&Node::time), lerp(&Node::dtdd),
+	                lerp(&Node::dtdh), lerp(&Node::dddp), lerp(&Node::takeoff));
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Grid::Tables::precompute() {
+	for ( size_t i = 0; i < tables.size(); ++i ) {
+		table(i);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Grid::Tables::build(Table &t) {
+	const float nan = numeric_limits<float>::quiet_NaN();
+	map<string, uint32_t> nameIndex;
+
+	SEISCOMP_DEBUG("Building %s:%s travel time grid for %s",
+	               settings.interface.c_str(), settings.model.c_str(),
+	               t.key.empty() ? "first arrivals" : t.key.c_str());
+
+	t.names.clear();
+	t.nodes.assign(distances * depths, Node{nan, nan, nan, nan, nan, 0});
+
+	// Sample along the equator where the distance equals the longitude
+	// difference. Ellipticity corrections are applied per query.
+	for ( size_t i = 0; i < depths; ++i ) {
+		double depth = i * settings.depthStep;
+
+		for ( size_t j = 0; j < distances; ++j ) {
+			double delta = j * settings.distanceStep;
+			TravelTime tt;
+
+			try {
+				tt = t.key.empty()
+				   ? sampler->computeFirst(0, 0, depth, 0, delta, 0, 0)
+				   : sampler->compute(t.key.c_str(), 0, 0, depth, 0, delta, 0, 0);
+			}
+			catch ( std::exception & ) {
+				continue;
+			}
+
+			auto it = nameIndex.find(tt.phase);
+			if ( it == nameIndex.end() ) {
+				it = nameIndex.emplace(tt.phase, static_cast<uint32_t>(t.names.size())).first;
+				t.names.push_back(tt.phase);
+			}
+
+			Node &node = t.nodes[i * distances + j];
+			node.time = static_cast<float>(tt.time);
+			node.dtdd = static_cast<float>(tt.dtdd);
+			node.dtdh = static_cast<float>(tt.dtdh);
+			node.dddp = static_cast<float>(tt.dddp);
+			node.takeoff = static_cast<float>(tt.takeoff);
+			node.phase = it->second;
+		}
+	}
+
+	updateCells(t);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Grid::Tables::updateCells(Table &t) {
+	auto valid = [&t](const Node &n) {
+		return !std::isnan(n.time) && n.phase < t.names.size();
+	};
+
+	// The error of a bilinear interpolation is bounded by h^2/8 |f''|
+	// per axis which is estimated by the second difference of the nodes.
+	// Only neighbours on the same branch are taken into account.
+	vector<float> errors(t.nodes.size(), 0);
+
+	auto secondDifference = [&](const Node &prev, const Node &node, const Node &next) {
+		if ( !valid(prev) || !valid(next)
+		  || prev.phase != node.phase || next.phase != node.phase ) {
+			return 0.0f;
+		}
+		return fabs(prev.time - 2 * node.time + next.time);
+	};
+
+	for ( size_t i = 0; i < depths; ++i ) {
+		for ( size_t j = 0; j < distances; ++j ) {
+			size_t n = i * distances + j;
+			if ( !valid(t.nodes[n]) ) continue;
+
+			float e = 0;
+			if ( j > 0 && j + 1 < distances ) {
+				e += secondDifference(t.nodes[n - 1], t.nodes[n], t.nodes[n + 1]);
+			}
+			if ( i > 0 && i + 1 < depths ) {
+				e += secondDifference(t.nodes[n - distances], t.nodes[n], t.nodes[n + distances]);
+			}
+
+			errors[n] = e / 8;
+		}
+	}
+
+	t.cells.assign((depths - 1) * (distances - 1), 0);
+
+	size_t usable = 0;
+	for ( size_t i = 0; i + 1 < depths; ++i ) {
+		for ( size_t j = 0; j + 1 < distances; ++j ) {
+			size_t corners[4] = {
+				i * distances + j, i * distances + j + 1,
+				(i + 1) * distances + j, (i + 1) * distances + j + 1
+			};
+
+			bool ok = true;
+			for ( auto n : corners ) {
+				if ( !valid(t.nodes[n])
+				  || t.nodes[n].phase != t.nodes[corners[0]].phase
+				  || errors[n] > settings.tolerance ) {
+					ok = false;
+					break;
+				}
+			}
+
+			if ( ok ) {
+				t.cells[i * (distances - 1) + j] = 1;
+				++usable;
+			}
+		}
+	}
+
+	SEISCOMP_DEBUG("%s:%s travel time grid for %s: %lu of %lu cells interpolated",
+	               settings.interface.c_str(), settings.model.c_str(),
+	               t.key.empty() ? "first arrivals" : t.key.c_str(),
+	               static_cast<unsigned long>(usable),
+	               static_cast<unsigned long>(t.cells.size()));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t Grid::Tables::load(const string &filename) {
+	ifstream ifs(filename, ios::binary);
+	if ( !ifs ) {
+		return 0;
+	}
+
+	char magic[4];
+	uint32_t version, fileDistances, fileDepths, tableCount;
+	double distanceStep, depthStep;
+	string interface, model;
+
+	if ( !ifs.read(magic, sizeof(magic)) || memcmp(magic, Magic, sizeof(magic))
+	  || !readValue(ifs, version) || version != Version
+	  || !readString(ifs, interface) || !readString(ifs, model)
+	  || !readValue(ifs, distanceStep) || !readValue(ifs, depthStep)
+	  || !readValue(ifs, fileDistances) || !readValue(ifs, fileDepths)
+	  || !readValue(ifs, tableCount) ) {
+		SEISCOMP_WARNING("%s: invalid travel time grid header", filename.c_str());
+		return 0;
+	}
+
+	if ( interface != settings.interface || model != settings.model
+	  || distanceStep != settings.distanceStep || depthStep != settings.depthStep
+	  || fileDistances != distances || fileDepths != depths ) {
+		SEISCOMP_INFO("%s: travel time grid does not match the configuration",
+		              filename.c_str());
+		return 0;
+	}
+
+	size_t loaded = 0;
+	lock_guard<mutex> lock(buildMutex);
+
+	for ( uint32_t n = 0; n < tableCount; ++n ) {
+		string key;
+		uint32_t nameCount;
+		vector<string> names;
+		vector<Node> nodes(distances * depths);
+
+		if ( !readString(ifs, key) || !readValue(ifs, nameCount) ) {
+			break;
+		}
+
+		names.resize(nameCount);
+		bool ok = true;
+		for ( auto &name : names ) {
+			if ( !readString(ifs, name) ) {
+				ok = false;
+				break;
+			}
+		}
+
+		if ( !ok || !ifs.read(reinterpret_cast<char*>(nodes.data()),
+		                      static_cast<streamsize>(nodes.size() * sizeof(Node))) ) {
+			SEISCOMP_WARNING("%s: truncated travel time grid", filename.c_str());
+			break;
+		}
+
+		for ( auto &t : tables ) {
+			if ( t->key != key || t->ready.load(memory_order_relaxed) ) continue;
+			t->names = move(names);
+			t->nodes = move(nodes);
+			updateCells(*t);
+			t->ready.store(true, memory_order_release);
+			++loaded;
+			break;
+		}
+	}
+
+	SEISCOMP_INFO("%s: loaded %lu travel time grid tables", filename.c_str(),
+	              static_cast<unsigned long>(loaded));
+
+	return loaded;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::Tables::save(const string &filename) const {
+	vector<const Table*> ready;
+	for ( const auto &t : tables ) {
+		if ( t->ready.load(memory_order_acquire) ) {
+			ready.push_back(t.get());
+		}
+	}
+
+	// Write to a temporary file first to never leave a partial grid
+	// behind which other processes could pick up
+	string tmpFile = filename + ".tmp";
+
+	{
+		ofstream ofs(tmpFile, ios::binary | ios::trunc);
+		if ( !ofs ) {
+			return false;
+		}
+
+		ofs.write(Magic, sizeof(Magic));
+		writeValue(ofs, Version);
+		writeString(ofs, settings.interface);
+		writeString(ofs, settings.model);
+		writeValue(ofs, settings.distanceStep);
+		writeValue(ofs, settings.depthStep);
+		writeValue(ofs, static_cast<uint32_t>(distances));
+		writeValue(ofs, static_cast<uint32_t>(depths));
+		writeValue(ofs, static_cast<uint32_t>(ready.size()));
+
+		for ( auto t : ready ) {
+			writeString(ofs, t->key);
+			writeValue(ofs, static_cast<uint32_t>(t->names.size()));
+			for ( const auto &name : t->names ) {
+				writeString(ofs, name);
+			}
+			ofs.write(reinterpret_cast<const char*>(t->nodes.data()),
+			          static_cast<streamsize>(t->nodes.size() * sizeof(Node)));
+		}
+
+		if ( !ofs.flush() ) {
+			remove(tmpFile.c_str());
+			return false;
+		}
+	}
+
+	if ( rename(tmpFile.c_str(), filename.c_str()) != 0 ) {
+		remove(tmpFile.c_str());
+		return false;
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Grid::Grid() = default;
+Grid::~Grid() = default;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::setModel(const string &model) {
+	if ( _tables && _model == model ) {
+		return true;
+	}
+
+	Settings settings;
+	if ( !settings.read(model) ) {
+		SEISCOMP_ERROR("Invalid travel time grid profile: %s", model.c_str());
+		return false;
+	}
+
+	TravelTimeTableInterfacePtr interface = TravelTimeTableInterface::Create(settings.interface.c_str());
+	if ( !interface || !interface->setModel(settings.model) ) {
+		SEISCOMP_ERROR("Failed to set up travel time interface %s with model %s",
+		               settings.interface.c_str(), settings.model.c_str());
+		return false;
+	}
+
+	auto tables = Tables::Get(settings);
+	if ( !tables ) {
+		return false;
+	}
+
+	_model = model;
+	_interface = interface;
+	_tables = tables;
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const string &Grid::model() const {
+	return _model;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+TravelTimeList *Grid::compute(double lat1, double lon1, double dep1,
+                              double lat2, double lon2, double elev2,
+                              int ellc) {
+	if ( !_interface ) {
+		return nullptr;
+	}
+
+	return _interface->compute(lat1, lon1, dep1, lat2, lon2, elev2, ellc);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+TravelTime Grid::compute(const char *phase,
+                         double lat1, double lon1, double dep1,
+                         double lat2, double lon2, double elev2,
+                         int ellc) {
+	if ( !_tables ) {
+		throw NoPhaseError();
+	}
+
+	double delta, azi1, azi2;
+	sc_locsat_distaz2(lat1, lon1, lat2, lon2, &delta, &azi1, &azi2);
+
+	TravelTime tt;
+	auto table = _tables->table(phase);
+	if ( !table || !_tables->interpolate(*table, delta, dep1, tt) ) {
+		return _interface->compute(phase, lat1, lon1, dep1, lat2, lon2, elev2, ellc);
+	}
+
+	if ( ellc ) {
+		tt.time += ellipticityCorrection(tt.phase, lat1, lon1, dep1, lat2, lon2);
+	}
+
+	return tt;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+TravelTime Grid::computeFirst(double lat1, double lon1, double dep1,
+                              double lat2, double lon2, double elev2,
+                              int ellc) {
+	if ( !_tables ) {
+		throw NoPhaseError();
+	}
+
+	double delta, azi1, azi2;
+	sc_locsat_distaz2(lat1, lon1, lat2, lon2, &delta, &azi1, &azi2);
+
+	TravelTime tt;
+	if ( !_tables->interpolate(*_tables->table(size_t(0)), delta, dep1, tt) ) {
+		return _interface->computeFirst(lat1, lon1, dep1, lat2, lon2, elev2, ellc);
+	}
+
+	if ( ellc ) {
+		tt.time += ellipticityCorrection(tt.phase, lat1, lon1, dep1, lat2, lon2);
+	}
+
+	return tt;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+double Grid::computeTime(const char *phase,
+                         double lat1, double lon1, double dep1,
+                         double lat2, double lon2, double elev2,
+                         int ellc) {
+	return compute(phase, lat1, lon1, dep1, lat2, lon2, elev2, ellc).time;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t Grid::computeTimes(const char *phase,
+                          double lat1, double lon1, double dep1,
+                          size_t count, const double *lat2, const double *lon2,
+                          const double *elev2, double *times,
+                          int ellc) {
+	if ( !_tables ) {
+		fill(times, times + count, numeric_limits<double>::quiet_NaN());
+		return 0;
+	}
+
+	auto table = phase ? _tables->table(phase) : _tables->table(size_t(0));
+	if ( !table ) {
+		// Not configured, let the sampled interface handle the batch
+		return _interface->computeTimes(phase, lat1, lon1, dep1, count,
+		                                lat2, lon2, elev2, times, ellc);
+	}
+
+	computeDistances(lat1, lon1, count, lat2, lon2, times, nullptr);
+
+	size_t found = 0;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		TravelTime tt;
+		double delta = times[i];
+
+		if ( _tables->interpolate(*table, delta, dep1, tt) ) {
+			times[i] = tt.time;
+			if ( ellc ) {
+				times[i] += ellipticityCorrection(tt.phase, lat1, lon1, dep1,
+				                                  lat2[i], lon2[i]);
+			}
+
+			++found;
+			continue;
+		}
+
+		try {
+			double elev = elev2 ? elev2[i] : 0.;
+			if ( phase ) {
+				times[i] = _interface->computeTime(phase, lat1, lon1, dep1,
+				                                   lat2[i], lon2[i], elev, ellc);
+			}
+			else {
+				times[i] = _interface->computeFirst(lat1, lon1, dep1,
+				                                    lat2[i], lon2[i], elev, ellc).time;
+			}
+
+			++found;
+		}
+		catch ( NoPhaseError & ) {
+			times[i] = numeric_limits<double>::quiet_NaN();
+		}
+	}
+
+	return found;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::precompute() {
+	if ( !_tables ) {
+		return false;
+	}
+
+	_tables->precompute();
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::save(const string &filename) const {
+	return _tables && _tables->save(filename);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+REGISTER_TRAVELTIMETABLE(Grid, "grid");
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
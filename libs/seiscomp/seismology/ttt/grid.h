@@ -0,0 +1,126 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#ifndef SEISCOMP_TTT_GRID_H
+#define SEISCOMP_TTT_GRID_H
+
+
+#include <seiscomp/seismology/ttt.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace TTT {
+
+
+/**
+ * Grid
+ *
+ * A caching travel time interface which samples another interface on a
+ * dense (distance, depth) grid per phase and answers queries by bilinear
+ * interpolation.
+ *
+ * The model is the name of a profile configured with
+ * ttt.grid.[profile].* or a string "interface:model", e.g. "libtau:iasp91",
+ * which uses the default grid parameters.
+ *
+ * A grid cell is only interpolated if all four nodes carry the same phase
+ * and the interpolation error estimated from the second differences of
+ * the travel times at the nodes does not exceed the configured tolerance.
+ * Otherwise, e.g. close to triplications and branch changes, and for phases
+ * which are not configured, the query is passed to the sampled interface.
+ * compute() for the complete phase list is always passed through.
+ *
+ * Tables are built on first use of a phase or loaded from and persisted to
+ * the configured file. Tables of the same configuration are shared
+ * read-only by all instances and threads.
+ */
+class SC_SYSTEM_CORE_API Grid : public TravelTimeTableInterface {
+	public:
+		Grid();
+		~Grid() override;
+
+
+	public:
+		bool setModel(const std::string &model) override;
+		const std::string &model() const override;
+
+		TravelTimeList *
+		compute(double lat1, double lon1, double dep1,
+		        double lat2, double lon2, double elev2 = 0.,
+		        int ellc = 1) override;
+
+		TravelTime
+		compute(const char *phase,
+		        double lat1, double lon1, double dep1,
+		        double lat2, double lon2, double elev2 = 0.,
+		        int ellc = 1) override;
+
+		TravelTime
+		computeFirst(double lat1, double lon1, double dep1,
+		             double lat2, double lon2, double elev2 = 0.,
+		             int ellc = 1) override;
+
+		double
+		computeTime(const char *phase,
+		            double lat1, double lon1, double dep1,
+		            double lat2, double lon2, double elev2 = 0.,
+		            int ellc = 1) override;
+
+		size_t
+		computeTimes(const char *phase,
+		             double lat1, double lon1, double dep1,
+		             size_t count, const double *lat2, const double *lon2,
+		             const double *elev2, double *times,
+		             int ellc = 1) override;
+
+		/**
+		 * @brief Builds the tables of all configured phases which have not
+		 *        been built or loaded yet.
+		 * @return false if no model has been set
+		 */
+		bool precompute();
+
+		/**
+		 * @brief Writes all tables built so far to a file which can be
+		 *        configured as ttt.grid.[profile].file.
+		 * @param filename The output file
+		 * @return Success flag
+		 */
+		bool save(const std::string &filename) const;
+
+
+	private:
+		struct Tables;
+
+		std::string                  _model;
+		TravelTimeTableInterfacePtr  _interface;
+		std::shared_ptr<Tables>      _tables;
+};
+
+
+}
+}
+
+
+#endif
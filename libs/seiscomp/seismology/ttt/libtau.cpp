@@ -23,6 +23,7 @@
 #include <string.h>
 #include <iostream>
 #include <stdexcept>
+#include <limits>
 
 #include <seiscomp/core/strings.h>
 #include <seiscomp/system/environment.h>
@@ -57,6 +58,7 @@ double takeoff_angle(double p, double zs, double vzs) {
 extern "C" {
 
 #include "geog.h"
+#include "loc.h"
 
 }
 
@@ -269,6 +271,74 @@ TravelTime LibTau::computeFirst(double lat1, double lon1, double dep1,
 }
 
 
+size_t LibTau::computeTimes(const char *phase,
+                            double lat1, double lon1, double dep1,
+                            size_t count, const double *lat2, const double *lon2,
+                            const double *, double *times,
+                            int ellc) {
+	int n;
+	char ph[1000], *phases[100];
+	float time[100], p[100], dtdd[100], dtdh[100], dddp[100];
+
+	if ( !_initialized ) {
+		setModel("iasp91");
+	}
+
+	setDepth(dep1);
+
+	for ( int i = 0; i < 100; ++i ) {
+		phases[i] = &ph[10 * i];
+	}
+
+	// The distances are written to the output and replaced by the
+	// travel times. computeFirst measures them on the sphere while
+	// compute uses geocentric latitudes, follow both.
+	if ( phase ) {
+		computeDistances(lat1, lon1, count, lat2, lon2, times, nullptr);
+	}
+	else {
+		for ( size_t i = 0; i < count; ++i ) {
+			times[i] = Math::Geo::delta(lat1, lon1, lat2[i], lon2[i]);
+		}
+	}
+
+	size_t found = 0;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		double delta = times[i];
+		int best = -1;
+
+		trtm(&_handle, delta, &n, time, p, dtdd, dtdh, dddp, phases);
+
+		if ( !phase ) {
+			best = n > 0 ? 0 : -1;
+		}
+		else {
+			for ( int k = 0; k < n; ++k ) {
+				if ( matchesPhase(phases[k], phase, delta)
+				  && (best < 0 || time[k] < time[best]) ) {
+					best = k;
+				}
+			}
+		}
+
+		if ( best < 0 ) {
+			times[i] = std::numeric_limits<double>::quiet_NaN();
+			continue;
+		}
+
+		times[i] = time[best];
+		if ( ellc ) {
+			times[i] += ellipticityCorrection(phases[best], lat1, lon1, dep1, lat2[i], lon2[i]);
+		}
+
+		++found;
+	}
+
+	return found;
+}
+
+
 REGISTER_TRAVELTIMETABLE(LibTau, "libtau");
 
 
@@ -111,6 +111,32 @@ class SC_SYSTEM_CORE_API LibTau : public TravelTimeTableInterface {
 		                        int ellc = 1) override;
 
 
+		/**
+		 * Compute the traveltimes of one phase for many receivers. The
+		 * source depth is set once and the distances of all receivers
+		 * are computed in one pass. A phase is resolved as in compute()
+		 * by the fastest arrival which satisfies matchesPhase().
+		 * @param phase The phase code or nullptr for the first arrival
+		 * @param lat1 The source latitude in degrees
+		 * @param lon1 The source longitude in degrees
+		 * @param dep1 The source depth in km
+		 * @param count The number of receivers
+		 * @param lat2 The receiver latitudes in degrees
+		 * @param lon2 The receiver longitudes in degrees
+		 * @param elev2 The receiver elevations in meter.
+		 *              Elevation correction is not implemented and this
+		 *              parameter is ignored.
+		 * @param times The travel times, NaN if the phase does not exist
+		 * @param ellc Toggle earth ellipticity correction.
+		 * @returns The number of receivers with a travel time
+		 */
+		size_t computeTimes(const char *phase,
+		                    double lat1, double lon1, double dep1,
+		                    size_t count, const double *lat2, const double *lon2,
+		                    const double *elev2, double *times,
+		                    int ellc = 1) override;
+
+
 	private:
 		TravelTimeList *compute(double delta, double depth);
 		TravelTime computeFirst(double delta, double depth);
@@ -22,6 +22,8 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
+#include <algorithm>
+#include <limits>
 
 #include <seiscomp/core/strings.h>
 #include <seiscomp/system/environment.h>
@@ -318,6 +320,58 @@ double Locsat::computeTime(const char *phase,
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t Locsat::computeTimes(const char *phase,
+                            double lat1, double lon1, double dep1,
+                            size_t count, const double *lat2, const double *lon2,
+                            const double *, double *times,
+                            int ellc) {
+	checkDepth(dep1);
+
+	if ( !phase && _Pindex >= 0 ) {
+		phase = _ttt.phases[_Pindex];
+	}
+
+	if ( !phase || !_ttt.num_phases ) {
+		fill(times, times + count, numeric_limits<double>::quiet_NaN());
+		return 0;
+	}
+
+	// The distances are written to the output and replaced by the
+	// travel times
+	computeDistances(lat1, lon1, count, lat2, lon2, times, nullptr);
+
+	size_t found = 0;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		double delta = times[i];
+		int errorflag = 0;
+		double dtdd, dtdh;
+		double ttime = sc_locsat_compute_ttime(
+			&_ttt, delta, dep1, phase, EXTRAPOLATE,
+			&dtdd, &dtdh, &errorflag
+		);
+
+		if ( errorflag || !(ttime > 0) ) {
+			times[i] = numeric_limits<double>::quiet_NaN();
+			continue;
+		}
+
+		if ( ellc ) {
+			ttime += ellipticityCorrection(phase, lat1, lon1, dep1, lat2[i], lon2[i]);
+		}
+
+		times[i] = ttime;
+		++found;
+	}
+
+	return found;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 TravelTime Locsat::computeFirst(double delta, double depth) {
 	if ( _Pindex < 0 ) {
@@ -127,6 +127,19 @@ class SC_SYSTEM_CORE_API Locsat : public TravelTimeTableInterface {
 		                   double lat2, double lon2, double elev2=0.,
 		                   int ellc = 1) override;
 
+		/**
+		 * @brief Computes the travel times of one phase for many receivers.
+		 *
+		 * Distances and azimuths of all receivers are computed in one pass
+		 * and the tables are interpolated without allocating lists.
+		 * Altitude correction is not implemented as with computeTime.
+		 */
+		size_t computeTimes(const char *phase,
+		                    double lat1, double lon1, double dep1,
+		                    size_t count, const double *lat2, const double *lon2,
+		                    const double *elev2, double *times,
+		                    int ellc = 1) override;
+
 
 	private:
 		TravelTimeList *compute(double delta, double depth);
@@ -810,6 +810,13 @@ void Application::printUsage() const {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::closeLogging() {
 	if ( _logger ) {
+		// Write pending messages of an asynchronous output while the
+		// output is still intact
+		auto *fileOutput = dynamic_cast<Logging::FileOutput*>(_logger);
+		if ( fileOutput ) {
+			fileOutput->setAsync(false);
+		}
+
 		delete _logger;
 		_logger = nullptr;
 	}
@@ -1577,6 +1584,16 @@ bool Application::initLogging() {
 
 			if ( logger->open(logFile.c_str()) ) {
 				//cerr << "using logfile: " << logFile << endl;
+				if ( _baseSettings.logging.file.async.enable ) {
+					logger->setAsync(
+						true,
+						_baseSettings.logging.file.async.bufferSize > 0 ?
+							_baseSettings.logging.file.async.bufferSize : 1024 * 1024,
+						_baseSettings.logging.file.async.block ?
+							Logging::FileOutput::OverflowPolicy::Block :
+							Logging::FileOutput::OverflowPolicy::Drop
+					);
+				}
 				_logger = logger;
 			}
 			else {
@@ -1263,10 +1263,24 @@ class SC_SYSTEM_CORE_API Application : public Core::InterruptibleObject {
 						}
 					} rotator;
 
+					struct Async {
+						bool enable{false};
+						int bufferSize{1024 * 1024}; /* per logging thread */
+						bool block{false};
+
+						void accept(SettingsLinker &linker) {
+							linker
+							& cfg(bufferSize, "bufferSize")
+							& cfg(block, "block");
+						}
+					} async;
+
 					void accept(SettingsLinker &linker) {
 						linker
 						& cfg(rotator.enable, "rotator")
-						& cfg(rotator, "rotator");
+						& cfg(rotator, "rotator")
+						& cfg(async.enable, "async")
+						& cfg(async, "async");
 					}
 				} file;
 
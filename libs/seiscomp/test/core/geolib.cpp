@@ -23,6 +23,7 @@
 
 #include <seiscomp/math/geo.h>
 #include <seiscomp/math/matrix3.h>
+#include <seiscomp/math/stationtable.h>
 #include <seiscomp/geo/coordinate.h>
 #include <seiscomp/geo/boundingbox.h>
 #include <seiscomp/geo/feature.h>
@@ -477,5 +478,78 @@ BOOST_AUTO_TEST_CASE(inclination, *bu::tolerance(0.005)) {
 
 
 
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(stationTable) {
+	StationTable table;
+	BOOST_CHECK(table.nearest(0, 0, 1).empty());
+
+	for ( int lat = -80; lat <= 80; lat += 10 ) {
+		for ( int lon = -175; lon < 180; lon += 15 ) {
+			table.add(lat + 0.3, lon - 0.7);
+		}
+	}
+
+	vector<double> dist(table.size()), azi(table.size()), baz(table.size());
+	double srcLat = 47.2, srcLon = 8.6;
+	table.delazi(srcLat, srcLon, dist.data(), azi.data(), baz.data());
+
+	for ( size_t i = 0; i < table.size(); ++i ) {
+		double d, a, b;
+		delazi(srcLat, srcLon, table.latitude(i), table.longitude(i), &d, &a, &b);
+		BOOST_CHECK_SMALL(dist[i] - d, 1E-9);
+		BOOST_CHECK_SMALL(azi[i] - a, 1E-5);
+		BOOST_CHECK_SMALL(baz[i] - b, 1E-5);
+	}
+
+	// Coincident points
+	table.delazi(table.latitude(3), table.longitude(3), dist.data(), azi.data(), baz.data());
+	BOOST_CHECK_EQUAL(dist[3], 0.0);
+	BOOST_CHECK_EQUAL(azi[3], 0.0);
+	BOOST_CHECK_EQUAL(baz[3], 0.0);
+
+	// Compare the spatial queries against all distances
+	table.delazi(srcLat, srcLon, dist.data());
+	vector<size_t> order(table.size());
+	for ( size_t i = 0; i < order.size(); ++i ) {
+		order[i] = i;
+	}
+	sort(order.begin(), order.end(), [&dist](size_t a, size_t b) {
+		return dist[a] < dist[b] || (dist[a] == dist[b] && a < b);
+	});
+
+	auto nearest = table.nearest(srcLat, srcLon, 5);
+	BOOST_REQUIRE_EQUAL(nearest.size(), 5);
+	for ( size_t i = 0; i < nearest.size(); ++i ) {
+		BOOST_CHECK_EQUAL(nearest[i].index, order[i]);
+		BOOST_CHECK_CLOSE(nearest[i].distance, dist[order[i]], 1E-9);
+	}
+
+	BOOST_CHECK(table.nearest(srcLat, srcLon, 5, dist[order[0]] * 0.5).empty());
+	BOOST_CHECK_EQUAL(table.nearest(srcLat, srcLon, 5, dist[order[1]]).size(), 2);
+
+	auto within = table.within(srcLat, srcLon, 25.0);
+	size_t count = 0;
+	for ( auto d : dist ) {
+		if ( d <= 25.0 ) {
+			++count;
+		}
+	}
+	BOOST_CHECK_EQUAL(within.size(), count);
+	for ( size_t i = 0; i < within.size(); ++i ) {
+		BOOST_CHECK_EQUAL(within[i].index, order[i]);
+	}
+
+	// Adding a station rebuilds the index
+	size_t index = table.add(srcLat, srcLon);
+	nearest = table.nearest(srcLat, srcLon, 1);
+	BOOST_REQUIRE_EQUAL(nearest.size(), 1);
+	BOOST_CHECK_EQUAL(nearest[0].index, index);
+	BOOST_CHECK_EQUAL(nearest[0].distance, 0.0);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
 //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 BOOST_AUTO_TEST_SUITE_END()
@@ -34,6 +34,7 @@
 #include <seiscomp/geo/feature.h>
 #include <seiscomp/geo/featureset.h>
 #include <seiscomp/geo/formats/geojson.h>
+#include <seiscomp/geo/index/featureindex.h>
 #include <seiscomp/seismology/regions.h>
 #include <seiscomp/seismology/regions/polygon.h>
 #include <seiscomp/utils/files.h>
@@ -543,4 +544,53 @@ BOOST_AUTO_TEST_CASE(geojsonRegions) {
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(featureIndex) {
+	GeoFeatureSet features;
+	features.readDir(dataDir + "fep");
+	BOOST_REQUIRE(!features.features().empty());
+
+	// Crosses the date line and has a hole
+	auto *f = new GeoFeature("dateline", nullptr, 1);
+	f->addVertex(-20, 160);
+	f->addVertex(20, 160);
+	f->addVertex(20, -160);
+	f->addVertex(-20, -160);
+	f->addVertex(-10, 170, true);
+	f->addVertex(10, 170);
+	f->addVertex(10, -170);
+	f->addVertex(-10, -170);
+	f->setClosedPolygon(true);
+	features.addFeature(f);
+
+	FeatureIndex index;
+	index.build(features.features());
+	BOOST_CHECK_EQUAL(index.size(), features.features().size());
+
+	BOOST_CHECK(index.contains(f, GeoCoordinate(15, 180)));
+	BOOST_CHECK(!index.contains(f, GeoCoordinate(0, 180)));
+	BOOST_CHECK(!index.contains(f, GeoCoordinate(0, 150)));
+
+	for ( double lat = -90; lat <= 90; lat += 0.5 ) {
+		for ( double lon = -180; lon <= 180; lon += 0.5 ) {
+			GeoCoordinate gc(lat, lon);
+			GeoFeature *expected = nullptr;
+			for ( auto *feature : features.features() ) {
+				if ( feature->contains(gc) ) {
+					expected = feature;
+					break;
+				}
+			}
+
+			BOOST_TEST_INFO("Lookup mismatch at " << lat << " / " << lon);
+			BOOST_CHECK(index.findFirst(gc) == expected);
+		}
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
 BOOST_AUTO_TEST_SUITE_END()
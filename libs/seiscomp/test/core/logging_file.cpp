@@ -0,0 +1,288 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+#include <seiscomp/unittest/unittests.h>
+#include <seiscomp/logging/file.h>
+#include <seiscomp/logging/log.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Logging;
+
+
+namespace {
+
+
+// Collects the written lines instead of writing them to a file. The
+// writer thread can be held in write() to fill up the buffers.
+class CaptureOutput : public FileOutput {
+	public:
+		CaptureOutput() {
+			logComponent(false);
+		}
+
+		~CaptureOutput() override {
+			setAsync(false);
+		}
+
+	public:
+		void post(const string &msg) {
+			log("info", LL_INFO, msg.c_str(), 0);
+		}
+
+		void hold(bool enable) {
+			{
+				std::lock_guard<std::mutex> l(_mutex);
+				_hold = enable;
+			}
+			_released.notify_all();
+		}
+
+		// Returns the messages without time, channel and newline
+		vector<string> messages() {
+			std::lock_guard<std::mutex> l(_mutex);
+			vector<string> result;
+			for ( const auto &line : _lines ) {
+				auto pos = line.find("] ");
+				BOOST_REQUIRE(pos != string::npos);
+				BOOST_REQUIRE(!line.empty() && line.back() == '\n');
+				result.push_back(line.substr(pos + 2, line.size() - pos - 3));
+			}
+			return result;
+		}
+
+	protected:
+		void write(const char *data, size_t size, time_t, bool) override {
+			std::unique_lock<std::mutex> l(_mutex);
+			_released.wait(l, [this]() { return !_hold; });
+			_lines.emplace_back(data, size);
+		}
+
+	private:
+		std::mutex         _mutex;
+		condition_variable _released;
+		bool               _hold{false};
+		vector<string>     _lines;
+};
+
+
+string message(int thread, int index) {
+	// Varying lengths to move the records across the buffer end
+	return to_string(thread) + " " + to_string(index) + " "
+	     + string(static_cast<size_t>(index % 301), 'x');
+}
+
+
+}
+
+
+BOOST_AUTO_TEST_SUITE(seiscomp_core_logging_file)
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(Wraparound) {
+	CaptureOutput output;
+	output.setAsync(true, 4096, FileOutput::OverflowPolicy::Block);
+
+	const int count = 5000;
+	for ( int i = 0; i < count; ++i ) {
+		output.post(message(0, i));
+	}
+
+	output.setAsync(false);
+
+	auto messages = output.messages();
+	BOOST_REQUIRE_EQUAL(messages.size(), count);
+	for ( int i = 0; i < count; ++i ) {
+		BOOST_CHECK_EQUAL(messages[i], message(0, i));
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(FullBuffer) {
+	CaptureOutput output;
+	output.setAsync(true, 4096, FileOutput::OverflowPolicy::Drop);
+
+	// The writer blocks in the first write and the buffer fills up
+	output.hold(true);
+
+	const int count = 1000;
+	for ( int i = 0; i < count; ++i ) {
+		output.post(message(0, i));
+	}
+
+	output.hold(false);
+	output.setAsync(false);
+
+	auto messages = output.messages();
+	BOOST_REQUIRE(!messages.empty());
+
+	const string notice = " log messages dropped due to full buffers";
+	BOOST_REQUIRE(messages.back().size() > notice.size());
+	BOOST_REQUIRE_EQUAL(messages.back().substr(messages.back().size() - notice.size()), notice);
+	int dropped = stoi(messages.back());
+	messages.pop_back();
+
+	BOOST_CHECK(dropped > 0);
+	BOOST_CHECK_EQUAL(messages.size() + static_cast<size_t>(dropped), count);
+
+	// The lines which made it are complete and in order. Shorter lines
+	// can still fit after longer ones have been dropped.
+	int last = -1;
+	for ( const auto &msg : messages ) {
+		int index = stoi(msg.substr(2));
+		BOOST_CHECK(index > last);
+		BOOST_CHECK_EQUAL(msg, message(0, index));
+		last = index;
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(MultipleProducers) {
+	CaptureOutput output;
+	output.setAsync(true, 4096, FileOutput::OverflowPolicy::Block);
+
+	const int threadCount = 8;
+	const int count = 2000;
+	vector<thread> threads;
+
+	for ( int t = 0; t < threadCount; ++t ) {
+		threads.emplace_back([&output, t]() {
+			for ( int i = 0; i < count; ++i ) {
+				output.post(message(t, i));
+			}
+		});
+	}
+
+	for ( auto &thrd : threads ) {
+		thrd.join();
+	}
+
+	output.setAsync(false);
+
+	auto messages = output.messages();
+	BOOST_REQUIRE_EQUAL(messages.size(), threadCount * count);
+
+	// Each thread's lines are complete and in order
+	vector<int> next(threadCount, 0);
+	for ( const auto &msg : messages ) {
+		int t = stoi(msg);
+		BOOST_REQUIRE(t >= 0 && t < threadCount);
+		BOOST_CHECK_EQUAL(msg, message(t, next[t]));
+		++next[t];
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(CausalOrder) {
+	CaptureOutput output;
+	output.setAsync(true);
+
+	// Two threads log in turns, each line is logged after the previous
+	// one of the other thread and must be written after it
+	const int count = 2000;
+	atomic<int> turn{0};
+	vector<thread> threads;
+
+	for ( int t = 0; t < 2; ++t ) {
+		threads.emplace_back([&output, &turn, t]() {
+			for ( int i = t; i < count; i += 2 ) {
+				while ( turn.load(memory_order_acquire) != i ) {
+					this_thread::yield();
+				}
+				output.post(to_string(i));
+				turn.store(i + 1, memory_order_release);
+			}
+		});
+	}
+
+	for ( auto &thrd : threads ) {
+		thrd.join();
+	}
+
+	output.setAsync(false);
+
+	auto messages = output.messages();
+	BOOST_REQUIRE_EQUAL(messages.size(), count);
+	for ( int i = 0; i < count; ++i ) {
+		BOOST_CHECK_EQUAL(messages[i], to_string(i));
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(ShortLivedThreads) {
+	CaptureOutput output;
+	output.setAsync(true, 4096, FileOutput::OverflowPolicy::Block);
+
+	// The buffers of exited threads are released by the writer, the
+	// lines logged before must still be written
+	const int count = 200;
+	for ( int t = 0; t < count; ++t ) {
+		thread([&output, t]() {
+			output.post(message(t, 0));
+			output.post(message(t, 1));
+		}).join();
+	}
+
+	output.setAsync(false);
+
+	auto messages = output.messages();
+	BOOST_REQUIRE_EQUAL(messages.size(), 2 * count);
+	for ( int t = 0; t < count; ++t ) {
+		BOOST_CHECK_EQUAL(messages[2 * t], message(t, 0));
+		BOOST_CHECK_EQUAL(messages[2 * t + 1], message(t, 1));
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_SUITE_END()
@@ -182,6 +182,100 @@ BOOST_AUTO_TEST_CASE(TIMESPAN) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(MEMORY) {
+	PublicObject::SetRegistrationEnabled(true);
+
+	PublicObjectMemoryBuffer buffer(nullptr, 0);
+	PickPtr pick = Pick::Create();
+	string publicID = pick->publicID();
+
+	// The last object fed is kept even if it exceeds the limit
+	BOOST_CHECK(buffer.feed(pick.get()));
+	BOOST_CHECK_EQUAL(buffer.size(), 1);
+	BOOST_CHECK(buffer.memoryUsage() > 0);
+
+	size_t pickFootprint = buffer.memoryUsage();
+	buffer.setMemoryLimit(pickFootprint * 3);
+
+	for ( int i = 0; i < 10; ++i ) {
+		BOOST_CHECK(buffer.feed(Pick::Create()));
+		BOOST_CHECK(buffer.memoryUsage() <= buffer.memoryLimit());
+	}
+
+	BOOST_CHECK(buffer.size() > 1);
+	BOOST_CHECK(buffer.size() < 5);
+
+	// The first pick has been evicted
+	BOOST_CHECK(!buffer.contains(publicID));
+	BOOST_CHECK_EQUAL(pick->referenceCount(), 1);
+
+	// The pick is still registered, look it up and check the statistics
+	buffer.resetStatistics();
+	BOOST_CHECK(buffer.get<Pick>(publicID));
+	BOOST_CHECK(!buffer.get<Pick>("unknown"));
+
+	auto it = buffer.statistics().find(&Pick::TypeInfo());
+	BOOST_REQUIRE(it != buffer.statistics().end());
+	BOOST_CHECK_EQUAL(it->second.hits, 1);
+	BOOST_CHECK_EQUAL(it->second.misses, 1);
+
+	// Without a database nothing can be prefetched
+	BOOST_CHECK_EQUAL(buffer.prefetch<Pick>({"unknown"}), 0);
+
+	buffer.clear();
+	BOOST_CHECK_EQUAL(buffer.size(), 0);
+	BOOST_CHECK_EQUAL(buffer.memoryUsage(), 0);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(MEMORY_FOOTPRINT) {
+	PublicObject::SetRegistrationEnabled(true);
+
+	struct CountingBuffer : PublicObjectMemoryBuffer {
+		CountingBuffer() : PublicObjectMemoryBuffer(nullptr, 1000) {}
+
+		size_t footprint(PublicObject *po) const override {
+			++estimates;
+			return PublicObjectMemoryBuffer::footprint(po);
+		}
+
+		mutable size_t estimates{0};
+	};
+
+	CountingBuffer buffer;
+	PickPtr pick = Pick::Create();
+
+	BOOST_CHECK(buffer.feed(pick.get()));
+	BOOST_CHECK_EQUAL(buffer.estimates, 1);
+	size_t usage = buffer.memoryUsage();
+
+	// Hits and repeated feeds reuse the stored footprint
+	for ( int i = 0; i < 10; ++i ) {
+		BOOST_CHECK_EQUAL(buffer.get<Pick>(pick->publicID()), pick.get());
+		BOOST_CHECK(buffer.feed(pick.get()));
+	}
+
+	BOOST_CHECK_EQUAL(buffer.estimates, 1);
+	BOOST_CHECK_EQUAL(buffer.memoryUsage(), usage);
+
+	// Evicting the object releases the stored footprint
+	buffer.setMemoryLimit(0);
+	BOOST_CHECK(buffer.feed(Pick::Create()));
+	BOOST_CHECK_EQUAL(buffer.estimates, 2);
+	BOOST_CHECK_EQUAL(buffer.size(), 1);
+	BOOST_CHECK(!buffer.contains(pick.get()));
+	BOOST_CHECK(buffer.memoryUsage() > 0);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BOOST_AUTO_TEST_SUITE_END()
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
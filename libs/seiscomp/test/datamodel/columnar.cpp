@@ -0,0 +1,211 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/amplitude.h>
+#include <seiscomp/datamodel/arrival.h>
+#include <seiscomp/datamodel/eventparameters.h>
+#include <seiscomp/datamodel/origin.h>
+#include <seiscomp/datamodel/pick.h>
+#include <seiscomp/datamodel/stationmagnitude.h>
+#include <seiscomp/io/exporter.h>
+#include <seiscomp/io/importer.h>
+
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+
+
+namespace {
+
+
+EventParametersPtr createParameters() {
+	EventParametersPtr ep = new EventParameters;
+	Core::Time t(1700000000, 250000);
+
+	for ( int i = 0; i < 100; ++i ) {
+		PickPtr pick = Pick::Create("Pick/" + to_string(i));
+		pick->setWaveformID(WaveformStreamID("GE", "STA" + to_string(i % 7), "", "BHZ", ""));
+		TimeQuantity time(t + Core::TimeSpan(i, 0));
+		time.setLowerUncertainty(0.1);
+		pick->setTime(time);
+		pick->setPhaseHint(Phase(i % 2 ? "S" : "P"));
+		if ( i % 3 ) {
+			pick->setEvaluationMode(EvaluationMode(AUTOMATIC));
+		}
+		CreationInfo ci;
+		ci.setAgencyID("GFZ");
+		ci.setCreationTime(t);
+		pick->setCreationInfo(ci);
+		ep->add(pick.get());
+
+		AmplitudePtr amp = Amplitude::Create("Amplitude/" + to_string(i));
+		amp->setType("MLv");
+		amp->setAmplitude(RealQuantity(i * 0.5));
+		amp->setTimeWindow(TimeWindow(t, -1.0, 2.0));
+		amp->setPickID(pick->publicID());
+		amp->setWaveformID(pick->waveformID());
+		ep->add(amp.get());
+	}
+
+	OriginPtr org = Origin::Create("Origin/1");
+	for ( int i = 0; i < 10; ++i ) {
+		ArrivalPtr arr = new Arrival;
+		arr->setPickID("Pick/" + to_string(i));
+		arr->setPhase(Phase("P"));
+		arr->setDistance(i * 1.5);
+		arr->setTimeUsed(i % 2 == 0);
+		arr->setWeight(1.0);
+		org->add(arr.get());
+
+		StationMagnitudePtr mag = StationMagnitude::Create("StationMagnitude/" + to_string(i));
+		mag->setMagnitude(RealQuantity(3.0 + i * 0.1));
+		mag->setType("MLv");
+		mag->setAmplitudeID("Amplitude/" + to_string(i));
+		org->add(mag.get());
+	}
+	ep->add(org.get());
+
+	return ep;
+}
+
+
+string exportParameters(EventParameters *ep) {
+	IO::ExporterPtr exp = IO::Exporter::Create("columnar");
+	BOOST_REQUIRE(exp);
+	stringbuf buf;
+	BOOST_REQUIRE(exp->write(&buf, ep));
+	return buf.str();
+}
+
+
+EventParametersPtr importParameters(const string &data) {
+	IO::ImporterPtr imp = IO::Importer::Create("columnar");
+	BOOST_REQUIRE(imp);
+	stringbuf buf(data);
+	return EventParameters::Cast(imp->read(&buf));
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_datamodel_columnar)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(ROUNDTRIP) {
+	EventParametersPtr ep = createParameters();
+	string data = exportParameters(ep.get());
+
+	// The originals are still registered
+	PublicObject::SetRegistrationEnabled(false);
+	EventParametersPtr ep2 = importParameters(data);
+	PublicObject::SetRegistrationEnabled(true);
+
+	BOOST_REQUIRE(ep2);
+	BOOST_REQUIRE_EQUAL(ep2->pickCount(), ep->pickCount());
+	BOOST_REQUIRE_EQUAL(ep2->amplitudeCount(), ep->amplitudeCount());
+	BOOST_REQUIRE_EQUAL(ep2->originCount(), 1);
+
+	for ( size_t i = 0; i < ep->pickCount(); ++i ) {
+		BOOST_CHECK(*ep2->pick(i) == *ep->pick(i));
+		BOOST_CHECK(*ep2->amplitude(i) == *ep->amplitude(i));
+	}
+
+	Origin *org = ep->origin(0);
+	Origin *org2 = ep2->origin(0);
+	BOOST_CHECK_EQUAL(org2->publicID(), org->publicID());
+	BOOST_REQUIRE_EQUAL(org2->arrivalCount(), org->arrivalCount());
+	BOOST_REQUIRE_EQUAL(org2->stationMagnitudeCount(), org->stationMagnitudeCount());
+
+	for ( size_t i = 0; i < org->arrivalCount(); ++i ) {
+		BOOST_CHECK(*org2->arrival(i) == *org->arrival(i));
+		BOOST_CHECK(*org2->stationMagnitude(i) == *org->stationMagnitude(i));
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(TRUNCATED) {
+	EventParametersPtr ep = createParameters();
+	string data = exportParameters(ep.get());
+
+	PublicObject::SetRegistrationEnabled(false);
+	BOOST_CHECK(!importParameters(data.substr(0, data.size() - 3)));
+	BOOST_CHECK(!importParameters("SCXX"));
+	PublicObject::SetRegistrationEnabled(true);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(INVALID_ROW_COUNT) {
+	EventParametersPtr ep = createParameters();
+	string data = exportParameters(ep.get());
+
+	// The row count of the first block follows the 16 byte document header
+	// and the padded table name
+	uint32_t nameLength;
+	BOOST_REQUIRE(data.size() > 20);
+	memcpy(&nameLength, data.data() + 16, sizeof(nameLength));
+	size_t rowsOffset = 20 + nameLength;
+	rowsOffset += (8 - rowsOffset % 8) % 8;
+	BOOST_REQUIRE(data.size() >= rowsOffset + 8);
+
+	PublicObject::SetRegistrationEnabled(false);
+	for ( uint64_t rows : { numeric_limits<uint64_t>::max(),
+	                        numeric_limits<uint64_t>::max() / 8,
+	                        uint64_t(1) << 32, uint64_t(65537) } ) {
+		string corrupted = data;
+		memcpy(&corrupted[rowsOffset], &rows, sizeof(rows));
+		BOOST_CHECK(!importParameters(corrupted));
+	}
+	PublicObject::SetRegistrationEnabled(true);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
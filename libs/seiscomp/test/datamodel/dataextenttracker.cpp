@@ -0,0 +1,167 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/dataavailability.h>
+#include <seiscomp/datamodel/dataextenttracker.h>
+#include <seiscomp/datamodel/notifier.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Core;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+size_t countOps(NotifierMessage *msg, Operation op) {
+	size_t count = 0;
+	for ( auto it = msg->begin(); it != msg->end(); ++it ) {
+		if ( (*it)->operation() == op &&
+		     DataSegment::Cast((*it)->object()) ) {
+			++count;
+		}
+	}
+	return count;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_datamodel_dataextenttracker)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(merge) {
+	DataAvailabilityPtr availability = new DataAvailability;
+	DataExtentPtr extent = DataExtent::Create("Extent/XX.ABCD..BHZ");
+	availability->add(extent.get());
+
+	Notifier::Enable();
+	Notifier::SetCheckEnabled(false);
+	Notifier::Clear();
+
+	DataExtentTracker tracker(extent.get());
+	Time t0(2024, 1, 1, 0, 0, 0);
+	const double fsamp = 100.0;
+
+	// Contiguous records with some jitter form one segment
+	for ( int i = 0; i < 10; ++i ) {
+		BOOST_CHECK(tracker.feed(t0 + TimeSpan(i * 10, i % 2 ? 2000 : 0),
+		                         t0 + TimeSpan((i + 1) * 10, 0), fsamp, "D"));
+	}
+	BOOST_CHECK(!tracker.feed(t0, t0, fsamp, "D"));
+	BOOST_CHECK_EQUAL(tracker.segmentCount(), 1);
+
+	BOOST_CHECK_EQUAL(tracker.sync(), 1);
+	BOOST_REQUIRE_EQUAL(extent->dataSegmentCount(), 1);
+	BOOST_CHECK_EQUAL(extent->start(), t0);
+	BOOST_CHECK_EQUAL(extent->end(), t0 + TimeSpan(100, 0));
+	BOOST_CHECK(!extent->dataSegment(0)->outOfOrder());
+
+	NotifierMessagePtr msg = Notifier::GetMessage();
+	BOOST_REQUIRE(msg);
+	BOOST_CHECK_EQUAL(countOps(msg.get(), OP_ADD), 1);
+
+	// Nothing changed, nothing is sent
+	BOOST_CHECK(!tracker.hasChanges());
+	BOOST_CHECK_EQUAL(tracker.sync(), 0);
+	BOOST_CHECK(!Notifier::GetMessage());
+
+	// Appending updates the segment in place
+	tracker.feed(t0 + TimeSpan(100, 0), t0 + TimeSpan(110, 0), fsamp, "D");
+	BOOST_CHECK_EQUAL(tracker.sync(), 1);
+	msg = Notifier::GetMessage();
+	BOOST_REQUIRE(msg);
+	BOOST_CHECK_EQUAL(countOps(msg.get(), OP_UPDATE), 1);
+	BOOST_CHECK_EQUAL(extent->dataSegment(0)->end(), t0 + TimeSpan(110, 0));
+
+	// A gap opens a second segment
+	tracker.feed(t0 + TimeSpan(200, 0), t0 + TimeSpan(210, 0), fsamp, "D");
+	BOOST_CHECK_EQUAL(tracker.segmentCount(), 2);
+	BOOST_CHECK_EQUAL(tracker.sync(), 1);
+	BOOST_CHECK_EQUAL(extent->dataSegmentCount(), 2);
+	Notifier::Clear();
+
+	TimeWindow tw(t0 + TimeSpan(50, 0), t0 + TimeSpan(300, 0));
+	BOOST_CHECK_EQUAL(tracker.coverage(tw), TimeSpan(70, 0));
+	auto gaps = tracker.gaps(tw);
+	BOOST_REQUIRE_EQUAL(gaps.size(), 2);
+	BOOST_CHECK_EQUAL(gaps[0], TimeWindow(t0 + TimeSpan(110, 0), t0 + TimeSpan(200, 0)));
+	BOOST_CHECK_EQUAL(gaps[1], TimeWindow(t0 + TimeSpan(210, 0), t0 + TimeSpan(300, 0)));
+	BOOST_CHECK_EQUAL(tracker.gaps(tw, TimeSpan(91, 0)).size(), 0);
+	BOOST_CHECK_EQUAL(tracker.segments(tw).size(), 2);
+
+	// Filling the gap joins both segments
+	tracker.feed(t0 + TimeSpan(110, 0), t0 + TimeSpan(200, 0), fsamp, "D");
+	BOOST_CHECK_EQUAL(tracker.segmentCount(), 1);
+	BOOST_CHECK_EQUAL(tracker.sync(), 2);
+	msg = Notifier::GetMessage();
+	BOOST_REQUIRE(msg);
+	BOOST_CHECK_EQUAL(countOps(msg.get(), OP_REMOVE), 1);
+	BOOST_CHECK_EQUAL(countOps(msg.get(), OP_UPDATE), 1);
+	BOOST_REQUIRE_EQUAL(extent->dataSegmentCount(), 1);
+	BOOST_CHECK_EQUAL(extent->dataSegment(0)->end(), t0 + TimeSpan(210, 0));
+	BOOST_CHECK(extent->dataSegment(0)->outOfOrder());
+	BOOST_CHECK_EQUAL(tracker.coverage(tw), TimeSpan(160, 0));
+
+	// A different quality cuts the segment in three parts
+	tracker.feed(t0 + TimeSpan(20, 0), t0 + TimeSpan(30, 0), fsamp, "Q");
+	BOOST_CHECK_EQUAL(tracker.segmentCount(), 3);
+	BOOST_CHECK_EQUAL(tracker.sync(), 3);
+	BOOST_CHECK_EQUAL(extent->dataSegmentCount(), 3);
+	BOOST_CHECK_EQUAL(tracker.coverage(TimeWindow(t0, t0 + TimeSpan(210, 0))), TimeSpan(210, 0));
+	Notifier::Clear();
+
+	// Loading the stored segments does not change anything
+	DataExtentTracker loaded(extent.get());
+	BOOST_CHECK_EQUAL(loaded.segmentCount(), 3);
+	BOOST_CHECK(!loaded.hasChanges());
+	BOOST_CHECK_EQUAL(loaded.sync(), 0);
+
+	Notifier::Disable();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,154 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/notifier.h>
+#include <seiscomp/datamodel/pick.h>
+
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_datamodel_notifier)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(POOL) {
+	Notifier::Enable();
+	Notifier::SetCheckEnabled(true);
+	Notifier::Clear();
+
+	vector<PickPtr> picks;
+	for ( int i = 0; i < 10; ++i ) {
+		picks.push_back(Pick::Create());
+		BOOST_CHECK(Notifier::Create("EP", OP_ADD, picks.back().get()));
+	}
+
+	BOOST_CHECK_EQUAL(Notifier::Size(), 10);
+
+	// An update of an added object is covered by the add
+	BOOST_CHECK(!Notifier::Create("EP", OP_UPDATE, picks[3].get()));
+	BOOST_CHECK(!Notifier::Create("EP", OP_ADD, picks[3].get()));
+	BOOST_CHECK_EQUAL(Notifier::Size(), 10);
+
+	// A different parent is a different notifier
+	BOOST_CHECK(Notifier::Create("EP2", OP_UPDATE, picks[3].get()));
+	BOOST_CHECK_EQUAL(Notifier::Size(), 11);
+
+	// Take the first two notifiers one by one
+	for ( int i = 0; i < 2; ++i ) {
+		NotifierMessagePtr msg = Notifier::GetMessage(false);
+		BOOST_REQUIRE(msg);
+		BOOST_REQUIRE_EQUAL(msg->size(), 1);
+		BOOST_CHECK_EQUAL((*msg->begin())->object(), picks[i].get());
+	}
+
+	BOOST_CHECK_EQUAL(Notifier::Size(), 9);
+
+	// Taken notifiers are not considered anymore
+	BOOST_CHECK(Notifier::Create("EP", OP_UPDATE, picks[0].get()));
+	BOOST_CHECK_EQUAL(Notifier::Size(), 10);
+
+	// The remaining notifiers are returned in creation order
+	NotifierMessagePtr msg = Notifier::GetMessage(true);
+	BOOST_REQUIRE(msg);
+	BOOST_REQUIRE_EQUAL(msg->size(), 10);
+
+	auto it = msg->begin();
+	for ( int i = 2; i < 10; ++i, ++it ) {
+		BOOST_CHECK_EQUAL((*it)->object(), picks[i].get());
+		BOOST_CHECK_EQUAL((*it)->operation(), OP_ADD);
+	}
+
+	BOOST_CHECK_EQUAL((*it)->object(), picks[3].get());
+	BOOST_CHECK_EQUAL((*it)->parentID(), "EP2");
+	++it;
+	BOOST_CHECK_EQUAL((*it)->object(), picks[0].get());
+	BOOST_CHECK_EQUAL((*it)->operation(), OP_UPDATE);
+
+	BOOST_CHECK_EQUAL(Notifier::Size(), 0);
+	BOOST_CHECK(!Notifier::GetMessage(true));
+	BOOST_CHECK(!Notifier::GetMessage(false));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(POOL_INTERLEAVED) {
+	Notifier::Enable();
+	Notifier::SetCheckEnabled(true);
+	Notifier::Clear();
+
+	// Queue two notifiers and take one in each round such that the pool is
+	// never drained and its consumed prefix is compacted several times
+	vector<PickPtr> picks;
+	size_t taken = 0;
+	for ( int i = 0; i < 1000; ++i ) {
+		for ( int j = 0; j < 2; ++j ) {
+			picks.push_back(Pick::Create());
+			BOOST_CHECK(Notifier::Create("EP", OP_ADD, picks.back().get()));
+		}
+
+		// The index must still find queued notifiers after compaction
+		BOOST_CHECK(!Notifier::Create("EP", OP_UPDATE, picks.back().get()));
+
+		NotifierMessagePtr msg = Notifier::GetMessage(false);
+		BOOST_REQUIRE(msg);
+		BOOST_REQUIRE_EQUAL(msg->size(), 1);
+		BOOST_CHECK_EQUAL((*msg->begin())->object(), picks[taken].get());
+		++taken;
+
+		BOOST_CHECK_EQUAL(Notifier::Size(), picks.size() - taken);
+	}
+
+	NotifierMessagePtr msg = Notifier::GetMessage(true);
+	BOOST_REQUIRE(msg);
+	BOOST_REQUIRE_EQUAL(msg->size(), picks.size() - taken);
+
+	for ( auto it = msg->begin(); it != msg->end(); ++it, ++taken )
+		BOOST_CHECK_EQUAL((*it)->object(), picks[taken].get());
+
+	BOOST_CHECK_EQUAL(Notifier::Size(), 0);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,164 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/pick.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_datamodel_publicobject)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Registration) {
+	size_t count = PublicObject::ObjectCount();
+
+	PickPtr pick = Pick::Create("Registry/Pick/1");
+	BOOST_REQUIRE(pick);
+	BOOST_CHECK(pick->registered());
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count + 1);
+	BOOST_CHECK_EQUAL(PublicObject::Find("Registry/Pick/1"), pick.get());
+	BOOST_CHECK(!PublicObject::Find("Registry/Pick/2"));
+
+	// Duplicate ids are rejected
+	BOOST_CHECK(!Pick::Create("Registry/Pick/1"));
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count + 1);
+
+	// Explicit deregistration and registration
+	BOOST_CHECK(pick->deregisterMe());
+	BOOST_CHECK(!pick->registered());
+	BOOST_CHECK(!PublicObject::Find("Registry/Pick/1"));
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count);
+
+	BOOST_CHECK(pick->registerMe());
+	BOOST_CHECK_EQUAL(PublicObject::Find("Registry/Pick/1"), pick.get());
+
+	// Changing the publicID of a registered object moves it
+	BOOST_CHECK(pick->setPublicID("Registry/Pick/2"));
+	BOOST_CHECK(!PublicObject::Find("Registry/Pick/1"));
+	BOOST_CHECK_EQUAL(PublicObject::Find("Registry/Pick/2"), pick.get());
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count + 1);
+
+	// Destruction unregisters the object
+	pick = nullptr;
+	BOOST_CHECK(!PublicObject::Find("Registry/Pick/2"));
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Iteration) {
+	vector<PickPtr> picks;
+	for ( int i = 0; i < 1000; ++i )
+		picks.push_back(Pick::Create("Registry/Iteration/" + to_string(i)));
+
+	// The iterator visits all shards
+	set<string> found;
+	PublicObject::Lock();
+	for ( auto it = PublicObject::Begin(); it != PublicObject::End(); ++it ) {
+		if ( it->second->publicID().compare(0, 19, "Registry/Iteration/") == 0 )
+			found.insert(it->second->publicID());
+	}
+	PublicObject::Unlock();
+
+	BOOST_CHECK_EQUAL(found.size(), picks.size());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(ConcurrentRegistration) {
+	const int threadCount = 8;
+	const int objectCount = 2000;
+
+	size_t count = PublicObject::ObjectCount();
+
+	vector<vector<PickPtr>> picks(threadCount);
+	vector<thread> threads;
+
+	// Each thread registers its own objects which spread over all shards
+	for ( int t = 0; t < threadCount; ++t ) {
+		threads.emplace_back([t, &picks] {
+			for ( int i = 0; i < objectCount; ++i ) {
+				string id = "Registry/Concurrent/" + to_string(t) + "/" + to_string(i);
+				picks[t].push_back(Pick::Create(id));
+				// Lookups of other threads' objects run concurrently
+				PublicObject::Find("Registry/Concurrent/" + to_string((t+1) % threadCount) + "/" + to_string(i));
+			}
+		});
+	}
+
+	for ( auto &thread : threads ) thread.join();
+	threads.clear();
+
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count + threadCount * objectCount);
+
+	for ( int t = 0; t < threadCount; ++t ) {
+		BOOST_REQUIRE_EQUAL(picks[t].size(), size_t(objectCount));
+		for ( int i = 0; i < objectCount; ++i ) {
+			BOOST_REQUIRE(picks[t][i]);
+			BOOST_CHECK_EQUAL(PublicObject::Find(picks[t][i]->publicID()), picks[t][i].get());
+		}
+	}
+
+	// Unregister concurrently again
+	for ( int t = 0; t < threadCount; ++t )
+		threads.emplace_back([t, &picks] { picks[t].clear(); });
+
+	for ( auto &thread : threads ) thread.join();
+
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count);
+	BOOST_CHECK(!PublicObject::Find("Registry/Concurrent/0/0"));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
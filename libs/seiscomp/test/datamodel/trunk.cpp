@@ -0,0 +1,373 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include "../io/archive/eventxml.h"
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/eventparameters_package.h>
+#include <seiscomp/datamodel/inventory_package.h>
+#include <seiscomp/datamodel/exchange/trunk.h>
+#include <seiscomp/io/exporter.h>
+
+#include <sstream>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+struct TestData {
+	TestData() {
+		// Objects are imported several times with the same publicIDs
+		PublicObject::SetRegistrationEnabled(false);
+	}
+
+	~TestData() {
+		PublicObject::SetRegistrationEnabled(true);
+	}
+};
+
+
+string exportObject(Core::BaseObject *obj) {
+	IO::ExporterPtr exp = IO::Exporter::Create("trunk");
+	BOOST_REQUIRE(exp);
+	exp->setFormattedOutput(true);
+	stringbuf buf;
+	BOOST_REQUIRE(exp->write(&buf, obj));
+	return buf.str();
+}
+
+
+string exportChunked(Core::BaseObject *obj, size_t threads, size_t chunkSize,
+                     bool formatted) {
+	ExporterTrunk exp;
+	exp.setThreads(threads);
+	exp.setChunkSize(chunkSize);
+	exp.setFormattedOutput(formatted);
+	stringbuf buf;
+	BOOST_REQUIRE(exp.write(&buf, obj));
+	return buf.str();
+}
+
+
+/**
+ * Checks that the chunked export writes the same document as the serial
+ * export for different chunk sizes.
+ */
+void checkChunkedExport(Core::BaseObject *obj) {
+	for ( bool formatted : { true, false } ) {
+		string serial = exportChunked(obj, 1, 1000, formatted);
+		BOOST_CHECK(!serial.empty());
+
+		for ( size_t chunkSize : { 1, 2, 7, 500 } ) {
+			BOOST_TEST_CONTEXT("formatted = " << formatted << ", chunkSize = " << chunkSize) {
+				BOOST_CHECK(exportChunked(obj, 4, chunkSize, formatted) == serial);
+			}
+		}
+	}
+}
+
+
+Core::BaseObjectPtr importObject(const string &data, bool streaming) {
+	IO::ImporterPtr imp = IO::Importer::Create("trunk");
+	BOOST_REQUIRE(imp);
+	auto trunk = dynamic_cast<ImporterTrunk*>(imp.get());
+	BOOST_REQUIRE(trunk);
+	trunk->setStreamingEnabled(streaming);
+	stringbuf buf(data);
+	return imp->read(&buf);
+}
+
+
+/**
+ * Imports a document with the DOM and the streaming reader and checks
+ * that both produce the same object tree. The trees are compared by their
+ * SCML representation.
+ */
+Core::BaseObjectPtr checkRoundTrip(const string &data) {
+	Core::BaseObjectPtr dom = importObject(data, false);
+	Core::BaseObjectPtr streamed = importObject(data, true);
+
+	BOOST_REQUIRE(dom);
+	BOOST_REQUIRE(streamed);
+	BOOST_CHECK_EQUAL(dom->className(), streamed->className());
+	BOOST_CHECK_EQUAL(exportObject(dom.get()), exportObject(streamed.get()));
+
+	return streamed;
+}
+
+
+OriginPtr createOrigin() {
+	OriginPtr org = Origin::Create("Origin/1");
+	org->setTime(TimeQuantity(Core::Time(2021, 4, 30, 5, 19, 0)));
+	org->setLatitude(RealQuantity(-15.2));
+	org->setLongitude(RealQuantity(167.4));
+	org->setDepth(RealQuantity(10.0));
+	org->setMethodID("LOCSAT");
+
+	CommentPtr comment = new Comment;
+	comment->setId("note");
+	comment->setText("first & <only>");
+	org->add(comment.get());
+
+	for ( int i = 0; i < 5; ++i ) {
+		ArrivalPtr arr = new Arrival;
+		arr->setPickID("Pick/" + to_string(i));
+		arr->setPhase(Phase(i % 2 ? "S" : "P"));
+		arr->setWeight(1.0);
+		org->add(arr.get());
+	}
+
+	MagnitudePtr mag = Magnitude::Create("Magnitude/1");
+	mag->setMagnitude(RealQuantity(4.2));
+	mag->setType("MLv");
+	org->add(mag.get());
+
+	return org;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_FIXTURE_TEST_SUITE(seiscomp_datamodel_trunk, TestData)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(EventParameters) {
+	auto obj = checkRoundTrip(XML_gempa2021ijvk);
+
+	auto ep = DataModel::EventParameters::Cast(obj);
+	BOOST_REQUIRE(ep);
+	BOOST_CHECK(ep->pickCount() > 0);
+	BOOST_CHECK(ep->amplitudeCount() > 0);
+	BOOST_REQUIRE(ep->originCount() > 0);
+	BOOST_CHECK(ep->origin(0)->arrivalCount() > 0);
+	BOOST_CHECK(ep->eventCount() > 0);
+
+	// An empty top-level object
+	obj = checkRoundTrip(XML_ep);
+	ep = DataModel::EventParameters::Cast(obj);
+	BOOST_REQUIRE(ep);
+	BOOST_CHECK_EQUAL(ep->pickCount(), 0);
+
+	// Only the first object of a document is read
+	obj = checkRoundTrip(XML_mixed);
+	BOOST_CHECK(DataModel::EventParameters::Cast(obj));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Inventory) {
+	InventoryPtr inv = new DataModel::Inventory;
+
+	SensorPtr sensor = Sensor::Create("Sensor/STS2");
+	sensor->setName("STS2");
+	sensor->setUnit("M/S");
+	inv->add(sensor.get());
+
+	DataloggerPtr logger = Datalogger::Create("Datalogger/Q330");
+	logger->setName("Q330");
+	DecimationPtr deci = new Decimation;
+	deci->setSampleRateNumerator(100);
+	deci->setSampleRateDenominator(1);
+	logger->add(deci.get());
+	inv->add(logger.get());
+
+	for ( int n = 0; n < 2; ++n ) {
+		NetworkPtr net = Network::Create();
+		net->setCode("N" + to_string(n));
+		net->setStart(Core::Time(2000, 1, 1));
+		inv->add(net.get());
+
+		for ( int s = 0; s < 3; ++s ) {
+			StationPtr sta = Station::Create();
+			sta->setCode("S" + to_string(s));
+			sta->setStart(Core::Time(2001, 1, 1));
+			net->add(sta.get());
+
+			SensorLocationPtr loc = SensorLocation::Create();
+			loc->setCode("");
+			loc->setStart(Core::Time(2001, 1, 1));
+			sta->add(loc.get());
+
+			for ( const char *code : { "HHZ", "HHN", "HHE" } ) {
+				StreamPtr cha = Stream::Create();
+				cha->setCode(code);
+				cha->setStart(Core::Time(2001, 1, 1));
+				cha->setDatalogger(logger->publicID());
+				cha->setSensor(sensor->publicID());
+				loc->add(cha.get());
+			}
+		}
+	}
+
+	string data = exportObject(inv.get());
+	auto obj = checkRoundTrip(data);
+	BOOST_CHECK_EQUAL(exportObject(obj.get()), data);
+
+	auto inv2 = DataModel::Inventory::Cast(obj);
+	BOOST_REQUIRE(inv2);
+	BOOST_CHECK_EQUAL(inv2->networkCount(), 2);
+	BOOST_CHECK_EQUAL(inv2->network(1)->station(2)->sensorLocation(0)->streamCount(), 3);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(ObjectMembers) {
+	// The members of the top-level object are read together with its
+	// children
+	OriginPtr org = createOrigin();
+	string data = exportObject(org.get());
+
+	auto obj = checkRoundTrip(data);
+	BOOST_CHECK_EQUAL(exportObject(obj.get()), data);
+
+	auto org2 = Origin::Cast(obj);
+	BOOST_REQUIRE(org2);
+	BOOST_CHECK_EQUAL(org2->latitude().value(), -15.2);
+	BOOST_CHECK_EQUAL(org2->commentCount(), 1);
+	BOOST_CHECK_EQUAL(org2->arrivalCount(), 5);
+	BOOST_CHECK_EQUAL(org2->arrival(3)->pickID(), "Pick/3");
+	BOOST_CHECK_EQUAL(org2->magnitudeCount(), 1);
+
+	// Objects without children are read as a whole
+	CommentPtr comment = new Comment;
+	comment->setId("single");
+	comment->setText("text");
+	data = exportObject(comment.get());
+	obj = checkRoundTrip(data);
+	BOOST_CHECK_EQUAL(exportObject(obj.get()), data);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Registration) {
+	string data;
+
+	{
+		OriginPtr org = createOrigin();
+		data = exportObject(org.get());
+	}
+
+	PublicObject::SetRegistrationEnabled(true);
+
+	{
+		auto obj = importObject(data, true);
+		auto org = Origin::Cast(obj);
+		BOOST_REQUIRE(org);
+
+		// The children are registered and belong to the returned object
+		Magnitude *mag = Magnitude::Find("Magnitude/1");
+		BOOST_REQUIRE(mag);
+		BOOST_CHECK(mag->origin() == org);
+		BOOST_CHECK(Origin::Find("Origin/1") == org);
+	}
+
+	BOOST_CHECK(Magnitude::Find("Magnitude/1") == nullptr);
+	BOOST_CHECK(Origin::Find("Origin/1") == nullptr);
+
+	PublicObject::SetRegistrationEnabled(false);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(SyntaxError) {
+	// A broken document discards the result in both modes
+	string data = XML_gempa2021ijvk;
+	data.resize(data.size() / 2);
+	BOOST_CHECK(!importObject(data, false));
+	BOOST_CHECK(!importObject(data, true));
+
+	// Also behind the object which has been read already
+	data = XML_ep;
+	data.resize(data.size() - 4);
+	BOOST_CHECK(!importObject(data, false));
+	BOOST_CHECK(!importObject(data, true));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(ChunkedExport) {
+	auto obj = importObject(XML_gempa2021ijvk, false);
+	BOOST_REQUIRE(obj);
+	checkChunkedExport(obj.get());
+
+	// Many children of a single type
+	EventParametersPtr ep = new DataModel::EventParameters;
+	for ( int i = 0; i < 2500; ++i ) {
+		PickPtr pick = Pick::Create("Pick/" + to_string(i));
+		pick->setTime(TimeQuantity(Core::Time(1600000000 + i, 0)));
+		pick->setWaveformID(WaveformStreamID("XX", "S" + to_string(i % 10), "", "HHZ", ""));
+		pick->setPhaseHint(Phase("P"));
+		ep->add(pick.get());
+	}
+	checkChunkedExport(ep.get());
+
+	// Members of the top-level object are written once
+	OriginPtr org = createOrigin();
+	checkChunkedExport(org.get());
+
+	// An object without children
+	ep = new DataModel::EventParameters;
+	checkChunkedExport(ep.get());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -202,6 +202,67 @@ BOOST_AUTO_TEST_CASE(binEmptyArrays) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(binMemory) {
+	stringbuf binBuf(ios_base::out);
+	IO::VBinaryArchive binOut;
+	ASSERT_MSG(binOut.create(&binBuf),
+	           "Could not create binary archive for output buffer");
+	binOut << referenceEP;
+	binOut.close();
+
+	string bin = binBuf.str();
+
+	// Read EventParameters directly from memory
+	DataModel::EventParametersPtr ep;
+	IO::VBinaryArchive binIn;
+	ASSERT_MSG(binIn.open(bin.data(), bin.size()),
+	           "Could not open binary archive for memory block of length: "
+	           << bin.length());
+	binIn >> ep;
+	BOOST_CHECK(binIn.success());
+	binIn.close();
+
+	ASSERT_MSG(ep, "EventParameters not initialized");
+
+	stringbuf xmlBuf(ios_base::out);
+	IO::XMLArchive xmlArchive(&xmlBuf, false);
+	xmlArchive.setFormattedOutput(true);
+	xmlArchive << ep;
+	xmlArchive.close();
+
+	BOOST_CHECK_EQUAL(xmlBuf.str(), referenceXML);
+
+	// Truncated blocks must not be read beyond their end. Strict mode
+	// passes errors of optional members through to the root object.
+	size_t truncatedSize = bin.size() / 2;
+	BOOST_REQUIRE_GT(truncatedSize, 0);
+	BOOST_REQUIRE_LT(truncatedSize, bin.size());
+
+	DataModel::EventParametersPtr truncated;
+	IO::VBinaryArchive truncIn;
+	BOOST_REQUIRE(truncIn.open(bin.data(), truncatedSize));
+	truncIn.setStrictMode(true);
+	truncIn >> truncated;
+	BOOST_CHECK(!truncIn.success());
+	truncIn.close();
+
+	if ( truncated ) {
+		// Whatever has been decoded must not be the complete document
+		stringbuf truncBuf(ios_base::out);
+		IO::XMLArchive truncArchive(&truncBuf, false);
+		truncArchive.setFormattedOutput(true);
+		truncArchive << truncated;
+		truncArchive.close();
+
+		BOOST_CHECK(truncBuf.str() != referenceXML);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BOOST_AUTO_TEST_SUITE_END()
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
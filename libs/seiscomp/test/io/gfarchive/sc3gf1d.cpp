@@ -0,0 +1,273 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/core/typedarray.h>
+#include <seiscomp/math/geo.h>
+#include <seiscomp/io/gfarchive/sc3gf1d.h>
+#include <seiscomp/io/gfarchive/tracecache.h>
+#include <seiscomp/io/records/sacrecord.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::IO;
+
+namespace fs = std::filesystem;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+const int Samples = 200;
+const double SamplingFrequency = 10;
+
+
+// Returns the sample value of a component after decoding. The archive
+// flips the sign of some of the components.
+float expectedValue(int comp) {
+	float value = comp + 1;
+	if ( (comp == Core::ZDS) || (comp == Core::TSS) || (comp == Core::RDS) ) {
+		value = -value;
+	}
+	return value;
+}
+
+
+/**
+ * @brief Creates an archive with a model "test" with depths of 10, 20 and
+ *        30 km and distances of 100 to 400 km in steps of 100 km. Each
+ *        component holds a constant value which does not change with
+ *        interpolation.
+ */
+struct Archive {
+	Archive() {
+		base = fs::temp_directory_path() / ("sc3gf1d-" + to_string(getpid()));
+		fs::remove_all(base);
+		fs::create_directories(base / "test");
+
+		ofstream desc((base / "test.desc").string());
+		desc << "depth 10 30 10" << endl
+		     << "distance 100 400 100" << endl;
+
+		for ( int dep = 10; dep <= 30; dep += 10 ) {
+			for ( int dist = 100; dist <= 400; dist += 100 ) {
+				for ( int i = 0; i < Core::GreensFunctionComponent::Quantity; ++i ) {
+					writeComponent(dep, dist, i);
+				}
+			}
+		}
+
+		GFTraceCache::Instance().clear();
+	}
+
+	~Archive() {
+		GFTraceCache::Instance().clear();
+		fs::remove_all(base);
+	}
+
+	fs::path componentFile(int dep, int dist, int comp) const {
+		char dep_str[10], dist_str[10];
+		snprintf(dep_str, 10, "%04d", dep*10);
+		snprintf(dist_str, 10, "%05d", dist);
+		Core::GreensFunctionComponent c(static_cast<Core::EGreensFunctionComponent>(comp));
+		return base / "test" / dep_str / dist_str
+		     / (string(dep_str) + "." + dist_str + "." + c.toString());
+	}
+
+	void writeComponent(int dep, int dist, int comp) const {
+		auto file = componentFile(dep, dist, comp);
+		fs::create_directories(file.parent_path());
+
+		FloatArray *data = new FloatArray(Samples);
+		data->fill(comp + 1);
+
+		SACRecord rec("", "", "", "", Core::Time(), SamplingFrequency);
+		rec.setData(data);
+
+		ofstream ofs(file.string(), ios::binary);
+		rec.write(ofs);
+	}
+
+	bool request(SC3GF1DArchive &archive, double distKm, double depth) const {
+		GFSource source(0, 0, depth);
+		GFReceiver receiver(0, Math::Geo::km2deg(distKm));
+		return archive.addRequest("req", "test", source, receiver);
+	}
+
+	fs::path base;
+};
+
+
+void checkComponents(const Core::GreensFunction *gf) {
+	BOOST_CHECK_EQUAL(gf->samplingFrequency(), SamplingFrequency);
+
+	for ( int i = 0; i < Core::GreensFunctionComponent::Quantity; ++i ) {
+		auto data = FloatArray::ConstCast(gf->data(static_cast<Core::EGreensFunctionComponent>(i)));
+		if ( !data ) {
+			continue;
+		}
+
+		// The time span of 10 s cuts the 20 s of samples
+		BOOST_CHECK_EQUAL(data->size(), 100);
+		BOOST_CHECK_CLOSE((*data)[0], expectedValue(i), 1E-4);
+		BOOST_CHECK_CLOSE((*data)[data->size()-1], expectedValue(i), 1E-4);
+	}
+
+	BOOST_CHECK(gf->data(Core::ZSS) != nullptr);
+	BOOST_CHECK(gf->data(Core::TDS) != nullptr);
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_FIXTURE_TEST_SUITE(seiscomp_io_gfarchive_sc3gf1d, Archive)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Decode) {
+	auto &cache = GFTraceCache::Instance();
+	size_t capacity = cache.capacity();
+
+	// Read through the mapped files only
+	cache.setCapacity(0);
+
+	SC3GF1DArchive archive;
+	BOOST_REQUIRE(archive.setSource(base.string()));
+	archive.setTimeSpan(Core::TimeSpan(10.0));
+
+	// Grid node
+	BOOST_REQUIRE(request(archive, 200.5, 10));
+	Core::GreensFunctionPtr gf = archive.get();
+	BOOST_REQUIRE(gf);
+	checkComponents(gf.get());
+
+	// Interpolated in depth
+	BOOST_REQUIRE(request(archive, 260, 15));
+	gf = archive.get();
+	BOOST_REQUIRE(gf);
+	checkComponents(gf.get());
+
+	BOOST_CHECK(archive.get() == nullptr);
+
+	archive.close();
+	cache.setCapacity(capacity);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(MissingComponent) {
+	auto &cache = GFTraceCache::Instance();
+
+	// Most of the other components of the node are decoded already when
+	// this one is missing and must be released.
+	fs::remove(componentFile(10, 200, Core::ZDD));
+
+	SC3GF1DArchive archive;
+	BOOST_REQUIRE(archive.setSource(base.string()));
+	archive.setTimeSpan(Core::TimeSpan(10.0));
+
+	BOOST_REQUIRE(request(archive, 200.5, 10));
+	BOOST_CHECK(archive.get() == nullptr);
+
+	// Nothing has been cached or prefetched for the broken node
+	archive.close();
+	BOOST_CHECK_EQUAL(cache.count(), 0);
+
+	// The intact nodes are still served
+	BOOST_REQUIRE(archive.setSource(base.string()));
+	archive.setTimeSpan(Core::TimeSpan(10.0));
+	BOOST_REQUIRE(request(archive, 200.5, 30));
+	Core::GreensFunctionPtr gf = archive.get();
+	BOOST_REQUIRE(gf);
+	checkComponents(gf.get());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Prefetch) {
+	auto &cache = GFTraceCache::Instance();
+
+	SC3GF1DArchive archive;
+	BOOST_REQUIRE(archive.setSource(base.string()));
+	archive.setTimeSpan(Core::TimeSpan(10.0));
+
+	// Reads the nodes at 300 km and 10 and 20 km depth
+	BOOST_REQUIRE(request(archive, 260, 15));
+	Core::GreensFunctionPtr gf = archive.get();
+	BOOST_REQUIRE(gf);
+	checkComponents(gf.get());
+
+	// Waits for the prefetch worker. The cells which share an edge with
+	// the cell of 200 - 300 km and 10 - 20 km depth add the nodes at 100
+	// and 400 km at both depths and the nodes at 30 km depth at both
+	// distances.
+	archive.close();
+	BOOST_CHECK_EQUAL(cache.count(), 8);
+
+	// Prefetched nodes are served from the cache even if the files are gone
+	for ( int i = 0; i < Core::GreensFunctionComponent::Quantity; ++i ) {
+		fs::remove(componentFile(30, 300, i));
+	}
+
+	BOOST_REQUIRE(archive.setSource(base.string()));
+	archive.setTimeSpan(Core::TimeSpan(10.0));
+	BOOST_REQUIRE(request(archive, 300.5, 30));
+	gf = archive.get();
+	BOOST_REQUIRE(gf);
+	checkComponents(gf.get());
+	archive.close();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,204 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/core/strings.h>
+#include <seiscomp/core/typedarray.h>
+#include <seiscomp/io/gfarchive/tracecache.h>
+
+#include <atomic>
+#include <thread>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::IO;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+GFTraceCache::TracePtr makeTrace(int samples, float value) {
+	Core::GreensFunctionPtr gf = new Core::GreensFunction();
+	gf->setSamplingFrequency(10);
+	gf->setTimeOffset(1.5);
+	gf->setData(Core::ZSS, new FloatArray(samples));
+	gf->setData(Core::TDS, new FloatArray(samples));
+	static_cast<FloatArray*>(gf->data(Core::ZSS))->fill(value);
+	static_cast<FloatArray*>(gf->data(Core::TDS))->fill(-value);
+	return GFTraceCache::FromGreensFunction(gf.get());
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_io_gfarchive_tracecache)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(RoundTrip) {
+	auto trace = makeTrace(100, 2.0f);
+	BOOST_CHECK_EQUAL(trace->bytes(), 2 * 100 * sizeof(float));
+
+	Core::GreensFunctionPtr gf = GFTraceCache::ToGreensFunction(*trace);
+	BOOST_CHECK_EQUAL(gf->samplingFrequency(), 10);
+	BOOST_CHECK_EQUAL(gf->timeOffset(), 1.5);
+	BOOST_CHECK(gf->data(Core::ZDD) == nullptr);
+
+	auto zss = FloatArray::Cast(gf->data(Core::ZSS));
+	auto tds = FloatArray::Cast(gf->data(Core::TDS));
+	BOOST_REQUIRE(zss != nullptr);
+	BOOST_REQUIRE(tds != nullptr);
+	BOOST_CHECK_EQUAL(zss->size(), 100);
+	BOOST_CHECK_EQUAL((*zss)[99], 2.0f);
+	BOOST_CHECK_EQUAL((*tds)[0], -2.0f);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Eviction) {
+	auto &cache = GFTraceCache::Instance();
+	cache.clear();
+
+	// Room for three traces
+	size_t bytes = makeTrace(100, 0)->bytes();
+	cache.setCapacity(3 * bytes);
+
+	cache.insert("a", makeTrace(100, 1));
+	cache.insert("b", makeTrace(100, 2));
+	cache.insert("c", makeTrace(100, 3));
+	BOOST_CHECK_EQUAL(cache.count(), 3);
+	BOOST_CHECK_EQUAL(cache.size(), 3 * bytes);
+
+	// Touch a such that b is the least recently used
+	BOOST_CHECK(cache.find("a") != nullptr);
+	BOOST_CHECK(cache.contains("c"));
+
+	cache.insert("d", makeTrace(100, 4));
+	BOOST_CHECK_EQUAL(cache.count(), 3);
+	BOOST_CHECK(cache.contains("a"));
+	BOOST_CHECK(!cache.contains("b"));
+	BOOST_CHECK(cache.contains("c"));
+	BOOST_CHECK(cache.contains("d"));
+
+	// The first insert wins
+	auto first = cache.find("d");
+	BOOST_CHECK(cache.insert("d", makeTrace(100, 5)) == first);
+	BOOST_CHECK_EQUAL(cache.find("d")->components[Core::ZSS][0], 4.0f);
+
+	// Traces larger than the capacity are not cached
+	cache.insert("e", makeTrace(400, 6));
+	BOOST_CHECK(!cache.contains("e"));
+	BOOST_CHECK_EQUAL(cache.count(), 3);
+
+	cache.setCapacity(bytes);
+	BOOST_CHECK_EQUAL(cache.count(), 1);
+	BOOST_CHECK(cache.contains("d"));
+
+	cache.setCapacity(0);
+	BOOST_CHECK(!cache.enabled());
+	BOOST_CHECK_EQUAL(cache.count(), 0);
+	BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Concurrent) {
+	auto &cache = GFTraceCache::Instance();
+	cache.clear();
+
+	// Room for a quarter of the keys which forces evictions while other
+	// threads look up the same traces
+	const int numKeys = 64;
+	const int numThreads = 8;
+	size_t bytes = makeTrace(100, 0)->bytes();
+	cache.setCapacity(numKeys / 4 * bytes);
+
+	std::atomic<int> mismatches{0};
+	std::atomic<int> hits{0};
+	std::vector<std::thread> threads;
+
+	for ( int t = 0; t < numThreads; ++t ) {
+		threads.emplace_back([&, t]() {
+			for ( int i = 0; i < 2000; ++i ) {
+				int k = (i * 7 + t * 13) % numKeys;
+				std::string key = Core::toString(k);
+
+				auto trace = cache.find(key);
+				if ( !trace ) {
+					trace = cache.insert(key, makeTrace(100, k));
+				}
+				else {
+					++hits;
+				}
+
+				// Whichever insert won, the trace must belong to the key
+				if ( trace->components[Core::ZSS][0] != k
+				  || trace->components[Core::TDS][99] != -k ) {
+					++mismatches;
+				}
+			}
+		});
+	}
+
+	for ( auto &thread : threads ) {
+		thread.join();
+	}
+
+	BOOST_CHECK_EQUAL(mismatches, 0);
+	BOOST_CHECK_GT(hits, 0);
+	BOOST_CHECK_LE(cache.size(), cache.capacity());
+	BOOST_CHECK_EQUAL(cache.size(), cache.count() * bytes);
+	BOOST_CHECK_LE(cache.count(), static_cast<size_t>(numKeys / 4));
+
+	cache.setCapacity(256 * 1024 * 1024);
+	cache.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -27,6 +27,9 @@
 #include <seiscomp/core/recordsequence.h>
 #include <seiscomp/logging/log.h>
 #include <seiscomp/io/recordstream/sdsarchive.h>
+#include <seiscomp/io/records/mseedrecord.h>
+
+#include <cstring>
 
 
 using namespace std;
@@ -303,5 +306,44 @@ BOOST_AUTO_TEST_CASE(READ_GAPPY_ARCHIVE_EMPTY3) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(READ_FR_SALF_RAW) {
+	Time startTime(2018,06,30,16,18,38,943300);
+	Time endTime(2018,06,30,16,21,58,943300);
+
+	SDSArchive sds("archive");
+	sds.addStream("FR", "SALF", "00", "HHN", startTime, endTime);
+
+	SDSArchive sdsRaw("archive");
+	sdsRaw.addStream("FR", "SALF", "00", "HHN", startTime, endTime);
+
+	vector<char> data;
+	RecordPtr rec;
+	size_t count = 0;
+
+	while ( (rec = sds.next()) ) {
+		BOOST_REQUIRE(sdsRaw.nextRaw(data));
+
+		const Array *raw = rec->raw();
+		BOOST_REQUIRE(raw);
+		BOOST_REQUIRE_EQUAL(data.size(), static_cast<size_t>(raw->size() * raw->elementSize()));
+		BOOST_CHECK(memcmp(data.data(), raw->data(), data.size()) == 0);
+
+		MSeedRawHeader header;
+		BOOST_REQUIRE(MSeedRecord::ParseRawHeader(data.data(), data.size(), header));
+		BOOST_CHECK_EQUAL(header.streamID(), rec->streamID());
+		BOOST_CHECK_EQUAL(header.startTime.iso(), rec->startTime().iso());
+		BOOST_CHECK_EQUAL(header.endTime.iso(), rec->endTime().iso());
+		++count;
+	}
+
+	BOOST_CHECK(count > 0);
+	BOOST_CHECK(!sdsRaw.nextRaw(data));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,251 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include "../archive/eventxml.h"
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/eventparameters_package.h>
+#include <seiscomp/datamodel/inventory_package.h>
+#include <seiscomp/io/archive/xmlarchive.h>
+#include <seiscomp/io/exporter.h>
+#include <seiscomp/io/xml/importer.h>
+
+#include <complex>
+#include <sstream>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+struct TestData {
+	TestData() {
+		// Objects are imported several times with the same publicIDs
+		PublicObject::SetRegistrationEnabled(false);
+	}
+
+	~TestData() {
+		PublicObject::SetRegistrationEnabled(true);
+	}
+};
+
+
+string exportObject(const char *format, Core::BaseObject *obj) {
+	IO::ExporterPtr exp = IO::Exporter::Create(format);
+	BOOST_REQUIRE(exp);
+	exp->setFormattedOutput(true);
+	stringbuf buf;
+	BOOST_REQUIRE(exp->write(&buf, obj));
+	return buf.str();
+}
+
+
+Core::BaseObjectPtr importObject(const char *format, const string &data,
+                                 bool streaming) {
+	IO::ImporterPtr imp = IO::Importer::Create(format);
+	BOOST_REQUIRE(imp);
+	auto xmlImp = dynamic_cast<IO::XML::Importer*>(imp.get());
+	BOOST_REQUIRE(xmlImp);
+	xmlImp->setStreamingEnabled(streaming);
+	stringbuf buf(data);
+	return imp->read(&buf);
+}
+
+
+/**
+ * Imports a document with the DOM and the streaming parser and checks
+ * that both produce the same object tree. The trees are compared by their
+ * SCML representation.
+ */
+Core::BaseObjectPtr checkRoundTrip(const char *format, const string &data) {
+	Core::BaseObjectPtr dom = importObject(format, data, false);
+	Core::BaseObjectPtr streamed = importObject(format, data, true);
+
+	BOOST_REQUIRE(dom);
+	BOOST_REQUIRE(streamed);
+	BOOST_CHECK_EQUAL(dom->className(), streamed->className());
+	BOOST_CHECK_EQUAL(exportObject("trunk", dom.get()),
+	                  exportObject("trunk", streamed.get()));
+
+	return streamed;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_FIXTURE_TEST_SUITE(seiscomp_io_xml_importer, TestData)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(EventParameters) {
+	EventParametersPtr ep;
+
+	stringbuf scmlBuf(XML_gempa2021ijvk, ios_base::in);
+	IO::XMLArchive ar(&scmlBuf, true);
+	ar >> ep;
+	ar.close();
+
+	BOOST_REQUIRE(ep);
+	BOOST_REQUIRE(ep->pickCount() > 0);
+	BOOST_REQUIRE(ep->originCount() > 0);
+
+	auto obj = checkRoundTrip("scdm0.51", exportObject("scdm0.51", ep.get()));
+
+	auto ep2 = DataModel::EventParameters::Cast(obj);
+	BOOST_REQUIRE(ep2);
+	BOOST_CHECK_EQUAL(ep2->pickCount(), ep->pickCount());
+	BOOST_CHECK_EQUAL(ep2->amplitudeCount(), ep->amplitudeCount());
+	BOOST_CHECK_EQUAL(ep2->originCount(), ep->originCount());
+	BOOST_CHECK_EQUAL(ep2->eventCount(), ep->eventCount());
+	BOOST_CHECK_EQUAL(ep2->origin(0)->arrivalCount(), ep->origin(0)->arrivalCount());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Inventory) {
+	InventoryPtr inv = new DataModel::Inventory;
+
+	ResponsePAZPtr paz = ResponsePAZ::Create("ResponsePAZ/STS2");
+	paz->setName("STS2");
+	paz->setType("A");
+	paz->setGain(1500.0);
+	paz->setGainFrequency(1.0);
+	paz->setNormalizationFactor(6.0077e7);
+	paz->setNormalizationFrequency(1.0);
+	ComplexArray poles;
+	poles.content().push_back(std::complex<double>(-0.037004, 0.037016));
+	poles.content().push_back(std::complex<double>(-0.037004, -0.037016));
+	paz->setNumberOfPoles(2);
+	paz->setPoles(poles);
+	paz->setNumberOfZeros(0);
+	paz->setZeros(ComplexArray());
+	inv->add(paz.get());
+
+	SensorPtr sensor = Sensor::Create("Sensor/STS2");
+	sensor->setName("STS2");
+	sensor->setResponse(paz->publicID());
+	sensor->setUnit("M/S");
+	inv->add(sensor.get());
+
+	DataloggerPtr logger = Datalogger::Create("Datalogger/Q330");
+	logger->setName("Q330");
+	logger->setMaxClockDrift(0.0001);
+	DecimationPtr deci = new Decimation;
+	deci->setSampleRateNumerator(100);
+	deci->setSampleRateDenominator(1);
+	logger->add(deci.get());
+	inv->add(logger.get());
+
+	for ( int n = 0; n < 2; ++n ) {
+		NetworkPtr net = Network::Create();
+		net->setCode("N" + to_string(n));
+		net->setStart(Core::Time(2000, 1, 1));
+		net->setDescription("Network <" + to_string(n) + "> & more");
+		inv->add(net.get());
+
+		for ( int s = 0; s < 3; ++s ) {
+			StationPtr sta = Station::Create();
+			sta->setCode("S" + to_string(s));
+			sta->setStart(Core::Time(2001, 1, 1));
+			sta->setLatitude(10.0 + s);
+			sta->setLongitude(20.0 - s);
+			sta->setElevation(100.0 * s);
+			net->add(sta.get());
+
+			SensorLocationPtr loc = SensorLocation::Create();
+			loc->setCode("");
+			loc->setStart(Core::Time(2001, 1, 1));
+			loc->setLatitude(10.0 + s);
+			loc->setLongitude(20.0 - s);
+			loc->setElevation(100.0 * s);
+			sta->add(loc.get());
+
+			for ( const char *code : { "HHZ", "HHN", "HHE" } ) {
+				StreamPtr cha = Stream::Create();
+				cha->setCode(code);
+				cha->setStart(Core::Time(2001, 1, 1));
+				cha->setDatalogger(logger->publicID());
+				cha->setSensor(sensor->publicID());
+				cha->setSampleRateNumerator(100);
+				cha->setSampleRateDenominator(1);
+				cha->setGain(6.0e8);
+				cha->setGainFrequency(1.0);
+				loc->add(cha.get());
+			}
+		}
+	}
+
+	auto obj = checkRoundTrip("arclink", exportObject("arclink", inv.get()));
+
+	auto inv2 = DataModel::Inventory::Cast(obj);
+	BOOST_REQUIRE(inv2);
+	BOOST_CHECK_EQUAL(inv2->networkCount(), inv->networkCount());
+	BOOST_CHECK_EQUAL(inv2->responsePAZCount(), inv->responsePAZCount());
+	BOOST_CHECK_EQUAL(inv2->network(1)->stationCount(), 3);
+	BOOST_CHECK_EQUAL(inv2->network(1)->station(2)->sensorLocation(0)->streamCount(), 3);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(SyntaxError) {
+	// A broken document discards the result in both modes
+	EventParametersPtr ep = new DataModel::EventParameters;
+	ep->add(Pick::Create("Pick/1"));
+	string data = exportObject("scdm0.51", ep.get());
+	data.resize(data.size() / 2);
+	BOOST_CHECK(!importObject("scdm0.51", data, false));
+	BOOST_CHECK(!importObject("scdm0.51", data, true));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,338 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/core/strings.h>
+#include <seiscomp/datamodel/notifier.h>
+#include <seiscomp/datamodel/pick.h>
+#include <seiscomp/datamodel/version.h>
+#include <seiscomp/messaging/connection.h>
+#include <seiscomp/wired/protocols/websocket.h>
+#include <seiscomp/broker/protocol.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+const char *Group = "PICK";
+
+
+/**
+ * @brief A broker stub which accepts a single client, completes the
+ *        handshake and records all bytes sent by the client afterwards
+ *        until the client closes the connection. It never acknowledges
+ *        messages and the client must connect with ack=0.
+ */
+class Broker {
+	public:
+		Broker() {
+			_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+			BOOST_REQUIRE(_fd >= 0);
+
+			sockaddr_in addr{};
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			addr.sin_port = 0;
+			BOOST_REQUIRE(::bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+			BOOST_REQUIRE(::listen(_fd, 1) == 0);
+
+			socklen_t len = sizeof(addr);
+			BOOST_REQUIRE(::getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0);
+			_port = ntohs(addr.sin_port);
+
+			_thread = thread(&Broker::run, this);
+		}
+
+		~Broker() {
+			wait();
+			::close(_fd);
+		}
+
+		string url() const {
+			return "scmp://127.0.0.1:" + Core::toString(_port) + "/production?ack=0";
+		}
+
+		//! Waits until the client has closed the connection
+		void wait() {
+			if ( _thread.joinable() ) {
+				_thread.join();
+			}
+		}
+
+		//! The raw bytes received after the connect frame
+		const string &stream() const {
+			return _stream;
+		}
+
+		//! The frames received after the connect frame
+		const vector<Wired::Websocket::FramePtr> &frames() const {
+			return _frames;
+		}
+
+
+	private:
+		void run() {
+			int client = ::accept(_fd, nullptr, nullptr);
+			if ( client < 0 ) {
+				return;
+			}
+
+			string input;
+			char buf[4096];
+			ssize_t bytes;
+
+			// HTTP upgrade request
+			size_t end;
+			while ( (end = input.find("\r\n\r\n")) == string::npos ) {
+				bytes = ::read(client, buf, sizeof(buf));
+				if ( bytes <= 0 ) {
+					::close(client);
+					return;
+				}
+				input.append(buf, bytes);
+			}
+
+			input.erase(0, end + 4);
+
+			string response = "HTTP/1.1 101 Switching Protocols\r\n"
+			                  "Upgrade: websocket\r\n"
+			                  "Connection: Upgrade\r\n"
+			                  "Sec-WebSocket-Protocol: scmp\r\n"
+			                  "\r\n";
+			write(client, response);
+
+			bool connected = false;
+			Wired::Websocket::FramePtr frame = new Wired::Websocket::Frame;
+
+			while ( true ) {
+				const char *data = input.data();
+				size_t len = input.size();
+
+				while ( len > 0 ) {
+					ssize_t consumed = frame->feed(data, len);
+					if ( consumed < 0 ) {
+						::close(client);
+						return;
+					}
+
+					if ( connected ) {
+						_stream.append(data, consumed);
+					}
+
+					data += consumed;
+					len -= consumed;
+
+					if ( !frame->isFinished() ) {
+						continue;
+					}
+
+					if ( !connected ) {
+						connected = true;
+						sendConnected(client);
+					}
+					else {
+						_frames.push_back(frame);
+					}
+
+					frame = new Wired::Websocket::Frame;
+				}
+
+				input.clear();
+
+				bytes = ::read(client, buf, sizeof(buf));
+				if ( bytes <= 0 ) {
+					break;
+				}
+
+				input.assign(buf, bytes);
+			}
+
+			::close(client);
+		}
+
+		void sendConnected(int client) {
+			Wired::Buffer reply;
+			reply.data = SCMP_PROTO_REPLY_CONNECT "\n"
+			             SCMP_PROTO_REPLY_CONNECT_HEADER_QUEUE ":production\n"
+			             SCMP_PROTO_REPLY_CONNECT_HEADER_CLIENT_NAME ":test\n";
+			reply.data += SCMP_PROTO_REPLY_CONNECT_HEADER_SCHEMA_VERSION ":"
+			            + Core::toString(Version::Major) + "." + Core::toString(Version::Minor) + "\n";
+			reply.data += SCMP_PROTO_REPLY_CONNECT_HEADER_GROUPS ":";
+			reply.data += Group;
+			reply.data += "\n\n";
+
+			Wired::Websocket::Frame::finalizeBuffer(&reply, Wired::Websocket::Frame::TextFrame);
+			write(client, reply.header);
+			write(client, reply.data);
+		}
+
+		static void write(int fd, const string &data) {
+			size_t written = 0;
+			while ( written < data.size() ) {
+				ssize_t bytes = ::write(fd, data.data() + written, data.size() - written);
+				if ( bytes <= 0 ) {
+					return;
+				}
+				written += static_cast<size_t>(bytes);
+			}
+		}
+
+
+	private:
+		int                                _fd;
+		int                                _port;
+		thread                             _thread;
+		string                             _stream;
+		vector<Wired::Websocket::FramePtr> _frames;
+};
+
+
+/**
+ * @brief Creates one notifier message per pick as Notifier::GetMessage(false)
+ *        would return them when the notifier pool is flushed.
+ */
+vector<NotifierMessagePtr> createMessages(size_t count) {
+	vector<NotifierMessagePtr> msgs;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		PickPtr pick = Pick::Create("Pick/" + Core::toString(i));
+		BOOST_REQUIRE(pick);
+		pick->setTime(Core::Time(1000000000 + static_cast<int64_t>(i)));
+		pick->setWaveformID(WaveformStreamID("XX", "ABC", "", "HHZ", ""));
+		pick->setPhaseHint(Phase("P"));
+
+		NotifierMessagePtr msg = new NotifierMessage;
+		msg->attach(new Notifier("EventParameters", OP_ADD, pick.get()));
+		msgs.push_back(msg);
+	}
+
+	return msgs;
+}
+
+
+string send(const vector<NotifierMessagePtr> &msgs, bool batch,
+            size_t *frames) {
+	Broker broker;
+
+	Client::ConnectionPtr con = new Client::Connection;
+	BOOST_REQUIRE(con->setSource(broker.url()) == Client::OK);
+	BOOST_REQUIRE(con->connect("test", Group) == Client::OK);
+
+	if ( batch ) {
+		BOOST_REQUIRE(con->beginBatch() == Client::OK);
+	}
+
+	for ( const auto &msg : msgs ) {
+		BOOST_REQUIRE(con->send(Group, msg.get()));
+	}
+
+	if ( batch ) {
+		BOOST_REQUIRE(con->endBatch() == Client::OK);
+	}
+
+	con->close();
+	broker.wait();
+
+	*frames = broker.frames().size();
+	for ( const auto &frame : broker.frames() ) {
+		BOOST_CHECK_EQUAL(frame->type, Wired::Websocket::Frame::BinaryFrame);
+		BOOST_CHECK(!frame->data.compare(0, 5, SCMP_PROTO_CMD_SEND "\n"));
+	}
+
+	return broker.stream();
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_messaging_websocket)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(BatchedMessages) {
+	auto msgs = createMessages(10);
+
+	size_t singleFrames, batchedFrames;
+	string single = send(msgs, false, &singleFrames);
+	string batched = send(msgs, true, &batchedFrames);
+
+	BOOST_CHECK_EQUAL(singleFrames, msgs.size());
+	BOOST_CHECK_EQUAL(batchedFrames, msgs.size());
+	BOOST_CHECK(!single.empty());
+	BOOST_CHECK(single == batched);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(LargeBatch) {
+	// Exceeds the batch size limit several times and the batch is
+	// flushed in between
+	auto msgs = createMessages(5000);
+
+	size_t singleFrames, batchedFrames;
+	string single = send(msgs, false, &singleFrames);
+	string batched = send(msgs, true, &batchedFrames);
+
+	BOOST_CHECK_EQUAL(singleFrames, msgs.size());
+	BOOST_CHECK_EQUAL(batchedFrames, msgs.size());
+	BOOST_CHECK(single.size() > 256 * 1024);
+	BOOST_CHECK(single == batched);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -0,0 +1,170 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/core/genericrecord.h>
+#include <seiscomp/core/typedarray.h>
+#include <seiscomp/qc/qcengine.h>
+#include <seiscomp/qc/qcprocessor_gap.h>
+#include <seiscomp/qc/qcprocessor_mean.h>
+#include <seiscomp/qc/qcprocessor_rms.h>
+#include <seiscomp/qc/qcprocessor_spike.h>
+
+#include <cmath>
+#include <vector>
+
+
+using namespace Seiscomp;
+using namespace Seiscomp::Core;
+using namespace Seiscomp::Processing;
+
+
+namespace {
+
+
+struct Counter : QcProcessorObserver {
+	void update() override { ++calls; }
+	int calls{0};
+};
+
+
+struct Processors {
+	Processors() {
+		mean = new QcProcessorMean;
+		rms = new QcProcessorRms;
+		gap = new QcProcessorGap;
+		spike = new QcProcessorSpike;
+		for ( QcProcessor *proc : list() ) {
+			proc->subscribe(&counter);
+		}
+	}
+
+	~Processors() {
+		for ( QcProcessor *proc : list() ) {
+			proc->unsubscribe(&counter);
+		}
+	}
+
+	std::vector<QcProcessor*> list() const {
+		return { mean.get(), rms.get(), gap.get(), spike.get() };
+	}
+
+	QcProcessorMeanPtr  mean;
+	QcProcessorRmsPtr   rms;
+	QcProcessorGapPtr   gap;
+	QcProcessorSpikePtr spike;
+	Counter             counter;
+};
+
+
+std::vector<GenericRecordPtr> makeRecords() {
+	std::vector<GenericRecordPtr> records;
+	const double fsamp = 20.0;
+	const int samples = 200;
+	Time startTime(2024, 12, 20, 0, 0, 0);
+
+	for ( int r = 0; r < 8; ++r ) {
+		DoubleArrayPtr data = new DoubleArray(samples);
+		for ( int i = 0; i < samples; ++i ) {
+			(*data)[i] = 1e6 + 100 * sin(0.05 * (r * samples + i)) + (i % 7);
+		}
+
+		if ( r == 3 ) {
+			(*data)[50] += 1e5;
+		}
+
+		if ( r == 5 ) {
+			startTime += TimeSpan(2, 0);
+		}
+
+		GenericRecordPtr rec = new GenericRecord("XX", "ABCD", "", "BHZ",
+		                                         startTime, fsamp);
+		rec->setData(data.get());
+		records.push_back(rec);
+		startTime = rec->endTime();
+	}
+
+	return records;
+}
+
+
+}
+
+
+BOOST_AUTO_TEST_SUITE(seiscomp_processing_qc)
+
+
+BOOST_AUTO_TEST_CASE(engine) {
+	auto records = makeRecords();
+
+	Processors single, combined;
+	QcEngine engine;
+
+	for ( QcProcessor *proc : combined.list() ) {
+		BOOST_CHECK(engine.add(proc));
+	}
+	BOOST_CHECK(!engine.add(combined.mean.get()));
+
+	int spikes = 0, gaps = 0;
+
+	for ( auto &rec : records ) {
+		for ( QcProcessor *proc : single.list() ) {
+			proc->feed(rec.get());
+		}
+		engine.feed(rec.get());
+
+		const DoubleArray *data = DoubleArray::ConstCast(rec->data());
+		BOOST_CHECK_EQUAL(engine.statistics().count, static_cast<size_t>(data->size()));
+		BOOST_CHECK_EQUAL(engine.statistics().min, data->min());
+		BOOST_CHECK_EQUAL(engine.statistics().max, data->max());
+
+		BOOST_CHECK_CLOSE(single.mean->getMean(), combined.mean->getMean(), 1e-9);
+		BOOST_CHECK_CLOSE(single.rms->getRms(), combined.rms->getRms(), 1e-9);
+
+		BOOST_CHECK_EQUAL(single.gap->isValid(), combined.gap->isValid());
+		if ( single.gap->isValid() ) {
+			BOOST_CHECK_EQUAL(single.gap->getGap(), combined.gap->getGap());
+			++gaps;
+		}
+
+		BOOST_CHECK_EQUAL(single.spike->isValid(), combined.spike->isValid());
+		if ( single.spike->isValid() ) {
+			BOOST_CHECK(single.spike->getSpikes() == combined.spike->getSpikes());
+			++spikes;
+		}
+	}
+
+	BOOST_CHECK_EQUAL(gaps, 1);
+	BOOST_CHECK_EQUAL(spikes, 1);
+	BOOST_CHECK_EQUAL(single.counter.calls, combined.counter.calls);
+	BOOST_CHECK_EQUAL(combined.counter.calls, static_cast<int>(records.size() * 4));
+
+	BOOST_CHECK(engine.remove(combined.spike.get()));
+	BOOST_CHECK(!engine.remove(combined.spike.get()));
+	BOOST_CHECK_EQUAL(engine.processors().size(), 3);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/geo/feature.h>
+#include <seiscomp/processing/regions.h>
+
+
+using namespace Seiscomp;
+using namespace Seiscomp::Geo;
+using namespace Seiscomp::Processing;
+
+
+namespace {
+
+
+GeoFeature *square(const char *name, double lat, double lon, double size) {
+	auto *f = new GeoFeature(name, nullptr, 1);
+	f->addVertex(lat, lon);
+	f->addVertex(lat + size, lon);
+	f->addVertex(lat + size, lon + size);
+	f->addVertex(lat, lon + size);
+	f->setClosedPolygon(true);
+	return f;
+}
+
+
+}
+
+
+BOOST_AUTO_TEST_SUITE(seiscomp_processing_regions)
+
+
+BOOST_AUTO_TEST_CASE(IndexUpdate) {
+	RegionsPtr regions = new Regions;
+	auto *a = square("A", 0, 0, 10);
+	regions->featureSet.addFeature(a);
+	BOOST_CHECK(!regions->isIndexed());
+
+	regions->updateIndex();
+	BOOST_CHECK(regions->isIndexed());
+	BOOST_CHECK_EQUAL(regions->find(5, 5), a);
+	BOOST_CHECK(regions->contains(a, 5, 5));
+	BOOST_CHECK(!regions->contains(a, 15, 15));
+
+	// Replace the feature with another one, the feature count does not
+	// change but the index refers to a deleted feature
+	regions->featureSet.clear();
+	auto *b = square("B", 20, 20, 10);
+	regions->featureSet.addFeature(b);
+	BOOST_CHECK(!regions->isIndexed());
+	BOOST_CHECK(regions->find(5, 5) == nullptr);
+	BOOST_CHECK_EQUAL(regions->find(25, 25), b);
+	BOOST_CHECK(regions->contains(b, 25, 25));
+	BOOST_CHECK(regions->containsPath(b, 21, 21, 29, 29));
+	BOOST_CHECK(!regions->containsPath(b, 21, 21, 5, 5));
+
+	regions->updateIndex();
+	BOOST_CHECK(regions->isIndexed());
+	BOOST_CHECK(regions->find(5, 5) == nullptr);
+	BOOST_CHECK_EQUAL(regions->find(25, 25), b);
+
+	// Adding a feature outdates the index as well
+	auto *c = square("C", 0, 0, 10);
+	regions->featureSet.addFeature(c);
+	BOOST_CHECK(!regions->isIndexed());
+	BOOST_CHECK_EQUAL(regions->find(5, 5), c);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
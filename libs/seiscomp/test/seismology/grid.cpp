@@ -0,0 +1,266 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+#include <seiscomp/unittest/unittests.h>
+#include <seiscomp/seismology/ttt.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+
+
+#define STR(X) #X
+#define STR2(X) STR(X)
+
+
+namespace {
+
+
+TravelTimeTableInterfacePtr create(const char *interface, const char *model) {
+	setenv("SEISCOMP_LIBTAU_TABLE_DIR", STR2(BUILD_DIR) "/libs/3rd-party/tau/data/", 1);
+
+	TravelTimeTableInterfacePtr ttt = TravelTimeTableInterfaceFactory::Create(interface);
+	BOOST_REQUIRE(ttt);
+	BOOST_REQUIRE(ttt->setModel(model));
+	return ttt;
+}
+
+
+// Receivers on the equator and off the equator from regional to core phase
+// distances. The distances on the equator avoid the nodes of the default grid.
+void receivers(vector<double> &lats, vector<double> &lons) {
+	for ( double d = 0.35; d < 180; d += 3.7 ) {
+		lats.push_back(0);
+		lons.push_back(d);
+		lats.push_back(d < 90 ? d * 0.5 : 90 - d * 0.5);
+		lons.push_back(-d * 0.7);
+	}
+}
+
+
+}
+
+
+BOOST_AUTO_TEST_SUITE(seiscomp_core_seismology_grid)
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(Interpolation) {
+	auto grid = create("grid", "libtau:iasp91");
+	auto libtau = create("libtau", "iasp91");
+
+	vector<double> lats, lons;
+	receivers(lats, lons);
+
+	for ( const char *phase : { "P", "S" } ) {
+		for ( double depth : { 12.0, 33.3, 212.5 } ) {
+			size_t valid = 0;
+
+			for ( size_t i = 0; i < lats.size(); ++i ) {
+				TravelTime tt, reference;
+
+				try {
+					reference = libtau->compute(phase, 0, 0, depth, lats[i], lons[i], 0, 0);
+				}
+				catch ( NoPhaseError & ) {
+					BOOST_CHECK_THROW(grid->compute(phase, 0, 0, depth, lats[i], lons[i], 0, 0),
+					                  NoPhaseError);
+					continue;
+				}
+
+				BOOST_REQUIRE_NO_THROW(tt = grid->compute(phase, 0, 0, depth, lats[i], lons[i], 0, 0));
+				BOOST_CHECK_SMALL(tt.time - reference.time, 0.2);
+				BOOST_CHECK_EQUAL(grid->computeTime(phase, 0, 0, depth, lats[i], lons[i], 0, 0),
+				                  tt.time);
+				++valid;
+			}
+
+			BOOST_CHECK(valid > 0);
+		}
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(FirstArrival) {
+	auto grid = create("grid", "libtau:iasp91");
+	auto libtau = create("libtau", "iasp91");
+
+	vector<double> lats, lons;
+	receivers(lats, lons);
+
+	for ( double depth : { 12.0, 33.3, 212.5 } ) {
+		for ( size_t i = 0; i < lats.size(); ++i ) {
+			TravelTime reference;
+
+			try {
+				reference = libtau->computeFirst(0, 0, depth, lats[i], lons[i], 0, 0);
+			}
+			catch ( NoPhaseError & ) {
+				continue;
+			}
+
+			TravelTime tt;
+			BOOST_REQUIRE_NO_THROW(tt = grid->computeFirst(0, 0, depth, lats[i], lons[i], 0, 0));
+			BOOST_CHECK_SMALL(tt.time - reference.time, 0.2);
+		}
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(CompleteList) {
+	auto grid = create("grid", "libtau:iasp91");
+	auto libtau = create("libtau", "iasp91");
+
+	// Complete lists are passed through to the sampled interface
+	unique_ptr<TravelTimeList> list(grid->compute(0, 0, 33, 10, 20, 0, 0));
+	unique_ptr<TravelTimeList> reference(libtau->compute(0, 0, 33, 10, 20, 0, 0));
+	BOOST_REQUIRE(list);
+	BOOST_REQUIRE(reference);
+	BOOST_REQUIRE_EQUAL(list->size(), reference->size());
+
+	auto it = list->begin();
+	for ( const auto &tt : *reference ) {
+		BOOST_CHECK_EQUAL(it->phase, tt.phase);
+		BOOST_CHECK_EQUAL(it->time, tt.time);
+		++it;
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(BatchedMatchesSingle) {
+	auto grid = create("grid", "libtau:iasp91");
+	auto libtau = create("libtau", "iasp91");
+
+	vector<double> lats, lons;
+	receivers(lats, lons);
+	vector<double> times(lats.size());
+
+	for ( const char *phase : { "P", "S", static_cast<const char*>(nullptr) } ) {
+		for ( double depth : { 12.0, 33.3, 212.5 } ) {
+			size_t found = grid->computeTimes(phase, 0, 0, depth, lats.size(),
+			                                  lats.data(), lons.data(),
+			                                  nullptr, times.data(), 0);
+			size_t valid = 0;
+
+			for ( size_t i = 0; i < lats.size(); ++i ) {
+				double single;
+				double reference;
+
+				try {
+					single = phase
+					       ? grid->computeTime(phase, 0, 0, depth, lats[i], lons[i], 0, 0)
+					       : grid->computeFirst(0, 0, depth, lats[i], lons[i], 0, 0).time;
+				}
+				catch ( NoPhaseError & ) {
+					single = numeric_limits<double>::quiet_NaN();
+				}
+
+				try {
+					reference = phase
+					          ? libtau->computeTime(phase, 0, 0, depth, lats[i], lons[i], 0, 0)
+					          : libtau->computeFirst(0, 0, depth, lats[i], lons[i], 0, 0).time;
+				}
+				catch ( NoPhaseError & ) {
+					reference = numeric_limits<double>::quiet_NaN();
+				}
+
+				BOOST_CHECK_EQUAL(isnan(times[i]), isnan(single));
+				if ( isnan(times[i]) || isnan(single) ) {
+					continue;
+				}
+
+				++valid;
+
+				// The cached table is interpolated identically for both
+				// paths
+				BOOST_CHECK_SMALL(times[i] - single, 1E-6);
+
+				// and stays close to the sampled interface
+				if ( !isnan(reference) ) {
+					BOOST_CHECK_SMALL(times[i] - reference, 0.2);
+				}
+			}
+
+			BOOST_CHECK_EQUAL(found, valid);
+			BOOST_CHECK(valid > 0);
+		}
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(UnconfiguredPhase) {
+	auto grid = create("grid", "libtau:iasp91");
+
+	vector<double> lats, lons;
+	receivers(lats, lons);
+	vector<double> times(lats.size());
+
+	// pP is not part of the default grid and passed to libtau
+	grid->computeTimes("pP", 0, 0, 102, lats.size(), lats.data(),
+	                   lons.data(), nullptr, times.data(), 0);
+
+	for ( size_t i = 0; i < lats.size(); ++i ) {
+		double single;
+		try {
+			single = grid->computeTime("pP", 0, 0, 102, lats[i], lons[i], 0, 0);
+		}
+		catch ( NoPhaseError & ) {
+			single = numeric_limits<double>::quiet_NaN();
+		}
+
+		BOOST_CHECK_EQUAL(isnan(times[i]), isnan(single));
+		if ( !isnan(times[i]) && !isnan(single) ) {
+			BOOST_CHECK_SMALL(times[i] - single, 1E-6);
+		}
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_SUITE_END()
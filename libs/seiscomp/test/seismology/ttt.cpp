@@ -0,0 +1,145 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+#include <seiscomp/unittest/unittests.h>
+#include <seiscomp/seismology/ttt.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+
+
+#define STR(X) #X
+#define STR2(X) STR(X)
+
+
+namespace {
+
+
+// Compares the batched travel times with the single receiver methods
+// including the ellipticity correction for sources off the equator
+void checkBatched(TravelTimeTableInterface *ttt) {
+	vector<double> lats, lons;
+	for ( double d = 0.35; d < 180; d += 3.7 ) {
+		lats.push_back(d < 90 ? 60 - d : -30);
+		lons.push_back(d * 0.9 - 80);
+	}
+
+	vector<double> times(lats.size());
+	const double lat1 = 47.3, lon1 = 11.4;
+
+	for ( const char *phase : { "P", "S", static_cast<const char*>(nullptr) } ) {
+		for ( double depth : { 12.0, 212.5 } ) {
+			size_t found = ttt->computeTimes(phase, lat1, lon1, depth,
+			                                 lats.size(), lats.data(),
+			                                 lons.data(), nullptr, times.data());
+			size_t valid = 0;
+
+			for ( size_t i = 0; i < lats.size(); ++i ) {
+				double single;
+
+				try {
+					single = phase
+					       ? ttt->computeTime(phase, lat1, lon1, depth, lats[i], lons[i])
+					       : ttt->computeFirst(lat1, lon1, depth, lats[i], lons[i]).time;
+				}
+				catch ( NoPhaseError & ) {
+					single = numeric_limits<double>::quiet_NaN();
+				}
+
+				BOOST_CHECK_EQUAL(isnan(times[i]), isnan(single));
+				if ( isnan(times[i]) || isnan(single) ) {
+					continue;
+				}
+
+				++valid;
+				BOOST_CHECK_SMALL(times[i] - single, 1E-6);
+			}
+
+			BOOST_CHECK_EQUAL(found, valid);
+			BOOST_CHECK(valid > 0);
+		}
+	}
+}
+
+
+}
+
+
+BOOST_AUTO_TEST_SUITE(seiscomp_core_seismology_ttt)
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(LibTau) {
+	setenv("SEISCOMP_LIBTAU_TABLE_DIR", STR2(BUILD_DIR) "/libs/3rd-party/tau/data/", 1);
+
+	TravelTimeTableInterfacePtr ttt = TravelTimeTableInterfaceFactory::Create("libtau");
+	BOOST_REQUIRE(ttt);
+	BOOST_REQUIRE(ttt->setModel("iasp91"));
+	checkBatched(ttt.get());
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(Grid) {
+	setenv("SEISCOMP_LIBTAU_TABLE_DIR", STR2(BUILD_DIR) "/libs/3rd-party/tau/data/", 1);
+
+	TravelTimeTableInterfacePtr ttt = TravelTimeTableInterfaceFactory::Create("grid");
+	BOOST_REQUIRE(ttt);
+	BOOST_REQUIRE(ttt->setModel("libtau:iasp91"));
+	checkBatched(ttt.get());
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(LOCSAT) {
+	TravelTimeTableInterfacePtr ttt = TravelTimeTableInterfaceFactory::Create("LOCSAT");
+	BOOST_REQUIRE(ttt);
+
+	// The LOCSAT tables are read from the installation
+	if ( !ttt->setModel("iasp91") ) {
+		BOOST_TEST_MESSAGE("LOCSAT iasp91 tables not installed, skipping");
+		return;
+	}
+
+	checkBatched(ttt.get());
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_SUITE_END()
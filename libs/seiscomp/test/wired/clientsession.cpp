@@ -0,0 +1,381 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+#include <seiscomp/unittest/unittests.h>
+#include <seiscomp/wired/buffers/file.h>
+#include <seiscomp/wired/clientsession.h>
+#include <seiscomp/wired/devices/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Wired;
+
+
+namespace {
+
+
+/**
+ * @brief A device which records everything written to it. Each call
+ *        writes at most maxChunk bytes to simulate partial writes.
+ */
+struct RecordingDevice : Device {
+	RecordingDevice() : Device(::open("/dev/null", O_WRONLY)) {}
+	~RecordingDevice() override { close(); }
+
+	void close() override {
+		if ( _fd != -1 ) {
+			::close(_fd);
+			_fd = -1;
+		}
+	}
+
+	ssize_t write(const char *data, size_t len) override {
+		++writes;
+		len = min(len, maxChunk);
+		output.append(data, len);
+		return static_cast<ssize_t>(len);
+	}
+
+	ssize_t read(char *, size_t) override {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	ssize_t writev(const struct iovec *iov, int count) override {
+		++writevs;
+		size_t total = 0;
+		for ( int i = 0; (i < count) && (total < maxChunk); ++i ) {
+			size_t len = min(iov[i].iov_len, maxChunk - total);
+			output.append(static_cast<const char*>(iov[i].iov_base), len);
+			total += len;
+		}
+		return static_cast<ssize_t>(total);
+	}
+
+	ssize_t sendFile(int fd, off_t *offset, size_t count) override {
+		if ( !canSendFile ) {
+			return Device::sendFile(fd, offset, count);
+		}
+
+		++sendFiles;
+		vector<char> tmp(min(count, maxChunk));
+		ssize_t r = ::pread(fd, tmp.data(), tmp.size(), *offset);
+		if ( r > 0 ) {
+			output.append(tmp.data(), static_cast<size_t>(r));
+			*offset += r;
+		}
+		return r;
+	}
+
+	string output;
+	size_t maxChunk{string::npos};
+	bool   canSendFile{true};
+	int    writes{0};
+	int    writevs{0};
+	int    sendFiles{0};
+};
+
+
+//! A socket which counts the sendfile calls
+struct CountingSocket : Socket {
+	CountingSocket(int fd) : Socket(fd) {}
+
+	ssize_t sendFile(int fd, off_t *offset, size_t count) override {
+		++sendFiles;
+		return Socket::sendFile(fd, offset, count);
+	}
+
+	int sendFiles{0};
+};
+
+
+//! A buffer which produces its content chunk by chunk in updateBuffer()
+struct StreamingBuffer : Buffer {
+	StreamingBuffer(vector<string> chunks_) : chunks(std::move(chunks_)) {
+		data = chunks[0];
+	}
+
+	bool updateBuffer() override {
+		if ( ++index >= chunks.size() ) {
+			return false;
+		}
+
+		data = chunks[index];
+		return true;
+	}
+
+	size_t length() const override {
+		return string::npos;
+	}
+
+	vector<string> chunks;
+	size_t         index{0};
+};
+
+
+struct TestSession : ClientSession {
+	TestSession(Device *dev) : ClientSession(dev) {}
+
+	//! Flushes the output with the given write quota
+	void run(size_t quota = 1 << 20) {
+		_writeQuota = quota;
+		update();
+	}
+};
+
+
+BufferPtr makeBuffer(const string &header, const string &data) {
+	BufferPtr buf = new Buffer;
+	buf->header = header;
+	buf->data = data;
+	return buf;
+}
+
+
+string makeFile(const string &path, size_t size) {
+	string content;
+	for ( size_t i = 0; i < size; ++i ) {
+		content += static_cast<char>('a' + (i * 7) % 26);
+	}
+
+	FILE *fp = fopen(path.c_str(), "wb");
+	BOOST_REQUIRE(fp);
+	fwrite(content.data(), 1, content.size(), fp);
+	fclose(fp);
+
+	return content;
+}
+
+
+}
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE(seiscomp_wired_clientsession)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(Completeness) {
+	BufferPtr plain = new Buffer;
+	BufferPtr streaming = new StreamingBuffer({"a"});
+	FileBufferPtr file = new FileBuffer;
+
+	BOOST_CHECK(plain->isComplete());
+	BOOST_CHECK(!streaming->isComplete());
+	BOOST_CHECK(!file->isComplete());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(BatchCompleteBuffers) {
+	DevicePtr dev = new RecordingDevice;
+	auto *rec = static_cast<RecordingDevice*>(dev.get());
+	TestSession session(dev.get());
+
+	// Without quota everything is queued
+	string expected;
+	for ( int i = 0; i < 10; ++i ) {
+		string header = "H" + to_string(i);
+		string data = "data" + to_string(i) + ";";
+		session.send(makeBuffer(header, data).get());
+		expected += header + data;
+	}
+
+	BOOST_CHECK_EQUAL(rec->output, "");
+
+	session.run();
+	BOOST_CHECK_EQUAL(rec->output, expected);
+	BOOST_CHECK_EQUAL(rec->writevs, 1);
+	BOOST_CHECK_EQUAL(rec->writes, 0);
+	BOOST_CHECK_EQUAL(session.outputBufferSize(), 0);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(PartialWrites) {
+	DevicePtr dev = new RecordingDevice;
+	auto *rec = static_cast<RecordingDevice*>(dev.get());
+	rec->maxChunk = 3;
+	TestSession session(dev.get());
+
+	session.send(makeBuffer("GET ", "hello").get());
+	session.send(makeBuffer("", " ").get());
+	session.send(makeBuffer("X", "world").get());
+
+	for ( int i = 0; (i < 100) && (rec->output.size() < 16); ++i ) {
+		session.run();
+	}
+
+	BOOST_CHECK_EQUAL(rec->output, "GET hello Xworld");
+	BOOST_CHECK_GT(rec->writevs, 1);
+
+	// The write quota limits the bytes sent per update
+	rec->output.clear();
+	rec->maxChunk = string::npos;
+	session.run(0);
+	session.send(makeBuffer("", "0123456789").get());
+	session.send(makeBuffer("", "abcdef").get());
+	session.run(4);
+	BOOST_CHECK_EQUAL(rec->output, "0123");
+	session.run(8);
+	BOOST_CHECK_EQUAL(rec->output, "0123456789ab");
+	session.run();
+	BOOST_CHECK_EQUAL(rec->output, "0123456789abcdef");
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(StreamingBufferKeepsOrder) {
+	DevicePtr dev = new RecordingDevice;
+	auto *rec = static_cast<RecordingDevice*>(dev.get());
+	TestSession session(dev.get());
+
+	// The streaming buffer does not override isComplete(). The buffers
+	// queued behind it must not be sent before all of its chunks.
+	session.send(makeBuffer("", "<").get());
+	session.send(new StreamingBuffer({"a", "b", "c"}));
+	session.send(makeBuffer("", "d").get());
+	session.send(makeBuffer("", ">").get());
+
+	for ( int i = 0; (i < 10) && (rec->output.size() < 6); ++i ) {
+		session.run();
+	}
+
+	BOOST_CHECK_EQUAL(rec->output, "<abcd>");
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(FileRegion) {
+	string path = "/tmp/wired-filebuffer-" + to_string(getpid());
+	string content = makeFile(path, 20000);
+
+	for ( bool canSendFile : {true, false} ) {
+		DevicePtr dev = new RecordingDevice;
+		auto *rec = static_cast<RecordingDevice*>(dev.get());
+		rec->canSendFile = canSendFile;
+		TestSession session(dev.get());
+
+		FileBufferPtr file = new FileBuffer(4096);
+		BOOST_REQUIRE(file->open(path));
+
+		session.send(makeBuffer("", "[").get());
+		session.send(file.get());
+		session.send(makeBuffer("", "]").get());
+
+		for ( int i = 0; (i < 100) && (rec->output.size() < content.size() + 2); ++i ) {
+			session.run();
+		}
+
+		BOOST_CHECK(rec->output == "[" + content + "]");
+
+		if ( canSendFile ) {
+			// Everything after the first chunk is sent from the file
+			BOOST_CHECK_EQUAL(rec->sendFiles, 1);
+		}
+		else {
+			BOOST_CHECK_EQUAL(rec->sendFiles, 0);
+		}
+	}
+
+	unlink(path.c_str());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(SocketSendFile) {
+	string path = "/tmp/wired-sendfile-" + to_string(getpid());
+	string content = makeFile(path, 50000);
+
+	int fds[2];
+	BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	DevicePtr dev = new CountingSocket(fds[0]);
+	auto *sock = static_cast<CountingSocket*>(dev.get());
+	TestSession session(dev.get());
+
+	FileBufferPtr file = new FileBuffer(4096);
+	BOOST_REQUIRE(file->open(path));
+
+	session.send(file.get());
+	session.send(makeBuffer("", "END").get());
+
+	string received;
+	char buf[8192];
+	for ( int i = 0; (i < 1000) && (received.size() < content.size() + 3); ++i ) {
+		session.run();
+
+		ssize_t r;
+		while ( (r = recv(fds[1], buf, sizeof(buf), MSG_DONTWAIT)) > 0 ) {
+			received.append(buf, static_cast<size_t>(r));
+		}
+	}
+
+	BOOST_CHECK(received == content + "END");
+#ifdef LINUX
+	BOOST_CHECK_GE(sock->sendFiles, 1);
+#else
+	(void)sock;
+#endif
+
+	::close(fds[1]);
+	unlink(path.c_str());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -24,6 +24,7 @@
 
 #include <seiscomp/core/baseobject.h>
 #include <seiscomp/core/datetime.h>
+#include <sys/types.h>
 #include <string>
 #include <list>
 
@@ -70,9 +71,42 @@ struct SC_SYSTEM_CORE_API Buffer : Seiscomp::Core::BaseObject {
 	time_t               lastModified;
 
 	// If true is returned the buffer is valid and updated
-	// otherwise everything has been read
+	// otherwise everything has been read. If true is returned and
+	// header and data are empty then the data is not yet available,
+	// e.g. because it is produced by another thread. Sending stops
+	// until the next update of the session which has to take care of
+	// being updated again, e.g. with a device timeout.
 	virtual bool updateBuffer();
 	virtual size_t length() const;
+
+	/**
+	 * @brief Returns whether header and data hold the complete content
+	 *        of the buffer, i.e. updateBuffer() will never return true.
+	 *        Complete buffers can be sent together with subsequent
+	 *        buffers in one call. Subclasses whose content is set once
+	 *        can override this to return true.
+	 * @return The default implementation returns true for plain Buffer
+	 *         instances and false for all subclasses.
+	 */
+	virtual bool isComplete() const;
+
+	/**
+	 * @brief Returns a region of a file which can be sent directly
+	 *        without copying it into data, e.g. with sendfile. The region
+	 *        is requested after header and data have been sent and before
+	 *        updateBuffer() is called.
+	 * @param fd The file descriptor
+	 * @param offset The file offset of the region
+	 * @param count The number of bytes of the region
+	 * @return Whether a region is available. The default implementation
+	 *         returns false.
+	 */
+	virtual bool fileRegion(int &fd, off_t &offset, size_t &count) const;
+
+	//! Marks the given number of bytes at the beginning of the file
+	//! region as sent. Header and data are considered sent as well and
+	//! must be cleared.
+	virtual void consumeFileRegion(size_t bytes);
 };
 
 
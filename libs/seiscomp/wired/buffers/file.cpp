@@ -49,7 +49,7 @@ const char *MimeTypes[FileBuffer::TypeQuantity] = {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 FileBuffer::FileBuffer(int max_size)
-: Buffer(max_size), fp(nullptr), fplen(0) {}
+: Buffer(max_size), fp(nullptr), fplen(0), _offset(0) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -93,6 +93,7 @@ bool FileBuffer::open(const char *fn, const char *mode) {
 	fseek(fp, 0L, SEEK_END);
 	fplen = ftell(fp);
 	fseek(fp, 0L, SEEK_SET);
+	_offset = 0;
 
 	if ( fplen == -1L ) {
 		fclose(fp);
@@ -121,8 +122,21 @@ bool FileBuffer::open(const char *fn, const char *mode) {
 bool FileBuffer::updateBuffer() {
 	// Erase header since we are transfering the data blocked
 	header.clear();
+
+	if ( data.empty() ) {
+		// The file region has been sent already
+		if ( _offset >= fplen ) return false;
+		size_t sz = fplen - _offset;
+		if ( (int)sz > maxBufferSize ) sz = maxBufferSize;
+		data.resize(sz);
+	}
+
+	// Synchronize the stream position with the last consumed file region
+	if ( ftell(fp) != _offset ) fseek(fp, _offset, SEEK_SET);
+
 	size_t rb = fread(&data[0], 1, data.size(), fp);
 	data.resize(rb);
+	_offset += static_cast<long>(rb);
 	return data.size() > 0;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -130,6 +144,41 @@ bool FileBuffer::updateBuffer() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool FileBuffer::isComplete() const {
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool FileBuffer::fileRegion(int &fd, off_t &offset, size_t &count) const {
+	if ( !fp || (_offset >= fplen) ) return false;
+
+	fd = fileno(fp);
+	offset = static_cast<off_t>(_offset);
+	count = static_cast<size_t>(fplen - _offset);
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void FileBuffer::consumeFileRegion(size_t bytes) {
+	_offset += static_cast<long>(bytes);
+	// Header and data have been sent already
+	header.clear();
+	data.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 size_t FileBuffer::length() const {
 	return fplen;
@@ -37,6 +37,9 @@ DEFINE_SMARTPOINTER(FileBuffer);
  *        connection. It only supports regular files, no symlinks, no
  *        directories, no pipes and so on.
  *        Technically, S_ISREG(stat(fn).st_mode) must evaluate to true.
+ *        If the device supports it, everything after the first chunk is
+ *        sent directly from the file (see fileRegion()) without reading
+ *        it into data.
  */
 class SC_SYSTEM_CORE_API FileBuffer : public Buffer {
 	public:
@@ -50,6 +53,10 @@ class SC_SYSTEM_CORE_API FileBuffer : public Buffer {
 		bool updateBuffer() override;
 		size_t length() const override;
 
+		bool isComplete() const override;
+		bool fileRegion(int &fd, off_t &offset, size_t &count) const override;
+		void consumeFileRegion(size_t bytes) override;
+
 	public:
 		enum Type {
 			HTML,
@@ -70,6 +77,9 @@ class SC_SYSTEM_CORE_API FileBuffer : public Buffer {
 
 		FILE  *fp;
 		long fplen;
+
+	private:
+		long  _offset;
 };
 
 
@@ -37,6 +37,16 @@ using namespace std;
 
 namespace Seiscomp {
 namespace Wired {
+
+
+namespace {
+
+
+// The maximum number of memory blocks passed to a single writev call
+const int MaxIOVectors = 64;
+
+
+}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -110,15 +120,79 @@ void ClientSession::flush(bool flagFlush) {
 		return;
 	}
 
+	auto consumed = [this](size_t written) {
+		if ( written <= _bufferBytesPending ) {
+			_bufferBytesPending -= written;
+		}
+		else {
+			_bufferBytesPending = 0;
+		}
+
+		_writeQuota -= written;
+		SEISCOMP_TRACE("%p: sent %d, quota = %d", static_cast<void*>(this), written, _writeQuota);
+		if ( !_writeQuota ) {
+			if ( _bufferBytesPending ) {
+				SEISCOMP_TRACE("%p: want write", static_cast<void*>(this));
+				_device->addMode(Device::Write);
+			}
+		}
+	};
+
 	while ( _currentBuffer ) {
-		size_t remaining = min(_currentBuffer->header.size() - _currentBufferHeaderOffset, _writeQuota);
 		ssize_t written;
 
-		if ( remaining > 0 ) {
-			written = _device->write(
-				&_currentBuffer->header[_currentBufferHeaderOffset],
-				static_cast<size_t>(remaining)
-			);
+		if ( (_currentBufferHeaderOffset < _currentBuffer->header.size())
+		  || (_currentBufferDataOffset < _currentBuffer->data.size()) ) {
+			struct iovec iov[MaxIOVectors];
+			int count = 0;
+			size_t total = 0;
+
+			auto append = [&](const string &block, size_t offset) {
+				if ( (offset >= block.size()) || (total >= _writeQuota) ) {
+					return;
+				}
+
+				size_t len = min(block.size() - offset, _writeQuota - total);
+				iov[count].iov_base = const_cast<char*>(block.data() + offset);
+				iov[count].iov_len = len;
+				total += len;
+				++count;
+			};
+
+			append(_currentBuffer->header, _currentBufferHeaderOffset);
+			append(_currentBuffer->data, _currentBufferDataOffset);
+
+			// Send subsequent buffers with the same call as long as the
+			// current buffer does not produce more data with updateBuffer.
+			// A non-complete buffer can be added but it must be the last
+			// one to preserve the order of the output.
+			if ( _currentBuffer->isComplete() ) {
+				for ( auto &buf : _bufferQueue ) {
+					if ( (count + 2 > MaxIOVectors) || (total >= _writeQuota) ) {
+						break;
+					}
+
+					append(buf->header, 0);
+					append(buf->data, 0);
+
+					if ( !buf->isComplete() ) {
+						break;
+					}
+				}
+			}
+
+			// No quota left
+			if ( !count ) {
+				break;
+			}
+
+			if ( count > 1 ) {
+				written = _device->writev(iov, count);
+			}
+			else {
+				written = _device->write(static_cast<const char*>(iov[0].iov_base),
+				                         iov[0].iov_len);
+			}
 
 			// Error on socket?
 			if ( written < 0 ) {
@@ -133,94 +207,99 @@ void ClientSession::flush(bool flagFlush) {
 			else if ( written == 0 ) {
 			}
 			else {
-				_currentBufferHeaderOffset += static_cast<size_t>(written);
-				if ( static_cast<size_t>(written) <= _bufferBytesPending ) {
-					_bufferBytesPending -= static_cast<size_t>(written);
-				}
-				else {
-					_bufferBytesPending = 0;
-					//SEISCOMP_DEBUG("Bytes pending: %d, written: %d", (int)_bytesPending, written);
-				}
+				size_t bytes = static_cast<size_t>(written);
+				consumed(bytes);
 
-				_writeQuota -= static_cast<size_t>(written);
-				SEISCOMP_TRACE("%p: sent_h %d, quota = %d", static_cast<void*>(this), written, _writeQuota);
-				if ( !_writeQuota ) {
-					if ( _bufferBytesPending ) {
-						SEISCOMP_TRACE("%p: want write", static_cast<void*>(this));
-						_device->addMode(Device::Write);
+				while ( true ) {
+					size_t chunk = min(bytes, _currentBuffer->header.size() - _currentBufferHeaderOffset);
+					_currentBufferHeaderOffset += chunk;
+					bytes -= chunk;
+
+					chunk = min(bytes, _currentBuffer->data.size() - _currentBufferDataOffset);
+					_currentBufferDataOffset += chunk;
+					bytes -= chunk;
+
+					if ( !bytes ) {
+						break;
 					}
+
+					// The remaining bytes belong to the next buffers. The
+					// current buffer is complete, otherwise no other buffer
+					// would have been written.
+					bufferSent(_currentBuffer.get());
+					_currentBuffer = _bufferQueue.front();
+					_bufferQueue.pop_front();
+					_currentBufferHeaderOffset = 0;
+					_currentBufferDataOffset = 0;
 				}
 			}
-		}
 
-		// header not yet completely sent
-		if ( _currentBufferHeaderOffset < _currentBuffer->header.size() ) {
-			return;
+			if ( (_currentBufferHeaderOffset < _currentBuffer->header.size())
+			  || (_currentBufferDataOffset < _currentBuffer->data.size()) ) {
+				// No all data has been written
+				break;
+			}
 		}
 
-		remaining = min(_currentBuffer->data.size() - _currentBufferDataOffset, _writeQuota);
-		if ( remaining > 0 ) {
-			written = _device->write(&_currentBuffer->data[_currentBufferDataOffset],
-			                         remaining);
+		// Header and data have been sent, try to send the remaining
+		// content directly from a file
+		int fd;
+		off_t offset;
+		size_t count;
+
+		if ( _currentBuffer->fileRegion(fd, offset, count) ) {
+			if ( !_writeQuota ) {
+				break;
+			}
+
+			written = _device->sendFile(fd, &offset, min(count, _writeQuota));
 
-			// Error on socket?
 			if ( written < 0 ) {
-				if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) ) {
-					_currentBuffer = nullptr;
+				if ( (errno == EAGAIN) || (errno == EWOULDBLOCK) ) {
+					break;
+				}
+
+				// If not supported by the device, fall back to updateBuffer
+				if ( (errno != ENOSYS) && (errno != EINVAL) && (errno != EOPNOTSUPP) ) {
 					// Close the session
+					_currentBuffer = nullptr;
 					close();
 					break;
 				}
 			}
-			// No non-blocking writing possible?
-			else if ( written == 0 ) {
-			}
-			else {
-				_currentBufferDataOffset += static_cast<size_t>(written);
-				if ( static_cast<size_t>(written) <= _bufferBytesPending ) {
-					_bufferBytesPending -= static_cast<size_t>(written);
-				}
-				else {
-					_bufferBytesPending = 0;
-					//SEISCOMP_DEBUG("Bytes pending: %d, written: %d", (int)_bytesPending, written);
-				}
-
-				_writeQuota -= static_cast<size_t>(written);
-				SEISCOMP_TRACE("%p: sent_d %d, quota = %d", static_cast<void*>(this), written, _writeQuota);
-				if ( !_writeQuota ) {
-					if ( _bufferBytesPending ) {
-						SEISCOMP_TRACE("%p: want write", static_cast<void*>(this));
-						_device->addMode(Device::Write);
-					}
-				}
+			else if ( written > 0 ) {
+				_currentBuffer->consumeFileRegion(static_cast<size_t>(written));
+				_currentBufferHeaderOffset = 0;
+				_currentBufferDataOffset = 0;
+				consumed(static_cast<size_t>(written));
+				continue;
 			}
 		}
 
-		// Finished current?
-		if ( _currentBufferDataOffset == _currentBuffer->data.size() ) {
-			_currentBufferHeaderOffset = 0;
-			_currentBufferDataOffset = 0;
+		// Finished current
+		_currentBufferHeaderOffset = 0;
+		_currentBufferDataOffset = 0;
 
-			if ( !_currentBuffer->updateBuffer() ) {
-				bufferSent(_currentBuffer.get());
-				_currentBuffer = nullptr;
-				_currentBufferHeaderOffset = 0;
+		if ( !_currentBuffer->updateBuffer() ) {
+			bufferSent(_currentBuffer.get());
+			_currentBuffer = nullptr;
 
-				if ( !_bufferQueue.empty() ) {
-					_currentBuffer = _bufferQueue.front();
-					_bufferQueue.pop_front();
-				}
-			}
-			else {
-				_bufferBytesPending += _currentBuffer->header.size();
-				size_t buf_length = _currentBuffer->length();
-				if ( buf_length == string::npos )
-					_bufferBytesPending += _currentBuffer->data.size();
+			if ( !_bufferQueue.empty() ) {
+				_currentBuffer = _bufferQueue.front();
+				_bufferQueue.pop_front();
 			}
 		}
 		else {
-			// No all data has been written
-			break;
+			_bufferBytesPending += _currentBuffer->header.size();
+			size_t buf_length = _currentBuffer->length();
+			if ( buf_length == string::npos )
+				_bufferBytesPending += _currentBuffer->data.size();
+
+			// The buffer has no data available yet, try again with the
+			// next update.
+			if ( _currentBuffer->header.empty() && _currentBuffer->data.empty() ) {
+				break;
+			}
 		}
 
 		if ( !_currentBuffer ) {
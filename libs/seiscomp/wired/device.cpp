@@ -221,6 +221,31 @@ Device::Status Device::setNonBlocking(bool nb) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ssize_t Device::writev(const struct iovec *iov, int count) {
+	for ( int i = 0; i < count; ++i ) {
+		if ( iov[i].iov_len > 0 ) {
+			return write(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+		}
+	}
+
+	return 0;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ssize_t Device::sendFile(int, off_t *, size_t) {
+	errno = ENOSYS;
+	return -1;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 int Device::takeFd() {
 	auto fd = _fd;
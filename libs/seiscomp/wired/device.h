@@ -44,6 +44,10 @@
 
 #include <seiscomp/core/baseobject.h>
 
+#ifndef WIN32
+#include <sys/uio.h>
+#endif
+
 #include <list>
 #include <stdint.h>
 #include <functional>
@@ -149,6 +153,29 @@ class SC_SYSTEM_CORE_API Device : public Core::BaseObject {
 		virtual ssize_t write(const char *data, size_t len) = 0;
 		virtual ssize_t read(char *data, size_t len) = 0;
 
+		/**
+		 * @brief Writes a list of memory blocks with a single call
+		 *        (scatter-gather). The default implementation writes the
+		 *        first non-empty block with write() only. Partial writes
+		 *        are possible and must be handled by the caller.
+		 * @param iov The list of memory blocks
+		 * @param count The number of memory blocks
+		 * @return The number of bytes written or -1 in case of an error
+		 */
+		virtual ssize_t writev(const struct iovec *iov, int count);
+
+		/**
+		 * @brief Sends data from a file descriptor directly without copying
+		 *        it to user space. The default implementation does not
+		 *        support that and returns -1 with errno set to ENOSYS.
+		 * @param fd The file descriptor to read from
+		 * @param offset The file offset to read from. It will be updated
+		 *               with the number of bytes sent.
+		 * @param count The maximum number of bytes to send
+		 * @return The number of bytes written or -1 in case of an error
+		 */
+		virtual ssize_t sendFile(int fd, off_t *offset, size_t count);
+
 		/**
 		 * @brief Returns the current file descriptor and sets the internal
 		 *        file descriptor to invalid
@@ -34,6 +34,9 @@
 #include <netdb.h>
 #include <unistd.h>
 #include <netinet/tcp.h>
+#ifdef LINUX
+#include <sys/sendfile.h>
+#endif
 #else
 #include <io.h>
 #include <winsock2.h>
@@ -966,6 +969,49 @@ ssize_t Socket::write(const char *data, size_t len) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ssize_t Socket::writev(const struct iovec *iov, int count) {
+#ifndef WIN32
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = const_cast<struct iovec*>(iov);
+	msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(count);
+
+#if !defined(MACOSX)
+	ssize_t sent = ::sendmsg(_fd, &msg, MSG_NOSIGNAL);
+#else
+	ssize_t sent = ::sendmsg(_fd, &msg, 0);
+#endif
+	if ( sent > 0 ) {
+		_bytesSent += static_cast<count_t>(sent);
+	}
+	return sent;
+#else
+	return Device::writev(iov, count);
+#endif
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ssize_t Socket::sendFile(int fd, off_t *offset, size_t count) {
+#ifdef LINUX
+	ssize_t sent = ::sendfile(_fd, fd, offset, count);
+	if ( sent > 0 ) {
+		_bytesSent += static_cast<count_t>(sent);
+	}
+	return sent;
+#else
+	return Device::sendFile(fd, offset, count);
+#endif
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 ssize_t Socket::read(char *data, size_t len) {
 	ssize_t recvd = ::recv(_fd, data, len, 0);
@@ -1318,6 +1364,24 @@ ssize_t SSLSocket::write(const char *data, size_t len) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ssize_t SSLSocket::writev(const struct iovec *iov, int count) {
+	return Device::writev(iov, count);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+ssize_t SSLSocket::sendFile(int fd, off_t *offset, size_t count) {
+	return Device::sendFile(fd, offset, count);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 ssize_t SSLSocket::read(char *data, size_t len) {
 	if ( _flags & InAccept ) {
@@ -175,6 +175,11 @@ class SC_SYSTEM_CORE_API Socket : public Device {
 		ssize_t write(const char *data, size_t len) override;
 		ssize_t read(char *data, size_t len) override;
 
+		//! Writes all blocks with one sendmsg call
+		ssize_t writev(const struct iovec *iov, int count) override;
+		//! Uses sendfile on Linux, not supported on other platforms
+		ssize_t sendFile(int fd, off_t *offset, size_t count) override;
+
 		//! Sets the socket timeout. This utilizes setsockopt which does not
 		//! work in non blocking sockets.
 		Status setSocketTimeout(int secs, int usecs);
@@ -276,6 +281,12 @@ class SSLSocket : public Socket {
 		ssize_t write(const char *data, size_t len) override;
 		ssize_t read(char *data, size_t len) override;
 
+		//! Encrypted data cannot be sent with one sendmsg call. This falls
+		//! back to write().
+		ssize_t writev(const struct iovec *iov, int count) override;
+		//! Not supported with SSL, returns -1 and sets errno to ENOSYS
+		ssize_t sendFile(int fd, off_t *offset, size_t count) override;
+
 		Status connect(const std::string &hostname, port_t port) override;
 		Status connectV6(const std::string &hostname, port_t port) override;
 
@@ -298,9 +298,29 @@ bool Frame::readData() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Frame::finalizeBuffer(Buffer *buf, Type type, Status statusCode) {
+	encodeHeader(buf->header, type, buf->data.size(), statusCode);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Frame::finalizeSplitBuffer(Buffer *buf, Type type) {
+	std::string frameHeader;
+	encodeHeader(frameHeader, type, buf->header.size() + buf->data.size());
+	buf->header.insert(0, frameHeader);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Frame::encodeHeader(std::string &header, Type type, uint64_t pl,
+                         Status statusCode) {
 	uint8_t control = 0x80 | type;
 	uint8_t plc;
-	uint64_t pl = buf->data.size();
 	size_t headerOffset = 0;
 
 	// Add two bytes for the status code
@@ -312,27 +332,27 @@ void Frame::finalizeBuffer(Buffer *buf, Type type, Status statusCode) {
 	if ( pl > 125 && pl <= 65535 ) {
 		plc = 126;
 		Core::Endianess::ByteSwapper<Core::Endianess::Current::LittleEndian,2>::Take(&pl, 1);
-		buf->header.resize(4+headerOffset);
-		memcpy(const_cast<char*>(buf->header.data()) + 2, &pl, 2);
+		header.resize(4+headerOffset);
+		memcpy(const_cast<char*>(header.data()) + 2, &pl, 2);
 	}
 	else if ( pl > 65535 ) {
 		plc = 127;
 		Core::Endianess::ByteSwapper<Core::Endianess::Current::LittleEndian,8>::Take(&pl, 1);
-		buf->header.resize(10+headerOffset);
-		memcpy(const_cast<char*>(buf->header.data()) + 2, &pl, 8);
+		header.resize(10+headerOffset);
+		memcpy(const_cast<char*>(header.data()) + 2, &pl, 8);
 	}
 	else {
 		plc = uint8_t(pl);
-		buf->header.resize(2 + headerOffset);
+		header.resize(2 + headerOffset);
 	}
 
-	memcpy(const_cast<char*>(buf->header.data()), &control, 1);
-	memcpy(const_cast<char*>(buf->header.data() + 1), &plc, 1);
+	memcpy(const_cast<char*>(header.data()), &control, 1);
+	memcpy(const_cast<char*>(header.data() + 1), &plc, 1);
 
 	if ( statusCode != NoStatus ) {
 		uint16_t sc = statusCode;
 		Core::Endianess::ByteSwapper<Core::Endianess::Current::LittleEndian,2>::Take(&sc, 1);
-		memcpy(const_cast<char*>(buf->header.data()) + buf->header.size() - 2, &sc, 2);
+		memcpy(const_cast<char*>(header.data()) + header.size() - 2, &sc, 2);
 	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -108,6 +108,30 @@ class Frame : public Seiscomp::Core::BaseObject {
 
 		static void finalizeBuffer(Buffer *buf, Type type, Status statusCode = NoStatus);
 
+		/**
+		 * @brief Finalizes a buffer whose payload is split into the buffer
+		 *        header and the buffer data, e.g. a small protocol header
+		 *        and a large message body. The frame header is prepended
+		 *        to the buffer header and the data is left untouched. A
+		 *        large body does not need to be copied into a contiguous
+		 *        frame and the buffer can be sent to many sessions.
+		 * @param buf The buffer to be finalized
+		 * @param type The frame type
+		 */
+		static void finalizeSplitBuffer(Buffer *buf, Type type);
+
+		/**
+		 * @brief Encodes a frame header.
+		 * @param header The output string which is overwritten
+		 * @param type The frame type
+		 * @param payloadLength The length of the payload without the
+		 *                      status code
+		 * @param statusCode The optional status code
+		 */
+		static void encodeHeader(std::string &header, Type type,
+		                         uint64_t payloadLength,
+		                         Status statusCode = NoStatus);
+
 
 	private:
 		typedef bool (Frame::*ItemCallback)();
@@ -191,6 +191,8 @@ bool Reactor::run() {
 
 	SEISCOMP_DEBUG("[reactor] running");
 
+	vector<Task> tasks;
+
 	while ( _shouldRun ) {
 		for ( Device *device = wait(); device; device = _devices.next() ) {
 			Session *session = device->session();
@@ -234,8 +236,17 @@ bool Reactor::run() {
 				_deferredSession.pop_front();
 				addSession(s.get());
 			}
+
+			tasks.swap(_tasks);
 		}
 
+		// Run posted tasks outside the lock, they may post again
+		for ( auto &task : tasks ) {
+			task();
+		}
+
+		tasks.clear();
+
 		idle();
 	}
 
@@ -258,6 +269,9 @@ bool Reactor::run() {
 void Reactor::clear() {
 	_devices.clear();
 	_sessions.clear();
+
+	lock_guard<mutex> l(_sessionMutex);
+	_tasks.clear();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -318,6 +332,20 @@ void Reactor::interrupt() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Reactor::post(Task task) {
+	{
+		lock_guard<mutex> l(_sessionMutex);
+		_tasks.push_back(std::move(task));
+	}
+
+	interrupt();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Reactor::stop() {
 	_shouldRun = false;
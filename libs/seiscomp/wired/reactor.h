@@ -25,6 +25,7 @@
 #include <seiscomp/wired/devices/socket.h>
 #include <seiscomp/core/list.h>
 
+#include <functional>
 #include <mutex>
 
 
@@ -54,6 +55,7 @@ class SC_SYSTEM_CORE_API Reactor : public Seiscomp::Core::BaseObject {
 	// ----------------------------------------------------------------------
 	public:
 		typedef DeviceGroup::TriggerMode TriggerMode;
+		typedef std::function<void()> Task;
 
 
 	// ----------------------------------------------------------------------
@@ -125,6 +127,12 @@ class SC_SYSTEM_CORE_API Reactor : public Seiscomp::Core::BaseObject {
 		//! Interrupts the reactors wait causing to idle method to be called
 		void interrupt();
 
+		//! Schedules a task which is executed in the thread of the reactors
+		//! run loop and interrupts the reactor.
+		//! @note This method is thread-safe and meant to notify sessions
+		//!       about events of other threads.
+		void post(Task task);
+
 		//! Interrupts the reactor causing the run loop to terminate.
 		//! The session sockets are not closed and resume can
 		//! be used to continue operation.
@@ -190,6 +198,7 @@ class SC_SYSTEM_CORE_API Reactor : public Seiscomp::Core::BaseObject {
 		size_t             _writeQuota{4096};
 		SessionList        _sessions;
 		SessionList        _deferredSession;
+		std::vector<Task>  _tasks;
 		DeviceGroup        _devices;
 };
 
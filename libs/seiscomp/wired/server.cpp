@@ -27,6 +27,7 @@
 #include <openssl/err.h>
 
 #include <csignal>
+#include <functional>
 #include <string.h>
 
 
@@ -123,6 +124,8 @@ Server::Server() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Server::~Server() {
+	stopWorkers();
+
 	// Free up allocated memory
 	EVP_cleanup();
 }
@@ -149,6 +152,24 @@ void Server::setPrivateKey(const string &key) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Server::setWorkerCount(size_t count) {
+	_workerCount = count;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t Server::workerCount() const {
+	return _workerCount;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool Server::init() {
 	if ( _endpoints.empty() ) {
@@ -166,6 +187,31 @@ bool Server::init() {
 		}
 	}
 
+	if ( !_workers.empty() ) {
+		SEISCOMP_ERROR("[server] workers are already running");
+		return false;
+	}
+
+	for ( size_t i = 0; i < _workerCount; ++i ) {
+		ReactorPtr worker = new Reactor;
+		worker->setTriggerMode(triggerMode());
+		worker->setReadQuota(_readQuota);
+		worker->setWriteQuota(_writeQuota);
+
+		if ( !worker->setup() ) {
+			SEISCOMP_ERROR("[server] failed to setup worker #%zu", i);
+			stopWorkers();
+			return false;
+		}
+
+		_workers.push_back(worker);
+		_workerThreads.push_back(new thread(bind(&Reactor::run, worker.get())));
+	}
+
+	if ( !_workers.empty() ) {
+		SEISCOMP_INFO("[server] started %zu workers", _workers.size());
+	}
+
 	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -187,6 +233,10 @@ void Server::shutdown() {
 		if ( (*it)->device() ) (*it)->device()->close();
 	}
 	_devices.interrupt();
+
+	for ( auto &worker : _workers ) {
+		worker->shutdown();
+	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -197,6 +247,7 @@ void Server::shutdown() {
 void Server::clear() {
 	Reactor::clear();
 	_endpoints.clear();
+	stopWorkers();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -205,6 +256,18 @@ void Server::clear() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool Server::addSession(Session *session) {
+	if ( !_workers.empty() && session && session->device()
+	  && !session->_parent ) {
+		Reactor *worker = selectWorker(session);
+		if ( worker && worker != this ) {
+			// Hand the session over to the worker thread which will add it
+			// in its run loop.
+			worker->addSessionDeferred(session);
+			worker->interrupt();
+			return true;
+		}
+	}
+
 	lock_guard<mutex> l(_mutex);
 
 	if ( session == nullptr || session->device() == nullptr ) {
@@ -451,6 +514,53 @@ void Server::endpointRemoved(Endpoint *) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Reactor *Server::selectWorker(Session *) {
+	if ( _workers.empty() ) {
+		return nullptr;
+	}
+
+	// Start the search at the next worker in turn to distribute sessions
+	// evenly if several workers carry the same load.
+	size_t best = _nextWorker % _workers.size();
+	size_t bestCount = _workers[best]->count();
+
+	for ( size_t i = 1; i < _workers.size(); ++i ) {
+		size_t idx = (_nextWorker + i) % _workers.size();
+		size_t cnt = _workers[idx]->count();
+		if ( cnt < bestCount ) {
+			best = idx;
+			bestCount = cnt;
+		}
+	}
+
+	_nextWorker = best + 1;
+	return _workers[best].get();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Server::stopWorkers() {
+	for ( auto &worker : _workers ) {
+		worker->shutdown();
+	}
+
+	for ( auto thread : _workerThreads ) {
+		thread->join();
+		delete thread;
+	}
+
+	_workerThreads.clear();
+	_workers.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 } // namespace TCP
 } // namespace Gempa
@@ -25,6 +25,9 @@
 #include <seiscomp/wired/reactor.h>
 #include <seiscomp/wired/endpoint.h>
 
+#include <thread>
+#include <vector>
+
 
 namespace Seiscomp {
 namespace Wired {
@@ -67,6 +70,25 @@ class SC_SYSTEM_CORE_API Server : public Reactor {
 		void setCertificate(const std::string&);
 		void setPrivateKey(const std::string&);
 
+		/**
+		 * @brief Sets the number of worker reactors.
+		 *
+		 * If the number of workers is greater than zero, the server starts
+		 * that number of reactors in init(), each running its own event
+		 * loop in a separate thread. Accepted sessions are handed over to
+		 * one of the workers and the server thread only accepts connections.
+		 * Sessions must therefore not share state without synchronisation.
+		 *
+		 * Sessions owned by a worker are not reported to sessionAdded,
+		 * sessionRemoved and sessionTagged of the server.
+		 *
+		 * This must be called before init().
+		 * @param count The number of workers. 0 disables workers and all
+		 *              sessions are handled in the server thread.
+		 */
+		void setWorkerCount(size_t count);
+		size_t workerCount() const;
+
 		//! Initializes the server and starts listening
 		//! on all defined ports
 		virtual bool init();
@@ -130,14 +152,33 @@ class SC_SYSTEM_CORE_API Server : public Reactor {
 	protected:
 		virtual void endpointRemoved(Endpoint *endpoint);
 
+		/**
+		 * @brief Selects the worker reactor which will take over an
+		 *        accepted session. The default implementation selects the
+		 *        worker with the lowest number of sessions.
+		 * @param session The accepted session
+		 * @return The worker or nullptr if the server should handle the
+		 *         session itself.
+		 */
+		virtual Reactor *selectWorker(Session *session);
+
 
 	// ----------------------------------------------------------------------
 	//  Private members
 	// ----------------------------------------------------------------------
 	private:
-		std::string  _certificate;
-		std::string  _privateKey;
-		SessionList  _endpoints;
+		using Workers = std::vector<ReactorPtr>;
+		using WorkerThreads = std::vector<std::thread*>;
+
+		void stopWorkers();
+
+		std::string   _certificate;
+		std::string   _privateKey;
+		SessionList   _endpoints;
+		size_t        _workerCount{0};
+		size_t        _nextWorker{0};
+		Workers       _workers;
+		WorkerThreads _workerThreads;
 };
 
 
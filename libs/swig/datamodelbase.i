@@ -98,6 +98,7 @@ namespace std {
    %template(vectorc) vector< std::complex<double> >;
 };
 
+%ignore Seiscomp::DataModel::PublicObject::Iterator;
 %ignore Seiscomp::DataModel::PublicObjectCache::const_iterator;
 %ignore Seiscomp::DataModel::PublicObjectCache::begin;
 %ignore Seiscomp::DataModel::PublicObjectCache::end;
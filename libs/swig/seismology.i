@@ -103,6 +103,8 @@
 %newobject Seiscomp::TravelTimeTableInterface::Create;
 %newobject Seiscomp::TravelTimeTableInterface::compute;
 %newobject Seiscomp::TravelTimeTable::compute;
+%ignore Seiscomp::TravelTimeTableInterface::computeTimes;
+%ignore Seiscomp::computeDistances;
 
 %apply int &OUTPUT { int *id };
 
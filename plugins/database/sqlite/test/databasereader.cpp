@@ -0,0 +1,275 @@
+/***************************************************************************
+ * Copyright (C) gempa GmbH                                                *
+ * All rights reserved.                                                    *
+ * Contact: gempa GmbH (seiscomp-dev@gempa.de)                             *
+ *                                                                         *
+ * GNU Affero General Public License Usage                                 *
+ * This file may be used under the terms of the GNU Affero                 *
+ * Public License version 3.0 as published by the Free Software Foundation *
+ * and appearing in the file LICENSE included in the packaging of this     *
+ * file. Please review the following information to ensure the GNU Affero  *
+ * Public License version 3.0 requirements will be met:                    *
+ * https://www.gnu.org/licenses/agpl-3.0.html.                             *
+ *                                                                         *
+ * Other Usage                                                             *
+ * Alternatively, this file may be used in accordance with the terms and   *
+ * conditions contained in a signed written agreement between you and      *
+ * gempa GmbH.                                                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE SeisComP
+
+
+#include <seiscomp/unittest/unittests.h>
+
+#include <seiscomp/datamodel/amplitude.h>
+#include <seiscomp/datamodel/arrival.h>
+#include <seiscomp/datamodel/comment.h>
+#include <seiscomp/datamodel/databasearchive.h>
+#include <seiscomp/datamodel/databasereader.h>
+#include <seiscomp/datamodel/event.h>
+#include <seiscomp/datamodel/eventparameters.h>
+#include <seiscomp/datamodel/focalmechanism.h>
+#include <seiscomp/datamodel/magnitude.h>
+#include <seiscomp/datamodel/momenttensor.h>
+#include <seiscomp/datamodel/origin.h>
+#include <seiscomp/datamodel/originreference.h>
+#include <seiscomp/datamodel/pick.h>
+#include <seiscomp/datamodel/stationmagnitude.h>
+#include <seiscomp/datamodel/stationmagnitudecontribution.h>
+#include <seiscomp/io/database.h>
+#include <seiscomp/io/exporter.h>
+
+#include <fstream>
+#include <sstream>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+// The schema relative to the working directory of the test
+const char *Schema = "../../../../libs/seiscomp/datamodel/share/sqlite3.sql";
+
+
+CreationInfo creationInfo(const Core::Time &t) {
+	CreationInfo ci;
+	ci.setAgencyID("GFZ");
+	ci.setAuthor("test");
+	ci.setCreationTime(t);
+	return ci;
+}
+
+
+CommentPtr createComment(const string &id, const string &text) {
+	CommentPtr comment = new Comment;
+	comment->setId(id);
+	comment->setText(text);
+	return comment;
+}
+
+
+/**
+ * @brief Creates event parameters which populate all relations of the
+ *        first levels with several children per parent.
+ */
+EventParametersPtr createParameters() {
+	EventParametersPtr ep = new EventParameters;
+	Core::Time t(1700000000, 250000);
+
+	for ( int i = 0; i < 20; ++i ) {
+		PickPtr pick = Pick::Create("Pick/" + to_string(i));
+		pick->setWaveformID(WaveformStreamID("GE", "STA" + to_string(i % 7), "", "BHZ", ""));
+		pick->setTime(TimeQuantity(t + Core::TimeSpan(i, 0)));
+		pick->setPhaseHint(Phase(i % 2 ? "S" : "P"));
+		pick->setCreationInfo(creationInfo(t));
+		if ( i % 4 == 0 ) {
+			pick->add(createComment("quality", "impulsive").get());
+		}
+		ep->add(pick.get());
+
+		AmplitudePtr amp = Amplitude::Create("Amplitude/" + to_string(i));
+		amp->setType("MLv");
+		amp->setAmplitude(RealQuantity(i * 0.5));
+		amp->setPickID(pick->publicID());
+		amp->setWaveformID(pick->waveformID());
+		ep->add(amp.get());
+	}
+
+	for ( int o = 0; o < 5; ++o ) {
+		OriginPtr org = Origin::Create("Origin/" + to_string(o));
+		org->setTime(TimeQuantity(t));
+		org->setLatitude(RealQuantity(52.0 + o));
+		org->setLongitude(RealQuantity(13.0));
+		org->setCreationInfo(creationInfo(t + Core::TimeSpan(o, 0)));
+		org->add(createComment("note", "origin " + to_string(o)).get());
+
+		// A different number of children per origin
+		for ( int i = 0; i < 4 + o * 3; ++i ) {
+			ArrivalPtr arr = new Arrival;
+			arr->setPickID("Pick/" + to_string(i));
+			arr->setPhase(Phase(i % 2 ? "S" : "P"));
+			arr->setDistance(i * 1.5);
+			arr->setWeight(1.0);
+			org->add(arr.get());
+
+			StationMagnitudePtr staMag = StationMagnitude::Create(
+				"StationMagnitude/" + to_string(o) + "/" + to_string(i));
+			staMag->setMagnitude(RealQuantity(3.0 + i * 0.1));
+			staMag->setType("MLv");
+			staMag->setAmplitudeID("Amplitude/" + to_string(i));
+			org->add(staMag.get());
+		}
+
+		MagnitudePtr mag = Magnitude::Create("Magnitude/" + to_string(o));
+		mag->setMagnitude(RealQuantity(3.5));
+		mag->setType("MLv");
+		for ( size_t i = 0; i < org->stationMagnitudeCount(); ++i ) {
+			mag->add(new StationMagnitudeContribution(org->stationMagnitude(i)->publicID(), 0.1, 1.0));
+		}
+		org->add(mag.get());
+
+		ep->add(org.get());
+	}
+
+	FocalMechanismPtr fm = FocalMechanism::Create("FocalMechanism/0");
+	fm->setTriggeringOriginID("Origin/0");
+	MomentTensorPtr mt = MomentTensor::Create("MomentTensor/0");
+	mt->setDerivedOriginID("Origin/1");
+	mt->add(createComment("inversion", "test").get());
+	fm->add(mt.get());
+	ep->add(fm.get());
+
+	for ( int e = 0; e < 2; ++e ) {
+		EventPtr evt = Event::Create("Event/" + to_string(e));
+		evt->setPreferredOriginID("Origin/" + to_string(e * 2));
+		evt->add(createComment("operator", "checked").get());
+		for ( int o = e * 2; o < e * 2 + 3 && o < 5; ++o ) {
+			evt->add(new OriginReference("Origin/" + to_string(o)));
+		}
+		ep->add(evt.get());
+	}
+
+	return ep;
+}
+
+
+string serialize(EventParameters *ep) {
+	IO::ExporterPtr exp = IO::Exporter::Create("trunk");
+	BOOST_REQUIRE(exp);
+	stringbuf buf;
+	BOOST_REQUIRE(exp->write(&buf, ep));
+	return buf.str();
+}
+
+
+/**
+ * @brief An in-memory sqlite3 database with the current schema.
+ */
+struct Database {
+	Database() {
+		db = IO::DatabaseInterface::Open("sqlite3://:memory:");
+		BOOST_REQUIRE(db);
+
+		ifstream ifs(Schema);
+		BOOST_REQUIRE(ifs.good());
+		stringstream ss;
+		ss << ifs.rdbuf();
+		BOOST_REQUIRE(db->execute(ss.str().c_str()));
+	}
+
+	string load(bool bulk, size_t chunkSize = 1000) {
+		DatabaseReaderPtr reader = new DatabaseReader(db.get());
+		reader->setBulkLoadingEnabled(bulk);
+		reader->setBulkChunkSize(chunkSize);
+
+		EventParametersPtr ep = reader->loadEventParameters();
+		BOOST_REQUIRE(ep);
+		BOOST_CHECK(ep->pickCount() > 0);
+		return serialize(ep.get());
+	}
+
+	IO::DatabaseInterfacePtr db;
+};
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_FIXTURE_TEST_SUITE(seiscomp_plugins_dbsqlite3_databasereader, Database)
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(BulkLoadEventParameters) {
+	string expected;
+
+	{
+		EventParametersPtr ep = createParameters();
+		expected = serialize(ep.get());
+
+		DatabaseReaderPtr writer = new DatabaseReader(db.get());
+		DatabaseObjectWriter write(*writer);
+		BOOST_REQUIRE(write(ep.get()));
+		BOOST_REQUIRE_EQUAL(write.errors(), 0);
+
+		// Release all objects to not resolve the loaded objects from the
+		// public object registry
+	}
+
+	string serial = load(false);
+	string bulk = load(true);
+	// Several queries per relation
+	string chunked = load(true, 2);
+
+	BOOST_CHECK(serial == expected);
+	BOOST_CHECK(bulk == serial);
+	BOOST_CHECK(chunked == serial);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_CASE(LoadReturnValue) {
+	{
+		EventParametersPtr ep = createParameters();
+		DatabaseReaderPtr writer = new DatabaseReader(db.get());
+		DatabaseObjectWriter write(*writer);
+		BOOST_REQUIRE(write(ep.get()));
+	}
+
+	// Both modes count the direct children of the event parameters only
+	for ( bool bulk : { false, true } ) {
+		DatabaseReaderPtr reader = new DatabaseReader(db.get());
+		reader->setBulkLoadingEnabled(bulk);
+
+		EventParametersPtr ep = new EventParameters;
+		int count = reader->load(ep.get());
+		BOOST_CHECK_EQUAL(count, 20 + 20 + 5 + 1 + 2);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+BOOST_AUTO_TEST_SUITE_END()
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -40,6 +40,7 @@
 #include <numeric>
 #include <array>
 #include <tuple>
+#include <map>
 #include <set>
 
 #include "solver.h"
@@ -1314,49 +1315,107 @@ bool StdLoc::computeOriginTime(const PickList &pickList,
 		throw LocatorException("Interna logic error");
 	}
 
-	travelTimes.resize(pickList.size());
+	travelTimes.assign(pickList.size(), -1.0);
 
-	vector<double> originTimes;
-	vector<double> timeWeights;
+	// Group the picks by phase to compute the travel times of all sensors
+	// of one phase with a single call
+	map<string, vector<size_t>> phasePicks;
 
 	for ( size_t i = 0; i < pickList.size(); ++i ) {
-		const PickItem &pi = pickList[i];
-		const PickPtr pick = pi.pick;
-
-		travelTimes[i] = -1.0;
-
 		if ( weights[i] <= 0 ) {
 			continue;
 		}
 
-		double ttime;
+		const string &phaseCode = pickList[i].pick->phaseHint().code();
+		string phaseName = phaseCode;
+		if ( _currentProfile.PSTableOnly ) {
+			if ( Util::getShortPhaseName(phaseCode) == 'P' ) {
+				phaseName = "P";
+			}
+			else if ( Util::getShortPhaseName(phaseCode) == 'S' ) {
+				phaseName = "S";
+			}
+		}
+
+		phasePicks[phaseName].push_back(i);
+	}
+
+	vector<double> lats, lons, elevs, ttimes;
+	vector<bool> valid(pickList.size(), false);
+
+	for ( const auto &[phaseName, indices] : phasePicks ) {
+		lats.clear();
+		lons.clear();
+		elevs.clear();
+
+		for ( size_t i : indices ) {
+			lats.push_back(sensorLat[i]);
+			lons.push_back(sensorLon[i]);
+			elevs.push_back(sensorElev[i]);
+		}
+
+		ttimes.resize(indices.size());
+
+		bool batched = true;
 
 		try {
-			const char *phaseName = pick->phaseHint().code().c_str();
-			if ( _currentProfile.PSTableOnly ) {
-				if ( Util::getShortPhaseName(pick->phaseHint().code()) == 'P' ) {
-					phaseName = "P";
+			_ttt->computeTimes(phaseName.c_str(), lat, lon, depth,
+			                   indices.size(), lats.data(), lons.data(),
+			                   elevs.data(), ttimes.data());
+		}
+		catch ( exception & ) {
+			// One failing receiver must not drop the whole group, compute
+			// the travel times of this group one by one
+			batched = false;
+		}
+
+		for ( size_t k = 0; k < indices.size(); ++k ) {
+			size_t i = indices[k];
+			const PickPtr pick = pickList[i].pick;
+
+			if ( !batched ) {
+				try {
+					ttimes[k] = _ttt->computeTime(phaseName.c_str(), lat, lon,
+					                              depth, lats[k], lons[k],
+					                              elevs[k]);
 				}
-				else if ( Util::getShortPhaseName(pick->phaseHint().code()) == 'S' ) {
-					phaseName = "S";
+				catch ( exception &e ) {
+					SEISCOMP_WARNING("Travel Time Table error for %s@%s.%s.%s and lat "
+					                 "%g lon %g depth %g: %s",
+					                 pick->phaseHint().code().c_str(),
+					                 pick->waveformID().networkCode().c_str(),
+					                 pick->waveformID().stationCode().c_str(),
+					                 pick->waveformID().locationCode().c_str(), lat,
+					                 lon, depth, e.what());
+					continue;
 				}
 			}
-			ttime = _ttt->computeTime(phaseName, lat, lon, depth, sensorLat[i],
-			                          sensorLon[i], sensorElev[i]);
-		}
-		catch ( exception &e ) {
-			SEISCOMP_WARNING("Travel Time Table error for %s@%s.%s.%s and lat "
-			                 "%g lon %g depth %g: %s",
-			                 pick->phaseHint().code().c_str(),
-			                 pick->waveformID().networkCode().c_str(),
-			                 pick->waveformID().stationCode().c_str(),
-			                 pick->waveformID().locationCode().c_str(), lat,
-			                 lon, depth, e.what());
+
+			if ( std::isnan(ttimes[k]) ) {
+				SEISCOMP_WARNING("Travel Time Table error for %s@%s.%s.%s and lat "
+				                 "%g lon %g depth %g: phase not found",
+				                 pick->phaseHint().code().c_str(),
+				                 pick->waveformID().networkCode().c_str(),
+				                 pick->waveformID().stationCode().c_str(),
+				                 pick->waveformID().locationCode().c_str(), lat,
+				                 lon, depth);
+				continue;
+			}
+
+			travelTimes[i] = ttimes[k];
+			valid[i] = true;
+		}
+	}
+
+	vector<double> originTimes;
+	vector<double> timeWeights;
+
+	for ( size_t i = 0; i < pickList.size(); ++i ) {
+		if ( !valid[i] ) {
 			continue;
 		}
 
-		travelTimes[i] = ttime;
-		double pickTime = pick->time().value().epoch();
+		double pickTime = pickList[i].pick->time().value().epoch();
 		originTimes.push_back(pickTime - travelTimes[i]);
 		timeWeights.push_back(weights[i]);
 	}